@@ -54,6 +54,11 @@ public:
   */
   void putNextEntry(const std::string& entryName);
 
+  /** Writes an entry whose data has already been compressed, see
+      ZipOutputStreambuf::putRawEntry(). */
+  void putRawEntry( const ZipCDirEntry &entry, const char *data,
+                    uint32 compressed_size, uint32 size, uint32 crc ) ;
+
   /** Sets the global comment for the Zip archive. */
   void setComment( const std::string& comment ) ;
 
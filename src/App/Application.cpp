@@ -2119,6 +2119,7 @@ void Application::initTypes()
     // Test features
     App::FeatureTest               ::init();
     App::FeatureTestException      ::init();
+    App::FeatureTestConcurrent     ::init();
     App::FeatureTestColumn         ::init();
     App::FeatureTestRow            ::init();
     App::FeatureTestAbsAddress     ::init();
@@ -44,7 +44,10 @@
 #include <boost/graph/strong_components.hpp>
 
 #include <boost/regex.hpp>
+#include <atomic>
+#include <future>
 #include <random>
+#include <thread>
 #include <unordered_map>
 #include <unordered_set>
 
@@ -587,6 +590,7 @@ void Document::clearDocument() // NOLINT
 
     d->clearRecomputeLog();
     d->objectLabelManager.clear();
+    d->clearSortedObjects();
     d->objectArray.clear();
     d->objectMap.clear();
     d->objectNameManager.clear();
@@ -2228,6 +2232,7 @@ void Document::restore(const char* filename,
 
     d->clearRecomputeLog();
     d->objectLabelManager.clear();
+    d->clearSortedObjects();
     d->objectArray.clear();
     d->objectNameManager.clear();
     d->objectMap.clear();
@@ -2283,7 +2288,31 @@ void Document::restore(const char* filename,
     // Note: This file doesn't need to be available if the document has been created
     // without GUI. But if available then follow after all data files of the App document.
     signalRestoreDocument(reader);
-    reader.readFiles(zipstream);
+
+    // With lazy loading, properties that support it keep a handle to their data
+    // file and only read it on first access, which requires random access to the
+    // archive
+    ParameterGrp::handle hGrp =
+        GetApplication().GetParameterGroupByPath("User parameter:BaseApp/Preferences/Document");
+    std::shared_ptr<zipios::ZipFile> zip;
+    if (hGrp->GetBool("LazyRestore", false)) {
+        try {
+            zip = std::make_shared<zipios::ZipFile>(fi.filePath());
+            if (!zip->isValid()) {
+                zip.reset();
+            }
+        }
+        catch (const std::exception& e) {
+            FC_WARN("Cannot open " << fi.filePath() << " for lazy loading: " << e.what());
+            zip.reset();
+        }
+    }
+    if (zip) {
+        reader.readFiles(zip);
+    }
+    else {
+        reader.readFiles(zipstream);
+    }
 
     DocumentP::checkStringHasher(reader);
 
@@ -2701,7 +2730,33 @@ Document::getDependencyList(const std::vector<DocumentObject*>& objs, int option
     std::map<DocumentObject*, Vertex> objectMap;
     std::map<Vertex, DocumentObject*> vertexMap;
 
-    buildDependencyList(objs, options, nullptr, &depList, &objectMap);
+    buildDependencyList(objs, options, &ret, &depList, &objectMap);
+
+    // If all dependencies live in one document, order them by the document's
+    // cached topological order instead of sorting the graph again
+    Document* doc = nullptr;
+    for (auto obj : ret) {
+        if (!doc) {
+            doc = obj->getDocument();
+        }
+        else if (obj->getDocument() != doc) {
+            doc = nullptr;
+            break;
+        }
+    }
+    if (doc && doc->d->updateSortedObjects()) {
+        const auto& sortedIndex = doc->d->sortedIndex;
+        bool indexed = std::all_of(ret.begin(), ret.end(), [&sortedIndex](auto obj) {
+            return sortedIndex.contains(obj);
+        });
+        if (indexed) {
+            std::sort(ret.begin(), ret.end(), [&sortedIndex](auto a, auto b) {
+                return sortedIndex.at(a) < sortedIndex.at(b);
+            });
+            return ret;
+        }
+    }
+    ret.clear();
 
     for (auto& v : objectMap) {
         vertexMap[v.second] = v.first;
@@ -2961,6 +3016,7 @@ int Document::recompute(const std::vector<DocumentObject*>& objs,
     ParameterGrp::handle hGrp =
         GetApplication().GetParameterGroupByPath("User parameter:BaseApp/Preferences/Document");
     bool canAbort = hGrp->GetBool("CanAbortRecompute", true);
+    bool parallel = hGrp->GetBool("ParallelRecompute", false) && topoSortedObjects.size() > 1;
 
     FC_TIME_INIT(t2);
 
@@ -2975,6 +3031,16 @@ int Document::recompute(const std::vector<DocumentObject*>& objs,
                                                                 topoSortedObjects.size());
             }
             FC_LOG("Recompute pass " << passes);
+            if (passes == 0 && parallel) {
+                if (!_recomputeParallel(topoSortedObjects,
+                                        filter,
+                                        objectCount,
+                                        hasError,
+                                        seq.get())) {
+                    passes = 2;
+                }
+                idx = topoSortedObjects.size();
+            }
             for (; idx < topoSortedObjects.size(); ++idx) {
                 auto obj = topoSortedObjects[idx];
                 if (!obj->isAttachedToDocument() || filter.find(obj) != filter.end()) {
@@ -3083,6 +3149,214 @@ int Document::recompute(const std::vector<DocumentObject*>& objs,
     return objectCount;
 }
 
+// Recompute the given topologically sorted objects one dependency level at a
+// time. The objects of a level only depend on objects of lower levels, so the
+// tasks of all objects of a level that allow it (see
+// DocumentObject::prepareConcurrentRecompute()) run on worker threads while the
+// other objects of the level are recomputed on the calling thread. The workers
+// are joined at the end of each level. Their results are then applied on the
+// calling thread in the order of the sorted list, so that property changes,
+// signals, undo and error reporting never happen on a worker thread.
+bool Document::_recomputeParallel(const std::vector<DocumentObject*>& topoSortedObjects,
+                                  std::set<DocumentObject*>& filter,
+                                  int& objectCount,
+                                  bool* hasError,
+                                  Base::SequencerLauncher* seq)
+{
+    struct Task
+    {
+        size_t index = 0;
+        DocumentObject::ConcurrentTask compute;
+        DocumentObject::ConcurrentResult apply;
+        std::exception_ptr exception;
+    };
+
+    const size_t count = topoSortedObjects.size();
+    std::unordered_map<DocumentObject*, size_t> indices;
+    indices.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        indices.emplace(topoSortedObjects[i], i);
+    }
+
+    // An object's level is one above its highest dependency. Dependencies
+    // that come later in the list are only possible with cyclic dependencies,
+    // which the sorted list has already broken up, so they are ignored.
+    std::vector<std::vector<size_t>> levels;
+    std::vector<size_t> levelOf(count, 0);
+    for (size_t i = 0; i < count; ++i) {
+        auto obj = topoSortedObjects[i];
+        if (obj->isAttachedToDocument()) {
+            for (auto dep : obj->getOutList()) {
+                auto it = indices.find(dep);
+                if (it != indices.end() && it->second < i) {
+                    levelOf[i] = std::max(levelOf[i], levelOf[it->second] + 1);
+                }
+            }
+        }
+        if (levelOf[i] >= levels.size()) {
+            levels.resize(levelOf[i] + 1);
+        }
+        levels[levelOf[i]].push_back(i);
+    }
+
+    ParameterGrp::handle hGrp =
+        GetApplication().GetParameterGroupByPath("User parameter:BaseApp/Preferences/Document");
+    int threads = int(hGrp->GetInt("RecomputeThreads", 0));
+    if (threads <= 0) {
+        threads = std::max(1, int(std::thread::hardware_concurrency()));
+    }
+
+    auto finish = [&](size_t i, bool doRecompute) {
+        auto obj = topoSortedObjects[i];
+        if (obj->isTouched() || doRecompute) {
+            signalRecomputedObject(*obj);
+            obj->purgeTouched();
+            // set all dependent object touched to force recompute
+            for (auto inObjIt : obj->getInList()) {
+                inObjIt->enforceRecompute();
+            }
+        }
+        if (seq) {
+            seq->next(true);
+        }
+    };
+
+    // returns false if aborted by user
+    auto fail = [&](size_t i, int res) {
+        if (hasError) {
+            *hasError = true;
+        }
+        if (res < 0) {
+            return false;
+        }
+        // if something happened filter all object in its
+        // inListRecursive from the queue then proceed
+        auto obj = topoSortedObjects[i];
+        obj->getInListEx(filter, true);
+        filter.insert(obj);
+        return true;
+    };
+
+    bool aborted = false;
+    for (const auto& level : levels) {
+        std::vector<Task> tasks;
+        std::vector<size_t> serial;
+        for (auto i : level) {
+            auto obj = topoSortedObjects[i];
+            if (!obj->isAttachedToDocument() || filter.contains(obj)) {
+                continue;
+            }
+            if (!obj->mustRecompute()) {
+                finish(i, false);
+                continue;
+            }
+
+            ++objectCount;
+            DocumentObject::ConcurrentTask compute;
+            int res = _recomputeFeature(obj, [obj, &compute]() {
+                auto returnCode =
+                    obj->ExpressionEngine.execute(PropertyExpressionEngine::ExecuteNonOutput);
+                if (returnCode == DocumentObject::StdReturn) {
+                    compute = obj->prepareConcurrentRecompute();
+                }
+                return returnCode;
+            });
+            if (res != 0) {
+                if (!fail(i, res)) {
+                    aborted = true;
+                    break;
+                }
+            }
+            else if (compute) {
+                Task task;
+                task.index = i;
+                task.compute = std::move(compute);
+                tasks.push_back(std::move(task));
+            }
+            else {
+                serial.push_back(i);
+            }
+        }
+
+        // the workers only run the prepared tasks and never touch the document
+        std::atomic<size_t> next {0};
+        auto work = [&tasks, &next]() {
+            for (size_t t = next++; t < tasks.size(); t = next++) {
+                try {
+                    tasks[t].apply = tasks[t].compute();
+                }
+                catch (...) {
+                    tasks[t].exception = std::current_exception();
+                }
+            }
+        };
+        std::vector<std::future<void>> workers;
+        size_t numWorkers = aborted ? 0 : std::min(tasks.size(), size_t(threads));
+        for (size_t w = 0; w < numWorkers; ++w) {
+            workers.push_back(std::async(std::launch::async, work));
+        }
+
+        // meanwhile the remaining objects of the level are recomputed here
+        for (auto i : serial) {
+            if (aborted) {
+                break;
+            }
+            auto obj = topoSortedObjects[i];
+            int res = _recomputeFeature(obj, [obj]() {
+                auto returnCode = obj->recompute();
+                if (returnCode == DocumentObject::StdReturn) {
+                    returnCode =
+                        obj->ExpressionEngine.execute(PropertyExpressionEngine::ExecuteOutput);
+                }
+                return returnCode;
+            });
+            if (res != 0) {
+                aborted = !fail(i, res);
+            }
+            else {
+                finish(i, true);
+            }
+        }
+
+        for (auto& worker : workers) {
+            worker.wait();
+        }
+        if (aborted) {
+            break;
+        }
+
+        for (auto& task : tasks) {
+            auto obj = topoSortedObjects[task.index];
+            FC_LOG("Applying concurrent recompute of " << obj->getFullName());
+            int res = _recomputeFeature(obj, [obj, &task]() {
+                if (task.exception) {
+                    std::rethrow_exception(task.exception);
+                }
+                auto returnCode = obj->recomputeWith(task.apply);
+                if (returnCode == DocumentObject::StdReturn) {
+                    returnCode =
+                        obj->ExpressionEngine.execute(PropertyExpressionEngine::ExecuteOutput);
+                }
+                return returnCode;
+            });
+            if (res != 0) {
+                if (!fail(task.index, res)) {
+                    aborted = true;
+                    break;
+                }
+            }
+            else {
+                finish(task.index, true);
+            }
+        }
+        if (aborted) {
+            break;
+        }
+    }
+
+    return !aborted;
+}
+
 /*!
   Does almost the same as topologicalSort() until no object with an input degree of zero
   can be found. It then searches for objects with an output degree of zero until neither
@@ -3256,6 +3530,85 @@ DocumentP::topologicalSort(const std::vector<DocumentObject*>& objects) const
     return ret;
 }
 
+// Bring the cached topological order of the document objects up to date. As
+// long as the changed OutLists only point to objects that already come first,
+// the order stays valid and is kept. Otherwise it is rebuilt from scratch.
+// Returns false if the objects contain a dependency cycle.
+bool DocumentP::updateSortedObjects()
+{
+    if (sortedValid && !sortedCycle) {
+        for (auto obj : sortedDirty) {
+            auto it = sortedIndex.find(obj);
+            if (it == sortedIndex.end()) {
+                sortedValid = false;
+                break;
+            }
+            for (auto dep : obj->getOutList()) {
+                if (!dep || dep->getDocument() != obj->getDocument()) {
+                    continue;
+                }
+                auto itDep = sortedIndex.find(dep);
+                if (itDep == sortedIndex.end() || itDep->second >= it->second) {
+                    sortedValid = false;
+                    break;
+                }
+            }
+            if (!sortedValid) {
+                break;
+            }
+        }
+        sortedDirty.clear();
+    }
+
+    if (sortedValid) {
+        return !sortedCycle;
+    }
+
+    clearSortedObjects();
+
+    // Kahn's algorithm, visiting independent objects in creation order
+    std::unordered_map<const DocumentObject*, size_t> indices;
+    indices.reserve(objectArray.size());
+    for (size_t i = 0; i < objectArray.size(); ++i) {
+        indices.emplace(objectArray[i], i);
+    }
+    std::vector<size_t> inDegree(objectArray.size(), 0);
+    std::vector<std::vector<size_t>> dependents(objectArray.size());
+    for (size_t i = 0; i < objectArray.size(); ++i) {
+        std::unordered_set<const DocumentObject*> outSet;
+        for (auto dep : objectArray[i]->getOutList()) {
+            auto it = indices.find(dep);
+            if (it != indices.end() && outSet.insert(dep).second) {
+                ++inDegree[i];
+                dependents[it->second].push_back(i);
+            }
+        }
+    }
+
+    std::deque<size_t> queue;
+    for (size_t i = 0; i < objectArray.size(); ++i) {
+        if (inDegree[i] == 0) {
+            queue.push_back(i);
+        }
+    }
+    sortedObjects.reserve(objectArray.size());
+    while (!queue.empty()) {
+        size_t i = queue.front();
+        queue.pop_front();
+        sortedIndex.emplace(objectArray[i], sortedObjects.size());
+        sortedObjects.push_back(objectArray[i]);
+        for (auto dependent : dependents[i]) {
+            if (--inDegree[dependent] == 0) {
+                queue.push_back(dependent);
+            }
+        }
+    }
+
+    sortedValid = true;
+    sortedCycle = sortedObjects.size() != objectArray.size();
+    return !sortedCycle;
+}
+
 std::vector<DocumentObject*> Document::topologicalSort() const
 {
     return d->topologicalSort(d->objectArray);
@@ -3271,9 +3624,9 @@ int Document::_recomputeFeature(DocumentObject* Feat) // NOLINT
 {
     FC_LOG("Recomputing " << Feat->getFullName());
 
-    DocumentObjectExecReturn* returnCode = nullptr;
-    try {
-        returnCode = Feat->ExpressionEngine.execute(PropertyExpressionEngine::ExecuteNonOutput);
+    return _recomputeFeature(Feat, [Feat]() {
+        auto returnCode =
+            Feat->ExpressionEngine.execute(PropertyExpressionEngine::ExecuteNonOutput);
         if (returnCode == DocumentObject::StdReturn) {
             returnCode = Feat->recompute();
             if (returnCode == DocumentObject::StdReturn) {
@@ -3281,6 +3634,16 @@ int Document::_recomputeFeature(DocumentObject* Feat) // NOLINT
                     Feat->ExpressionEngine.execute(PropertyExpressionEngine::ExecuteOutput);
             }
         }
+        return returnCode;
+    });
+}
+
+int Document::_recomputeFeature(DocumentObject* Feat,  // NOLINT
+                                const std::function<DocumentObjectExecReturn*()>& exec)
+{
+    DocumentObjectExecReturn* returnCode = nullptr;
+    try {
+        returnCode = exec();
     }
     catch (Base::AbortException& e) {
         e.reportException();
@@ -3392,6 +3755,7 @@ DocumentObject* Document::addObject(const char* sType,
     pcObject->pcNameInDocument = &(d->objectMap.find(ObjectName)->first);
     // insert in the vector
     d->objectArray.push_back(pcObject);
+    d->addSortedObject(pcObject);
     // Register the current Label even though it is (probably) about to change
     registerLabel(pcObject->Label.getStrValue());
 
@@ -3489,6 +3853,7 @@ Document::addObjects(const char* sType, const std::vector<std::string>& objectNa
         pcObject->pcNameInDocument = &(d->objectMap.find(ObjectName)->first);
         // insert in the vector
         d->objectArray.push_back(pcObject);
+        d->addSortedObject(pcObject);
         // Register the current Label even though it is about to change
         registerLabel(pcObject->Label.getStrValue());
 
@@ -3562,6 +3927,7 @@ void Document::addObject(DocumentObject* pcObject, const char* pObjectName)
     pcObject->pcNameInDocument = &(d->objectMap.find(ObjectName)->first);
     // insert in the vector
     d->objectArray.push_back(pcObject);
+    d->addSortedObject(pcObject);
     // Register the current Label even though it is about to change
     registerLabel(pcObject->Label.getStrValue());
 
@@ -3594,6 +3960,7 @@ void Document::_addObject(DocumentObject* pcObject, const char* pObjectName)
     }
     d->objectIdMap[pcObject->_Id] = pcObject;
     d->objectArray.push_back(pcObject);
+    d->addSortedObject(pcObject);
     registerLabel(pcObject->Label.getStrValue());
     // cache the pointer to the name string in the Object (for performance of
     // DocumentObject::getNameInDocument())
@@ -3710,6 +4077,7 @@ void Document::removeObject(const char* sName)
          obj != d->objectArray.end();
          ++obj) {
         if (*obj == pos->second) {
+            d->removeSortedObject(*obj);
             d->objectArray.erase(obj);
             break;
         }
@@ -3805,6 +4173,7 @@ void Document::_removeObject(DocumentObject* pcObject)
          it != d->objectArray.end();
          ++it) {
         if (*it == pcObject) {
+            d->removeSortedObject(pcObject);
             d->objectArray.erase(it);
             break;
         }
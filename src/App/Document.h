@@ -33,7 +33,9 @@
 #include "PropertyLinks.h"
 #include "PropertyStandard.h"
 
+#include <functional>
 #include <map>
+#include <set>
 #include <vector>
 #include <utility>
 #include <list>
@@ -41,6 +43,7 @@
 
 namespace Base
 {
+class SequencerLauncher;
 class Writer;
 }
 
@@ -646,6 +649,17 @@ protected:
     /// helper which Recompute only this feature
     /// @return 0 if succeeded, 1 if failed, -1 if aborted by user.
     int _recomputeFeature(DocumentObject* Feat);
+    /// helper which runs \a exec for \a Feat and records any failure in the recompute log
+    /// @return 0 if succeeded, 1 if failed, -1 if aborted by user.
+    int _recomputeFeature(DocumentObject* Feat,
+                          const std::function<DocumentObjectExecReturn*()>& exec);
+    /// helper which recomputes the sorted objects, running independent ones concurrently
+    /// @return false if aborted by user.
+    bool _recomputeParallel(const std::vector<DocumentObject*>& topoSortedObjects,
+                            std::set<DocumentObject*>& filter,
+                            int& objectCount,
+                            bool* hasError,
+                            Base::SequencerLauncher* seq);
     void _clearRedos();
 
     /// refresh the internal dependency graph
@@ -49,6 +49,7 @@
 #include "ObjectIdentifier.h"
 #include "PropertyExpressionEngine.h"
 #include "PropertyLinks.h"
+#include "private/DocumentP.h"
 
 
 FC_LOG_LEVEL_INIT("App", true, true)
@@ -153,6 +154,14 @@ void DocumentObject::printInvalidLinks() const
 }
 
 App::DocumentObjectExecReturn* DocumentObject::recompute()
+{
+    return recomputeWith([this]() {
+        return this->execute();
+    });
+}
+
+App::DocumentObjectExecReturn*
+DocumentObject::recomputeWith(const std::function<App::DocumentObjectExecReturn*()>& exec)
 {
     // check if the links are valid before making the recompute
     if (!GeoFeatureGroupExtension::areLinksValid(this)) {
@@ -165,7 +174,7 @@ App::DocumentObjectExecReturn* DocumentObject::recompute()
     // mark the object to recompute its extensions
     this->setStatus(App::RecomputeExtension, true);
 
-    auto ret = this->execute();
+    auto ret = exec();
     if (ret == StdReturn) {
         // most feature classes don't call the execute() method of its base class
         // so execute the extensions now
@@ -891,6 +900,9 @@ void DocumentObject::clearOutListCache() const
     _outList.clear();
     _outListMap.clear();
     _outListCached = false;
+    if (_pDoc) {
+        _pDoc->d->markSortedObjectDirty(this);
+    }
 }
 
 PyObject* DocumentObject::getPyObject()
@@ -32,6 +32,7 @@
 #include <Base/SmartPtrPy.h>
 
 #include <bitset>
+#include <functional>
 #include <unordered_map>
 #include <memory>
 #include <map>
@@ -517,6 +518,30 @@ public:
     {
         return false;
     }
+
+    /// Writes the result of a concurrent recompute, see prepareConcurrentRecompute()
+    using ConcurrentResult = std::function<DocumentObjectExecReturn*()>;
+    /// Computes the result of a concurrent recompute, see prepareConcurrentRecompute()
+    using ConcurrentTask = std::function<ConcurrentResult()>;
+
+    /** Return a task that does the work of execute() on a worker thread
+     *
+     * This is only consulted when parallel recompute is enabled in the
+     * preferences. It is called on the main thread once the inputs of the
+     * object are recomputed. The task then runs on a worker thread and must
+     * only use data captured by value: it must neither read nor write the
+     * document or any property, and must not call into Python or the GUI.
+     * It returns a function that is run on the main thread in place of
+     * execute() once all objects of the same dependency level are done, so
+     * that property changes, signals and undo only happen there.
+     * An empty task, which is the default, recomputes the object on the main
+     * thread as usual. Objects that override recompute() should not opt in,
+     * since the result is applied through DocumentObject::recompute().
+     */
+    virtual ConcurrentTask prepareConcurrentRecompute()
+    {
+        return {};
+    }
     /// Handle Label changes, including forcing unique label values,
     /// signalling OnBeforeLabelChange, and arranging to update linked references,
     /// on the assumption that after returning the label will indeed be changed to
@@ -704,6 +729,9 @@ public:
 protected:
     /// recompute only this object
     virtual App::DocumentObjectExecReturn* recompute();
+    /// recompute only this object but run \a exec in place of execute()
+    App::DocumentObjectExecReturn*
+    recomputeWith(const std::function<App::DocumentObjectExecReturn*()>& exec);
     /** get called by the document to recompute this feature
      * Normally this method get called in the processing of
      * Document::recompute().
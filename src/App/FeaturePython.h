@@ -196,6 +196,11 @@ public:
         }
         return imp->mustExecute() ? 1 : 0;
     }
+    /// Python features are always recomputed on the main thread
+    ConcurrentTask prepareConcurrentRecompute() override
+    {
+        return {};
+    }
     /// recalculate the Feature
     DocumentObjectExecReturn* execute() override
     {
@@ -25,6 +25,7 @@
 #ifndef _PreComp_
 #include <boost/core/ignore_unused.hpp>
 #include <sstream>
+#include <thread>
 #endif
 
 #include <Base/Console.h>
@@ -242,6 +243,49 @@ DocumentObjectExecReturn* FeatureTestException::execute()
 
 // ----------------------------------------------------------------------------
 
+PROPERTY_SOURCE(App::FeatureTestConcurrent, App::FeatureTest)
+
+namespace
+{
+long sourceValue(const PropertyLink& link)
+{
+    auto source = freecad_cast<FeatureTest*>(link.getValue());
+    return source ? source->Integer.getValue() : 0;
+}
+}  // namespace
+
+FeatureTestConcurrent::FeatureTestConcurrent()
+{
+    ADD_PROPERTY(ComputedOnWorker, (false));
+}
+
+DocumentObject::ConcurrentTask FeatureTestConcurrent::prepareConcurrentRecompute()
+{
+    // the inputs are read here on the main thread
+    long value = sourceValue(Source1) + sourceValue(Source2) + 1;
+    return [this, value]() -> ConcurrentResult {
+        auto worker = std::this_thread::get_id();
+        return [this, value, worker]() {
+            ComputedOnWorker.setValue(worker != std::this_thread::get_id());
+            Integer.setValue(value);
+            ExecCount.setValue(ExecCount.getValue() + 1);
+            ExecResult.setValue("Exec");
+            return DocumentObject::StdReturn;
+        };
+    };
+}
+
+DocumentObjectExecReturn* FeatureTestConcurrent::execute()
+{
+    ComputedOnWorker.setValue(false);
+    Integer.setValue(sourceValue(Source1) + sourceValue(Source2) + 1);
+    ExecCount.setValue(ExecCount.getValue() + 1);
+    ExecResult.setValue("Exec");
+    return DocumentObject::StdReturn;
+}
+
+// ----------------------------------------------------------------------------
+
 PROPERTY_SOURCE(App::FeatureTestColumn, App::DocumentObject)
 
 
@@ -138,6 +138,28 @@ public:
     }
 };
 
+/// The concurrent recompute testing feature
+class FeatureTestConcurrent: public FeatureTest
+{
+    PROPERTY_HEADER_WITH_OVERRIDE(App::FeatureTestConcurrent);
+
+public:
+    FeatureTestConcurrent();
+
+    /// set if the result was computed on another thread than it was applied on
+    App::PropertyBool ComputedOnWorker;
+
+    /// Integer becomes one plus the Integer values of Source1 and Source2
+    ConcurrentTask prepareConcurrentRecompute() override;
+    /// the same as above without a worker thread
+    DocumentObjectExecReturn* execute() override;
+    /// returns the type name of the ViewProvider
+    const char* getViewProviderName() const override
+    {
+        return "Gui::ViewProviderFeature";
+    }
+};
+
 class FeatureTestColumn: public DocumentObject
 {
     PROPERTY_HEADER_WITH_OVERRIDE(App::FeatureTestColumn);
@@ -51,10 +51,12 @@ TYPESYSTEM_SOURCE_ABSTRACT(App::Property, Base::Persistence)
 // Construction/Destruction
 
 static std::atomic<int64_t> _PropID;
+static std::atomic<int64_t> _PropChangeStamp;
 
 // Here is the implementation! Description should take place in the header file!
 Property::Property()
     : _id(++_PropID)
+    , _changeStamp(++_PropChangeStamp)
 {}
 
 Property::~Property() = default;
@@ -69,6 +71,11 @@ bool Property::hasName() const
     return isValidName(myName);
 }
 
+int64_t Property::getCurrentChangeStamp()
+{
+    return _PropChangeStamp;
+}
+
 bool Property::isValidName(const char* name)
 {
     return !Base::Tools::isNullOrEmpty(name);
@@ -255,6 +262,7 @@ void Property::destroy(Property* p)
 void Property::touch()
 {
     PropertyCleaner guard(this);
+    _changeStamp = ++_PropChangeStamp;
     if (father) {
         father->onEarlyChange(this);
         father->onChanged(this);
@@ -270,6 +278,7 @@ void Property::setReadOnly(bool readOnly)
 void Property::hasSetValue()
 {
     PropertyCleaner guard(this);
+    _changeStamp = ++_PropChangeStamp;
     if (father) {
         father->onChanged(this);
         if (!testStatus(Busy)) {
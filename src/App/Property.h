@@ -516,6 +516,24 @@ public:
         return _id;
     }
 
+    /**
+     * @brief Return the change stamp of the property.
+     *
+     * The stamp is taken from an application wide, monotonically increasing
+     * counter whenever the value of the property changes, or when it is
+     * created.  So, a property has been changed after a point in time if its
+     * stamp is greater than the value of getCurrentChangeStamp() at that time.
+     *
+     * @see getCurrentChangeStamp()
+     */
+    int64_t getChangeStamp() const
+    {
+        return _changeStamp;
+    }
+
+    /// Return the most recent change stamp of any property.
+    static int64_t getCurrentChangeStamp();
+
     /**
      * @brief Callback for when the property is about to be saved.
      *
@@ -596,6 +614,7 @@ private:
     PropertyContainer* father {nullptr};
     const char* myName {nullptr};
     int64_t _id;
+    int64_t _changeStamp;
 
 public:
     /// Signal emitted when the property value has changed.
@@ -26,6 +26,8 @@
 #include <App/Document.h>
 #include <App/DocumentObject.h>
 #include <App/DocumentObserver.h>
+#include <App/PropertyGeo.h>
+#include <App/PropertyPythonObject.h>
 #include <Base/Reader.h>
 #include <Base/Tools.h>
 #include <Base/Writer.h>
@@ -144,6 +146,10 @@ Property* PropertyExpressionEngine::Copy() const
 
 void PropertyExpressionEngine::hasSetValue()
 {
+    // Any change of the expressions or their dependencies, e.g. by deleting a
+    // referenced object, invalidates the cached evaluation state
+    resetEvaluationCache();
+
     App::DocumentObject* owner = dynamic_cast<App::DocumentObject*>(getContainer());
     if (!owner || !owner->isAttachedToDocument() || owner->isRestoring()
         || testFlag(LinkDetached)) {
@@ -581,6 +587,31 @@ protected:
     int& _src;
 };
 
+/**
+ * @brief Check if the binding of \a path is evaluated with the given option.
+ */
+
+static bool isExecuted(const ObjectIdentifier& path,
+                       PropertyExpressionEngine::ExecuteOption option)
+{
+    auto prop = path.getProperty();
+    if (!prop) {
+        throw Base::RuntimeError("Path does not resolve to a property.");
+    }
+    bool is_output =
+        prop->testStatus(App::Property::Output) || (prop->getType() & App::Prop_Output);
+    if ((is_output && option == PropertyExpressionEngine::ExecuteNonOutput)
+        || (!is_output && option == PropertyExpressionEngine::ExecuteOutput)) {
+        return false;
+    }
+    if (option == PropertyExpressionEngine::ExecuteOnRestore
+        && !prop->testStatus(Property::Transient) && !(prop->getType() & Prop_Transient)
+        && !prop->testStatus(Property::EvalOnRestore)) {
+        return false;
+    }
+    return true;
+}
+
 /**
  * @brief Build a graph of all expressions in \a exprs.
  * @param exprs Expressions to use in graph
@@ -599,22 +630,8 @@ void PropertyExpressionEngine::buildGraph(const ExpressionMap& exprs,
 
     // Build data structure for graph
     for (const auto& expr : exprs) {
-        if (option != ExecuteAll) {
-            auto prop = expr.first.getProperty();
-            if (!prop) {
-                throw Base::RuntimeError("Path does not resolve to a property.");
-            }
-            bool is_output =
-                prop->testStatus(App::Property::Output) || (prop->getType() & App::Prop_Output);
-            if ((is_output && option == ExecuteNonOutput)
-                || (!is_output && option == ExecuteOutput)) {
-                continue;
-            }
-            if (option == ExecuteOnRestore && !prop->testStatus(Property::Transient)
-                && !(prop->getType() & Prop_Transient)
-                && !prop->testStatus(Property::EvalOnRestore)) {
-                continue;
-            }
+        if (option != ExecuteAll && !isExecuted(expr.first, option)) {
+            continue;
         }
         buildGraphStructures(expr.first, expr.second.expression, nodes, revNodes, edges);
     }
@@ -670,6 +687,129 @@ PropertyExpressionEngine::computeEvaluationOrder(ExecuteOption option)
     return evaluationOrder;
 }
 
+/**
+ * The evaluation order of all expressions only changes with the expressions.
+ * So it is cached, and filtered for the given option. If the complete graph
+ * has a cycle then the graph of the requested bindings is checked instead.
+ */
+
+std::vector<App::ObjectIdentifier>
+PropertyExpressionEngine::getEvaluationOrder(ExecuteOption option)
+{
+    if (!evaluationOrderValid) {
+        try {
+            cachedEvaluationOrder = computeEvaluationOrder(ExecuteAll);
+        }
+        catch (Base::RuntimeError&) {
+            if (option == ExecuteAll) {
+                throw;
+            }
+            return computeEvaluationOrder(option);
+        }
+        evaluationOrderValid = true;
+    }
+
+    if (option == ExecuteAll) {
+        return cachedEvaluationOrder;
+    }
+
+    std::vector<App::ObjectIdentifier> evaluationOrder;
+    for (const auto& path : cachedEvaluationOrder) {
+        if (isExecuted(path, option)) {
+            evaluationOrder.push_back(path);
+        }
+    }
+    return evaluationOrder;
+}
+
+void PropertyExpressionEngine::resetEvaluationCache()
+{
+    evaluationOrderValid = false;
+    cachedEvaluationOrder.clear();
+    for (auto& e : expressions) {
+        e.second.inputs.clear();
+        e.second.inputsResolved = false;
+        e.second.trackable = false;
+        e.second.evalStamp = 0;
+    }
+}
+
+/**
+ * @brief Collect the properties read by the expression of \a info.
+ *
+ * An expression can only be tracked if all its inputs are properties of
+ * objects in the same document that are registered as dependencies of this
+ * engine, because only then the engine gets notified if they are deleted.
+ */
+
+void PropertyExpressionEngine::resolveInputs(ExpressionInfo& info) const
+{
+    auto owner = freecad_cast<DocumentObject*>(getContainer());
+    info.inputs.clear();
+    info.inputsResolved = true;
+    info.trackable = owner && info.expression;
+    if (!info.trackable) {
+        return;
+    }
+
+    for (auto& dep : info.expression->getDeps(Expression::DepAll)) {
+        auto obj = dep.first;
+        if (!obj
+            || (obj != owner
+                && (obj->getDocument() != owner->getDocument() || !_Deps.contains(obj)))) {
+            info.trackable = false;
+            break;
+        }
+        for (auto& propDep : dep.second) {
+            auto prop =
+                propDep.first.empty() ? nullptr : obj->getPropertyByName(propDep.first.c_str());
+            // Pseudo properties like '_self' or 'Name' can't be tracked, and neither can
+            // geometry or Python objects which may change without notification, e.g. the
+            // placement of a shape
+            if (!prop || prop->isDerivedFrom<PropertyComplexGeoData>()
+                || prop->isDerivedFrom<PropertyPythonObject>()) {
+                info.trackable = false;
+                break;
+            }
+            // The inputs behind a link depend on its value, so resolve them again
+            // on the next evaluation
+            if (prop->isDerivedFrom<PropertyLinkBase>()) {
+                info.inputsResolved = false;
+            }
+            info.inputs.emplace_back(obj, propDep.first);
+        }
+        if (!info.trackable) {
+            break;
+        }
+    }
+
+    if (!info.trackable) {
+        info.inputs.clear();
+    }
+}
+
+/**
+ * @brief Check if the binding would evaluate to the value it has already set.
+ *
+ * This is the case if neither the bound property nor any input of the
+ * expression has changed since the last evaluation.
+ */
+
+bool PropertyExpressionEngine::isUpToDate(ExpressionInfo& info, const Property* prop) const
+{
+    if (!info.evalStamp || !info.trackable || info.targetStamp != prop->getChangeStamp()) {
+        return false;
+    }
+
+    for (const auto& input : info.inputs) {
+        auto inputProp = input.first->getPropertyByName(input.second.c_str());
+        if (!inputProp || inputProp->getChangeStamp() > info.evalStamp) {
+            return false;
+        }
+    }
+    return true;
+}
+
 /**
  * @brief Compute and update values of all registered expressions.
  * @return StdReturn on success.
@@ -731,9 +871,12 @@ DocumentObjectExecReturn* App::PropertyExpressionEngine::execute(ExecuteOption o
     resetter r(running);
 
     // Compute evaluation order
-    std::vector<App::ObjectIdentifier> evaluationOrder = computeEvaluationOrder(option);
+    std::vector<App::ObjectIdentifier> evaluationOrder = getEvaluationOrder(option);
     std::vector<ObjectIdentifier>::const_iterator it = evaluationOrder.begin();
 
+    // Bindings evaluated in this run, see isUpToDate()
+    std::vector<std::pair<ExpressionInfo*, Property*>> evaluated;
+
 #ifdef FC_PROPERTYEXPRESSIONENGINE_LOG
     std::clog << "Computing expressions for " << getName() << std::endl;
 #endif
@@ -759,9 +902,22 @@ DocumentObjectExecReturn* App::PropertyExpressionEngine::execute(ExecuteOption o
         App::any value;
         try {
             // Evaluate expression
-            std::shared_ptr<App::Expression> expression = expressions[*it].expression;
+            ExpressionInfo& info = expressions[*it];
+            std::shared_ptr<App::Expression> expression = info.expression;
             if (expression) {
+                if (isUpToDate(info, prop)) {
+                    continue;
+                }
+
+                // only set after all bindings have been applied without error
+                info.targetStamp = 0;
+                int64_t stamp = Property::getCurrentChangeStamp();
                 value = expression->getValueAsAny();
+                if (!info.inputsResolved) {
+                    resolveInputs(info);
+                }
+                info.evalStamp = stamp;
+                evaluated.emplace_back(&info, prop);
 
                 // Enable value comparison for all expression bindings to reduce
                 // unnecessary touch and recompute.
@@ -804,6 +960,12 @@ DocumentObjectExecReturn* App::PropertyExpressionEngine::execute(ExecuteOption o
             throw Base::RuntimeError(ss.str().c_str());
         }
     }
+
+    // Bindings may set different parts of the same property, so remember its
+    // state after all of them have been applied
+    for (auto& v : evaluated) {
+        v.first->targetStamp = v.second->getChangeStamp();
+    }
     return DocumentObject::StdReturn;
 }
 
@@ -99,6 +99,15 @@ public:
         std::shared_ptr<App::Expression> expression; /**< The actual expression tree */
         bool busy;
 
+        /** Properties read by the expression, stored as owner object and property
+         * name. They are resolved on the first evaluation and reset whenever the
+         * engine changes. */
+        std::vector<std::pair<App::DocumentObject*, std::string>> inputs;
+        bool inputsResolved = false; /**< True if inputs has been resolved */
+        bool trackable = false;      /**< True if all inputs of the expression are known */
+        int64_t evalStamp = 0;       /**< Property change stamp before the last evaluation */
+        int64_t targetStamp = 0;     /**< Change stamp of the bound property afterwards */
+
         explicit ExpressionInfo(
             std::shared_ptr<App::Expression> expression = std::shared_ptr<App::Expression>())
         {
@@ -205,6 +214,7 @@ private:
 #endif
 
     std::vector<App::ObjectIdentifier> computeEvaluationOrder(ExecuteOption option);
+    std::vector<App::ObjectIdentifier> getEvaluationOrder(ExecuteOption option);
 
     void buildGraphStructures(const App::ObjectIdentifier& path,
                               const std::shared_ptr<Expression> expression,
@@ -217,6 +227,10 @@ private:
                     DiGraph& g,
                     ExecuteOption option = ExecuteAll) const;
 
+    void resolveInputs(ExpressionInfo& info) const;
+    bool isUpToDate(ExpressionInfo& info, const Property* prop) const;
+    void resetEvaluationCache();
+
     void slotChangedObject(const App::DocumentObject& obj, const App::Property& prop);
     void slotChangedProperty(const App::DocumentObject& obj, const App::Property& prop);
     void updateHiddenReference(const std::string& key);
@@ -226,6 +240,10 @@ private:
 
     ExpressionMap expressions; /**< Stored expressions */
 
+    /** Evaluation order of all expressions, computed on demand */
+    std::vector<App::ObjectIdentifier> cachedEvaluationOrder;
+    bool evaluationOrderValid = false;
+
     ValidatorFunc validator; /**< Valdiator functor */
 
     struct RestoredExpression
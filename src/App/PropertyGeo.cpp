@@ -333,18 +333,20 @@ void PropertyVectorList::SaveDocFile(Base::Writer& writer) const
     Base::OutputStream str(writer.Stream());
     uint32_t uCt = (uint32_t)getSize();
     str << uCt;
+    static_assert(sizeof(Base::Vector3d) == 3 * sizeof(double));
     if (!isSinglePrecision()) {
-        for (const auto& it : _lValueList) {
-            str << it.x << it.y << it.z;
-        }
+        str.writeArray(reinterpret_cast<const double*>(_lValueList.data()),
+                       3 * _lValueList.size());
     }
     else {
+        std::vector<float> values;
+        values.reserve(3 * _lValueList.size());
         for (const auto& it : _lValueList) {
-            float x = (float)it.x;
-            float y = (float)it.y;
-            float z = (float)it.z;
-            str << x << y << z;
+            values.push_back(static_cast<float>(it.x));
+            values.push_back(static_cast<float>(it.y));
+            values.push_back(static_cast<float>(it.z));
         }
+        str.writeArray(values.data(), values.size());
     }
 }
 
@@ -355,15 +357,13 @@ void PropertyVectorList::RestoreDocFile(Base::Reader& reader)
     str >> uCt;
     std::vector<Base::Vector3d> values(uCt);
     if (!isSinglePrecision()) {
-        for (auto& it : values) {
-            str >> it.x >> it.y >> it.z;
-        }
+        str.readArray(reinterpret_cast<double*>(values.data()), 3 * values.size());
     }
     else {
-        Base::Vector3f vec;
-        for (auto& it : values) {
-            str >> vec.x >> vec.y >> vec.z;
-            it.Set(vec.x, vec.y, vec.z);
+        std::vector<float> floats(3 * values.size());
+        str.readArray(floats.data(), floats.size());
+        for (std::size_t i = 0; i < values.size(); i++) {
+            values[i].Set(floats[3 * i], floats[3 * i + 1], floats[3 * i + 2]);
         }
     }
     setValues(values);
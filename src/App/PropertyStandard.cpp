@@ -1369,15 +1369,11 @@ void PropertyFloatList::SaveDocFile(Base::Writer& writer) const
     uint32_t uCt = (uint32_t)getSize();
     str << uCt;
     if (!isSinglePrecision()) {
-        for (double it : _lValueList) {
-            str << it;
-        }
+        str.writeArray(_lValueList.data(), _lValueList.size());
     }
     else {
-        for (double it : _lValueList) {
-            float v = static_cast<float>(it);
-            str << v;
-        }
+        std::vector<float> values(_lValueList.begin(), _lValueList.end());
+        str.writeArray(values.data(), values.size());
     }
 }
 
@@ -1388,16 +1384,12 @@ void PropertyFloatList::RestoreDocFile(Base::Reader& reader)
     str >> uCt;
     std::vector<double> values(uCt);
     if (!isSinglePrecision()) {
-        for (double& it : values) {
-            str >> it;
-        }
+        str.readArray(values.data(), values.size());
     }
     else {
-        for (double& it : values) {
-            float val;
-            str >> val;
-            it = val;
-        }
+        std::vector<float> floats(uCt);
+        str.readArray(floats.data(), floats.size());
+        std::copy(floats.begin(), floats.end(), values.begin());
     }
     setValues(values);
 }
@@ -98,6 +98,17 @@ struct DocumentP
 
     StringHasherRef Hasher {new StringHasher};
 
+    // Cached topological order of objectArray with dependencies first. Removed
+    // objects leave a null entry behind until compactSortedObjects() drops them,
+    // see Document::getDependencyList()
+    std::vector<DocumentObject*> sortedObjects;
+    std::unordered_map<const DocumentObject*, size_t> sortedIndex;
+    size_t sortedRemoved {0};
+    // objects whose OutList changed since the order was last verified
+    std::unordered_set<const DocumentObject*> sortedDirty;
+    bool sortedValid {false};
+    bool sortedCycle {false};
+
     Document::PreRecomputeHook _preRecomputeHook;
 
     DocumentP();
@@ -133,8 +144,73 @@ struct DocumentP
         }
     }
 
+    void clearSortedObjects()
+    {
+        sortedObjects.clear();
+        sortedIndex.clear();
+        sortedDirty.clear();
+        sortedRemoved = 0;
+        sortedValid = false;
+        sortedCycle = false;
+    }
+
+    void addSortedObject(DocumentObject* obj)
+    {
+        if (sortedValid && !sortedCycle) {
+            sortedIndex[obj] = sortedObjects.size();
+            sortedObjects.push_back(obj);
+            sortedDirty.insert(obj);
+        }
+    }
+
+    void removeSortedObject(const DocumentObject* obj)
+    {
+        if (sortedCycle) {
+            // the removed object may have been part of the cycle
+            clearSortedObjects();
+            return;
+        }
+        auto it = sortedIndex.find(obj);
+        if (it != sortedIndex.end()) {
+            sortedObjects[it->second] = nullptr;
+            sortedIndex.erase(it);
+            // keep add/remove cycles from growing the order without bound
+            if (++sortedRemoved > 64 && sortedRemoved * 2 > sortedObjects.size()) {
+                compactSortedObjects();
+            }
+        }
+        sortedDirty.erase(obj);
+    }
+
+    void compactSortedObjects()
+    {
+        size_t count = 0;
+        for (auto obj : sortedObjects) {
+            if (obj) {
+                sortedIndex[obj] = count;
+                sortedObjects[count++] = obj;
+            }
+        }
+        sortedObjects.resize(count);
+        sortedRemoved = 0;
+    }
+
+    void markSortedObjectDirty(const DocumentObject* obj)
+    {
+        if (sortedValid) {
+            if (sortedCycle) {
+                // any link change may have broken the cycle
+                clearSortedObjects();
+            }
+            else if (sortedIndex.contains(obj)) {
+                sortedDirty.insert(obj);
+            }
+        }
+    }
+
     void clearDocument()
     {
+        clearSortedObjects();
         objectLabelManager.clear();
         objectArray.clear();
         for (auto& v : objectMap) {
@@ -164,6 +240,7 @@ struct DocumentP
     topologicalSort(const std::vector<App::DocumentObject*>& objects) const;
     static std::vector<App::DocumentObject*>
     partialTopologicalSort(const std::vector<App::DocumentObject*>& objects);
+    bool updateSortedObjects();
     static void checkStringHasher(const Base::XMLReader& reader);
 };
 
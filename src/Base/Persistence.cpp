@@ -74,6 +74,11 @@ void Persistence::SaveDocFile(Writer& /*writer*/) const
 void Persistence::RestoreDocFile(Reader& /*reader*/)
 {}
 
+void Persistence::setLazyDocFile(const std::shared_ptr<LazyDocFile>& file)
+{
+    file->restore(this);
+}
+
 std::string Persistence::encodeAttribute(const std::string& str)
 {
     std::string tmp;
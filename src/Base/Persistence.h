@@ -24,10 +24,13 @@
 #ifndef APP_PERSISTENCE_H
 #define APP_PERSISTENCE_H
 
+#include <memory>
+
 #include "BaseClass.h"
 
 namespace Base
 {
+class LazyDocFile;
 class Reader;
 class Writer;
 class XMLReader;
@@ -145,6 +148,20 @@ public:
      * @see Base::Reader,Base::XMLReader
      */
     virtual void RestoreDocFile(Reader& /*reader*/);
+    /** Return true if RestoreDocFile() may be deferred until the data is needed
+     * If a document is restored with lazy loading, such objects get their file
+     * passed to setLazyDocFile() instead and are expected to restore it with
+     * LazyDocFile::restore() on first access of the data.
+     * The default implementation returns false.
+     */
+    virtual bool canRestoreDocFileLazily() const
+    {
+        return false;
+    }
+    /** Keep the handle to a file registered with XMLReader::addFile() to restore it later
+     * The default implementation restores the file immediately.
+     */
+    virtual void setLazyDocFile(const std::shared_ptr<LazyDocFile>& file);
     /// Encodes an attribute upon saving.
     static std::string encodeAttribute(const std::string&);
 
@@ -24,6 +24,9 @@
 #include "PreCompiled.h"
 
 #ifndef _PreComp_
+#include <cerrno>
+#include <charconv>
+#include <cstdlib>
 #include <map>
 #include <vector>
 #include <iostream>
@@ -48,6 +51,7 @@
 #ifdef _MSC_VER
 #include <zipios++/zipios-config.h>
 #endif
+#include <zipios++/zipfile.h>
 #include <zipios++/zipinputstream.h>
 #include <boost/iostreams/filtering_stream.hpp>
 
@@ -115,28 +119,62 @@ const char* Base::XMLReader::localName() const
 
 unsigned int Base::XMLReader::getAttributeCount() const
 {
-    return static_cast<unsigned int>(AttrMap.size());
+    return static_cast<unsigned int>(AttributeCount);
+}
+
+const std::string* Base::XMLReader::findAttribute(const char* AttrName) const
+{
+    // elements have only a few attributes so that a linear search is fastest
+    for (std::size_t i = 0; i < AttributeCount; i++) {
+        if (Attributes[i].first == AttrName) {
+            return &Attributes[i].second;
+        }
+    }
+    return nullptr;
 }
 
 namespace
 {
+// Parses the common plain numbers without creating a temporary std::string. Anything
+// else is handed to the std::sto* functions to keep their results and exceptions.
 template<typename T>
-T readerCast(const char* value)
+bool fastNumberCast(const std::string& value, T& result)
+{
+    const char* begin = value.data();
+    if constexpr (std::is_same_v<T, double>) {
+        // std::from_chars for floating point is not supported by all standard libraries
+        char* last = nullptr;
+        errno = 0;
+        result = std::strtod(begin, &last);
+        return last != begin && errno != ERANGE;
+    }
+    else {
+        auto [last, ec] = std::from_chars(begin, begin + value.size(), result);
+        return ec == std::errc() && last != begin;
+    }
+}
+
+template<typename T>
+T readerCast(const std::string& value)
 {
     if constexpr (std::is_same_v<T, const char*>) {
-        return value;
+        return value.c_str();
     }
     if constexpr (std::is_same_v<T, long>) {
-        return stol(value);
+        long result {};
+        return fastNumberCast(value, result) ? result : stol(value);
     }
     if constexpr (std::is_same_v<T, int>) {
-        return stoi(value);
+        int result {};
+        return fastNumberCast(value, result) ? result : stoi(value);
     }
     if constexpr (std::is_same_v<T, unsigned long>) {
-        return stoul(value, nullptr);
+        unsigned long result {};
+        return fastNumberCast(value, result) ? result : stoul(value, nullptr);
     }
     if constexpr (std::is_same_v<T, double>) {
-        return stod(value, nullptr);
+        double result {};
+        return fastNumberCast(value, result) ? result : stod(value, nullptr);
     }
     if constexpr (std::is_same_v<T, bool>) {
         return std::string_view(value) != "0";
@@ -148,26 +186,24 @@ template<typename T>
     requires Base::XMLReader::instantiated<T>
 T Base::XMLReader::getAttribute(const char* AttrName, T defaultValue) const
 {
-    auto pos = AttrMap.find(AttrName);
-    if (pos == AttrMap.end()) {
+    const std::string* value = findAttribute(AttrName);
+    if (!value) {
         return defaultValue;
     }
-    const char* rawValue = pos->second.c_str();
-    return readerCast<T>(rawValue);
+    return readerCast<T>(*value);
 }
 
 template<typename T>
     requires Base::XMLReader::instantiated<T>
 T Base::XMLReader::getAttribute(const char* AttrName) const
 {
-    auto pos = AttrMap.find(AttrName);
-    if (pos == AttrMap.end()) {
+    const std::string* value = findAttribute(AttrName);
+    if (!value) {
         // wrong name, use hasAttribute if not sure!
         std::string msg = std::string("XML Attribute: \"") + AttrName + "\" not found";
         throw Base::XMLAttributeError(msg);
     }
-    const char* rawValue = pos->second.c_str();
-    return readerCast<T>(rawValue);
+    return readerCast<T>(*value);
 }
 
 // Explicit template instantiation
@@ -195,7 +231,7 @@ Base::XMLReader::getAttribute<unsigned long>(const char* AttrName) const;
 
 bool Base::XMLReader::hasAttribute(const char* AttrName) const
 {
-    return AttrMap.find(AttrName) != AttrMap.end();
+    return findAttribute(AttrName) != nullptr;
 }
 
 bool Base::XMLReader::read()
@@ -503,6 +539,34 @@ void Base::XMLReader::readFiles(zipios::ZipInputStream& zipstream) const
     }
 }
 
+void Base::XMLReader::readFiles(const std::shared_ptr<zipios::ZipFile>& zip) const
+{
+    // Unlike the sequential version above the order of the files in the archive
+    // doesn't matter. Files of objects that couldn't be created are simply not
+    // requested, and requested files missing in the archive are skipped.
+    Base::SequencerLauncher seq("Importing project files...", FileList.size());
+    for (const auto& it : FileList) {
+        if (zip->getEntry(it.FileName)) {
+            try {
+                auto file = std::make_shared<LazyDocFile>(zip, it.FileName, FileVersion);
+                if (it.Object->canRestoreDocFileLazily()) {
+                    it.Object->setLazyDocFile(file);
+                }
+                else {
+                    file->restore(it.Object);
+                }
+            }
+            catch (...) {
+                Base::Console().error("Reading failed from embedded file: %s\n",
+                                      it.FileName.c_str());
+                FailedFiles.push_back(it.FileName);
+            }
+        }
+
+        seq.next();
+    }
+}
+
 const char* Base::XMLReader::addFile(const char* Name, Base::Persistence* Object)
 {
     FileEntry temp;
@@ -569,12 +633,16 @@ void Base::XMLReader::startElement(const XMLCh* const /*uri*/,
                                    const XERCES_CPP_NAMESPACE_QUALIFIER Attributes& attrs)
 {
     Level++;  // new scope
-    LocalName = StrX(localname).c_str();
+    XMLTools::toStdString(localname, LocalName);
 
-    // saving attributes of the current scope, delete all previously stored ones
-    AttrMap.clear();
-    for (unsigned int i = 0; i < attrs.getLength(); i++) {
-        AttrMap[StrX(attrs.getQName(i)).c_str()] = StrXUTF8(attrs.getValue(i)).c_str();
+    // saving attributes of the current scope, overwrite all previously stored ones
+    AttributeCount = attrs.getLength();
+    if (Attributes.size() < AttributeCount) {
+        Attributes.resize(AttributeCount);
+    }
+    for (std::size_t i = 0; i < AttributeCount; i++) {
+        XMLTools::toStdString(attrs.getQName(i), Attributes[i].first);
+        XMLTools::toStdString(attrs.getValue(i), Attributes[i].second);
     }
 
     ReadType = StartElement;
@@ -585,7 +653,7 @@ void Base::XMLReader::endElement(const XMLCh* const /*uri*/,
                                  const XMLCh* const /*qname*/)
 {
     Level--;  // end of scope
-    LocalName = StrX(localname).c_str();
+    XMLTools::toStdString(localname, LocalName);
 
     if (ReadType == StartElement) {
         ReadType = StartEndElement;
@@ -729,3 +797,32 @@ std::shared_ptr<Base::XMLReader> Base::Reader::getLocalReader() const
 {
     return (this->localreader);
 }
+
+// ----------------------------------------------------------------------------
+
+Base::LazyDocFile::LazyDocFile(std::shared_ptr<zipios::ZipFile> zip,
+                               std::string fileName,
+                               int version)
+    : zip(std::move(zip))
+    , fileName(std::move(fileName))
+    , fileVersion(version)
+{}
+
+void Base::LazyDocFile::restore(Base::Persistence* object) const
+{
+    std::unique_ptr<std::istream> str(zip->getInputStream(fileName));
+    if (!str) {
+        throw Base::FileException("Missing file in project archive", fileName);
+    }
+
+    Base::Reader reader(*str, fileName, fileVersion);
+    object->RestoreDocFile(reader);
+    if (reader.getLocalReader()) {
+        reader.getLocalReader()->readFiles(zip);
+    }
+}
+
+const std::string& Base::LazyDocFile::getFileName() const
+{
+    return fileName;
+}
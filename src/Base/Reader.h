@@ -39,6 +39,7 @@
 
 namespace zipios
 {
+class ZipFile;
 class ZipInputStream;
 }
 #ifndef XERCES_CPP_NAMESPACE_BEGIN
@@ -285,6 +286,11 @@ public:
     const char* addFile(const char* Name, Base::Persistence* Object);
     /// process the requested file writes
     void readFiles(zipios::ZipInputStream& zipstream) const;
+    /** process the requested file writes with random access to the archive
+     * Objects that support it only get a handle to their file, see
+     * Persistence::canRestoreDocFileLazily().
+     */
+    void readFiles(const std::shared_ptr<zipios::ZipFile>& zip) const;
     /// Returns whether reader has any registered filenames
     bool hasFilenames() const;
     /// returns true if reading the file \a filename has failed
@@ -366,8 +372,10 @@ private:
     unsigned int CharacterCount {0};
     std::streamsize CharacterOffset {-1};
 
-    std::map<std::string, std::string> AttrMap;
-    using AttrMapType = std::map<std::string, std::string>;
+    /// attributes of the current element, the string buffers are re-used by the next element
+    std::vector<std::pair<std::string, std::string>> Attributes;
+    std::size_t AttributeCount {0};
+    const std::string* findAttribute(const char* AttrName) const;
 
     enum
     {
@@ -422,6 +430,24 @@ private:
     std::shared_ptr<Base::XMLReader> localreader;
 };
 
+/** The LazyDocFile class
+ * Handle to a file inside a project archive that is restored on demand.
+ * It keeps the archive open for random access, see XMLReader::readFiles().
+ */
+class BaseExport LazyDocFile
+{
+public:
+    LazyDocFile(std::shared_ptr<zipios::ZipFile> zip, std::string fileName, int version);
+    /// call RestoreDocFile() of \a object with the content of the file
+    void restore(Base::Persistence* object) const;
+    const std::string& getFileName() const;
+
+private:
+    std::shared_ptr<zipios::ZipFile> zip;
+    std::string fileName;
+    int fileVersion;
+};
+
 }  // namespace Base
 
 
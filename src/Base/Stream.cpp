@@ -24,7 +24,10 @@
 #include "PreCompiled.h"
 
 #ifndef _PreComp_
+#include <algorithm>
+#include <array>
 #include <QBuffer>
+#include <QFile>
 #include <QIODevice>
 #ifdef __GNUC__
 #include <cstdint>
@@ -38,6 +41,43 @@
 
 using namespace Base;
 
+namespace
+{
+template<typename T>
+void writeBlock(std::ostream& out, const T* values, std::size_t count, bool swap)
+{
+    if (!swap) {
+        out.write(reinterpret_cast<const char*>(values),
+                  static_cast<std::streamsize>(count * sizeof(T)));
+        return;
+    }
+
+    // convert a limited number of values at a time to keep the memory overhead low
+    constexpr std::size_t chunkSize = 4096;
+    std::array<T, chunkSize> chunk;
+    for (std::size_t pos = 0; pos < count; pos += chunkSize) {
+        std::size_t num = std::min(chunkSize, count - pos);
+        std::copy(values + pos, values + pos + num, chunk.begin());
+        for (std::size_t i = 0; i < num; i++) {
+            SwapEndian<T>(chunk[i]);
+        }
+        out.write(reinterpret_cast<const char*>(chunk.data()),
+                  static_cast<std::streamsize>(num * sizeof(T)));
+    }
+}
+
+template<typename T>
+void readBlock(std::istream& in, T* values, std::size_t count, bool swap)
+{
+    in.read(reinterpret_cast<char*>(values), static_cast<std::streamsize>(count * sizeof(T)));
+    if (swap) {
+        for (std::size_t i = 0; i < count; i++) {
+            SwapEndian<T>(values[i]);
+        }
+    }
+}
+}  // namespace
+
 Stream::Stream() = default;
 
 Stream::~Stream() = default;
@@ -154,6 +194,30 @@ OutputStream& OutputStream::write(const char* s, int n)
     return *this;
 }
 
+OutputStream& OutputStream::writeArray(const int32_t* values, std::size_t count)
+{
+    writeBlock(_out, values, count, isSwapped());
+    return *this;
+}
+
+OutputStream& OutputStream::writeArray(const uint32_t* values, std::size_t count)
+{
+    writeBlock(_out, values, count, isSwapped());
+    return *this;
+}
+
+OutputStream& OutputStream::writeArray(const float* values, std::size_t count)
+{
+    writeBlock(_out, values, count, isSwapped());
+    return *this;
+}
+
+OutputStream& OutputStream::writeArray(const double* values, std::size_t count)
+{
+    writeBlock(_out, values, count, isSwapped());
+    return *this;
+}
+
 InputStream::InputStream(std::istream& rin)
     : _in(rin)
 {}
@@ -256,6 +320,30 @@ InputStream& InputStream::read(char* s, int n)
     return *this;
 }
 
+InputStream& InputStream::readArray(int32_t* values, std::size_t count)
+{
+    readBlock(_in, values, count, isSwapped());
+    return *this;
+}
+
+InputStream& InputStream::readArray(uint32_t* values, std::size_t count)
+{
+    readBlock(_in, values, count, isSwapped());
+    return *this;
+}
+
+InputStream& InputStream::readArray(float* values, std::size_t count)
+{
+    readBlock(_in, values, count, isSwapped());
+    return *this;
+}
+
+InputStream& InputStream::readArray(double* values, std::size_t count)
+{
+    readBlock(_in, values, count, isSwapped());
+    return *this;
+}
+
 // ----------------------------------------------------------------------
 
 ByteArrayOStreambuf::ByteArrayOStreambuf(QByteArray& ba)
@@ -843,6 +931,46 @@ std::streambuf::pos_type Streambuf::seekpos(std::streambuf::pos_type pos,
     return seekoff(pos, std::ios_base::beg);
 }
 
+// ----------------------------------------------------------------------
+
+MemoryStreambuf::MemoryStreambuf(const char* data, std::size_t size)
+{
+    // the get area is only read, so casting away const is safe
+    char* beg = const_cast<char*>(data);  // NOLINT
+    setg(beg, beg, beg + size);
+}
+
+MemoryStreambuf::~MemoryStreambuf() = default;
+
+std::streambuf::pos_type MemoryStreambuf::seekoff(std::streambuf::off_type off,
+                                                  std::ios_base::seekdir way,
+                                                  std::ios_base::openmode /*mode*/)
+{
+    char* pos = nullptr;
+    if (way == std::ios_base::beg) {
+        pos = eback() + off;
+    }
+    else if (way == std::ios_base::end) {
+        pos = egptr() + off;
+    }
+    else {
+        pos = gptr() + off;
+    }
+
+    if (pos < eback() || pos > egptr()) {
+        return {off_type(-1)};
+    }
+
+    setg(eback(), pos, egptr());
+    return {pos - eback()};
+}
+
+std::streambuf::pos_type MemoryStreambuf::seekpos(std::streambuf::pos_type pos,
+                                                  std::ios_base::openmode /*mode*/)
+{
+    return seekoff(pos, std::ios_base::beg);
+}
+
 // The custom string handler written by realthunder for the LinkStage3 toponaming code, to handle
 // reading multi-line strings directly into a std::string. Imported from LinkStage3 and refactored
 // during the TNP mitigation project in February 2024.
@@ -904,3 +1032,24 @@ TextInputStream& TextInputStream::operator>>(std::string& outputString)
     outputString = _ss.str();
     return *this;
 }
+
+// ----------------------------------------------------------------------
+
+MappedFile::MappedFile(const FileInfo& fi)
+    : _file(std::make_unique<QFile>(QString::fromStdString(fi.filePath())))
+{
+    if (_file->open(QIODevice::ReadOnly) && _file->size() > 0) {
+        uchar* data = _file->map(0, _file->size());
+        if (data) {
+            _data = reinterpret_cast<const char*>(data);  // NOLINT
+            _size = static_cast<std::size_t>(_file->size());
+        }
+    }
+}
+
+MappedFile::~MappedFile()
+{
+    if (_data) {
+        _file->unmap(reinterpret_cast<uchar*>(const_cast<char*>(_data)));  // NOLINT
+    }
+}
@@ -28,7 +28,9 @@
 #include <cstdint>
 #endif
 
+#include <cstddef>
 #include <fstream>
+#include <memory>
 #include <sstream>
 #include <string>
 #include <vector>
@@ -38,6 +40,7 @@
 class QByteArray;
 class QIODevice;
 class QBuffer;
+class QFile;
 using PyObject = struct _object;
 
 namespace Base
@@ -96,6 +99,15 @@ public:
 
     OutputStream& write(const char* s, int n);
 
+    /** Writes the \a count values of \a values as one contiguous block.
+     * The result is the same as writing each value with operator<<, but without
+     * the per-value overhead. Only a swapped stream converts the values chunk-wise.
+     */
+    OutputStream& writeArray(const int32_t* values, std::size_t count);
+    OutputStream& writeArray(const uint32_t* values, std::size_t count);
+    OutputStream& writeArray(const float* values, std::size_t count);
+    OutputStream& writeArray(const double* values, std::size_t count);
+
     OutputStream(const OutputStream&) = delete;
     OutputStream(OutputStream&&) = delete;
     void operator=(const OutputStream&) = delete;
@@ -129,6 +141,14 @@ public:
 
     InputStream& read(char* s, int n);
 
+    /** Reads \a count values into \a values as one contiguous block.
+     * This is the counterpart of OutputStream::writeArray().
+     */
+    InputStream& readArray(int32_t* values, std::size_t count);
+    InputStream& readArray(uint32_t* values, std::size_t count);
+    InputStream& readArray(float* values, std::size_t count);
+    InputStream& readArray(double* values, std::size_t count);
+
     explicit operator bool() const
     {
         // test if _Ipfx succeeded
@@ -558,6 +578,31 @@ private:
     std::string::const_iterator _cur;
 };
 
+/**
+ * This class implements the streambuf interface to read data from a block of memory
+ * that is not owned by the buffer, e.g. a MappedFile.
+ * This class can only be used for reading but not for writing purposes.
+ */
+class BaseExport MemoryStreambuf: public std::streambuf
+{
+public:
+    MemoryStreambuf(const char* data, std::size_t size);
+    ~MemoryStreambuf() override;
+
+protected:
+    pos_type seekoff(std::streambuf::off_type off,
+                     std::ios_base::seekdir way,
+                     std::ios_base::openmode which = std::ios::in | std::ios::out) override;
+    pos_type seekpos(std::streambuf::pos_type pos,
+                     std::ios_base::openmode which = std::ios::in | std::ios::out) override;
+
+public:
+    MemoryStreambuf(const MemoryStreambuf&) = delete;
+    MemoryStreambuf(MemoryStreambuf&&) = delete;
+    MemoryStreambuf& operator=(const MemoryStreambuf&) = delete;
+    MemoryStreambuf& operator=(MemoryStreambuf&&) = delete;
+};
+
 // ----------------------------------------------------------------------------
 
 class FileInfo;
@@ -628,6 +673,42 @@ public:
     ifstream& operator=(ifstream&&) = delete;
 };
 
+/**
+ * The MappedFile class maps a whole file read-only into memory so that large files
+ * can be parsed without copying them into a buffer first. The mapping is released
+ * when the object is destroyed.
+ */
+class BaseExport MappedFile
+{
+public:
+    explicit MappedFile(const FileInfo& fi);
+    ~MappedFile();
+
+    /** Returns true if the file could be mapped. Empty files cannot be mapped. */
+    bool isMapped() const
+    {
+        return _data != nullptr;
+    }
+    const char* data() const
+    {
+        return _data;
+    }
+    std::size_t size() const
+    {
+        return _size;
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile(MappedFile&&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile& operator=(MappedFile&&) = delete;
+
+private:
+    std::unique_ptr<QFile> _file;
+    const char* _data {nullptr};
+    std::size_t _size {0};
+};
+
 }  // namespace Base
 
 #endif  // BASE_STREAM_H
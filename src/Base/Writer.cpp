@@ -29,9 +29,16 @@
 #include <string>
 #endif
 
+#include <algorithm>
+#include <array>
+#include <deque>
+#include <functional>
+#include <future>
 #include <limits>
 #include <locale>
 #include <iomanip>
+#include <thread>
+#include <zlib.h>
 
 #include "Writer.h"
 #include "Base64.h"
@@ -316,28 +323,155 @@ void Writer::putNextEntry(const char* file, const char* obj)
 
 // ----------------------------------------------------------------------------
 
+namespace
+{
+struct DeflatedEntry
+{
+    std::string data;
+    zipios::uint32 size {0};
+    zipios::uint32 crc {0};
+};
+
+// Raw deflate (no zlib header) as expected by zip archives, using the same
+// settings as zipios' DeflateOutputStreambuf
+DeflatedEntry deflateEntry(const std::string& input, int level)
+{
+    // zipios writes no zip64 records, the sizes must fit the 32-bit header fields
+    const size_t maxEntrySize = std::numeric_limits<zipios::uint32>::max();
+    if (input.size() > maxEntrySize) {
+        throw Base::RuntimeError("ZipWriter: entry exceeds the 4 GB zip size limit");
+    }
+
+    // zlib takes at most uInt bytes per call, feed larger buffers in slices
+    const size_t maxSlice = std::numeric_limits<uInt>::max();
+    auto bytes = reinterpret_cast<const Bytef*>(input.data());  // NOLINT
+    uLong crc = crc32(0L, Z_NULL, 0);
+    for (size_t pos = 0; pos < input.size(); pos += maxSlice) {
+        crc = crc32(crc, bytes + pos, static_cast<uInt>(std::min(maxSlice, input.size() - pos)));
+    }
+
+    DeflatedEntry entry;
+    entry.size = static_cast<zipios::uint32>(input.size());
+    entry.crc = static_cast<zipios::uint32>(crc);
+
+    z_stream zs {};
+    const int memLevel = 8;
+    if (deflateInit2(&zs, level, Z_DEFLATED, -MAX_WBITS, memLevel, Z_DEFAULT_STRATEGY) != Z_OK) {
+        throw Base::RuntimeError("ZipWriter: failed to initialize deflate");
+    }
+    entry.data.resize(deflateBound(&zs, static_cast<uLong>(input.size())));
+    size_t inPos = 0;
+    size_t outPos = 0;
+    int err = Z_OK;
+    while (err == Z_OK) {
+        size_t inSlice = std::min(maxSlice, input.size() - inPos);
+        size_t outSlice = std::min(maxSlice, entry.data.size() - outPos);
+        zs.next_in = const_cast<Bytef*>(bytes + inPos);  // NOLINT
+        zs.avail_in = static_cast<uInt>(inSlice);
+        zs.next_out = reinterpret_cast<Bytef*>(entry.data.data() + outPos);  // NOLINT
+        zs.avail_out = static_cast<uInt>(outSlice);
+        bool last = inPos + inSlice == input.size();
+        err = deflate(&zs, last ? Z_FINISH : Z_NO_FLUSH);
+        inPos += inSlice - zs.avail_in;
+        outPos += outSlice - zs.avail_out;
+        if (err == Z_BUF_ERROR && outPos < entry.data.size()) {
+            // no progress possible with the current slices, continue with the next ones
+            err = Z_OK;
+        }
+    }
+    entry.data.resize(outPos);
+    deflateEnd(&zs);
+    if (err != Z_STREAM_END || entry.data.size() > maxEntrySize) {
+        throw Base::RuntimeError("ZipWriter: failed to deflate entry");
+    }
+    return entry;
+}
+
+// Collects the serialized entry in memory up to a limit. Larger entries are
+// handed over to the stream returned by the spill callback, together with the
+// data collected so far, so they never have to be held in memory as a whole.
+class EntryBuffer: public std::streambuf
+{
+public:
+    EntryBuffer(size_t limit, std::function<std::ostream&(const std::string&)> spill)
+        : limit(limit)
+        , spill(std::move(spill))
+    {
+        setp(chunk.data(), chunk.data() + chunk.size());
+    }
+    bool isSpilled() const
+    {
+        return target != nullptr;
+    }
+    std::string takeData()
+    {
+        return std::move(data);
+    }
+
+protected:
+    int_type overflow(int_type ch) override
+    {
+        if (!flushChunk()) {
+            return traits_type::eof();
+        }
+        if (!traits_type::eq_int_type(ch, traits_type::eof())) {
+            *pptr() = traits_type::to_char_type(ch);
+            pbump(1);
+        }
+        return traits_type::not_eof(ch);
+    }
+    int sync() override
+    {
+        return flushChunk() ? 0 : -1;
+    }
+
+private:
+    bool flushChunk()
+    {
+        auto count = static_cast<size_t>(pptr() - pbase());
+        if (!target && data.size() + count > limit) {
+            target = &spill(data);
+            std::string().swap(data);
+        }
+        if (target) {
+            target->write(pbase(), static_cast<std::streamsize>(count));
+        }
+        else {
+            data.append(pbase(), count);
+        }
+        setp(chunk.data(), chunk.data() + chunk.size());
+        return !target || target->good();
+    }
+
+    std::array<char, 65536> chunk {};
+    std::string data;
+    size_t limit;
+    std::function<std::ostream&(const std::string&)> spill;
+    std::ostream* target {nullptr};
+};
+}  // namespace
+
 ZipWriter::ZipWriter(const char* FileName)
     : ZipStream(FileName)
 {
-#ifdef _MSC_VER
-    ZipStream.imbue(std::locale::empty());
-#else
-    ZipStream.imbue(std::locale::classic());
-#endif
-    ZipStream.precision(std::numeric_limits<double>::digits10 + 1);
-    ZipStream.setf(std::ios::fixed, std::ios::floatfield);
+    setupStream(ZipStream);
 }
 
 ZipWriter::ZipWriter(std::ostream& os)
     : ZipStream(os)
+{
+    setupStream(ZipStream);
+}
+
+void ZipWriter::setupStream(std::ostream& str)
 {
 #ifdef _MSC_VER
-    ZipStream.imbue(std::locale::empty());
+    str.imbue(std::locale::empty());
 #else
-    ZipStream.imbue(std::locale::classic());
+    str.imbue(std::locale::classic());
 #endif
-    ZipStream.precision(std::numeric_limits<double>::digits10 + 1);
-    ZipStream.setf(std::ios::fixed, std::ios::floatfield);
+    str.precision(std::numeric_limits<double>::digits10 + 1);
+    str.setf(std::ios::fixed, std::ios::floatfield);
 }
 
 void ZipWriter::putNextEntry(const char* file, const char* obj)
@@ -351,17 +485,87 @@ void ZipWriter::putNextEntry(const char* file, const char* obj)
 
 void ZipWriter::writeFiles()
 {
+    // SaveDocFile() is not required to be thread safe, so the files are
+    // serialized on this thread. Only the compression is done concurrently,
+    // with at most one pending entry per thread and a cap on the serialized
+    // bytes waiting for compression to bound the memory use. Entries above
+    // maxEntryBytes are streamed through the archive's own deflate stream
+    // instead, after the pending entries have been written.
+    const size_t maxPending = std::max(1U, std::thread::hardware_concurrency());
+    const size_t maxPendingBytes = size_t(64) << 20;
+    const size_t maxEntryBytes = size_t(16) << 20;
+    struct PendingEntry
+    {
+        std::string name;
+        size_t size;
+        std::future<DeflatedEntry> deflated;
+    };
+    std::deque<PendingEntry> pending;
+    size_t pendingBytes = 0;
+    auto writePending = [this, &pending, &pendingBytes]() {
+        DeflatedEntry deflated = pending.front().deflated.get();
+        ZipStream.putRawEntry(zipios::ZipCDirEntry(pending.front().name),
+                              deflated.data.data(),
+                              static_cast<zipios::uint32>(deflated.data.size()),
+                              deflated.size,
+                              deflated.crc);
+        pendingBytes -= pending.front().size;
+        pending.pop_front();
+        Writer::checkErrNo();
+    };
+
     // use a while loop because it is possible that while
     // processing the files new ones can be added
     size_t index = 0;
     while (index < FileList.size()) {
         FileEntry entry = FileList[index];
-        putNextEntry(entry.FileName.c_str());
+        Writer::putNextEntry(entry.FileName.c_str());
         indent = 0;
         indBuf[0] = 0;
-        entry.Object->SaveDocFile(*this);
+
+        EntryBuffer buffer(maxEntryBytes, [&](const std::string& head) -> std::ostream& {
+            while (!pending.empty()) {
+                writePending();
+            }
+            ZipStream.putNextEntry(entry.FileName);
+            Writer::checkErrNo();
+            ZipStream.write(head.data(), static_cast<std::streamsize>(head.size()));
+            return ZipStream;
+        });
+        std::ostream stream(&buffer);
+        setupStream(stream);
+        EntryStream = &stream;
+        try {
+            entry.Object->SaveDocFile(*this);
+            stream.flush();
+        }
+        catch (...) {
+            EntryStream = nullptr;
+            throw;
+        }
+        EntryStream = nullptr;
+        if (buffer.isSpilled()) {
+            Writer::checkErrNo();
+            index++;
+            continue;
+        }
+
+        std::string data = buffer.takeData();
+        while (!pending.empty()
+               && (pending.size() >= maxPending || pendingBytes + data.size() > maxPendingBytes)) {
+            writePending();
+        }
+        pendingBytes += data.size();
+        size_t size = data.size();
+        pending.push_back({entry.FileName,
+                           size,
+                           std::async(std::launch::async, deflateEntry, std::move(data), Level)});
         index++;
     }
+
+    while (!pending.empty()) {
+        writePending();
+    }
 }
 
 ZipWriter::~ZipWriter()
@@ -195,6 +195,12 @@ private:
 /** The ZipWriter class
  * This is an important helper class implementation for the store and retrieval system
  * of persistent objects in FreeCAD.
+ *
+ * The files requested with addFile() are serialized one after another into memory
+ * by writeFiles() while previously serialized files are deflated on worker threads.
+ * The compressed entries are written to the archive in the order they were requested.
+ * Files that grow beyond a size limit while being serialized are streamed directly
+ * into the archive instead, so no file has to be held in memory as a whole.
  * \see Base::Persistence
  * \author Juergen Riegel
  */
@@ -209,7 +215,7 @@ public:
 
     std::ostream& Stream() override
     {
-        return ZipStream;
+        return EntryStream ? *EntryStream : ZipStream;
     }
 
     void setComment(const char* str)
@@ -218,6 +224,7 @@ public:
     }
     void setLevel(int level)
     {
+        Level = level;
         ZipStream.setLevel(level);
     }
     void putNextEntry(const char* filename, const char* objName = nullptr) override;
@@ -228,7 +235,11 @@ public:
     ZipWriter& operator=(ZipWriter&&) = delete;
 
 private:
+    void setupStream(std::ostream& str);
+
     zipios::ZipOutputStream ZipStream;
+    std::ostream* EntryStream {nullptr};
+    int Level {6};
 };
 
 /** The StringWriter class
@@ -59,6 +59,26 @@ void XMLTools::initialize()
 std::string XMLTools::toStdString(const XMLCh* const toTranscode)
 {
     std::string str;
+    toStdString(toTranscode, str);
+    return str;
+}
+
+void XMLTools::toStdString(const XMLCh* const toTranscode, std::string& str)
+{
+    str.clear();
+    if (!toTranscode) {
+        return;
+    }
+
+    // ASCII is the same in UTF-16 and UTF-8 and is the common case for names and numbers
+    const XMLCh* pos = toTranscode;
+    for (; *pos != 0 && *pos < 0x80; ++pos) {
+        str.push_back(static_cast<char>(*pos));
+    }
+    if (*pos == 0) {
+        return;
+    }
+    str.clear();
 
     initialize();
 
@@ -86,8 +106,6 @@ std::string XMLTools::toStdString(const XMLCh* const toTranscode)
             break;
         }
     }
-
-    return str;
 }
 
 std::basic_string<XMLCh> XMLTools::toXMLString(const char* const fromTranscode)
@@ -53,7 +53,7 @@
 #include <Mod/Mesh/App/MeshFeature.h>
 #include <Mod/Part/App/PartFeature.h>
 #include <Mod/Points/App/PointsFeature.h>
-#include <Mod/Points/App/PointsGrid.h>
+#include <Mod/Points/App/PointsOctree.h>
 
 #include "InspectionFeature.h"
 
@@ -223,21 +223,19 @@ protected:
                 for (unsigned long ulY = ulY1; ulY <= ulY2; ulY++) {
                     for (unsigned long ulZ = ulZ1; ulZ <= ulZ2; ulZ++) {
                         if (rclFacet.IntersectBoundingBox(GetBoundBox(ulX, ulY, ulZ))) {
-                            _aulGrid[ulX][ulY][ulZ].insert(ulFacetIndex);
+                            AddElement(ulX, ulY, ulZ, ulFacetIndex);
                         }
                     }
                 }
             }
         }
         else {
-            _aulGrid[ulX1][ulY1][ulZ1].insert(ulFacetIndex);
+            AddElement(ulX1, ulY1, ulZ1, ulFacetIndex);
         }
     }
 
     void InitGrid() override
     {
-        unsigned long i, j;
-
         Base::BoundBox3f clBBMesh = _pclMesh->GetBoundBox().Transformed(_transform);
 
         float fLengthX = clBBMesh.LengthX();
@@ -253,14 +251,7 @@ protected:
         _fGridLenZ = (1.0f + fLengthZ) / float(_ulCtGridsZ);
         _fMinZ = clBBMesh.MinZ - 0.5f;
 
-        _aulGrid.clear();
-        _aulGrid.resize(_ulCtGridsX);
-        for (i = 0; i < _ulCtGridsX; i++) {
-            _aulGrid[i].resize(_ulCtGridsY);
-            for (j = 0; j < _ulCtGridsY; j++) {
-                _aulGrid[i][j].resize(_ulCtGridsZ);
-            }
-        }
+        InitCells();
     }
 
     void RebuildGrid() override
@@ -274,6 +265,8 @@ protected:
         for (clFIter.Init(); clFIter.More(); clFIter.Next()) {
             AddFacet(*clFIter, i++);
         }
+
+        FinishCells();
     }
 
 private:
@@ -440,34 +433,31 @@ float InspectNominalFastMesh::getDistance(const Base::Vector3f& point) const
 InspectNominalPoints::InspectNominalPoints(const Points::PointKernel& Kernel, float /*offset*/)
     : _rKernel(Kernel)
 {
-    int uGridPerAxis = 50;  // totally 125.000 grid elements
-    this->_pGrid = new Points::PointsGrid(Kernel, uGridPerAxis);
+    // small leaves keep the nearest point search fast
+    const std::size_t pointsPerLeaf = 64;
+    this->_pOctree = new Points::PointOctree(Kernel, pointsPerLeaf);
+    this->_inverse = Kernel.getTransform();
+    this->_inverse.inverseGauss();
 }
 
 InspectNominalPoints::~InspectNominalPoints()
 {
-    delete this->_pGrid;
+    delete this->_pOctree;
 }
 
 float InspectNominalPoints::getDistance(const Base::Vector3f& point) const
 {
-    // TODO: Make faster
-    std::set<unsigned long> indices;
-    unsigned long x, y, z;
+    // the octree works in the local coordinate system of the points
     Base::Vector3d pointd(point.x, point.y, point.z);
-    _pGrid->Position(pointd, x, y, z);
-    _pGrid->GetElements(x, y, z, indices);
+    Base::Vector3d local = _inverse * pointd;
 
-    double fMinDist = std::numeric_limits<double>::max();
-    for (unsigned long it : indices) {
-        Base::Vector3d pt = _rKernel.getPoint(it);
-        double fDist = Base::Distance(pointd, pt);
-        if (fDist < fMinDist) {
-            fMinDist = fDist;
-        }
+    std::size_t index {};
+    float fDist {};
+    if (!_pOctree->nearest(Base::toVector<float>(local), index, fDist)) {
+        return std::numeric_limits<float>::max();
     }
 
-    return (float)fMinDist;
+    return (float)Base::Distance(pointd, _rKernel.getPoint(index));
 }
 
 // ----------------------------------------------------------------
@@ -659,9 +649,7 @@ void PropertyDistanceList::SaveDocFile(Base::Writer& writer) const
     Base::OutputStream str(writer.Stream());
     uint32_t uCt = (uint32_t)getSize();
     str << uCt;
-    for (float it : _lValueList) {
-        str << it;
-    }
+    str.writeArray(_lValueList.data(), _lValueList.size());
 }
 
 void PropertyDistanceList::RestoreDocFile(Base::Reader& reader)
@@ -670,9 +658,7 @@ void PropertyDistanceList::RestoreDocFile(Base::Reader& reader)
     uint32_t uCt = 0;
     str >> uCt;
     std::vector<float> values(uCt);
-    for (float& it : values) {
-        str >> it;
-    }
+    str.readArray(values.data(), values.size());
     setValues(values);
 }
 
@@ -46,7 +46,7 @@ class MeshObject;
 }
 namespace Points
 {
-class PointsGrid;
+class PointOctree;
 }
 namespace Part
 {
@@ -156,7 +156,8 @@ public:
 
 private:
     const Points::PointKernel& _rKernel;
-    Points::PointsGrid* _pGrid;
+    Points::PointOctree* _pOctree;
+    Base::Matrix4D _inverse;
 };
 
 class InspectionExport InspectNominalShape: public InspectNominalGeometry
@@ -25,21 +25,27 @@
 #include <algorithm>
 #include <map>
 #include <memory>
+#include <string>
+#include <vector>
 #endif
 
 #include <App/Application.h>
 #include <App/Document.h>
 #include <App/DocumentObjectPy.h>
+#include <Base/FileInfo.h>
 #include <Base/GeometryPyCXX.h>
 #include <Base/Interpreter.h>
+#include <Base/MatrixPy.h>
 #include <Base/PlacementPy.h>
 #include <Base/PyWrapParseTupleAndKeywords.h>
+#include <Base/Stream.h>
 #include <Base/VectorPy.h>
 #include "Core/Approximation.h"
 #include "Core/Evaluation.h"
 #include "Core/Iterator.h"
 #include "Core/MeshIO.h"
 #include "Core/MeshKernel.h"
+#include "Core/OutOfCore.h"
 #include "WildMagic4/Wm4ContBox3.h"
 
 #include "Exporter.h"
@@ -51,6 +57,35 @@
 using namespace Mesh;
 using namespace MeshCore;
 
+namespace
+{
+// Temporary files that are removed when leaving the scope, also by an exception
+class TemporaryFiles
+{
+public:
+    TemporaryFiles() = default;
+    ~TemporaryFiles()
+    {
+        for (const auto& it : _files) {
+            it.deleteFile();
+        }
+    }
+    std::string Next()
+    {
+        _files.emplace_back(Base::FileInfo::getTempFileName());
+        return _files.back().filePath();
+    }
+
+    TemporaryFiles(const TemporaryFiles&) = delete;
+    TemporaryFiles(TemporaryFiles&&) = delete;
+    TemporaryFiles& operator=(const TemporaryFiles&) = delete;
+    TemporaryFiles& operator=(TemporaryFiles&&) = delete;
+
+private:
+    std::vector<Base::FileInfo> _files;
+};
+}  // namespace
+
 namespace Mesh
 {
 class Module: public Py::ExtensionModule<Module>
@@ -79,6 +114,17 @@ public:
                            "between the specified objects and the exported mesh.\n"
                            "exportAmfCompressed specifies whether exported AMF files should be\n"
                            "compressed.\n");
+        add_keyword_method(
+            "processOutOfCore",
+            &Module::processOutOfCore,
+            "processOutOfCore(input, output, [Matrix, Cleanup=False, Reduction=0.0,\n"
+            "                 MaxError=0.0, FacetsPerChunk=1000000])\n"
+            "Processes a mesh that is too large for the main memory chunk by chunk.\n"
+            "input is an STL file or a chunked mesh file. output is an STL or PLY file\n"
+            "or otherwise a chunked mesh file that can be processed further.\n"
+            "The mesh is transformed with Matrix, corrupted and duplicated facets are\n"
+            "removed if Cleanup is True and the fraction Reduction of the facets is\n"
+            "removed by decimation. The borders of the chunks are kept.\n");
         add_varargs_method("show",
                            &Module::show,
                            "show(shape,[string]) -- Add the mesh to the active document or create "
@@ -290,6 +336,102 @@ private:
         return Py::None();
     }
 
+    Py::Object processOutOfCore(const Py::Tuple& args, const Py::Dict& keywds)
+    {
+        char* inputPy {};
+        char* outputPy {};
+        PyObject* matrix {};
+        PyObject* cleanup = Py_False;
+        float reduction = 0.0F;
+        float maxError = 0.0F;
+        unsigned long facetsPerChunk = 1000000;
+
+        static const std::array<const char*, 8> kwList {"input",
+                                                        "output",
+                                                        "Matrix",
+                                                        "Cleanup",
+                                                        "Reduction",
+                                                        "MaxError",
+                                                        "FacetsPerChunk",
+                                                        nullptr};
+
+        if (!Base::Wrapped_ParseTupleAndKeywords(args.ptr(),
+                                                 keywds.ptr(),
+                                                 "etet|O!O!ffk",
+                                                 kwList,
+                                                 "utf-8",
+                                                 &inputPy,
+                                                 "utf-8",
+                                                 &outputPy,
+                                                 &(Base::MatrixPy::Type),
+                                                 &matrix,
+                                                 &PyBool_Type,
+                                                 &cleanup,
+                                                 &reduction,
+                                                 &maxError,
+                                                 &facetsPerChunk)) {
+            throw Py::Exception();
+        }
+
+        std::string input(inputPy);
+        PyMem_Free(inputPy);
+        std::string output(outputPy);
+        PyMem_Free(outputPy);
+
+        std::vector<MeshOutOfCore::Operation> operations;
+        if (matrix) {
+            Base::Matrix4D mat = *static_cast<Base::MatrixPy*>(matrix)->getMatrixPtr();
+            operations.push_back(MeshOutOfCore::Transform(mat));
+        }
+        if (Base::asBoolean(cleanup)) {
+            operations.push_back(MeshOutOfCore::Cleanup());
+        }
+        if (reduction > 0.0F) {
+            operations.push_back(MeshOutOfCore::Decimate(reduction, maxError));
+        }
+
+        Base::FileInfo fi(output);
+        bool exportMesh = fi.hasExtension({"stl", "ply"});
+        TemporaryFiles tempFiles;
+        auto nextFile = [&](bool last) {
+            if (last && !exportMesh) {
+                return output;
+            }
+            return tempFiles.Next();
+        };
+
+        try {
+            // an STL file is split into chunks first
+            std::string current = input;
+            if (!MeshChunkFile::IsChunkFile(input)) {
+                current = nextFile(operations.empty());
+                MeshOutOfCore::Partition(input, current, facetsPerChunk);
+            }
+            if (!operations.empty() || (current == input && !exportMesh)) {
+                std::string file = nextFile(true);
+                MeshOutOfCore::Process(current, file, [&operations](MeshKernel& kernel) {
+                    for (const auto& op : operations) {
+                        op(kernel);
+                    }
+                });
+                current = file;
+            }
+            if (exportMesh) {
+                Base::ofstream str(fi, std::ios::out | std::ios::binary);
+                bool ok = fi.hasExtension("stl") ? MeshOutOfCore::SaveBinarySTL(current, str)
+                                                 : MeshOutOfCore::SaveBinaryPLY(current, str);
+                if (!ok) {
+                    throw Base::FileException("Failed to write file", fi);
+                }
+            }
+        }
+        catch (const Base::Exception& e) {
+            throw Py::RuntimeError(e.what());
+        }
+
+        return Py::None();
+    }
+
     Py::Object show(const Py::Tuple& args)
     {
         PyObject* pcObj {};
@@ -25,6 +25,7 @@
 #ifndef _PreComp_
 #include <algorithm>
 #include <limits>
+#include <numeric>
 #endif
 
 #include <Base/Console.h>
@@ -33,6 +34,7 @@
 #include "Algorithm.h"
 #include "Approximation.h"
 #include "Elements.h"
+#include "Functional.h"
 #include "Grid.h"
 #include "Iterator.h"
 #include "Triangulation.h"
@@ -2168,3 +2170,82 @@ const Base::Vector3f& MeshRefNormalToPoints::operator[](PointIndex pos) const
 {
     return _norm[pos];
 }
+
+//----------------------------------------------------------------------------
+
+void MeshCompactAdjacency::Rebuild()
+{
+    _start.clear();
+    _elements.clear();
+
+    const MeshPointArray& rPoints = _rclMesh.GetPoints();
+    const MeshFacetArray& rFacets = _rclMesh.GetFacets();
+
+    // The point to facet relation is a counting sort of the facet corners. As the facets are
+    // visited in order each row is sorted already.
+    std::vector<std::size_t> pointStart(rPoints.size() + 1, 0);
+    for (const auto& rFacet : rFacets) {
+        for (PointIndex ptIndex : rFacet._aulPoints) {
+            pointStart[ptIndex + 1]++;
+        }
+    }
+    std::partial_sum(pointStart.begin(), pointStart.end(), pointStart.begin());
+
+    std::vector<ElementIndex> pointFacets(pointStart.back());
+    std::vector<std::size_t> fill(pointStart.begin(), pointStart.end() - 1);
+    for (FacetIndex index = 0; index < rFacets.size(); index++) {
+        for (PointIndex ptIndex : rFacets[index]._aulPoints) {
+            pointFacets[fill[ptIndex]++] = index;
+        }
+    }
+
+    if (_relation == PointToFacets) {
+        _start.swap(pointStart);
+        _elements.swap(pointFacets);
+        return;
+    }
+
+    // The other relations are sorted unions of point to facet rows. They are collected twice,
+    // first to count the entries of each row and then to fill in the entries.
+    auto collect = [&](ElementIndex pos, std::vector<ElementIndex>& row) {
+        row.clear();
+        if (_relation == PointToPoints) {
+            for (std::size_t i = pointStart[pos]; i < pointStart[pos + 1]; i++) {
+                for (PointIndex ptIndex : rFacets[pointFacets[i]]._aulPoints) {
+                    if (ptIndex != pos) {
+                        row.push_back(ptIndex);
+                    }
+                }
+            }
+        }
+        else {
+            for (PointIndex ptIndex : rFacets[pos]._aulPoints) {
+                row.insert(row.end(),
+                           pointFacets.begin() + std::ptrdiff_t(pointStart[ptIndex]),
+                           pointFacets.begin() + std::ptrdiff_t(pointStart[ptIndex + 1]));
+            }
+        }
+        std::sort(row.begin(), row.end());
+        row.erase(std::unique(row.begin(), row.end()), row.end());
+    };
+
+    std::size_t count = _relation == PointToPoints ? rPoints.size() : rFacets.size();
+    _start.resize(count + 1, 0);
+    parallel_for(count, 4096, [&](std::size_t begin, std::size_t end) {
+        std::vector<ElementIndex> row;
+        for (std::size_t pos = begin; pos < end; pos++) {
+            collect(pos, row);
+            _start[pos + 1] = row.size();
+        }
+    });
+    std::partial_sum(_start.begin(), _start.end(), _start.begin());
+
+    _elements.resize(_start.back());
+    parallel_for(count, 4096, [&](std::size_t begin, std::size_t end) {
+        std::vector<ElementIndex> row;
+        for (std::size_t pos = begin; pos < end; pos++) {
+            collect(pos, row);
+            std::copy(row.begin(), row.end(), _elements.begin() + std::ptrdiff_t(_start[pos]));
+        }
+    });
+}
@@ -25,6 +25,7 @@
 
 #include <map>
 #include <set>
+#include <span>
 #include <vector>
 
 #include "Elements.h"
@@ -638,6 +639,58 @@ private:
     std::vector<Base::Vector3f> _norm;
 };
 
+/**
+ * The MeshCompactAdjacency class stores one of the relations of MeshRefPointToPoints,
+ * MeshRefPointToFacets or MeshRefFacetToFacets in compressed row form: the neighbours of all
+ * elements are kept in one array and each element refers to its range by an offset. Compared
+ * to the set based structures it needs a fraction of the memory, is built in parallel and can
+ * be read from several threads at the same time.
+ * \note If the underlying mesh kernel gets changed this structure becomes invalid and must
+ * be rebuilt.
+ */
+class MeshExport MeshCompactAdjacency
+{
+public:
+    enum Relation
+    {
+        PointToPoints,  ///< Points sharing an edge with a point
+        PointToFacets,  ///< Facets referencing a point
+        FacetToFacets   ///< Facets sharing at least one point with a facet, including itself
+    };
+
+    /// Construction
+    MeshCompactAdjacency(const MeshKernel& rclM, Relation relation)
+        : _rclMesh(rclM)
+        , _relation(relation)
+    {
+        Rebuild();
+    }
+
+    /// Rebuilds up data structure
+    void Rebuild();
+    /// Returns the number of elements, i.e. points or facets depending on the relation.
+    std::size_t Size() const
+    {
+        return _start.empty() ? 0 : _start.size() - 1;
+    }
+    /// Returns the number of neighbours of the element with index \a pos.
+    std::size_t CountNeighbours(ElementIndex pos) const
+    {
+        return _start[pos + 1] - _start[pos];
+    }
+    /// Returns the neighbours of the element with index \a pos in ascending order.
+    std::span<const ElementIndex> operator[](ElementIndex pos) const
+    {
+        return {_elements.data() + _start[pos], _start[pos + 1] - _start[pos]};
+    }
+
+private:
+    const MeshKernel& _rclMesh; /**< The mesh kernel. */
+    Relation _relation;
+    std::vector<std::size_t> _start;
+    std::vector<ElementIndex> _elements;
+};
+
 }  // namespace MeshCore
 
 #endif  // MESH_ALGORITHM_H
@@ -0,0 +1,437 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2025 FreeCAD Project Association                         *
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+#include "PreCompiled.h"
+
+#ifndef _PreComp_
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <future>
+#include <limits>
+#include <thread>
+#endif
+
+#include "BVH.h"
+#include "MeshKernel.h"
+
+
+using namespace MeshCore;
+
+namespace
+{
+
+constexpr std::size_t maxLeafSize = 4;
+constexpr std::size_t numBins = 16;
+constexpr std::size_t minBatchPerThread = 1024;
+
+float surfaceArea(const Base::BoundBox3f& box)
+{
+    if (!box.IsValid()) {
+        return 0.0F;
+    }
+    float dx = box.LengthX();
+    float dy = box.LengthY();
+    float dz = box.LengthZ();
+    return 2.0F * (dx * dy + dy * dz + dz * dx);
+}
+
+float component(const Base::Vector3f& vec, int axis)
+{
+    return axis == 0 ? vec.x : (axis == 1 ? vec.y : vec.z);
+}
+
+// Intersects the line (pnt, dir) with the box and returns the smallest
+// absolute line parameter of the section, or a negative value for a miss.
+float distanceOnLine(const Base::BoundBox3f& box,
+                     const Base::Vector3f& pnt,
+                     const Base::Vector3f& dir)
+{
+    float tmin = -std::numeric_limits<float>::max();
+    float tmax = std::numeric_limits<float>::max();
+    const std::array<float, 3> minv {box.MinX, box.MinY, box.MinZ};
+    const std::array<float, 3> maxv {box.MaxX, box.MaxY, box.MaxZ};
+    for (int i = 0; i < 3; i++) {
+        float p = component(pnt, i);
+        float d = component(dir, i);
+        if (std::fabs(d) < std::numeric_limits<float>::epsilon()) {
+            if (p < minv[i] || p > maxv[i]) {
+                return -1.0F;
+            }
+            continue;
+        }
+
+        float t0 = (minv[i] - p) / d;
+        float t1 = (maxv[i] - p) / d;
+        if (t0 > t1) {
+            std::swap(t0, t1);
+        }
+        tmin = std::max(tmin, t0);
+        tmax = std::min(tmax, t1);
+        if (tmin > tmax) {
+            return -1.0F;
+        }
+    }
+
+    if (tmin <= 0.0F && tmax >= 0.0F) {
+        return 0.0F;
+    }
+    return std::min(std::fabs(tmin), std::fabs(tmax));
+}
+
+// BoundBox3::ClosestPoint() moves inner points to the surface, so clamp here
+float distanceToBox(const Base::BoundBox3f& box, const Base::Vector3f& pnt)
+{
+    Base::Vector3f closest(std::clamp(pnt.x, box.MinX, box.MaxX),
+                           std::clamp(pnt.y, box.MinY, box.MaxY),
+                           std::clamp(pnt.z, box.MinZ, box.MaxZ));
+    return Base::Distance(closest, pnt);
+}
+
+// Calls func(begin, end) for contiguous ranges of [0, count)
+template<typename Func>
+void forEachRange(std::size_t count, bool parallel, Func func)
+{
+    std::size_t numThreads = parallel ? std::max(std::thread::hardware_concurrency(), 1U) : 1;
+    numThreads = std::min(numThreads, count / minBatchPerThread);
+    if (numThreads < 2) {
+        func(std::size_t(0), count);
+        return;
+    }
+
+    std::vector<std::future<void>> tasks;
+    std::size_t chunk = count / numThreads;
+    for (std::size_t t = 0; t < numThreads; t++) {
+        std::size_t begin = t * chunk;
+        std::size_t end = (t + 1 == numThreads) ? count : begin + chunk;
+        tasks.push_back(std::async(std::launch::async, func, begin, end));
+    }
+    for (auto& it : tasks) {
+        it.get();
+    }
+}
+
+}  // namespace
+
+MeshFacetBVH::MeshFacetBVH(const MeshKernel& rclMesh)
+    : _rclMesh(rclMesh)
+{
+    Rebuild();
+}
+
+void MeshFacetBVH::Rebuild()
+{
+    _nodes.clear();
+    _facets.clear();
+
+    const FacetIndex numFacets = _rclMesh.CountFacets();
+    if (numFacets == 0) {
+        return;
+    }
+
+    // enlarge the boxes a bit so that intersection points computed for a facet
+    // are never rejected by the box test due to rounding errors
+    const float tolerance = _rclMesh.GetBoundBox().CalcDiagonalLength() * 1.0e-6F;
+
+    std::vector<Base::BoundBox3f> boxes;
+    std::vector<Base::Vector3f> centers;
+    boxes.reserve(numFacets);
+    centers.reserve(numFacets);
+    _facets.reserve(numFacets);
+    for (FacetIndex i = 0; i < numFacets; i++) {
+        Base::BoundBox3f box = _rclMesh.GetFacet(i).GetBoundBox();
+        box.Enlarge(tolerance);
+        boxes.push_back(box);
+        centers.push_back(box.GetCenter());
+        _facets.push_back(i);
+    }
+
+    _nodes.reserve(2 * numFacets / maxLeafSize + 1);
+    _nodes.emplace_back();
+    Build(0, 0, numFacets, boxes, centers);
+}
+
+void MeshFacetBVH::Build(std::size_t node,
+                         std::size_t begin,
+                         std::size_t end,
+                         const std::vector<Base::BoundBox3f>& boxes,
+                         const std::vector<Base::Vector3f>& centers)
+{
+    Base::BoundBox3f box;
+    Base::BoundBox3f centerBox;
+    for (std::size_t i = begin; i < end; i++) {
+        box.Add(boxes[_facets[i]]);
+        centerBox.Add(centers[_facets[i]]);
+    }
+    _nodes[node].box = box;
+
+    const std::size_t count = end - begin;
+    auto makeLeaf = [&]() {
+        _nodes[node].first = begin;
+        _nodes[node].count = count;
+    };
+
+    if (count <= maxLeafSize) {
+        makeLeaf();
+        return;
+    }
+
+    // binned surface area heuristic
+    struct Bin
+    {
+        Base::BoundBox3f box;
+        std::size_t count {0};
+    };
+
+    float bestCost = std::numeric_limits<float>::max();
+    int bestAxis = -1;
+    std::size_t bestSplit = 0;
+    for (int axis = 0; axis < 3; axis++) {
+        float lower = component(Base::Vector3f(centerBox.MinX, centerBox.MinY, centerBox.MinZ),
+                                axis);
+        float upper = component(Base::Vector3f(centerBox.MaxX, centerBox.MaxY, centerBox.MaxZ),
+                                axis);
+        if (upper - lower <= 0.0F) {
+            continue;
+        }
+
+        std::array<Bin, numBins> bins;
+        float scale = float(numBins) / (upper - lower);
+        for (std::size_t i = begin; i < end; i++) {
+            FacetIndex index = _facets[i];
+            auto bin = std::min(numBins - 1,
+                                std::size_t((component(centers[index], axis) - lower) * scale));
+            bins[bin].count++;
+            bins[bin].box.Add(boxes[index]);
+        }
+
+        std::array<float, numBins - 1> rightArea {};
+        std::array<std::size_t, numBins - 1> rightCount {};
+        Base::BoundBox3f right;
+        std::size_t numRight = 0;
+        for (std::size_t i = numBins - 1; i > 0; i--) {
+            right.Add(bins[i].box);
+            numRight += bins[i].count;
+            rightArea[i - 1] = surfaceArea(right);
+            rightCount[i - 1] = numRight;
+        }
+
+        Base::BoundBox3f left;
+        std::size_t numLeft = 0;
+        for (std::size_t i = 0; i < numBins - 1; i++) {
+            left.Add(bins[i].box);
+            numLeft += bins[i].count;
+            float cost = surfaceArea(left) * float(numLeft) + rightArea[i] * float(rightCount[i]);
+            if (numLeft > 0 && rightCount[i] > 0 && cost < bestCost) {
+                bestCost = cost;
+                bestAxis = axis;
+                bestSplit = i;
+            }
+        }
+    }
+
+    std::size_t mid = begin;
+    if (bestAxis >= 0) {
+        float lower = component(Base::Vector3f(centerBox.MinX, centerBox.MinY, centerBox.MinZ),
+                                bestAxis);
+        float upper = component(Base::Vector3f(centerBox.MaxX, centerBox.MaxY, centerBox.MaxZ),
+                                bestAxis);
+        float scale = float(numBins) / (upper - lower);
+        auto it = std::partition(_facets.begin() + std::ptrdiff_t(begin),
+                                 _facets.begin() + std::ptrdiff_t(end),
+                                 [&](FacetIndex index) {
+                                     auto bin = std::min(
+                                         numBins - 1,
+                                         std::size_t((component(centers[index], bestAxis) - lower)
+                                                     * scale));
+                                     return bin <= bestSplit;
+                                 });
+        mid = std::size_t(it - _facets.begin());
+    }
+
+    if (mid == begin || mid == end) {
+        // all centers coincide, a split doesn't help
+        makeLeaf();
+        return;
+    }
+
+    std::size_t leftChild = _nodes.size();
+    _nodes.emplace_back();
+    Build(leftChild, begin, mid, boxes, centers);
+
+    std::size_t rightChild = _nodes.size();
+    _nodes.emplace_back();
+    Build(rightChild, mid, end, boxes, centers);
+
+    // the left child always directly follows its parent
+    _nodes[node].first = rightChild;
+    _nodes[node].count = 0;
+}
+
+bool MeshFacetBVH::NearestFacetOnRay(const Base::Vector3f& rclPt,
+                                     const Base::Vector3f& rclDir,
+                                     float fMaxAngle,
+                                     Base::Vector3f& rclRes,
+                                     FacetIndex& rulFacet) const
+{
+    if (_nodes.empty() || rclDir.Length() == 0.0F) {
+        return false;
+    }
+
+    // with a normalized direction the line parameter is the distance to the base point
+    Base::Vector3f dir(rclDir);
+    dir.Normalize();
+
+    float bestDist = std::numeric_limits<float>::max();
+    bool found = false;
+
+    std::vector<std::pair<std::size_t, float>> stack;
+    stack.emplace_back(0, distanceOnLine(_nodes[0].box, rclPt, dir));
+    while (!stack.empty()) {
+        auto [index, dist] = stack.back();
+        stack.pop_back();
+        if (dist < 0.0F || dist > bestDist) {
+            continue;
+        }
+
+        const Node& node = _nodes[index];
+        if (node.count > 0) {
+            Base::Vector3f res;
+            for (std::size_t i = node.first; i < node.first + node.count; i++) {
+                FacetIndex facet = _facets[i];
+                if (_rclMesh.GetFacet(facet).Foraminate(rclPt, dir, res, fMaxAngle)) {
+                    float resDist = Base::Distance(res, rclPt);
+                    if (resDist < bestDist) {
+                        bestDist = resDist;
+                        rclRes = res;
+                        rulFacet = facet;
+                        found = true;
+                    }
+                }
+            }
+        }
+        else {
+            // visit the nearer child first
+            std::size_t left = index + 1;
+            std::size_t right = node.first;
+            float leftDist = distanceOnLine(_nodes[left].box, rclPt, dir);
+            float rightDist = distanceOnLine(_nodes[right].box, rclPt, dir);
+            if (leftDist < 0.0F || (rightDist >= 0.0F && rightDist < leftDist)) {
+                std::swap(left, right);
+                std::swap(leftDist, rightDist);
+            }
+            stack.emplace_back(right, rightDist);
+            stack.emplace_back(left, leftDist);
+        }
+    }
+
+    return found;
+}
+
+bool MeshFacetBVH::NearestPointFromPoint(const Base::Vector3f& rclPt,
+                                         float fMaxDist,
+                                         FacetIndex& rulFacet,
+                                         Base::Vector3f& rclRes) const
+{
+    if (_nodes.empty()) {
+        return false;
+    }
+
+    float bestDist = fMaxDist;
+    bool found = false;
+
+    std::vector<std::pair<std::size_t, float>> stack;
+    stack.emplace_back(0, distanceToBox(_nodes[0].box, rclPt));
+    while (!stack.empty()) {
+        auto [index, dist] = stack.back();
+        stack.pop_back();
+        if (dist >= bestDist) {
+            continue;
+        }
+
+        const Node& node = _nodes[index];
+        if (node.count > 0) {
+            Base::Vector3f res;
+            for (std::size_t i = node.first; i < node.first + node.count; i++) {
+                FacetIndex facet = _facets[i];
+                float resDist = _rclMesh.GetFacet(facet).DistanceToPoint(rclPt, res);
+                if (resDist < bestDist) {
+                    bestDist = resDist;
+                    rclRes = res;
+                    rulFacet = facet;
+                    found = true;
+                }
+            }
+        }
+        else {
+            // visit the nearer child first
+            std::size_t left = index + 1;
+            std::size_t right = node.first;
+            float leftDist = distanceToBox(_nodes[left].box, rclPt);
+            float rightDist = distanceToBox(_nodes[right].box, rclPt);
+            if (rightDist < leftDist) {
+                std::swap(left, right);
+                std::swap(leftDist, rightDist);
+            }
+            stack.emplace_back(right, rightDist);
+            stack.emplace_back(left, leftDist);
+        }
+    }
+
+    return found;
+}
+
+std::vector<MeshFacetBVH::Result>
+MeshFacetBVH::NearestFacetsOnRays(const std::vector<Ray>& rays,
+                                  float fMaxAngle,
+                                  bool parallel) const
+{
+    std::vector<Result> results(rays.size(), Result(FACET_INDEX_MAX, Base::Vector3f()));
+    forEachRange(rays.size(), parallel, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            const Ray& ray = rays[i];
+            Result& res = results[i];
+            if (!NearestFacetOnRay(ray.first, ray.second, fMaxAngle, res.second, res.first)) {
+                res.first = FACET_INDEX_MAX;
+            }
+        }
+    });
+    return results;
+}
+
+std::vector<MeshFacetBVH::Result>
+MeshFacetBVH::NearestPointsFromPoints(const std::vector<Base::Vector3f>& points,
+                                      float fMaxDist,
+                                      bool parallel) const
+{
+    std::vector<Result> results(points.size(), Result(FACET_INDEX_MAX, Base::Vector3f()));
+    forEachRange(points.size(), parallel, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            Result& res = results[i];
+            if (!NearestPointFromPoint(points[i], fMaxDist, res.first, res.second)) {
+                res.first = FACET_INDEX_MAX;
+            }
+        }
+    });
+    return results;
+}
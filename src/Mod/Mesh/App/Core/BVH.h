@@ -0,0 +1,132 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2025 FreeCAD Project Association                         *
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+#ifndef MESH_BVH_H
+#define MESH_BVH_H
+
+#include <utility>
+#include <vector>
+
+#include <Base/BoundBox.h>
+
+#include "Definitions.h"
+
+
+namespace MeshCore
+{
+
+class MeshKernel;
+
+/**
+ * The MeshFacetBVH class is a bounding volume hierarchy over the facets of a mesh.
+ *
+ * Unlike the MeshFacetGrid it adapts to the distribution of the facets, so it keeps
+ * its performance for meshes with very non-uniform density like scans with dense
+ * details next to large flat areas. The hierarchy is built with the surface area
+ * heuristic.
+ *
+ * The structure keeps a reference to the mesh, so it must be rebuilt with Rebuild()
+ * when the mesh has been modified. All query methods are thread-safe.
+ */
+class MeshExport MeshFacetBVH
+{
+public:
+    /** Index of the facet and the found point. If nothing is found the index is
+     * FACET_INDEX_MAX. */
+    using Result = std::pair<FacetIndex, Base::Vector3f>;
+    /** Base point and direction of a ray. */
+    using Ray = std::pair<Base::Vector3f, Base::Vector3f>;
+
+    /** Builds the hierarchy for the facets of \a rclMesh. */
+    explicit MeshFacetBVH(const MeshKernel& rclMesh);
+
+    /** Builds the hierarchy again, must be called after the mesh has changed. */
+    void Rebuild();
+    /** Returns true if the mesh has no facets. */
+    bool IsEmpty() const
+    {
+        return _nodes.empty();
+    }
+    /** Returns the number of nodes of the hierarchy. */
+    std::size_t CountNodes() const
+    {
+        return _nodes.size();
+    }
+
+    /**
+     * Searches for the nearest facet to the ray defined by (\a rclPt, \a rclDir) in the same
+     * way as MeshAlgorithm::NearestFacetOnRay() does. \a rclRes holds the intersection point
+     * and \a rulFacet the index of the facet. The angle between the ray and the normal of the
+     * facet must be less than or equal to \a fMaxAngle.
+     */
+    bool NearestFacetOnRay(const Base::Vector3f& rclPt,
+                           const Base::Vector3f& rclDir,
+                           float fMaxAngle,
+                           Base::Vector3f& rclRes,
+                           FacetIndex& rulFacet) const;
+    /**
+     * Projects the point \a rclPt to the nearest facet of the mesh. \a rclRes holds the
+     * projected point and \a rulFacet the index of the facet. Only facets with a distance
+     * less than \a fMaxDist are considered.
+     */
+    bool NearestPointFromPoint(const Base::Vector3f& rclPt,
+                               float fMaxDist,
+                               FacetIndex& rulFacet,
+                               Base::Vector3f& rclRes) const;
+
+    /** Performs NearestFacetOnRay() for each ray of \a rays, large batches are split over
+     * several threads if \a parallel is true. */
+    std::vector<Result>
+    NearestFacetsOnRays(const std::vector<Ray>& rays, float fMaxAngle, bool parallel = true) const;
+    /** Performs NearestPointFromPoint() for each point of \a points, large batches are split
+     * over several threads if \a parallel is true. */
+    std::vector<Result> NearestPointsFromPoints(const std::vector<Base::Vector3f>& points,
+                                                float fMaxDist,
+                                                bool parallel = true) const;
+
+private:
+    struct Node
+    {
+        Base::BoundBox3f box;
+        // index of the first facet in _facets for leaves, of the second child otherwise
+        std::size_t first {0};
+        // number of facets of a leaf, zero for inner nodes
+        std::size_t count {0};
+    };
+
+    void Build(std::size_t node,
+               std::size_t begin,
+               std::size_t end,
+               const std::vector<Base::BoundBox3f>& boxes,
+               const std::vector<Base::Vector3f>& centers);
+
+private:
+    const MeshKernel& _rclMesh;
+    std::vector<Node> _nodes;
+    std::vector<FacetIndex> _facets;
+};
+
+}  // namespace MeshCore
+
+
+#endif  // MESH_BVH_H
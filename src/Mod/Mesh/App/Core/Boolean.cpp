@@ -0,0 +1,1751 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2025 FreeCAD Project Association                         *
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+#include "PreCompiled.h"
+
+#ifndef _PreComp_
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <deque>
+#include <limits>
+#include <mutex>
+#include <numbers>
+#include <numeric>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+#endif
+
+#include <Base/Vector3D.h>
+
+#include "Boolean.h"
+#include "Functional.h"
+#include "Iterator.h"
+#include "MeshKernel.h"
+
+
+using namespace MeshCore;
+
+namespace
+{
+
+// ------------------------------------------------------------------------------------------
+// Exact predicates
+
+// The predicates first compute the determinant with doubles and only if its magnitude is
+// below the error bound the sign is computed exactly with the expansion arithmetic described
+// by J. R. Shewchuk in "Adaptive Precision Floating-Point Arithmetic and Fast Robust Geometric
+// Predicates". An expansion is a sum of non-overlapping doubles of increasing magnitude.
+using Expansion = std::vector<double>;
+
+constexpr double epsilon = std::numeric_limits<double>::epsilon() / 2.0;
+constexpr double errBound2 = (3.0 + 16.0 * epsilon) * epsilon;
+constexpr double errBound3 = (7.0 + 56.0 * epsilon) * epsilon;
+
+void twoSum(double a, double b, double& x, double& y)
+{
+    x = a + b;
+    double bv = x - a;
+    double av = x - bv;
+    y = (a - av) + (b - bv);
+}
+
+void twoProduct(double a, double b, double& x, double& y)
+{
+    x = a * b;
+    y = std::fma(a, b, -x);
+}
+
+Expansion difference(double a, double b)
+{
+    double x {}, y {};
+    twoSum(a, -b, x, y);
+    if (y == 0.0) {
+        return {x};
+    }
+    return {y, x};
+}
+
+Expansion grow(const Expansion& e, double b)
+{
+    Expansion h;
+    h.reserve(e.size() + 1);
+    double q = b;
+    for (double c : e) {
+        double s {}, err {};
+        twoSum(q, c, s, err);
+        if (err != 0.0) {
+            h.push_back(err);
+        }
+        q = s;
+    }
+    h.push_back(q);
+    return h;
+}
+
+Expansion sum(const Expansion& e, const Expansion& f)
+{
+    Expansion h = e;
+    for (double c : f) {
+        h = grow(h, c);
+    }
+    return h;
+}
+
+Expansion negate(Expansion e)
+{
+    for (double& c : e) {
+        c = -c;
+    }
+    return e;
+}
+
+Expansion scale(const Expansion& e, double b)
+{
+    Expansion h;
+    h.reserve(2 * e.size());
+    double q {}, err {};
+    twoProduct(e[0], b, q, err);
+    if (err != 0.0) {
+        h.push_back(err);
+    }
+    for (std::size_t i = 1; i < e.size(); i++) {
+        double p1 {}, p0 {}, s {};
+        twoProduct(e[i], b, p1, p0);
+        twoSum(q, p0, s, err);
+        if (err != 0.0) {
+            h.push_back(err);
+        }
+        // |p1| >= |s|, so the fast version of two-sum is sufficient
+        q = p1 + s;
+        err = s - (q - p1);
+        if (err != 0.0) {
+            h.push_back(err);
+        }
+    }
+    h.push_back(q);
+    return h;
+}
+
+Expansion product(const Expansion& e, const Expansion& f)
+{
+    Expansion h {0.0};
+    for (double c : f) {
+        h = sum(h, scale(e, c));
+    }
+    return h;
+}
+
+int sign(const Expansion& e)
+{
+    for (auto it = e.rbegin(); it != e.rend(); ++it) {
+        if (*it > 0.0) {
+            return 1;
+        }
+        if (*it < 0.0) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+struct Point2
+{
+    double x {};
+    double y {};
+};
+
+// Returns 1 if (a, b, c) is counterclockwise, -1 if it is clockwise and 0 if the points are
+// collinear.
+int orient2d(const Point2& a, const Point2& b, const Point2& c)
+{
+    double left = (a.x - c.x) * (b.y - c.y);
+    double right = (a.y - c.y) * (b.x - c.x);
+    double det = left - right;
+    double bound = errBound2 * (std::fabs(left) + std::fabs(right));
+    if (det > bound) {
+        return 1;
+    }
+    if (-det > bound) {
+        return -1;
+    }
+
+    Expansion exact = sum(product(difference(a.x, c.x), difference(b.y, c.y)),
+                          negate(product(difference(a.y, c.y), difference(b.x, c.x))));
+    return sign(exact);
+}
+
+// Returns 1 if d lies on the side of the plane through (a, b, c) the normal of the triangle
+// points to, -1 if it lies on the other side and 0 if the points are coplanar.
+int orient3d(const Base::Vector3d& a,
+             const Base::Vector3d& b,
+             const Base::Vector3d& c,
+             const Base::Vector3d& d)
+{
+    double adx = a.x - d.x;
+    double bdx = b.x - d.x;
+    double cdx = c.x - d.x;
+    double ady = a.y - d.y;
+    double bdy = b.y - d.y;
+    double cdy = c.y - d.y;
+    double adz = a.z - d.z;
+    double bdz = b.z - d.z;
+    double cdz = c.z - d.z;
+
+    double bdxcdy = bdx * cdy;
+    double cdxbdy = cdx * bdy;
+    double cdxady = cdx * ady;
+    double adxcdy = adx * cdy;
+    double adxbdy = adx * bdy;
+    double bdxady = bdx * ady;
+
+    // this is the determinant of (a - d, b - d, c - d) which is negative if d lies above
+    double det = adz * (bdxcdy - cdxbdy) + bdz * (cdxady - adxcdy) + cdz * (adxbdy - bdxady);
+    double permanent = (std::fabs(bdxcdy) + std::fabs(cdxbdy)) * std::fabs(adz)
+        + (std::fabs(cdxady) + std::fabs(adxcdy)) * std::fabs(bdz)
+        + (std::fabs(adxbdy) + std::fabs(bdxady)) * std::fabs(cdz);
+    double bound = errBound3 * permanent;
+    if (det > bound) {
+        return -1;
+    }
+    if (-det > bound) {
+        return 1;
+    }
+
+    Expansion eadx = difference(a.x, d.x);
+    Expansion ebdx = difference(b.x, d.x);
+    Expansion ecdx = difference(c.x, d.x);
+    Expansion eady = difference(a.y, d.y);
+    Expansion ebdy = difference(b.y, d.y);
+    Expansion ecdy = difference(c.y, d.y);
+    Expansion eadz = difference(a.z, d.z);
+    Expansion ebdz = difference(b.z, d.z);
+    Expansion ecdz = difference(c.z, d.z);
+
+    Expansion minor1 = sum(product(ebdx, ecdy), negate(product(ecdx, ebdy)));
+    Expansion minor2 = sum(product(ecdx, eady), negate(product(eadx, ecdy)));
+    Expansion minor3 = sum(product(eadx, ebdy), negate(product(ebdx, eady)));
+    Expansion exact =
+        sum(sum(product(eadz, minor1), product(ebdz, minor2)), product(ecdz, minor3));
+    return -sign(exact);
+}
+
+// Returns a positive value if d lies inside the circumcircle of the counterclockwise
+// triangle (a, b, c). This is only used to improve the shape of the triangles, so it
+// doesn't need to be exact.
+double incircle(const Point2& a, const Point2& b, const Point2& c, const Point2& d)
+{
+    double adx = a.x - d.x;
+    double ady = a.y - d.y;
+    double bdx = b.x - d.x;
+    double bdy = b.y - d.y;
+    double cdx = c.x - d.x;
+    double cdy = c.y - d.y;
+    double alift = adx * adx + ady * ady;
+    double blift = bdx * bdx + bdy * bdy;
+    double clift = cdx * cdx + cdy * cdy;
+    return alift * (bdx * cdy - cdx * bdy) + blift * (cdx * ady - adx * cdy)
+        + clift * (adx * bdy - bdx * ady);
+}
+
+// Unlike the comparison operators of the vectors this doesn't use a tolerance
+template<class Vector>
+bool isEqual(const Vector& a, const Vector& b)
+{
+    return a.x == b.x && a.y == b.y && a.z == b.z;
+}
+
+Point2 project(const Base::Vector3d& p, int axis)
+{
+    // the cyclic order of the remaining coordinates keeps the orientation of the normal
+    switch (axis) {
+        case 0:
+            return {p.y, p.z};
+        case 1:
+            return {p.z, p.x};
+        default:
+            return {p.x, p.y};
+    }
+}
+
+// ------------------------------------------------------------------------------------------
+// Intersection points
+
+enum FeatureType : std::uint8_t
+{
+    VertexFeature,
+    EdgeFeature,
+    FaceFeature
+};
+
+// A vertex, edge or facet of one of the meshes. Vertices and edges are given by the global
+// point indices, facets by the global facet index.
+struct Feature
+{
+    FeatureType type {VertexFeature};
+    std::size_t first {0};
+    std::size_t second {0};
+
+    bool operator==(const Feature& other) const
+    {
+        return type == other.type && first == other.first && second == other.second;
+    }
+};
+
+Feature vertexFeature(std::size_t point)
+{
+    return {VertexFeature, point, 0};
+}
+
+Feature edgeFeature(std::size_t point1, std::size_t point2)
+{
+    return {EdgeFeature, std::min(point1, point2), std::max(point1, point2)};
+}
+
+Feature faceFeature(std::size_t facet)
+{
+    return {FaceFeature, facet, 0};
+}
+
+// An intersection point is identified by the lowest dimensional features of both meshes it
+// lies on. The first feature belongs to the first mesh.
+struct Key
+{
+    Feature first;
+    Feature second;
+
+    bool operator==(const Key& other) const
+    {
+        return first == other.first && second == other.second;
+    }
+};
+
+struct KeyHash
+{
+    std::size_t operator()(const Key& key) const
+    {
+        std::size_t hash = 0;
+        auto combine = [&hash](std::size_t value) {
+            hash ^= std::hash<std::size_t>()(value) + 0x9e3779b97f4a7c15ULL + (hash << 6)
+                + (hash >> 2);
+        };
+        combine(key.first.type);
+        combine(key.first.first);
+        combine(key.first.second);
+        combine(key.second.type);
+        combine(key.second.first);
+        combine(key.second.second);
+        return hash;
+    }
+};
+
+using Edge = std::pair<std::size_t, std::size_t>;
+
+Edge makeEdge(std::size_t point1, std::size_t point2)
+{
+    return {std::min(point1, point2), std::max(point1, point2)};
+}
+
+struct EdgeHash
+{
+    std::size_t operator()(const Edge& edge) const
+    {
+        std::size_t hash = std::hash<std::size_t>()(edge.first);
+        return hash ^ (std::hash<std::size_t>()(edge.second) + 0x9e3779b97f4a7c15ULL
+                       + (hash << 6) + (hash >> 2));
+    }
+};
+
+using Triangle = std::array<std::size_t, 3>;
+
+// The points and facets of both meshes with global indices, the elements of the second mesh
+// follow the ones of the first mesh.
+struct Data
+{
+    std::vector<Base::Vector3d> points;
+    std::vector<Triangle> facets;
+    std::vector<Base::Vector3d> normals;
+    // the coordinate that is dropped to project a facet into 2d
+    std::vector<int> axes;
+    // the orientation of the projected facet, zero for degenerated facets
+    std::vector<int> orientations;
+    std::size_t numPoints1 {0};
+    std::size_t numFacets1 {0};
+
+    void addMesh(const MeshKernel& mesh)
+    {
+        std::size_t offset = points.size();
+        for (const auto& pnt : mesh.GetPoints()) {
+            points.emplace_back(pnt.x, pnt.y, pnt.z);
+        }
+        for (const auto& face : mesh.GetFacets()) {
+            const auto& pts = face._aulPoints;
+            Triangle tria {pts[0] + offset, pts[1] + offset, pts[2] + offset};
+            const Base::Vector3d& p0 = points[tria[0]];
+            const Base::Vector3d& p1 = points[tria[1]];
+            const Base::Vector3d& p2 = points[tria[2]];
+            Base::Vector3d normal = (p1 - p0) % (p2 - p0);
+            int axis = 2;
+            if (std::fabs(normal.x) >= std::fabs(normal.y)
+                && std::fabs(normal.x) >= std::fabs(normal.z)) {
+                axis = 0;
+            }
+            else if (std::fabs(normal.y) >= std::fabs(normal.z)) {
+                axis = 1;
+            }
+            facets.push_back(tria);
+            normals.push_back(normal);
+            axes.push_back(axis);
+            orientations.push_back(
+                orient2d(project(p0, axis), project(p1, axis), project(p2, axis)));
+        }
+    }
+
+    bool isFirst(std::size_t facet) const
+    {
+        return facet < numFacets1;
+    }
+
+    Base::Vector3d linePlane(std::size_t point1, std::size_t point2, std::size_t facet) const
+    {
+        const Base::Vector3d& p = points[point1];
+        const Base::Vector3d& q = points[point2];
+        const Base::Vector3d& a = points[facets[facet][0]];
+        const Base::Vector3d& n = normals[facet];
+        double dp = n * (p - a);
+        double dq = n * (q - a);
+        double t = dp != dq ? dp / (dp - dq) : 0.0;
+        t = std::clamp(t, 0.0, 1.0);
+        return p + (q - p) * t;
+    }
+
+    Base::Vector3d lineLine(const Feature& edge1, const Feature& edge2) const
+    {
+        const Base::Vector3d& p1 = points[edge1.first];
+        const Base::Vector3d& p2 = points[edge2.first];
+        Base::Vector3d d1 = points[edge1.second] - p1;
+        Base::Vector3d d2 = points[edge2.second] - p2;
+        Base::Vector3d r = p1 - p2;
+        double a = d1 * d1;
+        double b = d1 * d2;
+        double c = d2 * d2;
+        double d = d1 * r;
+        double e = d2 * r;
+        double den = a * c - b * b;
+        double s = den > 0.0 ? (b * e - c * d) / den : 0.0;
+        s = std::clamp(s, 0.0, 1.0);
+        return p1 + d1 * s;
+    }
+
+    // Computes the coordinates of an intersection point, rounded to doubles. The topology is
+    // given by the key, but the re-triangulation works on these coordinates.
+    Base::Vector3d pointOf(const Key& key) const
+    {
+        if (key.first.type == VertexFeature) {
+            return points[key.first.first];
+        }
+        if (key.second.type == VertexFeature) {
+            return points[key.second.first];
+        }
+        if (key.first.type == EdgeFeature && key.second.type == EdgeFeature) {
+            return lineLine(key.first, key.second);
+        }
+        if (key.first.type == EdgeFeature) {
+            return linePlane(key.first.first, key.first.second, key.second.first);
+        }
+        return linePlane(key.second.first, key.second.second, key.first.first);
+    }
+};
+
+// An intersection of an edge of one mesh with a facet of the other mesh. 'param' is the
+// approximate position on the edge.
+struct Hit
+{
+    Feature edge;
+    Feature face;
+    double param {0.0};
+};
+
+struct Constraint
+{
+    std::size_t facet;
+    Key from;
+    Key to;
+};
+
+struct Coplanar
+{
+    std::size_t facet;
+    std::size_t other;
+    bool sameOrientation;
+};
+
+// The results of the facet pairs of a range of facets of the first mesh
+struct PairResult
+{
+    std::vector<Key> points;
+    std::vector<Constraint> constraints;
+    std::vector<Coplanar> coplanar;
+    std::vector<std::size_t> touched;
+};
+
+// Returns the feature of the facet given by the vanishing orientations of a point relative
+// to its edges (0, 1), (1, 2) and (2, 0).
+Feature featureOfFacet(const Data& data, std::size_t facet, bool zero0, bool zero1, bool zero2)
+{
+    const Triangle& tria = data.facets[facet];
+    if (zero0 && zero1) {
+        return vertexFeature(tria[1]);
+    }
+    if (zero1 && zero2) {
+        return vertexFeature(tria[2]);
+    }
+    if (zero2 && zero0) {
+        return vertexFeature(tria[0]);
+    }
+    if (zero0) {
+        return edgeFeature(tria[0], tria[1]);
+    }
+    if (zero1) {
+        return edgeFeature(tria[1], tria[2]);
+    }
+    if (zero2) {
+        return edgeFeature(tria[2], tria[0]);
+    }
+    return faceFeature(facet);
+}
+
+// Locates a point that lies in the plane of the facet. Returns false if it's outside.
+bool locate(const Data& data, std::size_t point, std::size_t facet, Feature& feature)
+{
+    const Triangle& tria = data.facets[facet];
+    int axis = data.axes[facet];
+    int sigma = data.orientations[facet];
+    Point2 a = project(data.points[tria[0]], axis);
+    Point2 b = project(data.points[tria[1]], axis);
+    Point2 c = project(data.points[tria[2]], axis);
+    Point2 p = project(data.points[point], axis);
+    int o0 = sigma * orient2d(a, b, p);
+    int o1 = sigma * orient2d(b, c, p);
+    int o2 = sigma * orient2d(c, a, p);
+    if (o0 < 0 || o1 < 0 || o2 < 0) {
+        return false;
+    }
+    feature = featureOfFacet(data, facet, o0 == 0, o1 == 0, o2 == 0);
+    return true;
+}
+
+// Returns true if c lies strictly between a and b, all points must be collinear.
+bool between(const Point2& a, const Point2& b, const Point2& c)
+{
+    if (std::fabs(b.x - a.x) >= std::fabs(b.y - a.y)) {
+        return (c.x - a.x) * (c.x - b.x) < 0.0;
+    }
+    return (c.y - a.y) * (c.y - b.y) < 0.0;
+}
+
+double parameter(const Point2& a, const Point2& b, const Point2& c)
+{
+    double dx = b.x - a.x;
+    double dy = b.y - a.y;
+    double len = dx * dx + dy * dy;
+    return len > 0.0 ? ((c.x - a.x) * dx + (c.y - a.y) * dy) / len : 0.0;
+}
+
+// Intersects the edge (p, q) with a facet it is coplanar to
+void intersectCoplanarEdge(const Data& data,
+                           std::size_t p,
+                           std::size_t q,
+                           std::size_t facet,
+                           std::vector<Hit>& hits)
+{
+    Feature feature;
+    if (locate(data, p, facet, feature)) {
+        hits.push_back({vertexFeature(p), feature, 0.0});
+    }
+    if (locate(data, q, facet, feature)) {
+        hits.push_back({vertexFeature(q), feature, 1.0});
+    }
+
+    const Triangle& tria = data.facets[facet];
+    int axis = data.axes[facet];
+    const Base::Vector3d& pp = data.points[p];
+    const Base::Vector3d& pq = data.points[q];
+    Point2 p2 = project(pp, axis);
+    Point2 q2 = project(pq, axis);
+    for (int i = 0; i < 3; i++) {
+        std::size_t u = tria[i];
+        std::size_t v = tria[(i + 1) % 3];
+        Point2 u2 = project(data.points[u], axis);
+        Point2 v2 = project(data.points[v], axis);
+        int o1 = orient2d(p2, q2, u2);
+        int o2 = orient2d(p2, q2, v2);
+        int o3 = orient2d(u2, v2, p2);
+        int o4 = orient2d(u2, v2, q2);
+        if (o1 * o2 > 0 || o3 * o4 > 0) {
+            continue;
+        }
+        // End points of the edge (p, q) on the facet are already handled above
+        if (o1 == 0 && o2 == 0) {
+            for (std::size_t w : {u, v}) {
+                Point2 w2 = project(data.points[w], axis);
+                if (between(p2, q2, w2)) {
+                    hits.push_back({edgeFeature(p, q), vertexFeature(w), parameter(p2, q2, w2)});
+                }
+            }
+        }
+        else if (o1 == 0 || o2 == 0) {
+            std::size_t w = o1 == 0 ? u : v;
+            const Base::Vector3d& pw = data.points[w];
+            if (!isEqual(pw, pp) && !isEqual(pw, pq)) {
+                Point2 w2 = project(pw, axis);
+                hits.push_back({edgeFeature(p, q), vertexFeature(w), parameter(p2, q2, w2)});
+            }
+        }
+        else if (o3 != 0 && o4 != 0) {
+            double d3 = (u2.x - p2.x) * (v2.y - p2.y) - (u2.y - p2.y) * (v2.x - p2.x);
+            double d4 = (u2.x - q2.x) * (v2.y - q2.y) - (u2.y - q2.y) * (v2.x - q2.x);
+            double t = d3 != d4 ? d3 / (d3 - d4) : 0.5;
+            hits.push_back({edgeFeature(p, q), edgeFeature(u, v), t});
+        }
+    }
+}
+
+// Intersects the edge (p, q) with a facet of the other mesh. 'op' and 'oq' are the orientations
+// of the end points relative to the plane of the facet.
+void intersectEdge(const Data& data,
+                   std::size_t p,
+                   std::size_t q,
+                   int op,
+                   int oq,
+                   std::size_t facet,
+                   std::vector<Hit>& hits)
+{
+    if (op == oq && op != 0) {
+        return;
+    }
+    if (op == 0 && oq == 0) {
+        intersectCoplanarEdge(data, p, q, facet, hits);
+        return;
+    }
+    if (op == 0 || oq == 0) {
+        std::size_t point = op == 0 ? p : q;
+        Feature feature;
+        if (locate(data, point, facet, feature)) {
+            hits.push_back({vertexFeature(point), feature, op == 0 ? 0.0 : 1.0});
+        }
+        return;
+    }
+
+    const Triangle& tria = data.facets[facet];
+    const auto& pts = data.points;
+    int s0 = orient3d(pts[p], pts[q], pts[tria[0]], pts[tria[1]]);
+    int s1 = orient3d(pts[p], pts[q], pts[tria[1]], pts[tria[2]]);
+    int s2 = orient3d(pts[p], pts[q], pts[tria[2]], pts[tria[0]]);
+    bool positive = s0 > 0 || s1 > 0 || s2 > 0;
+    bool negative = s0 < 0 || s1 < 0 || s2 < 0;
+    if (positive && negative) {
+        return;
+    }
+    Feature feature = featureOfFacet(data, facet, s0 == 0, s1 == 0, s2 == 0);
+    hits.push_back({edgeFeature(p, q), feature, 0.5});
+}
+
+void removeDuplicates(std::vector<Hit>& hits)
+{
+    for (std::size_t i = 0; i < hits.size(); i++) {
+        for (std::size_t j = hits.size(); j-- > i + 1;) {
+            if (hits[j].edge == hits[i].edge && hits[j].face == hits[i].face) {
+                hits.erase(hits.begin() + std::ptrdiff_t(j));
+            }
+        }
+    }
+}
+
+// Computes the intersection of the facet 'facet1' of the first mesh with the facet 'facet2'
+// of the second mesh
+void intersectFacets(const Data& data, std::size_t facet1, std::size_t facet2, PairResult& res)
+{
+    const auto& pts = data.points;
+    const Triangle& t1 = data.facets[facet1];
+    const Triangle& t2 = data.facets[facet2];
+    auto separated = [](const std::array<int, 3>& o) {
+        return (o[0] > 0 && o[1] > 0 && o[2] > 0) || (o[0] < 0 && o[1] < 0 && o[2] < 0);
+    };
+
+    std::array<int, 3> o2 {};
+    for (int i = 0; i < 3; i++) {
+        o2[i] = orient3d(pts[t1[0]], pts[t1[1]], pts[t1[2]], pts[t2[i]]);
+    }
+    if (separated(o2)) {
+        return;
+    }
+    std::array<int, 3> o1 {};
+    for (int i = 0; i < 3; i++) {
+        o1[i] = orient3d(pts[t2[0]], pts[t2[1]], pts[t2[2]], pts[t1[i]]);
+    }
+    if (separated(o1)) {
+        return;
+    }
+
+    bool coplanar = o2[0] == 0 && o2[1] == 0 && o2[2] == 0;
+    std::vector<Key> keys;
+    std::vector<Hit> hits;
+    auto addKey = [&keys](const Key& key) {
+        if (std::find(keys.begin(), keys.end(), key) == keys.end()) {
+            keys.push_back(key);
+        }
+    };
+
+    // In the coplanar case the part of an edge inside the other facet bounds the overlapping
+    // area and thus is a constraint of the other facet
+    auto addCoplanarConstraint = [&](std::size_t facet, bool first) {
+        removeDuplicates(hits);
+        if (hits.size() < 2) {
+            return;
+        }
+        auto range = std::minmax_element(hits.begin(), hits.end(), [](const Hit& a, const Hit& b) {
+            return a.param < b.param;
+        });
+        const Hit& h1 = *range.first;
+        const Hit& h2 = *range.second;
+        if (first) {
+            res.constraints.push_back({facet, {h1.edge, h1.face}, {h2.edge, h2.face}});
+        }
+        else {
+            res.constraints.push_back({facet, {h1.face, h1.edge}, {h2.face, h2.edge}});
+        }
+    };
+
+    for (int i = 0; i < 3; i++) {
+        hits.clear();
+        intersectEdge(data, t1[i], t1[(i + 1) % 3], o1[i], o1[(i + 1) % 3], facet2, hits);
+        for (const auto& hit : hits) {
+            addKey({hit.edge, hit.face});
+        }
+        if (coplanar) {
+            addCoplanarConstraint(facet2, true);
+        }
+    }
+    for (int i = 0; i < 3; i++) {
+        hits.clear();
+        intersectEdge(data, t2[i], t2[(i + 1) % 3], o2[i], o2[(i + 1) % 3], facet1, hits);
+        for (const auto& hit : hits) {
+            addKey({hit.face, hit.edge});
+        }
+        if (coplanar) {
+            addCoplanarConstraint(facet1, false);
+        }
+    }
+
+    if (keys.empty()) {
+        return;
+    }
+
+    res.touched.push_back(facet1);
+    res.touched.push_back(facet2);
+    res.points.insert(res.points.end(), keys.begin(), keys.end());
+    if (coplanar) {
+        bool same = data.normals[facet1] * data.normals[facet2] > 0.0;
+        res.coplanar.push_back({facet1, facet2, same});
+        res.coplanar.push_back({facet2, facet1, same});
+        return;
+    }
+
+    // All points lie on the intersection line of both planes, connect them in their order
+    Base::Vector3d dir = data.normals[facet1] % data.normals[facet2];
+    std::vector<std::pair<double, std::size_t>> order;
+    order.reserve(keys.size());
+    for (std::size_t i = 0; i < keys.size(); i++) {
+        order.emplace_back(data.pointOf(keys[i]) * dir, i);
+    }
+    std::sort(order.begin(), order.end());
+    for (std::size_t i = 1; i < order.size(); i++) {
+        const Key& from = keys[order[i - 1].second];
+        const Key& to = keys[order[i].second];
+        res.constraints.push_back({facet1, from, to});
+        res.constraints.push_back({facet2, from, to});
+    }
+}
+
+// A grid of the bounding boxes of facets. Unlike MeshFacetGrid a facet is added to all cells
+// its bounding box overlaps, so facets that only touch each other are never missed.
+class BoxGrid
+{
+public:
+    BoxGrid(const std::vector<Base::BoundBox3f>& boxes, std::size_t begin, std::size_t end)
+        : _boxes(boxes)
+    {
+        for (std::size_t i = begin; i < end; i++) {
+            _bbox.Add(boxes[i]);
+        }
+        float lenX = _bbox.LengthX();
+        float lenY = _bbox.LengthY();
+        float lenZ = _bbox.LengthZ();
+        float maxLen = std::max({lenX, lenY, lenZ, std::numeric_limits<float>::min()});
+        float minLen = maxLen * 1.0e-3F;
+        double volume = double(std::max(lenX, minLen)) * std::max(lenY, minLen)
+            * std::max(lenZ, minLen);
+        auto cellLen = float(std::cbrt(volume / double(std::max<std::size_t>(end - begin, 1))));
+        _count[0] = std::clamp(int(std::ceil(lenX / cellLen)), 1, 256);
+        _count[1] = std::clamp(int(std::ceil(lenY / cellLen)), 1, 256);
+        _count[2] = std::clamp(int(std::ceil(lenZ / cellLen)), 1, 256);
+
+        // the elements of the cells are stored consecutively
+        std::vector<std::size_t> numElements(std::size_t(_count[0]) * _count[1] * _count[2] + 1);
+        for (std::size_t i = begin; i < end; i++) {
+            forEachCell(boxes[i], [&numElements](std::size_t cell) {
+                numElements[cell + 1]++;
+            });
+        }
+        std::partial_sum(numElements.begin(), numElements.end(), numElements.begin());
+        _offsets = numElements;
+        _elements.resize(_offsets.back());
+        for (std::size_t i = begin; i < end; i++) {
+            forEachCell(boxes[i], [this, &numElements, i](std::size_t cell) {
+                _elements[numElements[cell]++] = i;
+            });
+        }
+    }
+
+    // Collects the facets whose bounding boxes overlap with the given box
+    void Inside(const Base::BoundBox3f& box, std::vector<std::size_t>& elements) const
+    {
+        elements.clear();
+        forEachCell(box, [this, &box, &elements](std::size_t cell) {
+            for (std::size_t i = _offsets[cell]; i < _offsets[cell + 1]; i++) {
+                const Base::BoundBox3f& other = _boxes[_elements[i]];
+                if (box.MinX <= other.MaxX && other.MinX <= box.MaxX && box.MinY <= other.MaxY
+                    && other.MinY <= box.MaxY && box.MinZ <= other.MaxZ
+                    && other.MinZ <= box.MaxZ) {
+                    elements.push_back(_elements[i]);
+                }
+            }
+        });
+        std::sort(elements.begin(), elements.end());
+        elements.erase(std::unique(elements.begin(), elements.end()), elements.end());
+    }
+
+private:
+    static int position(float value, float min, float len, int count)
+    {
+        if (!(value > min) || !(len > 0.0F)) {
+            return 0;
+        }
+        return int(std::min((value - min) / len * float(count), float(count - 1)));
+    }
+
+    template<class Func>
+    void forEachCell(const Base::BoundBox3f& box, Func func) const
+    {
+        int x1 = position(box.MinX, _bbox.MinX, _bbox.LengthX(), _count[0]);
+        int x2 = position(box.MaxX, _bbox.MinX, _bbox.LengthX(), _count[0]);
+        int y1 = position(box.MinY, _bbox.MinY, _bbox.LengthY(), _count[1]);
+        int y2 = position(box.MaxY, _bbox.MinY, _bbox.LengthY(), _count[1]);
+        int z1 = position(box.MinZ, _bbox.MinZ, _bbox.LengthZ(), _count[2]);
+        int z2 = position(box.MaxZ, _bbox.MinZ, _bbox.LengthZ(), _count[2]);
+        for (int z = z1; z <= z2; z++) {
+            for (int y = y1; y <= y2; y++) {
+                for (int x = x1; x <= x2; x++) {
+                    func((std::size_t(z) * _count[1] + y) * _count[0] + x);
+                }
+            }
+        }
+    }
+
+private:
+    const std::vector<Base::BoundBox3f>& _boxes;
+    Base::BoundBox3f _bbox;
+    std::array<int, 3> _count {1, 1, 1};
+    std::vector<std::size_t> _offsets;
+    std::vector<std::size_t> _elements;
+};
+
+// ------------------------------------------------------------------------------------------
+// Re-triangulation of the cut facets
+
+// The points on a cut facet and the constraints. The indices refer to the points of the
+// mesh of the facet.
+struct FacetCut
+{
+    std::vector<std::size_t> points;
+    std::vector<Edge> constraints;
+    std::vector<std::pair<std::size_t, bool>> coplanar;
+};
+
+using EdgePoints = std::unordered_map<Edge, std::vector<std::size_t>, EdgeHash>;
+
+// A facet of the result. 'coplanar' is 1 if it overlaps with an equally oriented facet of
+// the other mesh, -1 if it overlaps with an oppositely oriented facet and 0 otherwise.
+struct Piece
+{
+    Triangle corners;
+    int coplanar {0};
+};
+
+struct CutResult
+{
+    std::vector<Piece> pieces;
+    std::vector<Edge> constraints;
+};
+
+class FacetTriangulation
+{
+public:
+    FacetTriangulation(const Data& data, std::size_t facet)
+        : _data(data)
+        , _facet(facet)
+        , _axis(data.axes[facet])
+        , _mirror(data.orientations[facet] < 0)
+    {}
+
+    void Compute(const FacetCut& cut, const EdgePoints& edgePoints, CutResult& res)
+    {
+        const Triangle& tria = _data.facets[_facet];
+        for (std::size_t corner : tria) {
+            addPoint(corner);
+        }
+        addTriangle(0, 1, 2);
+
+        // Points on the edges are inserted in their order by splitting the boundary edges
+        for (int i = 0; i < 3; i++) {
+            auto it = edgePoints.find(makeEdge(tria[i], tria[(i + 1) % 3]));
+            if (it != edgePoints.end()) {
+                insertOnBoundary(i, it->second);
+            }
+        }
+        for (std::size_t point : cut.points) {
+            if (_local.find(point) == _local.end()) {
+                insertInner(addPoint(point));
+            }
+        }
+        for (const auto& edge : cut.constraints) {
+            auto it1 = _local.find(edge.first);
+            auto it2 = _local.find(edge.second);
+            if (it1 != _local.end() && it2 != _local.end()) {
+                insertConstraint(resolve(it1->second), resolve(it2->second), 0);
+            }
+        }
+
+        for (const auto& tri : _triangles) {
+            if (tri[0] < 0) {
+                continue;
+            }
+            Piece piece;
+            piece.corners = {_ids[tri[0]], _ids[tri[1]], _ids[tri[2]]};
+            piece.coplanar = coplanarState(tri, cut);
+            res.pieces.push_back(piece);
+        }
+        for (auto edge : _constrained) {
+            res.constraints.push_back(makeEdge(_ids[edge >> 32], _ids[edge & 0xffffffff]));
+        }
+    }
+
+private:
+    int addPoint(std::size_t id)
+    {
+        Point2 p = project(_data.points[id], _axis);
+        if (_mirror) {
+            p.x = -p.x;
+        }
+        int index = int(_points.size());
+        _points.push_back(p);
+        _ids.push_back(id);
+        _alias.push_back(index);
+        _local[id] = index;
+        return index;
+    }
+
+    int resolve(int index) const
+    {
+        while (_alias[index] != index) {
+            index = _alias[index];
+        }
+        return index;
+    }
+
+    static std::uint64_t key(int a, int b)
+    {
+        return (std::uint64_t(a) << 32) | std::uint64_t(b);
+    }
+
+    int orient(int a, int b, int c) const
+    {
+        return orient2d(_points[a], _points[b], _points[c]);
+    }
+
+    void addTriangle(int a, int b, int c)
+    {
+        int index = int(_triangles.size());
+        _triangles.push_back({a, b, c});
+        _edges[key(a, b)] = index;
+        _edges[key(b, c)] = index;
+        _edges[key(c, a)] = index;
+    }
+
+    void removeTriangle(int index)
+    {
+        auto& tri = _triangles[index];
+        _edges.erase(key(tri[0], tri[1]));
+        _edges.erase(key(tri[1], tri[2]));
+        _edges.erase(key(tri[2], tri[0]));
+        tri = {-1, -1, -1};
+    }
+
+    // Returns the triangle with the directed edge (a, b) or -1
+    int findTriangle(int a, int b) const
+    {
+        auto it = _edges.find(key(a, b));
+        return it != _edges.end() ? it->second : -1;
+    }
+
+    int opposite(int tri, int a, int b) const
+    {
+        for (int v : _triangles[tri]) {
+            if (v != a && v != b) {
+                return v;
+            }
+        }
+        return -1;
+    }
+
+    bool isConstrained(int a, int b) const
+    {
+        return _constrained.count(key(std::min(a, b), std::max(a, b))) > 0;
+    }
+
+    // Restores the Delaunay property around the newly inserted point p. The edges are given
+    // as directed edges of the triangles that contain p.
+    void legalize(std::vector<std::pair<int, int>>& edges, int p)
+    {
+        int limit = 100 * int(_points.size()) + 100;
+        while (!edges.empty() && limit-- > 0) {
+            auto [a, b] = edges.back();
+            edges.pop_back();
+            int other = findTriangle(b, a);
+            if (other < 0 || isConstrained(a, b)) {
+                continue;
+            }
+            int d = opposite(other, b, a);
+            if (incircle(_points[a], _points[b], _points[p], _points[d]) <= 0.0) {
+                continue;
+            }
+            if (flip(a, b)) {
+                edges.emplace_back(a, d);
+                edges.emplace_back(d, b);
+            }
+        }
+    }
+
+    // Replaces the edge (a, b) of the triangles (a, b, c) and (b, a, d) by the edge (c, d) if
+    // the quadrilateral is strictly convex
+    bool flip(int a, int b)
+    {
+        int t1 = findTriangle(a, b);
+        int t2 = findTriangle(b, a);
+        if (t1 < 0 || t2 < 0) {
+            return false;
+        }
+        int c = opposite(t1, a, b);
+        int d = opposite(t2, b, a);
+        if (orient(a, d, c) <= 0 || orient(d, b, c) <= 0) {
+            return false;
+        }
+        removeTriangle(t1);
+        removeTriangle(t2);
+        addTriangle(a, d, c);
+        addTriangle(d, b, c);
+        return true;
+    }
+
+    void insertOnBoundary(int side, const std::vector<std::size_t>& ids)
+    {
+        const Triangle& tria = _data.facets[_facet];
+        const Base::Vector3d& start = _data.points[tria[side]];
+        Base::Vector3d dir = _data.points[tria[(side + 1) % 3]] - start;
+        std::vector<std::pair<double, std::size_t>> order;
+        for (std::size_t id : ids) {
+            if (_local.find(id) == _local.end()) {
+                order.emplace_back((_data.points[id] - start) * dir, id);
+            }
+        }
+        std::sort(order.begin(), order.end());
+
+        int prev = side;
+        int next = (side + 1) % 3;
+        std::vector<std::pair<int, int>> edges;
+        for (const auto& it : order) {
+            int p = addPoint(it.second);
+            int tri = findTriangle(prev, next);
+            if (tri < 0) {
+                continue;
+            }
+            int c = opposite(tri, prev, next);
+            removeTriangle(tri);
+            addTriangle(prev, p, c);
+            addTriangle(p, next, c);
+            edges.emplace_back(c, prev);
+            edges.emplace_back(next, c);
+            legalize(edges, p);
+            prev = p;
+        }
+    }
+
+    // Searches for the triangle containing p by walking towards it, falls back to checking
+    // all triangles if the walk fails
+    int locateTriangle(int p, std::array<int, 3>& signs) const
+    {
+        auto classify = [&](int tri) {
+            const auto& t = _triangles[tri];
+            signs = {orient(t[0], t[1], p), orient(t[1], t[2], p), orient(t[2], t[0], p)};
+            return signs[0] >= 0 && signs[1] >= 0 && signs[2] >= 0;
+        };
+
+        int tri = _last >= 0 && _triangles[_last][0] >= 0 ? _last : -1;
+        int steps = int(_triangles.size());
+        while (tri >= 0 && steps-- > 0) {
+            if (classify(tri)) {
+                return tri;
+            }
+            int next = -1;
+            const auto& t = _triangles[tri];
+            for (int i = 0; i < 3; i++) {
+                if (signs[i] < 0) {
+                    next = findTriangle(t[(i + 1) % 3], t[i]);
+                    break;
+                }
+            }
+            tri = next;
+        }
+
+        for (int i = 0; i < int(_triangles.size()); i++) {
+            if (_triangles[i][0] >= 0 && classify(i)) {
+                return i;
+            }
+        }
+        return -1;
+    }
+
+    // Returns the triangle that is closest to contain p. Due to rounding an intersection point
+    // may lie marginally outside of the facet.
+    int nearestTriangle(int p) const
+    {
+        int best = -1;
+        double bestValue = -std::numeric_limits<double>::max();
+        const Point2& pt = _points[p];
+        for (int i = 0; i < int(_triangles.size()); i++) {
+            const auto& t = _triangles[i];
+            if (t[0] < 0) {
+                continue;
+            }
+            double value = std::numeric_limits<double>::max();
+            for (int k = 0; k < 3; k++) {
+                const Point2& a = _points[t[k]];
+                const Point2& b = _points[t[(k + 1) % 3]];
+                double len = std::hypot(b.x - a.x, b.y - a.y);
+                double dist = ((b.x - a.x) * (pt.y - a.y) - (b.y - a.y) * (pt.x - a.x))
+                    / std::max(len, std::numeric_limits<double>::min());
+                value = std::min(value, dist);
+            }
+            if (value > bestValue) {
+                bestValue = value;
+                best = i;
+            }
+        }
+        return best;
+    }
+
+    void insertInner(int p)
+    {
+        std::array<int, 3> signs {};
+        int tri = locateTriangle(p, signs);
+        if (tri < 0) {
+            tri = nearestTriangle(p);
+            signs = {1, 1, 1};
+        }
+        if (tri < 0) {
+            return;
+        }
+
+        std::array<int, 3> t = _triangles[tri];
+        int zeros = int(std::count(signs.begin(), signs.end(), 0));
+        if (zeros >= 2) {
+            // the point coincides with a vertex
+            for (int i = 0; i < 3; i++) {
+                if (signs[i] != 0) {
+                    _alias[p] = t[(i + 2) % 3];
+                }
+            }
+            return;
+        }
+
+        std::vector<std::pair<int, int>> edges;
+        if (zeros == 1) {
+            int i = int(std::find(signs.begin(), signs.end(), 0) - signs.begin());
+            int a = t[i];
+            int b = t[(i + 1) % 3];
+            int other = findTriangle(b, a);
+            if (other >= 0) {
+                int c = t[(i + 2) % 3];
+                int d = opposite(other, b, a);
+                removeTriangle(tri);
+                removeTriangle(other);
+                addTriangle(a, p, c);
+                addTriangle(p, b, c);
+                addTriangle(b, p, d);
+                addTriangle(p, a, d);
+                edges = {{c, a}, {b, c}, {d, b}, {a, d}};
+                legalize(edges, p);
+                _last = int(_triangles.size()) - 1;
+                return;
+            }
+        }
+
+        removeTriangle(tri);
+        addTriangle(t[0], t[1], p);
+        addTriangle(t[1], t[2], p);
+        addTriangle(t[2], t[0], p);
+        edges = {{t[0], t[1]}, {t[1], t[2]}, {t[2], t[0]}};
+        legalize(edges, p);
+        _last = int(_triangles.size()) - 1;
+    }
+
+    // Returns true if the edges (a, b) and (u, v) cross in their interior
+    bool crosses(int a, int b, int u, int v) const
+    {
+        return orient(u, v, a) * orient(u, v, b) < 0 && orient(a, b, u) * orient(a, b, v) < 0;
+    }
+
+    // Returns a point that lies (almost) on the open segment (u, v) or -1
+    int pointOnSegment(int u, int v) const
+    {
+        const Point2& a = _points[u];
+        const Point2& b = _points[v];
+        double dx = b.x - a.x;
+        double dy = b.y - a.y;
+        double len2 = dx * dx + dy * dy;
+        if (len2 <= 0.0) {
+            return -1;
+        }
+        const Triangle& tria = _data.facets[_facet];
+        double size = std::sqrt((_data.points[tria[1]] - _data.points[tria[0]]).Sqr()
+                                + (_data.points[tria[2]] - _data.points[tria[0]]).Sqr());
+        double tolerance = 1.0e-10 * size * std::sqrt(len2);
+        for (int i = 0; i < int(_points.size()); i++) {
+            if (i == u || i == v || resolve(i) != i) {
+                continue;
+            }
+            const Point2& c = _points[i];
+            double cross = dx * (c.y - a.y) - dy * (c.x - a.x);
+            double dot = dx * (c.x - a.x) + dy * (c.y - a.y);
+            if (std::fabs(cross) <= tolerance && dot > 0.0 && dot < len2) {
+                return i;
+            }
+        }
+        return -1;
+    }
+
+    // Recovers the edge (u, v) by flipping the edges crossing it
+    void insertConstraint(int u, int v, int depth)
+    {
+        if (u == v) {
+            return;
+        }
+        if (findTriangle(u, v) >= 0 || findTriangle(v, u) >= 0) {
+            _constrained.insert(key(std::min(u, v), std::max(u, v)));
+            return;
+        }
+        int w = depth < 64 ? pointOnSegment(u, v) : -1;
+        if (w >= 0) {
+            insertConstraint(u, w, depth + 1);
+            insertConstraint(w, v, depth + 1);
+            return;
+        }
+
+        std::deque<std::pair<int, int>> crossing;
+        for (const auto& it : _edges) {
+            int a = int(it.first >> 32);
+            int b = int(it.first & 0xffffffff);
+            if (a < b && findTriangle(b, a) >= 0 && crosses(a, b, u, v)) {
+                crossing.emplace_back(a, b);
+            }
+        }
+
+        std::size_t limit = 100 * crossing.size() * crossing.size() + 100;
+        while (!crossing.empty() && limit-- > 0) {
+            auto [a, b] = crossing.front();
+            crossing.pop_front();
+            int t1 = findTriangle(a, b);
+            int t2 = findTriangle(b, a);
+            if (t1 < 0 || t2 < 0) {
+                continue;
+            }
+            int c = opposite(t1, a, b);
+            int d = opposite(t2, b, a);
+            if (!flip(a, b)) {
+                crossing.emplace_back(a, b);
+            }
+            else if (crosses(c, d, u, v)) {
+                crossing.emplace_back(c, d);
+            }
+        }
+
+        if (findTriangle(u, v) >= 0 || findTriangle(v, u) >= 0) {
+            _constrained.insert(key(std::min(u, v), std::max(u, v)));
+        }
+    }
+
+    int coplanarState(const std::array<int, 3>& tri, const FacetCut& cut) const
+    {
+        if (cut.coplanar.empty()) {
+            return 0;
+        }
+        Point2 center {(_points[tri[0]].x + _points[tri[1]].x + _points[tri[2]].x) / 3.0,
+                       (_points[tri[0]].y + _points[tri[1]].y + _points[tri[2]].y) / 3.0};
+        for (const auto& [other, same] : cut.coplanar) {
+            std::array<Point2, 3> corners {};
+            for (int i = 0; i < 3; i++) {
+                corners[i] = project(_data.points[_data.facets[other][i]], _axis);
+                if (_mirror) {
+                    corners[i].x = -corners[i].x;
+                }
+            }
+            int o0 = orient2d(corners[0], corners[1], center);
+            int o1 = orient2d(corners[1], corners[2], center);
+            int o2 = orient2d(corners[2], corners[0], center);
+            if ((o0 > 0 && o1 > 0 && o2 > 0) || (o0 < 0 && o1 < 0 && o2 < 0)) {
+                return same ? 1 : -1;
+            }
+        }
+        return 0;
+    }
+
+private:
+    const Data& _data;
+    std::size_t _facet;
+    int _axis;
+    bool _mirror;
+    int _last {-1};
+    std::vector<Point2> _points;
+    std::vector<std::size_t> _ids;
+    std::vector<int> _alias;
+    std::unordered_map<std::size_t, int> _local;
+    std::vector<std::array<int, 3>> _triangles;
+    std::unordered_map<std::uint64_t, int> _edges;
+    std::unordered_set<std::uint64_t> _constrained;
+};
+
+// ------------------------------------------------------------------------------------------
+// Classification
+
+// Computes the generalized winding number of the facets [begin, end) at the point p. It is
+// close to one inside and close to zero outside of a closed mesh.
+double windingNumber(const Data& data, std::size_t begin, std::size_t end, const Base::Vector3d& p)
+{
+    double angle = 0.0;
+    for (std::size_t i = begin; i < end; i++) {
+        const Triangle& tria = data.facets[i];
+        Base::Vector3d a = data.points[tria[0]] - p;
+        Base::Vector3d b = data.points[tria[1]] - p;
+        Base::Vector3d c = data.points[tria[2]] - p;
+        double la = a.Length();
+        double lb = b.Length();
+        double lc = c.Length();
+        double num = a * (b % c);
+        double den = la * lb * lc + (a * b) * lc + (a * c) * lb + (b * c) * la;
+        angle += 2.0 * std::atan2(num, den);
+    }
+    return angle / (4.0 * std::numbers::pi);
+}
+
+std::size_t findRoot(std::vector<std::size_t>& parent, std::size_t index)
+{
+    while (parent[index] != index) {
+        parent[index] = parent[parent[index]];
+        index = parent[index];
+    }
+    return index;
+}
+
+enum class Location
+{
+    Outside,
+    Inside,
+    SameCoplanar,
+    OppositeCoplanar
+};
+
+// Splits the pieces into patches that are bounded by the intersection lines and classifies
+// them relative to the other mesh
+std::vector<Location> classify(const Data& data,
+                               const std::vector<Piece>& pieces,
+                               const std::unordered_set<Edge, EdgeHash>& constraints,
+                               std::size_t otherBegin,
+                               std::size_t otherEnd)
+{
+    std::vector<std::size_t> parent(pieces.size());
+    std::iota(parent.begin(), parent.end(), 0);
+
+    std::vector<std::pair<Edge, std::size_t>> edges;
+    edges.reserve(3 * pieces.size());
+    for (std::size_t i = 0; i < pieces.size(); i++) {
+        const Triangle& tria = pieces[i].corners;
+        for (int k = 0; k < 3; k++) {
+            edges.emplace_back(makeEdge(tria[k], tria[(k + 1) % 3]), i);
+        }
+    }
+    std::sort(edges.begin(), edges.end());
+    for (std::size_t i = 0; i < edges.size();) {
+        std::size_t j = i + 1;
+        while (j < edges.size() && edges[j].first == edges[i].first) {
+            j++;
+        }
+        if (j - i > 1 && constraints.count(edges[i].first) == 0) {
+            for (std::size_t k = i + 1; k < j; k++) {
+                std::size_t r1 = findRoot(parent, edges[i].second);
+                std::size_t r2 = findRoot(parent, edges[k].second);
+                parent[r2] = r1;
+            }
+        }
+        i = j;
+    }
+
+    // the largest piece of a patch is used to classify it
+    std::vector<std::size_t> patchOf(pieces.size());
+    std::vector<std::size_t> representative;
+    std::vector<double> largest;
+    std::unordered_map<std::size_t, std::size_t> patches;
+    for (std::size_t i = 0; i < pieces.size(); i++) {
+        std::size_t root = findRoot(parent, i);
+        auto it = patches.emplace(root, representative.size()).first;
+        if (it->second == representative.size()) {
+            representative.push_back(i);
+            largest.push_back(-1.0);
+        }
+        std::size_t patch = it->second;
+        patchOf[i] = patch;
+        const Triangle& tria = pieces[i].corners;
+        const auto& pts = data.points;
+        double area = ((pts[tria[1]] - pts[tria[0]]) % (pts[tria[2]] - pts[tria[0]])).Sqr();
+        if (area > largest[patch]) {
+            largest[patch] = area;
+            representative[patch] = i;
+        }
+    }
+
+    std::vector<Location> location(representative.size());
+    parallel_for(representative.size(), 1, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            const Piece& piece = pieces[representative[i]];
+            if (piece.coplanar != 0) {
+                location[i] =
+                    piece.coplanar > 0 ? Location::SameCoplanar : Location::OppositeCoplanar;
+                continue;
+            }
+            const Triangle& tria = piece.corners;
+            Base::Vector3d center =
+                (data.points[tria[0]] + data.points[tria[1]] + data.points[tria[2]]) / 3.0;
+            double winding = windingNumber(data, otherBegin, otherEnd, center);
+            location[i] = winding > 0.5 ? Location::Inside : Location::Outside;
+        }
+    });
+
+    std::vector<Location> result(pieces.size());
+    for (std::size_t i = 0; i < pieces.size(); i++) {
+        result[i] = location[patchOf[i]];
+    }
+    return result;
+}
+
+}  // namespace
+
+MeshBoolean::MeshBoolean(const MeshKernel& mesh1,
+                         const MeshKernel& mesh2,
+                         MeshKernel& result,
+                         SetOperations::OperationType opType)
+    : _mesh1(mesh1)
+    , _mesh2(mesh2)
+    , _result(result)
+    , _operationType(opType)
+{}
+
+void MeshBoolean::Do()
+{
+    Data data;
+    data.addMesh(_mesh1);
+    data.numPoints1 = data.points.size();
+    data.numFacets1 = data.facets.size();
+    data.addMesh(_mesh2);
+    std::size_t numFacets = data.facets.size();
+
+    // Intersects the facet pairs whose bounding boxes overlap
+    std::vector<std::pair<std::size_t, PairResult>> partial;
+    if (data.numFacets1 > 0 && numFacets > data.numFacets1) {
+        std::vector<Base::BoundBox3f> boxes;
+        boxes.reserve(numFacets);
+        MeshFacetIterator it1(_mesh1);
+        for (it1.Begin(); it1.More(); it1.Next()) {
+            boxes.push_back((*it1).GetBoundBox());
+        }
+        MeshFacetIterator it2(_mesh2);
+        for (it2.Begin(); it2.More(); it2.Next()) {
+            boxes.push_back((*it2).GetBoundBox());
+        }
+
+        BoxGrid grid(boxes, data.numFacets1, numFacets);
+        std::mutex mutex;
+        parallel_for(data.numFacets1, 64, [&](std::size_t begin, std::size_t end) {
+            PairResult res;
+            std::vector<std::size_t> elements;
+            for (std::size_t i = begin; i < end; i++) {
+                if (data.orientations[i] == 0) {
+                    continue;
+                }
+                grid.Inside(boxes[i], elements);
+                for (std::size_t j : elements) {
+                    if (data.orientations[j] != 0) {
+                        intersectFacets(data, i, j, res);
+                    }
+                }
+            }
+            std::lock_guard<std::mutex> lock(mutex);
+            partial.emplace_back(begin, std::move(res));
+        });
+        std::sort(partial.begin(), partial.end(), [](const auto& a, const auto& b) {
+            return a.first < b.first;
+        });
+    }
+
+    // Assigns the point indices. An intersection point at a vertex uses the vertex, so that
+    // a point of both meshes has a different index for each mesh.
+    struct Indices
+    {
+        std::size_t first;
+        std::size_t second;
+    };
+    std::unordered_map<Key, Indices, KeyHash> indices;
+    std::unordered_map<std::size_t, FacetCut> cuts;
+    EdgePoints edgePoints;
+    auto registerPoint = [&](const Feature& feature, std::size_t index) {
+        if (feature.type == FaceFeature) {
+            cuts[feature.first].points.push_back(index);
+        }
+        else if (feature.type == EdgeFeature) {
+            edgePoints[makeEdge(feature.first, feature.second)].push_back(index);
+        }
+    };
+    auto indexOf = [&](const Key& key) {
+        auto it = indices.find(key);
+        if (it != indices.end()) {
+            return it->second;
+        }
+        Indices index {};
+        if (key.first.type == VertexFeature) {
+            index.first = key.first.first;
+            index.second = key.second.type == VertexFeature ? key.second.first : index.first;
+        }
+        else if (key.second.type == VertexFeature) {
+            index.first = index.second = key.second.first;
+        }
+        else {
+            index.first = index.second = data.points.size();
+            data.points.push_back(data.pointOf(key));
+        }
+        indices[key] = index;
+        registerPoint(key.first, index.first);
+        registerPoint(key.second, index.second);
+        return index;
+    };
+
+    for (const auto& [begin, res] : partial) {
+        for (const Key& key : res.points) {
+            indexOf(key);
+        }
+        for (std::size_t facet : res.touched) {
+            cuts[facet];
+        }
+        for (const auto& it : res.constraints) {
+            Indices from = indexOf(it.from);
+            Indices to = indexOf(it.to);
+            if (data.isFirst(it.facet)) {
+                cuts[it.facet].constraints.emplace_back(from.first, to.first);
+            }
+            else {
+                cuts[it.facet].constraints.emplace_back(from.second, to.second);
+            }
+        }
+        for (const auto& it : res.coplanar) {
+            cuts[it.facet].coplanar.emplace_back(it.other, it.sameOrientation);
+        }
+    }
+    partial.clear();
+
+    // Facets that are only touched at an edge must be split, too
+    if (!edgePoints.empty()) {
+        for (std::size_t i = 0; i < numFacets; i++) {
+            const Triangle& tria = data.facets[i];
+            for (int k = 0; k < 3; k++) {
+                if (edgePoints.count(makeEdge(tria[k], tria[(k + 1) % 3])) > 0) {
+                    cuts[i];
+                    break;
+                }
+            }
+        }
+    }
+
+    // Re-triangulates the cut facets
+    std::vector<std::size_t> cutFacets;
+    cutFacets.reserve(cuts.size());
+    for (const auto& it : cuts) {
+        cutFacets.push_back(it.first);
+    }
+    std::sort(cutFacets.begin(), cutFacets.end());
+    std::vector<CutResult> cutResults(cutFacets.size());
+    parallel_for(cutFacets.size(), 16, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            std::size_t facet = cutFacets[i];
+            if (data.orientations[facet] == 0) {
+                const Triangle& tria = data.facets[facet];
+                cutResults[i].pieces.push_back({tria, 0});
+                continue;
+            }
+            FacetTriangulation triangulation(data, facet);
+            triangulation.Compute(cuts.at(facet), edgePoints, cutResults[i]);
+        }
+    });
+
+    std::vector<Piece> pieces1;
+    std::vector<Piece> pieces2;
+    std::unordered_set<Edge, EdgeHash> constraints;
+    std::size_t next = 0;
+    for (std::size_t i = 0; i < numFacets; i++) {
+        std::vector<Piece>& pieces = data.isFirst(i) ? pieces1 : pieces2;
+        if (next < cutFacets.size() && cutFacets[next] == i) {
+            const CutResult& res = cutResults[next++];
+            pieces.insert(pieces.end(), res.pieces.begin(), res.pieces.end());
+            constraints.insert(res.constraints.begin(), res.constraints.end());
+        }
+        else {
+            pieces.push_back({data.facets[i], 0});
+        }
+    }
+    cutResults.clear();
+
+    std::vector<Location> location1 =
+        classify(data, pieces1, constraints, data.numFacets1, numFacets);
+    std::vector<Location> location2 = classify(data, pieces2, constraints, 0, data.numFacets1);
+
+    // Collects the pieces of the result. Overlapping coplanar areas are taken from the
+    // first mesh only.
+    std::vector<Triangle> triangles;
+    auto collect = [&triangles](const std::vector<Piece>& pieces,
+                                const std::vector<Location>& location,
+                                Location loc1,
+                                Location loc2,
+                                bool flip) {
+        for (std::size_t i = 0; i < pieces.size(); i++) {
+            if (location[i] == loc1 || location[i] == loc2) {
+                Triangle tria = pieces[i].corners;
+                if (flip) {
+                    std::swap(tria[1], tria[2]);
+                }
+                triangles.push_back(tria);
+            }
+        }
+    };
+
+    switch (_operationType) {
+        case SetOperations::Union:
+            collect(pieces1, location1, Location::Outside, Location::SameCoplanar, false);
+            collect(pieces2, location2, Location::Outside, Location::Outside, false);
+            break;
+        case SetOperations::Intersect:
+            collect(pieces1, location1, Location::Inside, Location::SameCoplanar, false);
+            collect(pieces2, location2, Location::Inside, Location::Inside, false);
+            break;
+        case SetOperations::Difference:
+            collect(pieces1, location1, Location::Outside, Location::OppositeCoplanar, false);
+            collect(pieces2, location2, Location::Inside, Location::Inside, true);
+            break;
+        case SetOperations::Inner:
+            collect(pieces1, location1, Location::Inside, Location::SameCoplanar, false);
+            break;
+        case SetOperations::Outer:
+            collect(pieces1, location1, Location::Outside, Location::OppositeCoplanar, false);
+            break;
+    }
+
+    // Points that are equal after rounding to float are merged
+    std::vector<std::size_t> used;
+    used.reserve(3 * triangles.size());
+    for (const auto& tria : triangles) {
+        used.insert(used.end(), tria.begin(), tria.end());
+    }
+    std::sort(used.begin(), used.end());
+    used.erase(std::unique(used.begin(), used.end()), used.end());
+
+    std::vector<std::pair<Base::Vector3f, std::size_t>> rounded;
+    rounded.reserve(used.size());
+    for (std::size_t id : used) {
+        const Base::Vector3d& pnt = data.points[id];
+        rounded.emplace_back(Base::Vector3f(float(pnt.x), float(pnt.y), float(pnt.z)), id);
+    }
+    auto lessPoint = [](const Base::Vector3f& a, const Base::Vector3f& b) {
+        if (a.x != b.x) {
+            return a.x < b.x;
+        }
+        if (a.y != b.y) {
+            return a.y < b.y;
+        }
+        return a.z < b.z;
+    };
+    std::sort(rounded.begin(), rounded.end(), [&lessPoint](const auto& a, const auto& b) {
+        return lessPoint(a.first, b.first);
+    });
+
+    MeshPointArray points;
+    std::unordered_map<std::size_t, PointIndex> pointIndex;
+    for (std::size_t i = 0; i < rounded.size(); i++) {
+        if (i == 0 || !isEqual(rounded[i - 1].first, rounded[i].first)) {
+            points.push_back(MeshPoint(rounded[i].first));
+        }
+        pointIndex[rounded[i].second] = points.size() - 1;
+    }
+
+    MeshFacetArray facets;
+    facets.reserve(triangles.size());
+    for (const auto& tria : triangles) {
+        PointIndex p0 = pointIndex[tria[0]];
+        PointIndex p1 = pointIndex[tria[1]];
+        PointIndex p2 = pointIndex[tria[2]];
+        if (p0 != p1 && p1 != p2 && p2 != p0) {
+            facets.push_back(MeshFacet(p0, p1, p2));
+        }
+    }
+
+    _result.Clear();
+    _result.Adopt(points, facets, true);
+}
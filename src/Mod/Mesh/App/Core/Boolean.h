@@ -0,0 +1,81 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2025 FreeCAD Project Association                         *
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+#ifndef MESH_BOOLEAN_H
+#define MESH_BOOLEAN_H
+
+#include <Mod/Mesh/MeshGlobal.h>
+
+#include "SetOperations.h"
+
+
+namespace MeshCore
+{
+
+class MeshKernel;
+
+/**
+ * The MeshBoolean class computes the same set operations as SetOperations but with
+ * exact predicates for the intersection tests.
+ *
+ * All decisions about whether and where two facets of the input meshes touch or intersect
+ * are made with orientation tests that are evaluated exactly on the input coordinates, so
+ * that coplanar facets, edges running through vertices and similar degenerate configurations
+ * are classified consistently. Every intersection point is identified by the pair of
+ * features (vertex, edge or facet) of the two meshes it lies on, so that all facets around
+ * a point share it.
+ *
+ * The coordinates of the intersection points, however, are rounded to doubles. The
+ * re-triangulation of a cut facet evaluates its orientation tests on these rounded points,
+ * so it is exact with respect to the rounded positions only and may have to fall back to
+ * the nearest triangle for a point that ends up marginally outside of its facet.
+ *
+ * The cut facets are re-triangulated with the intersection lines as constraints, and the
+ * parts of a mesh are classified as inside or outside of the other mesh by its generalized
+ * winding number, which also gives sensible results for meshes with small holes. The
+ * facet pairs, the re-triangulation and the classification are processed on several
+ * threads.
+ */
+class MeshExport MeshBoolean
+{
+public:
+    /// Construction
+    MeshBoolean(const MeshKernel& mesh1,
+                const MeshKernel& mesh2,
+                MeshKernel& result,
+                SetOperations::OperationType opType);
+
+    /** Computes the set operation and writes the resulting mesh to the result kernel. */
+    void Do();
+
+private:
+    const MeshKernel& _mesh1;
+    const MeshKernel& _mesh2;
+    MeshKernel& _result;
+    SetOperations::OperationType _operationType;
+};
+
+}  // namespace MeshCore
+
+
+#endif  // MESH_BOOLEAN_H
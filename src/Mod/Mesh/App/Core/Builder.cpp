@@ -336,6 +336,22 @@ void MeshFastBuilder::Initialize(size_type ctFacets)
     p->verts.reserve(ctFacets * 3);
 }
 
+void MeshFastBuilder::Resize(size_type ctFacets)
+{
+    p->verts.resize(ctFacets * 3);
+}
+
+void MeshFastBuilder::SetFacet(size_type index, const Base::Vector3f* facetPoints)
+{
+    // use the raw pointer because QVector::operator[] isn't safe to use from several threads
+    Private::Vertex* v = p->verts.data() + 3 * index;
+    for (int i = 0; i < 3; i++) {
+        v[i].x = facetPoints[i].x;
+        v[i].y = facetPoints[i].y;
+        v[i].z = facetPoints[i].z;
+    }
+}
+
 void MeshFastBuilder::AddFacet(const Base::Vector3f* facetPoints)
 {
     Private::Vertex v;
@@ -371,23 +387,19 @@ void MeshFastBuilder::Finish()
     int threads = int(std::thread::hardware_concurrency());
     MeshCore::parallel_sort(verts.begin(), verts.end(), std::less<>(), threads);
 
-    QVector<FacetIndex> indices(ulCtPts);
+    // write the point indices directly into the facets to avoid a temporary index array
+    size_type ulCt = verts.size() / 3;
+    MeshFacetArray rFacets(static_cast<FacetIndex>(ulCt));
 
     size_type vertex_count = 0;
     for (QVector<Private::Vertex>::iterator v = verts.begin(); v != verts.end(); ++v) {
+        size_type index = v->i;
         if (!vertex_count || *v != verts[vertex_count - 1]) {
             verts[vertex_count++] = *v;
         }
 
-        indices[v->i] = static_cast<FacetIndex>(vertex_count - 1);
-    }
-
-    size_type ulCt = verts.size() / 3;
-    MeshFacetArray rFacets(static_cast<FacetIndex>(ulCt));
-    for (size_type i = 0; i < ulCt; ++i) {
-        rFacets[static_cast<size_t>(i)]._aulPoints[0] = indices[3 * i];
-        rFacets[static_cast<size_t>(i)]._aulPoints[1] = indices[3 * i + 1];
-        rFacets[static_cast<size_t>(i)]._aulPoints[2] = indices[3 * i + 2];
+        rFacets[static_cast<size_t>(index / 3)]._aulPoints[index % 3] =
+            static_cast<PointIndex>(vertex_count - 1);
     }
 
     verts.resize(vertex_count);
@@ -398,5 +410,8 @@ void MeshFastBuilder::Finish()
         rPoints.push_back(MeshPoint(v.x, v.y, v.z));
     }
 
+    // release the memory before the neighbourhood is computed
+    verts = QVector<Private::Vertex>();
+
     _meshKernel.Adopt(rPoints, rFacets, true);
 }
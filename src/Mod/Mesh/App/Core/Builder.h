@@ -212,6 +212,14 @@ public:
      * @param ctFacets count of facets.
      */
     void Initialize(size_type ctFacets);
+    /** Allocates the space for \a ctFacets facets that must be set with SetFacet() instead of
+     * using AddFacet(). This allows to fill in the facets from several threads.
+     */
+    void Resize(size_type ctFacets);
+    /** Sets the points of the facet with index \a index. Can be called from several threads
+     * for different indices.
+     */
+    void SetFacet(size_type index, const Base::Vector3f* facetPoints);
     /** Add new facet
      */
     void AddFacet(const Base::Vector3f* facetPoints);
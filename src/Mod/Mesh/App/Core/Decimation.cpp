@@ -22,10 +22,19 @@
 
 #include "PreCompiled.h"
 #ifndef _PreComp_
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <functional>
 #include <limits>
+#include <queue>
+#include <thread>
 #endif
 
+#include <Base/Converter.h>
+
 #include "Decimation.h"
+#include "Functional.h"
 #include "MeshKernel.h"
 #include "Simplify.h"
 
@@ -155,3 +164,937 @@ void MeshSimplify::simplify(int targetSize)
 
     myKernel.Adopt(new_points, new_facets, true);
 }
+
+// ----------------------------------------------------------------------------
+
+namespace
+{
+
+// The coefficients of the symmetric 4x4 matrix of an error quadric
+using Quadric = std::array<double, 10>;
+
+Quadric planeQuadric(const Base::Vector3d& n, double d, double weight)
+{
+    // clang-format off
+    return {weight * n.x * n.x, weight * n.x * n.y, weight * n.x * n.z, weight * n.x * d,
+                                weight * n.y * n.y, weight * n.y * n.z, weight * n.y * d,
+                                                    weight * n.z * n.z, weight * n.z * d,
+                                                                        weight * d * d};
+    // clang-format on
+}
+
+void addQuadric(Quadric& q, const Quadric& r)
+{
+    for (std::size_t i = 0; i < q.size(); i++) {
+        q[i] += r[i];
+    }
+}
+
+double quadricError(const Quadric& q, const Base::Vector3d& p)
+{
+    // clang-format off
+    return q[0] * p.x * p.x + 2 * q[1] * p.x * p.y + 2 * q[2] * p.x * p.z + 2 * q[3] * p.x
+         + q[4] * p.y * p.y + 2 * q[5] * p.y * p.z + 2 * q[6] * p.y
+         + q[7] * p.z * p.z + 2 * q[8] * p.z
+         + q[9];
+    // clang-format on
+}
+
+// Computes the point with the minimum error of the quadric
+bool quadricMinimum(const Quadric& q, Base::Vector3d& p)
+{
+    // adjugate of the upper left 3x3 matrix
+    double a00 = q[4] * q[7] - q[5] * q[5];
+    double a01 = q[2] * q[5] - q[1] * q[7];
+    double a02 = q[1] * q[5] - q[2] * q[4];
+    double a11 = q[0] * q[7] - q[2] * q[2];
+    double a12 = q[1] * q[2] - q[0] * q[5];
+    double a22 = q[0] * q[4] - q[1] * q[1];
+
+    double det = q[0] * a00 + q[1] * a01 + q[2] * a02;
+    double trace = q[0] + q[4] + q[7];
+    if (std::fabs(det) <= 1e-9 * trace * trace * trace) {
+        return false;
+    }
+
+    p.x = -(a00 * q[3] + a01 * q[6] + a02 * q[8]) / det;
+    p.y = -(a01 * q[3] + a11 * q[6] + a12 * q[8]) / det;
+    p.z = -(a02 * q[3] + a12 * q[6] + a22 * q[8]) / det;
+    return true;
+}
+
+class Decimator
+{
+public:
+    Decimator(const MeshKernel& kernel,
+              float maxError,
+              float featureAngle,
+              bool lockBorders,
+              const std::vector<unsigned long>& segments);
+
+    void Decimate(std::size_t targetSize);
+    void GetResult(MeshPointArray& points,
+                   MeshFacetArray& facets,
+                   std::vector<FacetIndex>& origin) const;
+
+private:
+    // the vertex that is kept, the one that is removed and the new position of the kept one
+    struct Collapse
+    {
+        PointIndex keep {};
+        PointIndex remove {};
+        Base::Vector3f pos;
+    };
+
+    struct Candidate
+    {
+        double cost {};
+        PointIndex a {};
+        PointIndex b {};
+        unsigned int stampA {};
+        unsigned int stampB {};
+
+        bool operator>(const Candidate& other) const
+        {
+            return cost > other.cost;
+        }
+    };
+
+    struct Partition
+    {
+        int index {};
+        std::vector<FacetIndex> facets;
+        // the facets around the points of the partition
+        std::vector<FacetIndex> refs;
+        std::size_t quota {};
+        std::size_t removed {};
+    };
+
+    // the work arrays of a collapse
+    struct Buffers
+    {
+        std::vector<FacetIndex> fanKeep;
+        std::vector<FacetIndex> fanRemove;
+        std::vector<FacetIndex> shared;
+        std::vector<PointIndex> ringKeep;
+        std::vector<PointIndex> ringRemove;
+        // the modified facets for the error check
+        std::vector<FacetIndex> changed;
+        std::vector<MeshGeomFacet> triangles;
+        std::vector<FacetIndex> fan;
+        std::vector<MeshGeomFacet> local;
+    };
+
+    static constexpr int NotOwned = -1;
+    static constexpr int Locked = -2;
+
+    void initFeatures(const MeshKernel& kernel,
+                      float featureAngle,
+                      bool lockBorders,
+                      const std::vector<unsigned long>& segments);
+    void addFeatureEdge(PointIndex a, PointIndex b);
+    bool isFeatureEdge(PointIndex a, PointIndex b) const;
+    void initQuadrics();
+    void buildFans();
+    std::vector<Partition> makePartitions(int pass, std::size_t numParts);
+    void decimatePartition(int index, Partition& part);
+    void addCandidates(int index,
+                       PointIndex pnt,
+                       const Partition& part,
+                       std::priority_queue<Candidate,
+                                           std::vector<Candidate>,
+                                           std::greater<>>& heap) const;
+    bool plan(int index, PointIndex a, PointIndex b, Collapse& col) const;
+    double cost(PointIndex a, PointIndex b, const Collapse& col) const;
+    bool collapse(Partition& part, const Collapse& col, Buffers& buf);
+    void collectFan(const Partition& part, PointIndex pnt, std::vector<FacetIndex>& fan) const;
+    bool checkError(const Partition& part, const Collapse& col, Buffers& buf) const;
+    std::size_t removeDeletedFacets();
+
+private:
+    float _maxError;
+    std::vector<Base::Vector3f> _points;
+    std::vector<Base::Vector3f> _original;
+    std::vector<std::array<PointIndex, 3>> _facets;
+    std::vector<FacetIndex> _origin;
+    std::vector<Base::Vector3f> _normals;
+    std::vector<char> _deleted;
+    // the partition of a facet in the current pass
+    std::vector<int> _facetPart;
+    std::vector<Quadric> _quadrics;
+    std::vector<unsigned int> _stamps;
+    std::vector<int> _owner;
+    // the number of feature edges of a point and the first two of its neighbours along them
+    std::vector<unsigned char> _featureCount;
+    std::vector<std::array<PointIndex, 2>> _featureNeighbours;
+    // linked lists of the original points that are merged into a point
+    std::vector<PointIndex> _chainNext;
+    std::vector<PointIndex> _chainLast;
+    // the facets around a point for the current pass
+    std::vector<std::size_t> _fanStart;
+    std::vector<FacetIndex> _fanFacets;
+    // the position of the facets of a point in the refs array of its partition
+    std::vector<std::size_t> _refStart;
+    std::vector<std::size_t> _refCount;
+    int _axes[2] {0, 1};
+};
+
+Decimator::Decimator(const MeshKernel& kernel,
+                     float maxError,
+                     float featureAngle,
+                     bool lockBorders,
+                     const std::vector<unsigned long>& segments)
+    : _maxError(maxError)
+{
+    const MeshPointArray& points = kernel.GetPoints();
+    const MeshFacetArray& facets = kernel.GetFacets();
+
+    _points.reserve(points.size());
+    for (const auto& pnt : points) {
+        _points.push_back(pnt);
+    }
+
+    _facets.reserve(facets.size());
+    for (const auto& face : facets) {
+        _facets.push_back({face._aulPoints[0], face._aulPoints[1], face._aulPoints[2]});
+    }
+
+    _origin.resize(facets.size());
+    for (std::size_t i = 0; i < _origin.size(); i++) {
+        _origin[i] = static_cast<FacetIndex>(i);
+    }
+
+    std::size_t numPoints = points.size();
+    _deleted.resize(facets.size(), 0);
+    _stamps.resize(numPoints, 0);
+    _owner.resize(numPoints, NotOwned);
+    _refStart.resize(numPoints, 0);
+    _refCount.resize(numPoints, 0);
+
+    if (_maxError > 0.0F) {
+        _original = _points;
+        _chainNext.resize(numPoints, POINT_INDEX_MAX);
+        _chainLast.resize(numPoints);
+        for (std::size_t i = 0; i < numPoints; i++) {
+            _chainLast[i] = static_cast<PointIndex>(i);
+        }
+    }
+
+    // the partitions are made along the two longest axes of the bounding box
+    Base::BoundBox3f box = kernel.GetBoundBox();
+    std::array<float, 3> length = {box.LengthX(), box.LengthY(), box.LengthZ()};
+    std::array<int, 3> axes = {0, 1, 2};
+    std::sort(axes.begin(), axes.end(), [&length](int a, int b) {
+        return length[a] > length[b];
+    });
+    _axes[0] = axes[0];
+    _axes[1] = axes[1];
+
+    initFeatures(kernel, featureAngle, lockBorders, segments);
+    buildFans();
+    initQuadrics();
+}
+
+void Decimator::addFeatureEdge(PointIndex a, PointIndex b)
+{
+    for (auto [p, q] : {std::make_pair(a, b), std::make_pair(b, a)}) {
+        unsigned char& count = _featureCount[p];
+        if (count < 2) {
+            _featureNeighbours[p][count] = q;
+        }
+        if (count < std::numeric_limits<unsigned char>::max()) {
+            count++;
+        }
+    }
+}
+
+bool Decimator::isFeatureEdge(PointIndex a, PointIndex b) const
+{
+    auto hasNeighbour = [this](PointIndex p, PointIndex q) {
+        return _featureCount[p] == 2
+            && (_featureNeighbours[p][0] == q || _featureNeighbours[p][1] == q);
+    };
+
+    return hasNeighbour(a, b) || hasNeighbour(b, a);
+}
+
+void Decimator::initFeatures(const MeshKernel& kernel,
+                             float featureAngle,
+                             bool lockBorders,
+                             const std::vector<unsigned long>& segments)
+{
+    _featureCount.resize(_points.size(), 0);
+    _featureNeighbours.resize(_points.size());
+
+    const MeshFacetArray& facets = kernel.GetFacets();
+    _normals.resize(facets.size());
+    MeshCore::parallel_for(facets.size(), 10000, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            _normals[i] = kernel.GetFacet(static_cast<FacetIndex>(i)).GetNormal();
+        }
+    });
+
+    float cosAngle = std::cos(featureAngle);
+    for (std::size_t i = 0; i < facets.size(); i++) {
+        const MeshFacet& face = facets[i];
+        for (int j = 0; j < 3; j++) {
+            FacetIndex n = face._aulNeighbours[j];
+            // open and non-manifold edges have no neighbour
+            bool feature = (n == FACET_INDEX_MAX);
+            if (!feature && n < i) {
+                continue;  // already handled
+            }
+            if (!feature && featureAngle > 0.0F) {
+                feature = _normals[i].Dot(_normals[n]) < cosAngle;
+            }
+            if (!feature && !segments.empty()) {
+                feature = segments[i] != segments[n];
+            }
+            if (feature) {
+                addFeatureEdge(face._aulPoints[j], face._aulPoints[(j + 1) % 3]);
+            }
+            // locked points are handled like corners of feature lines
+            if (lockBorders && n == FACET_INDEX_MAX) {
+                _featureCount[face._aulPoints[j]] = std::numeric_limits<unsigned char>::max();
+                _featureCount[face._aulPoints[(j + 1) % 3]] =
+                    std::numeric_limits<unsigned char>::max();
+            }
+        }
+    }
+}
+
+void Decimator::buildFans()
+{
+    _fanStart.assign(_points.size() + 1, 0);
+    for (const auto& face : _facets) {
+        for (PointIndex p : face) {
+            _fanStart[p + 1]++;
+        }
+    }
+    for (std::size_t i = 1; i < _fanStart.size(); i++) {
+        _fanStart[i] += _fanStart[i - 1];
+    }
+
+    _fanFacets.resize(_fanStart.back());
+    std::vector<std::size_t> pos(_fanStart.begin(), _fanStart.end() - 1);
+    for (std::size_t i = 0; i < _facets.size(); i++) {
+        for (PointIndex p : _facets[i]) {
+            _fanFacets[pos[p]++] = static_cast<FacetIndex>(i);
+        }
+    }
+}
+
+void Decimator::initQuadrics()
+{
+    // area weighted quadrics of the planes of the facets around a point
+    _quadrics.resize(_points.size());
+    MeshCore::parallel_for(_points.size(), 10000, [this](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            Quadric q {};
+            for (std::size_t k = _fanStart[i]; k < _fanStart[i + 1]; k++) {
+                const auto& face = _facets[_fanFacets[k]];
+                Base::Vector3d p0 = Base::convertTo<Base::Vector3d>(_points[face[0]]);
+                Base::Vector3d p1 = Base::convertTo<Base::Vector3d>(_points[face[1]]);
+                Base::Vector3d p2 = Base::convertTo<Base::Vector3d>(_points[face[2]]);
+                Base::Vector3d n = (p1 - p0).Cross(p2 - p0);
+                double length = n.Length();
+                if (length > 0.0) {
+                    n /= length;
+                    addQuadric(q, planeQuadric(n, -n.Dot(p0), 0.5 * length));
+                }
+            }
+            _quadrics[i] = q;
+        }
+    });
+}
+
+std::vector<Decimator::Partition> Decimator::makePartitions(int pass, std::size_t numParts)
+{
+    // balanced partitions along one axis that are shifted by half a partition in every second
+    // pass, so that the points locked in one pass can be removed in the next one
+    int axis = _axes[(pass / 2) % 2];
+    std::vector<float> keys(_facets.size());
+    MeshCore::parallel_for(_facets.size(), 10000, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            const auto& face = _facets[i];
+            keys[i] = _points[face[0]][axis] + _points[face[1]][axis] + _points[face[2]][axis];
+        }
+    });
+
+    std::vector<float> splits;
+    if (numParts > 1) {
+        std::vector<float> sorted(keys);
+        int threads = static_cast<int>(std::thread::hardware_concurrency());
+        MeshCore::parallel_sort(sorted.begin(), sorted.end(), std::less<>(), threads);
+        double shift = (pass % 2) * 0.5;
+        for (std::size_t i = 1; i < numParts; i++) {
+            auto pos = static_cast<std::size_t>((double(i) - shift) * sorted.size() / numParts);
+            splits.push_back(sorted[std::min(pos, sorted.size() - 1)]);
+        }
+    }
+
+    std::vector<Partition> parts(numParts);
+    for (std::size_t i = 0; i < numParts; i++) {
+        parts[i].index = static_cast<int>(i);
+    }
+    std::fill(_owner.begin(), _owner.end(), NotOwned);
+    _facetPart.resize(_facets.size());
+    for (std::size_t i = 0; i < _facets.size(); i++) {
+        auto index = static_cast<int>(std::upper_bound(splits.begin(), splits.end(), keys[i])
+                                      - splits.begin());
+        parts[index].facets.push_back(static_cast<FacetIndex>(i));
+        _facetPart[i] = index;
+        for (PointIndex p : _facets[i]) {
+            int& owner = _owner[p];
+            if (owner == NotOwned) {
+                owner = index;
+            }
+            else if (owner != index) {
+                owner = Locked;
+            }
+        }
+    }
+
+    return parts;
+}
+
+void Decimator::collectFan(const Partition& part,
+                           PointIndex pnt,
+                           std::vector<FacetIndex>& fan) const
+{
+    fan.clear();
+    for (std::size_t k = 0; k < _refCount[pnt]; k++) {
+        FacetIndex f = part.refs[_refStart[pnt] + k];
+        if (!_deleted[f]) {
+            fan.push_back(f);
+        }
+    }
+
+    // the facets of locked points are still those from the beginning of the pass, but only
+    // those of the own partition may be accessed because the others are modified concurrently
+    if (_refCount[pnt] == 0) {
+        for (std::size_t k = _fanStart[pnt]; k < _fanStart[pnt + 1]; k++) {
+            FacetIndex f = _fanFacets[k];
+            if (_facetPart[f] == part.index && !_deleted[f]) {
+                fan.push_back(f);
+            }
+        }
+    }
+}
+
+bool Decimator::plan(int index, PointIndex a, PointIndex b, Collapse& col) const
+{
+    if (_owner[a] != index || _owner[b] != index) {
+        return false;
+    }
+
+    unsigned char fa = _featureCount[a];
+    unsigned char fb = _featureCount[b];
+    if (fa == 0 && fb == 0) {
+        // free points are moved to the position with the minimum error
+        Quadric q = _quadrics[a];
+        addQuadric(q, _quadrics[b]);
+        Base::Vector3d pa = Base::convertTo<Base::Vector3d>(_points[a]);
+        Base::Vector3d pb = Base::convertTo<Base::Vector3d>(_points[b]);
+        Base::Vector3d mid = (pa + pb) / 2.0;
+        Base::Vector3d pos;
+        if (!quadricMinimum(q, pos) || Base::Distance(pos, mid) > Base::Distance(pa, pb)) {
+            pos = mid;
+            for (const auto& it : {pa, pb}) {
+                if (quadricError(q, it) < quadricError(q, pos)) {
+                    pos = it;
+                }
+            }
+        }
+
+        col.keep = a;
+        col.remove = b;
+        col.pos = Base::convertTo<Base::Vector3f>(pos);
+        return true;
+    }
+
+    if (fa == 0 || fb == 0) {
+        // a free point is moved onto a feature point
+        col.keep = fa == 0 ? b : a;
+        col.remove = fa == 0 ? a : b;
+        col.pos = _points[col.keep];
+        return true;
+    }
+
+    // a point on a feature line can only be moved along the line
+    if (!isFeatureEdge(a, b)) {
+        return false;
+    }
+
+    if (fb == 2) {
+        col.keep = a;
+        col.remove = b;
+    }
+    else if (fa == 2) {
+        col.keep = b;
+        col.remove = a;
+    }
+    else {
+        return false;  // corners and ends of feature lines are kept
+    }
+
+    // the next point along the line gets a new neighbour
+    const auto& nb = _featureNeighbours[col.remove];
+    PointIndex next = nb[0] == col.keep ? nb[1] : nb[0];
+    if (next == col.keep || _owner[next] != index) {
+        return false;
+    }
+
+    // keep the corners of feature lines
+    Base::Vector3f dir1 = _points[col.remove] - _points[col.keep];
+    Base::Vector3f dir2 = _points[next] - _points[col.remove];
+    constexpr float minCosine = 0.9F;
+    if (dir1.Dot(dir2) <= minCosine * dir1.Length() * dir2.Length()) {
+        return false;
+    }
+
+    col.pos = _points[col.keep];
+    return true;
+}
+
+double Decimator::cost(PointIndex a, PointIndex b, const Collapse& col) const
+{
+    Quadric q = _quadrics[a];
+    addQuadric(q, _quadrics[b]);
+    return quadricError(q, Base::convertTo<Base::Vector3d>(col.pos));
+}
+
+bool Decimator::checkError(const Partition& part, const Collapse& col, Buffers& buf) const
+{
+    auto isShared = [&buf](FacetIndex f) {
+        return std::find(buf.shared.begin(), buf.shared.end(), f) != buf.shared.end();
+    };
+
+    // the facets around both points after the collapse
+    buf.changed.clear();
+    buf.triangles.clear();
+    for (const auto& fan : {std::cref(buf.fanKeep), std::cref(buf.fanRemove)}) {
+        for (FacetIndex f : fan.get()) {
+            if (isShared(f)) {
+                continue;
+            }
+            MeshGeomFacet triangle;
+            for (int j = 0; j < 3; j++) {
+                PointIndex p = _facets[f][j];
+                bool moved = (p == col.keep || p == col.remove);
+                triangle._aclPoints[j] = moved ? col.pos : _points[p];
+            }
+            buf.changed.push_back(f);
+            buf.triangles.push_back(triangle);
+        }
+    }
+
+    if (buf.triangles.empty()) {
+        return false;
+    }
+
+    auto isNear = [this](PointIndex start, const std::vector<MeshGeomFacet>& triangles) {
+        for (PointIndex p = start; p != POINT_INDEX_MAX; p = _chainNext[p]) {
+            const Base::Vector3f& pnt = _original[p];
+            bool near = std::any_of(triangles.begin(),
+                                    triangles.end(),
+                                    [this, &pnt](const MeshGeomFacet& triangle) {
+                                        return triangle.DistanceToPoint(pnt) <= _maxError;
+                                    });
+            if (!near) {
+                return false;
+            }
+        }
+        return true;
+    };
+
+    // all original points merged into both points must be close to the new facets
+    if (!isNear(col.keep, buf.triangles) || !isNear(col.remove, buf.triangles)) {
+        return false;
+    }
+
+    // the same applies to the neighbours because their facets are modified, too
+    for (const auto& ring : {std::cref(buf.ringKeep), std::cref(buf.ringRemove)}) {
+        for (PointIndex pnt : ring.get()) {
+            if (pnt == col.remove
+                || (_chainNext[pnt] == POINT_INDEX_MAX && _points[pnt] == _original[pnt])) {
+                continue;
+            }
+
+            buf.local.clear();
+            collectFan(part, pnt, buf.fan);
+            for (FacetIndex f : buf.fan) {
+                auto it = std::find(buf.changed.begin(), buf.changed.end(), f);
+                if (it != buf.changed.end()) {
+                    buf.local.push_back(buf.triangles[it - buf.changed.begin()]);
+                }
+                else if (!isShared(f)) {
+                    const auto& face = _facets[f];
+                    buf.local.emplace_back(_points[face[0]], _points[face[1]], _points[face[2]]);
+                }
+            }
+            if (!isNear(pnt, buf.local)) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+bool Decimator::collapse(Partition& part, const Collapse& col, Buffers& buf)
+{
+    PointIndex keep = col.keep;
+    PointIndex remove = col.remove;
+    collectFan(part, keep, buf.fanKeep);
+    collectFan(part, remove, buf.fanRemove);
+
+    buf.shared.clear();
+    for (FacetIndex f : buf.fanRemove) {
+        const auto& face = _facets[f];
+        if (face[0] == keep || face[1] == keep || face[2] == keep) {
+            buf.shared.push_back(f);
+        }
+    }
+
+    // the edge doesn't exist any more
+    if (buf.shared.empty()) {
+        return false;
+    }
+
+    // do not collapse small closed parts
+    std::size_t numFacets = buf.fanKeep.size() + buf.fanRemove.size() - 2 * buf.shared.size();
+    if (numFacets < 3 && buf.shared.size() > 1) {
+        return false;
+    }
+
+    // link condition: the only common neighbours of both points are the opposite points of
+    // the shared facets, otherwise the collapse creates non-manifolds
+    auto collectRing = [this](const std::vector<FacetIndex>& fan,
+                              PointIndex center,
+                              std::vector<PointIndex>& ring) {
+        ring.clear();
+        for (FacetIndex f : fan) {
+            for (PointIndex p : _facets[f]) {
+                if (p != center) {
+                    ring.push_back(p);
+                }
+            }
+        }
+        std::sort(ring.begin(), ring.end());
+        ring.erase(std::unique(ring.begin(), ring.end()), ring.end());
+    };
+    collectRing(buf.fanKeep, keep, buf.ringKeep);
+    collectRing(buf.fanRemove, remove, buf.ringRemove);
+
+    std::size_t common = 0;
+    std::vector<PointIndex>::const_iterator it = buf.ringKeep.begin();
+    for (PointIndex p : buf.ringRemove) {
+        it = std::lower_bound(it, buf.ringKeep.cend(), p);
+        if (it != buf.ringKeep.end() && *it == p && p != remove) {
+            common++;
+        }
+    }
+    if (common != buf.shared.size()) {
+        return false;
+    }
+
+    // the facets must not flip or become too thin
+    bool moved = col.pos != _points[keep];
+    for (const auto& fan : {std::cref(buf.fanKeep), std::cref(buf.fanRemove)}) {
+        if (!moved && &fan.get() == &buf.fanKeep) {
+            continue;
+        }
+        for (FacetIndex f : fan.get()) {
+            const auto& face = _facets[f];
+            std::array<Base::Vector3f, 3> oldPts;
+            std::array<Base::Vector3f, 3> newPts;
+            int corner = -1;
+            for (int j = 0; j < 3; j++) {
+                oldPts[j] = _points[face[j]];
+                newPts[j] = oldPts[j];
+                if (face[j] == keep || face[j] == remove) {
+                    if (corner >= 0) {
+                        corner = -2;  // shared facet
+                    }
+                    else {
+                        corner = j;
+                    }
+                    newPts[j] = col.pos;
+                }
+            }
+            if (corner < 0) {
+                continue;
+            }
+
+            Base::Vector3f e1 = newPts[(corner + 1) % 3] - newPts[corner];
+            Base::Vector3f e2 = newPts[(corner + 2) % 3] - newPts[corner];
+            Base::Vector3f n1 = e1 % e2;
+            Base::Vector3f d1 = oldPts[(corner + 1) % 3] - oldPts[corner];
+            Base::Vector3f d2 = oldPts[(corner + 2) % 3] - oldPts[corner];
+            Base::Vector3f n0 = d1 % d2;
+            // nearly collinear edges unless the facet already was that thin, but it must
+            // never get thinner
+            constexpr float minSine = 0.0447F;
+            float sine = n1.Length() / (e1.Length() * e2.Length());
+            float oldSine = n0.Length() / (d1.Length() * d2.Length());
+            if (!(sine > minSine) && !(sine >= 0.99F * oldSine && sine > 0.01F * minSine)) {
+                return false;
+            }
+            // compared with the original facet as well to avoid folds by many small rotations
+            constexpr float minCosine = 0.2F;
+            if (n0.Dot(n1) <= minCosine * n0.Length() * n1.Length()
+                || _normals[_origin[f]].Dot(n1) <= 0.0F) {
+                return false;
+            }
+        }
+    }
+
+    if (_maxError > 0.0F && !checkError(part, col, buf)) {
+        return false;
+    }
+
+    // now the collapse is done
+    for (FacetIndex f : buf.shared) {
+        _deleted[f] = 1;
+    }
+    part.removed += buf.shared.size();
+
+    std::size_t start = part.refs.size();
+    for (FacetIndex f : buf.fanKeep) {
+        if (!_deleted[f]) {
+            part.refs.push_back(f);
+        }
+    }
+    for (FacetIndex f : buf.fanRemove) {
+        if (!_deleted[f]) {
+            for (PointIndex& p : _facets[f]) {
+                if (p == remove) {
+                    p = keep;
+                }
+            }
+            part.refs.push_back(f);
+        }
+    }
+    _refStart[keep] = start;
+    _refCount[keep] = part.refs.size() - start;
+    _refCount[remove] = 0;
+
+    _points[keep] = col.pos;
+    addQuadric(_quadrics[keep], _quadrics[remove]);
+
+    if (_featureCount[remove] == 2) {
+        auto& nb = _featureNeighbours[remove];
+        PointIndex next = nb[0] == keep ? nb[1] : nb[0];
+        for (auto& [p, q] : {std::make_pair(keep, next), std::make_pair(next, keep)}) {
+            auto& pnb = _featureNeighbours[p];
+            if (_featureCount[p] <= 2) {
+                std::replace(pnb.begin(), pnb.end(), remove, q);
+            }
+        }
+    }
+
+    if (!_chainNext.empty()) {
+        _chainNext[_chainLast[keep]] = remove;
+        _chainLast[keep] = _chainLast[remove];
+    }
+
+    _stamps[keep]++;
+    _stamps[remove]++;
+    _owner[remove] = NotOwned;
+    return true;
+}
+
+void Decimator::addCandidates(
+    int index,
+    PointIndex pnt,
+    const Partition& part,
+    std::priority_queue<Candidate, std::vector<Candidate>, std::greater<>>& heap) const
+{
+    for (std::size_t k = 0; k < _refCount[pnt]; k++) {
+        FacetIndex f = part.refs[_refStart[pnt] + k];
+        if (_deleted[f]) {
+            continue;
+        }
+        for (PointIndex other : _facets[f]) {
+            Collapse col;
+            if (other != pnt && plan(index, pnt, other, col)) {
+                heap.push({cost(pnt, other, col), pnt, other, _stamps[pnt], _stamps[other]});
+            }
+        }
+    }
+}
+
+void Decimator::decimatePartition(int index, Partition& part)
+{
+    // copy the facets around the points of the partition
+    std::vector<std::pair<PointIndex, PointIndex>> edges;
+    for (FacetIndex f : part.facets) {
+        const auto& face = _facets[f];
+        for (int j = 0; j < 3; j++) {
+            PointIndex a = face[j];
+            PointIndex b = face[(j + 1) % 3];
+            if (_owner[a] == index && _refCount[a] == 0) {
+                _refStart[a] = part.refs.size();
+                _refCount[a] = _fanStart[a + 1] - _fanStart[a];
+                part.refs.insert(part.refs.end(),
+                                 _fanFacets.begin() + _fanStart[a],
+                                 _fanFacets.begin() + _fanStart[a + 1]);
+            }
+            if (_owner[a] == index && _owner[b] == index) {
+                edges.emplace_back(std::min(a, b), std::max(a, b));
+            }
+        }
+    }
+
+    std::sort(edges.begin(), edges.end());
+    edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+
+    std::vector<Candidate> candidates;
+    candidates.reserve(edges.size());
+    for (const auto& [a, b] : edges) {
+        Collapse col;
+        if (plan(index, a, b, col)) {
+            candidates.push_back({cost(a, b, col), a, b, _stamps[a], _stamps[b]});
+        }
+    }
+    edges = {};
+
+    std::priority_queue<Candidate, std::vector<Candidate>, std::greater<>> heap(
+        std::greater<>(),
+        std::move(candidates));
+
+    Buffers buf;
+    while (part.removed < part.quota && !heap.empty()) {
+        Candidate top = heap.top();
+        heap.pop();
+        if (_stamps[top.a] != top.stampA || _stamps[top.b] != top.stampB) {
+            continue;  // outdated
+        }
+
+        Collapse col;
+        if (!plan(index, top.a, top.b, col)) {
+            continue;
+        }
+        if (collapse(part, col, buf)) {
+            addCandidates(index, col.keep, part, heap);
+        }
+    }
+}
+
+std::size_t Decimator::removeDeletedFacets()
+{
+    std::size_t count = 0;
+    for (std::size_t i = 0; i < _facets.size(); i++) {
+        if (!_deleted[i]) {
+            _facets[count] = _facets[i];
+            _origin[count] = _origin[i];
+            count++;
+        }
+    }
+
+    std::size_t removed = _facets.size() - count;
+    _facets.resize(count);
+    _origin.resize(count);
+    _deleted.assign(count, 0);
+    return removed;
+}
+
+void Decimator::Decimate(std::size_t targetSize)
+{
+    constexpr int maxPasses = 30;
+    constexpr std::size_t minPartitionSize = 5000;
+    std::size_t threads = std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+
+    int idlePasses = 0;
+    for (int pass = 0; pass < maxPasses && _facets.size() > targetSize; pass++) {
+        if (pass > 0) {
+            buildFans();
+        }
+
+        std::size_t numParts = std::min(4 * threads, _facets.size() / minPartitionSize);
+        std::vector<Partition> parts = makePartitions(pass, std::max<std::size_t>(numParts, 1));
+        // at most the half of the facets are removed in one pass because the points on the
+        // borders of the partitions are locked
+        std::size_t excess = std::min(_facets.size() - targetSize, _facets.size() / 2);
+        for (auto& part : parts) {
+            part.quota = (excess * part.facets.size() + _facets.size() - 1) / _facets.size();
+        }
+
+        std::fill(_refCount.begin(), _refCount.end(), 0);
+        MeshCore::parallel_for(parts.size(), 1, [this, &parts](std::size_t begin, std::size_t end) {
+            for (std::size_t i = begin; i < end; i++) {
+                decimatePartition(static_cast<int>(i), parts[i]);
+            }
+        });
+
+        // stop if neither of the two partition layouts allows further collapses
+        if (removeDeletedFacets() == 0) {
+            if (++idlePasses == 2) {
+                break;
+            }
+        }
+        else {
+            idlePasses = 0;
+        }
+    }
+}
+
+void Decimator::GetResult(MeshPointArray& points,
+                          MeshFacetArray& facets,
+                          std::vector<FacetIndex>& origin) const
+{
+    std::vector<PointIndex> index(_points.size(), POINT_INDEX_MAX);
+    for (const auto& face : _facets) {
+        for (PointIndex p : face) {
+            index[p] = 0;
+        }
+    }
+
+    points.clear();
+    for (std::size_t i = 0; i < _points.size(); i++) {
+        if (index[i] == 0) {
+            index[i] = static_cast<PointIndex>(points.size());
+            points.push_back(_points[i]);
+        }
+    }
+
+    facets.clear();
+    facets.reserve(_facets.size());
+    for (const auto& face : _facets) {
+        facets.push_back(MeshFacet(index[face[0]], index[face[1]], index[face[2]]));
+    }
+
+    origin = _origin;
+}
+
+}  // namespace
+
+MeshDecimation::MeshDecimation(MeshKernel& mesh)
+    : _kernel(mesh)
+{}
+
+void MeshDecimation::SetSegments(const std::vector<std::vector<FacetIndex>>& segments)
+{
+    _segments.assign(_kernel.CountFacets(), 0);
+    unsigned long id = 0;
+    for (const auto& segment : segments) {
+        id++;
+        for (FacetIndex f : segment) {
+            if (f < _segments.size()) {
+                _segments[f] = id;
+            }
+        }
+    }
+}
+
+void MeshDecimation::Decimate(std::size_t targetSize)
+{
+    Decimator alg(_kernel, _maxError, _featureAngle, _lockBorders, _segments);
+    alg.Decimate(targetSize);
+
+    MeshPointArray points;
+    MeshFacetArray facets;
+    alg.GetResult(points, facets, _origin);
+    _kernel.Adopt(points, facets, true);
+}
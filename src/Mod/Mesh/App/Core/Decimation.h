@@ -24,8 +24,12 @@
 #ifndef MESH_DECIMATION_H
 #define MESH_DECIMATION_H
 
+#include <vector>
+
 #include <Mod/Mesh/MeshGlobal.h>
 
+#include "Definitions.h"
+
 namespace MeshCore
 {
 class MeshKernel;
@@ -41,6 +45,68 @@ private:
     MeshKernel& myKernel;
 };
 
+/**
+ * The MeshDecimation class reduces the number of facets with quadric based edge collapses
+ * that are done on several threads.
+ *
+ * The mesh is split into spatial partitions of about the same number of facets which are
+ * decimated independently. Points that are shared by several partitions are locked and the
+ * partitions are shifted from pass to pass, so that the locked points can be removed later.
+ *
+ * The open borders of the mesh are handled as feature lines, and optionally the sharp edges and
+ * the boundaries between segments, too. Feature lines are only simplified along themselves,
+ * with SetLockBorders() the points on open borders are kept entirely. Furthermore, the distance
+ * of the removed points to the decimated surface can be limited.
+ */
+class MeshExport MeshDecimation
+{
+public:
+    explicit MeshDecimation(MeshKernel&);
+
+    /** Sets the maximum distance of the removed points to the decimated surface. A value
+     * less than or equal to zero means no limit.
+     */
+    void SetMaxError(float error)
+    {
+        _maxError = error;
+    }
+    /** Edges where the normals of the adjacent facets differ by more than \a angle (in radian)
+     * are kept. A value less than or equal to zero doesn't keep sharp edges.
+     */
+    void SetFeatureAngle(float angle)
+    {
+        _featureAngle = angle;
+    }
+    /** The boundaries between the facets of different segments are kept. */
+    void SetSegments(const std::vector<std::vector<FacetIndex>>& segments);
+    /** If \a on is true the points on open borders keep their position, so that parts of a
+     * mesh that are decimated separately still fit together.
+     */
+    void SetLockBorders(bool on)
+    {
+        _lockBorders = on;
+    }
+    /** Decimates the mesh down to \a targetSize facets. The decimated mesh may have more facets
+     * if the feature lines or the maximum error don't allow further collapses.
+     */
+    void Decimate(std::size_t targetSize);
+    /** Returns for each facet of the decimated mesh the index of the facet of the original mesh
+     * it is derived from.
+     */
+    const std::vector<FacetIndex>& GetOriginalFacets() const
+    {
+        return _origin;
+    }
+
+private:
+    MeshKernel& _kernel;
+    float _maxError {0.0F};
+    float _featureAngle {0.0F};
+    bool _lockBorders {false};
+    std::vector<unsigned long> _segments;
+    std::vector<FacetIndex> _origin;
+};
+
 }  // namespace MeshCore
 
 
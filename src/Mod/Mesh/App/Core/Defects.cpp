@@ -0,0 +1,173 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2025 FreeCAD Project Association                         *
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+#include "PreCompiled.h"
+
+#ifndef _PreComp_
+#include <algorithm>
+#include <future>
+#endif
+
+#include <Base/Sequencer.h>
+
+#include "Defects.h"
+#include "Degeneration.h"
+#include "Functional.h"
+#include "MeshKernel.h"
+
+
+using namespace MeshCore;
+
+namespace
+{
+
+// Runs the given functions concurrently and waits until all of them have finished.
+// The parallel algorithms used by the functions run serially so that the threads
+// aren't nested.
+template<typename... Funcs>
+void runConcurrently(Base::SequencerLauncher& seq, Funcs&&... funcs)
+{
+    std::vector<std::future<void>> tasks;
+    tasks.reserve(sizeof...(funcs));
+    (tasks.push_back(std::async(std::launch::async,
+                                [func = std::forward<Funcs>(funcs)]() mutable {
+                                    SerialScope serial;
+                                    func();
+                                })),
+     ...);
+    for (auto& task : tasks) {
+        task.get();
+        seq.next();
+    }
+}
+
+void removeDuplicates(std::vector<FacetIndex>& indices)
+{
+    std::sort(indices.begin(), indices.end());
+    indices.erase(std::unique(indices.begin(), indices.end()), indices.end());
+}
+
+}  // namespace
+
+bool MeshDefectReport::IsValid() const
+{
+    return facetsOutOfRange.empty() && pointsOutOfRange.empty() && corruptedFacets.empty()
+        && wrongNeighbourhood.empty();
+}
+
+bool MeshDefectReport::IsEmpty() const
+{
+    return IsValid() && invalidPoints.empty() && duplicatedPoints.empty()
+        && duplicatedFacets.empty() && degeneratedFacets.empty() && nonManifolds.empty()
+        && nonManifoldPoints.empty() && wrongOrientation.empty() && selfIntersections.empty()
+        && foldsOnSurface.empty() && foldsOnBoundary.empty();
+}
+
+bool MeshEvalDefects::Evaluate()
+{
+    report = MeshDefectReport();
+
+    // The sequencer of this class is the active one so that the evaluators, which
+    // create their own ones in other threads, don't report any progress.
+    Base::SequencerLauncher seq("Analyzing mesh...", 14);
+    EvaluateStructure(seq);
+    if (report.IsValid()) {
+        EvaluateDefects(seq);
+    }
+
+    return report.IsEmpty();
+}
+
+void MeshEvalDefects::EvaluateStructure(Base::SequencerLauncher& seq)
+{
+    runConcurrently(
+        seq,
+        [this] {
+            report.facetsOutOfRange = MeshEvalRangeFacet(_rclMesh).GetIndices();
+        },
+        [this] {
+            report.pointsOutOfRange = MeshEvalRangePoint(_rclMesh).GetIndices();
+        },
+        [this] {
+            report.corruptedFacets = MeshEvalCorruptedFacets(_rclMesh).GetIndices();
+        });
+
+    // the neighbourhood check relies on valid indices
+    if (report.IsValid()) {
+        report.wrongNeighbourhood = MeshEvalNeighbourhood(_rclMesh).GetIndices();
+    }
+    seq.next();
+}
+
+void MeshEvalDefects::EvaluateDefects(Base::SequencerLauncher& seq)
+{
+    runConcurrently(
+        seq,
+        [this] {
+            report.invalidPoints = MeshEvalNaNPoints(_rclMesh).GetIndices();
+        },
+        [this] {
+            report.duplicatedPoints = MeshEvalDuplicatePoints(_rclMesh).GetIndices();
+        },
+        [this] {
+            report.duplicatedFacets = MeshEvalDuplicateFacets(_rclMesh).GetIndices();
+        },
+        [this] {
+            report.degeneratedFacets = MeshEvalDegeneratedFacets(_rclMesh, fEpsilon).GetIndices();
+        },
+        [this] {
+            MeshEvalTopology eval(_rclMesh);
+            if (!eval.Evaluate()) {
+                eval.GetFacetManifolds(report.nonManifolds);
+                removeDuplicates(report.nonManifolds);
+            }
+        },
+        [this] {
+            MeshEvalPointManifolds eval(_rclMesh);
+            if (!eval.Evaluate()) {
+                eval.GetFacetIndices(report.nonManifoldPoints);
+            }
+        },
+        [this] {
+            report.wrongOrientation = MeshEvalOrientation(_rclMesh).GetIndices();
+        },
+        [this] {
+            MeshEvalSelfIntersection(_rclMesh).GetIntersections(report.selfIntersections);
+        },
+        [this] {
+            MeshEvalFoldsOnSurface s_eval(_rclMesh);
+            MeshEvalFoldOversOnSurface f_eval(_rclMesh);
+            s_eval.Evaluate();
+            f_eval.Evaluate();
+            std::vector<FacetIndex> inds = s_eval.GetIndices();
+            std::vector<FacetIndex> inds1 = f_eval.GetIndices();
+            inds.insert(inds.end(), inds1.begin(), inds1.end());
+            removeDuplicates(inds);
+            report.foldsOnSurface = inds;
+        },
+        [this] {
+            MeshEvalFoldsOnBoundary eval(_rclMesh);
+            eval.Evaluate();
+            report.foldsOnBoundary = eval.GetIndices();
+        });
+}
@@ -0,0 +1,115 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2025 FreeCAD Project Association                         *
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+#ifndef MESH_DEFECTS_H
+#define MESH_DEFECTS_H
+
+#include <utility>
+#include <vector>
+
+#include "Definitions.h"
+#include "Evaluation.h"
+
+
+namespace Base
+{
+class SequencerLauncher;
+}
+
+namespace MeshCore
+{
+
+/**
+ * The MeshDefectReport struct holds the results of all checks of MeshEvalDefects.
+ */
+struct MeshExport MeshDefectReport
+{
+    /** @name Structural errors
+     * If any of these lists is not empty the remaining checks are skipped because they
+     * rely on a consistent data structure.
+     */
+    //@{
+    std::vector<FacetIndex> facetsOutOfRange;   /**< Facets with invalid neighbour indices. */
+    std::vector<FacetIndex> pointsOutOfRange;   /**< Facets with invalid point indices. */
+    std::vector<FacetIndex> corruptedFacets;    /**< Facets referencing a point twice. */
+    std::vector<FacetIndex> wrongNeighbourhood; /**< Facets with inconsistent neighbours. */
+    //@}
+
+    /** @name Defects */
+    //@{
+    std::vector<PointIndex> invalidPoints;     /**< Points with NaN coordinates. */
+    std::vector<PointIndex> duplicatedPoints;  /**< All but the first point of a group. */
+    std::vector<FacetIndex> duplicatedFacets;  /**< All but the first facet of a group. */
+    std::vector<FacetIndex> degeneratedFacets; /**< Facets with no area. */
+    std::vector<FacetIndex> nonManifolds;      /**< Facets at non-manifold edges. */
+    std::vector<FacetIndex> nonManifoldPoints; /**< Facets at non-manifold points. */
+    std::vector<FacetIndex> wrongOrientation;  /**< Facets with a flipped normal. */
+    std::vector<std::pair<FacetIndex, FacetIndex>> selfIntersections;
+    std::vector<FacetIndex> foldsOnSurface;  /**< Folds and fold-overs on the surface. */
+    std::vector<FacetIndex> foldsOnBoundary; /**< Folded boundary facets. */
+    //@}
+
+    /** Returns true if the data structure of the mesh is consistent. */
+    bool IsValid() const;
+    /** Returns true if no check has found anything. */
+    bool IsEmpty() const;
+};
+
+/**
+ * The MeshEvalDefects class runs the evaluations of a mesh that are needed before
+ * repairing it in one go and collects their results in a MeshDefectReport.
+ *
+ * The evaluations don't depend on each other and only read the mesh, so they run
+ * concurrently. The checks for the consistency of the data structure run first and
+ * if they fail the other checks are skipped.
+ */
+class MeshExport MeshEvalDefects: public MeshEvaluation
+{
+public:
+    /** \a fEps is the tolerance used to detect degenerated facets. */
+    explicit MeshEvalDefects(const MeshKernel& rclM,
+                             float fEps = MeshDefinitions::_fMinPointDistanceP2)
+        : MeshEvaluation(rclM)
+        , fEpsilon(fEps)
+    {}
+    /** Runs all checks and returns true if no defects were found. */
+    bool Evaluate() override;
+    /** Returns the results of the last call of Evaluate(). */
+    const MeshDefectReport& GetReport() const
+    {
+        return report;
+    }
+
+private:
+    void EvaluateStructure(Base::SequencerLauncher& seq);
+    void EvaluateDefects(Base::SequencerLauncher& seq);
+
+private:
+    float fEpsilon;
+    MeshDefectReport report;
+};
+
+}  // namespace MeshCore
+
+
+#endif  // MESH_DEFECTS_H
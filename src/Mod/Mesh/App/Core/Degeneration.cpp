@@ -26,11 +26,13 @@
 #include <algorithm>
 #include <map>
 #include <queue>
+#include <thread>
 #endif
 
 #include <boost/math/special_functions/fpclassify.hpp>
 
 #include "Degeneration.h"
+#include "Functional.h"
 #include "Grid.h"
 #include "Iterator.h"
 #include "TopoAlgorithm.h"
@@ -123,6 +125,28 @@ struct Vertex_Less
     }
 };
 
+/*
+ * Sorts the iterators in parallel. Iterators to equal elements are ordered by their
+ * position so that the result is deterministic and the element with the lowest index
+ * comes first.
+ */
+template<class Iter, class Pred>
+void sortByIndex(std::vector<Iter>& items, Pred comp)
+{
+    auto less = [comp](const Iter& x, const Iter& y) {
+        if (comp(x, y)) {
+            return true;
+        }
+        if (comp(y, x)) {
+            return false;
+        }
+        return x < y;
+    };
+
+    int threads = int(available_threads());
+    parallel_sort(items.begin(), items.end(), less, threads);
+}
+
 }  // namespace MeshCore
 
 bool MeshEvalDuplicatePoints::Evaluate()
@@ -137,7 +161,7 @@ bool MeshEvalDuplicatePoints::Evaluate()
     }
 
     // if there are two adjacent vertices which have the same coordinates
-    std::sort(vertices.begin(), vertices.end(), Vertex_Less());
+    sortByIndex(vertices, Vertex_Less());
     return (std::adjacent_find(vertices.begin(), vertices.end(), Vertex_EqualTo())
             == vertices.end());
 }
@@ -145,8 +169,7 @@ bool MeshEvalDuplicatePoints::Evaluate()
 std::vector<PointIndex> MeshEvalDuplicatePoints::GetIndices() const
 {
     // Note: We must neither use map or set to get duplicated indices because
-    // the sort algorithms deliver different results compared to std::sort of
-    // a vector.
+    // the sort algorithms deliver different results compared to sortByIndex().
     const MeshPointArray& rPoints = _rclMesh.GetPoints();
     std::vector<VertexIterator> vertices;
     vertices.reserve(rPoints.size());
@@ -157,7 +180,7 @@ std::vector<PointIndex> MeshEvalDuplicatePoints::GetIndices() const
     // if there are two adjacent vertices which have the same coordinates
     std::vector<PointIndex> aInds;
     Vertex_EqualTo pred;
-    std::sort(vertices.begin(), vertices.end(), Vertex_Less());
+    sortByIndex(vertices, Vertex_Less());
 
     std::vector<VertexIterator>::iterator vt = vertices.begin();
     while (vt < vertices.end()) {
@@ -175,8 +198,7 @@ std::vector<PointIndex> MeshEvalDuplicatePoints::GetIndices() const
 bool MeshFixDuplicatePoints::Fixup()
 {
     // Note: We must neither use map or set to get duplicated indices because
-    // the sort algorithms deliver different results compared to std::sort of
-    // a vector.
+    // the sort algorithms deliver different results compared to sortByIndex().
     const MeshPointArray& rPoints = _rclMesh.GetPoints();
     std::vector<VertexIterator> vertices;
     vertices.reserve(rPoints.size());
@@ -185,7 +207,7 @@ bool MeshFixDuplicatePoints::Fixup()
     }
 
     // get the indices of adjacent vertices which have the same coordinates
-    std::sort(vertices.begin(), vertices.end(), Vertex_Less());
+    sortByIndex(vertices, Vertex_Less());
 
     Vertex_EqualTo pred;
     std::vector<VertexIterator>::iterator next = vertices.begin();
@@ -369,16 +391,16 @@ struct MeshFacet_EqualTo
 
 bool MeshEvalDuplicateFacets::Evaluate()
 {
-    std::set<FaceIterator, MeshFacet_Less> aFaces;
-    const MeshFacetArray& rFaces = _rclMesh.GetFacets();
-    for (auto it = rFaces.begin(); it != rFaces.end(); ++it) {
-        std::pair<std::set<FaceIterator, MeshFacet_Less>::iterator, bool> pI = aFaces.insert(it);
-        if (!pI.second) {
-            return false;
-        }
+    const MeshFacetArray& rFacets = _rclMesh.GetFacets();
+    std::vector<FaceIterator> faces;
+    faces.reserve(rFacets.size());
+    for (MeshFacetArray::_TConstIterator it = rFacets.begin(); it != rFacets.end(); ++it) {
+        faces.push_back(it);
     }
 
-    return true;
+    // if there are two adjacent faces which references the same vertices
+    sortByIndex(faces, MeshFacet_Less());
+    return (std::adjacent_find(faces.begin(), faces.end(), MeshFacet_EqualTo()) == faces.end());
 }
 
 std::vector<FacetIndex> MeshEvalDuplicateFacets::GetIndices() const
@@ -394,7 +416,7 @@ std::vector<FacetIndex> MeshEvalDuplicateFacets::GetIndices() const
     // if there are two adjacent faces which references the same vertices
     std::vector<FacetIndex> aInds;
     MeshFacet_EqualTo pred;
-    std::sort(faces.begin(), faces.end(), MeshFacet_Less());
+    sortByIndex(faces, MeshFacet_Less());
 
     std::vector<FaceIterator>::iterator ft = faces.begin();
     while (ft < faces.end()) {
@@ -427,18 +449,9 @@ std::vector<FacetIndex> MeshEvalDuplicateFacets::GetIndices() const
 
 bool MeshFixDuplicateFacets::Fixup()
 {
-    FacetIndex uIndex = 0;
-    std::vector<FacetIndex> aRemoveFaces;
-    const MeshFacetArray& rFaces = _rclMesh.GetFacets();
-
-    // get all facets
-    std::set<FaceIterator, MeshFacet_Less> aFaceSet;
-    for (auto it = rFaces.begin(); it != rFaces.end(); ++it, uIndex++) {
-        std::pair<std::set<FaceIterator, MeshFacet_Less>::iterator, bool> pI = aFaceSet.insert(it);
-        if (!pI.second) {
-            aRemoveFaces.push_back(uIndex);
-        }
-    }
+    // keeps the facet with the lowest index of each group of duplicates
+    MeshEvalDuplicateFacets eval(_rclMesh);
+    std::vector<FacetIndex> aRemoveFaces = eval.GetIndices();
 
     _rclMesh.DeleteFacets(aRemoveFaces);
     _rclMesh.RebuildNeighbours();  // needs to be done here
@@ -24,6 +24,9 @@
 
 #ifndef _PreComp_
 #include <algorithm>
+#include <atomic>
+#include <future>
+#include <thread>
 #include <vector>
 #endif
 
@@ -65,9 +68,13 @@ bool MeshOrientationVisitor::HasNonUnifomOrientedFacets() const
 }
 
 MeshOrientationCollector::MeshOrientationCollector(std::vector<FacetIndex>& aulIndices,
-                                                   std::vector<FacetIndex>& aulComplement)
+                                                   std::vector<FacetIndex>& aulComplement,
+                                                   const MeshFacetArray& rclFacets,
+                                                   MeshFlagTable& rclWrong)
     : _aulIndices(aulIndices)
     , _aulComplement(aulComplement)
+    , _rclFacets(rclFacets)
+    , _rclWrong(rclWrong)
 {}
 
 bool MeshOrientationCollector::Visit(const MeshFacet& rclFacet,
@@ -76,12 +83,16 @@ bool MeshOrientationCollector::Visit(const MeshFacet& rclFacet,
                                      unsigned long ulLevel)
 {
     (void)ulLevel;
+    // rclFrom is an element of the visited facet array
+    auto from = static_cast<FacetIndex>(&rclFrom - _rclFacets.data());
+    bool fromIsWrong = _rclWrong.IsSet(from);
+
     // different orientation of rclFacet and rclFrom
     if (!rclFacet.HasSameOrientation(rclFrom)) {
         // is not marked as false oriented
-        if (!rclFrom.IsFlag(MeshFacet::TMP0)) {
+        if (!fromIsWrong) {
             // mark this facet as false oriented
-            rclFacet.SetFlag(MeshFacet::TMP0);
+            _rclWrong.Set(ulFInd);
             _aulIndices.push_back(ulFInd);
         }
         else {
@@ -91,9 +102,9 @@ bool MeshOrientationCollector::Visit(const MeshFacet& rclFacet,
     else {
         // same orientation but if the neighbour rclFrom is false oriented
         // then rclFrom is also false oriented
-        if (rclFrom.IsFlag(MeshFacet::TMP0)) {
+        if (fromIsWrong) {
             // mark this facet as false oriented
-            rclFacet.SetFlag(MeshFacet::TMP0);
+            _rclWrong.Set(ulFInd);
             _aulIndices.push_back(ulFInd);
         }
         else {
@@ -152,10 +163,11 @@ bool MeshEvalOrientation::Evaluate()
     return true;
 }
 
-unsigned long MeshEvalOrientation::HasFalsePositives(const std::vector<FacetIndex>& inds) const
+unsigned long MeshEvalOrientation::HasFalsePositives(const std::vector<FacetIndex>& inds,
+                                                     const MeshFlagTable& wrong) const
 {
     // All faces with wrong orientation (i.e. adjacent faces with a normal flip and their
-    // neighbours) build a segment and are marked as TMP0. Now we check all border faces of the
+    // neighbours) build a segment and are marked in 'wrong'. Now we check all border faces of the
     // segments with their correct neighbours if there was really a normal flip. If there is no
     // normal flip we have a false positive. False-positives can occur if the mesh structure has
     // some defects which let the region-grow algorithm fail to detect the faces with wrong
@@ -167,7 +179,7 @@ unsigned long MeshEvalOrientation::HasFalsePositives(const std::vector<FacetInde
         for (FacetIndex nbIndex : f._aulNeighbours) {
             if (nbIndex != FACET_INDEX_MAX) {
                 const MeshFacet& n = iBeg[nbIndex];
-                if (f.IsFlag(MeshFacet::TMP0) && !n.IsFlag(MeshFacet::TMP0)) {
+                if (wrong.IsSet(it) && !wrong.IsSet(nbIndex)) {
                     for (int j = 0; j < 3; j++) {
                         if (f.HasSameOrientation(n)) {
                             // adjacent face with same orientation => false positive
@@ -190,27 +202,22 @@ std::vector<FacetIndex> MeshEvalOrientation::GetIndices() const
         return {};
     }
 
-    // reset VISIT flags
-    MeshAlgorithm cAlg(_rclMesh);
-    cAlg.ResetFacetFlag(MeshFacet::VISIT);
-    cAlg.ResetFacetFlag(MeshFacet::TMP0);
-
+    // the mesh itself is not modified, the state of the algorithm is kept in flag tables
     const MeshFacetArray& rFAry = _rclMesh.GetFacets();
-    MeshFacetArray::_TConstIterator iTri = rFAry.begin();
-    MeshFacetArray::_TConstIterator iBeg = rFAry.begin();
-    MeshFacetArray::_TConstIterator iEnd = rFAry.end();
+    MeshFlagTable visited(rFAry.size());
+    MeshFlagTable wrong(rFAry.size());
 
     ulStartFacet = 0;
 
     std::vector<FacetIndex> uIndices, uComplement;
-    MeshOrientationCollector clHarmonizer(uIndices, uComplement);
+    MeshOrientationCollector clHarmonizer(uIndices, uComplement, rFAry, wrong);
 
     while (ulStartFacet != FACET_INDEX_MAX) {
         unsigned long wrongFacets = uIndices.size();
 
         uComplement.clear();
         uComplement.push_back(ulStartFacet);
-        ulVisited = _rclMesh.VisitNeighbourFacets(clHarmonizer, ulStartFacet) + 1;
+        ulVisited = _rclMesh.VisitNeighbourFacets(clHarmonizer, ulStartFacet, visited) + 1;
 
         // In the currently visited component we have found less than 40% as correct
         // oriented and the rest as false oriented. So, we decide that it should be the other
@@ -221,31 +228,21 @@ std::vector<FacetIndex> MeshEvalOrientation::GetIndices() const
         }
 
         // if the mesh consists of several topologic independent components
-        // We can search from position 'iTri' on because all elements _before_ are already visited
-        // what we know from the previous iteration.
-        MeshIsNotFlag<MeshFacet> flag;
-        iTri = std::find_if(iTri, iEnd, [flag](const MeshFacet& f) {
-            return flag(f, MeshFacet::VISIT);
-        });
-
-        if (iTri < iEnd) {
-            ulStartFacet = iTri - iBeg;
-        }
-        else {
-            ulStartFacet = FACET_INDEX_MAX;
-        }
+        // We can search from position 'ulStartFacet' on because all elements _before_ are
+        // already visited what we know from the previous iteration.
+        ulStartFacet = visited.FindFirstUnset(ulStartFacet);
     }
 
     // in some very rare cases where we have some strange artifacts in the mesh structure
     // we get false-positives. If we find some we check all 'invalid' faces again
-    cAlg.ResetFacetFlag(MeshFacet::TMP0);
-    cAlg.SetFacetsFlag(uIndices, MeshFacet::TMP0);
-    ulStartFacet = HasFalsePositives(uIndices);
+    wrong.Reset();
+    wrong.Set(uIndices);
+    ulStartFacet = HasFalsePositives(uIndices, wrong);
     while (ulStartFacet != FACET_INDEX_MAX) {
-        cAlg.ResetFacetsFlag(uIndices, MeshFacet::VISIT);
+        visited.Unset(uIndices);
         std::vector<FacetIndex> falsePos;
         MeshSameOrientationCollector coll(falsePos);
-        _rclMesh.VisitNeighbourFacets(coll, ulStartFacet);
+        _rclMesh.VisitNeighbourFacets(coll, ulStartFacet, visited);
 
         std::sort(uIndices.begin(), uIndices.end());
         std::sort(falsePos.begin(), falsePos.end());
@@ -259,10 +256,10 @@ std::vector<FacetIndex> MeshEvalOrientation::GetIndices() const
                             biit);
         uIndices = diff;
 
-        cAlg.ResetFacetFlag(MeshFacet::TMP0);
-        cAlg.SetFacetsFlag(uIndices, MeshFacet::TMP0);
+        wrong.Reset();
+        wrong.Set(uIndices);
         FacetIndex current = ulStartFacet;
-        ulStartFacet = HasFalsePositives(uIndices);
+        ulStartFacet = HasFalsePositives(uIndices, wrong);
         if (current == ulStartFacet) {
             break;  // avoid an endless loop
         }
@@ -357,7 +354,8 @@ bool MeshEvalTopology::Evaluate()
     }
 
     // sort the edges
-    std::sort(edges.begin(), edges.end(), Edge_Less());
+    int threads = int(MeshCore::available_threads());
+    MeshCore::parallel_sort(edges.begin(), edges.end(), Edge_Less(), threads);
 
     // search for non-manifold edges
     PointIndex p0 = POINT_INDEX_MAX, p1 = POINT_INDEX_MAX;
@@ -597,81 +595,162 @@ bool MeshFixSingleFacet::Fixup()
 
 // ----------------------------------------------------------------
 
-bool MeshEvalSelfIntersection::Evaluate()
+namespace
 {
-    // Contains bounding boxes for every facet
-    std::vector<Base::BoundBox3f> boxes;
 
-    // Splits the mesh using grid for speeding up the calculation
-    MeshFacetGrid cMeshFacetGrid(_rclMesh);
-    const MeshFacetArray& rFaces = _rclMesh.GetFacets();
-    MeshGridIterator clGridIter(cMeshFacetGrid);
-    unsigned long ulGridX {}, ulGridY {}, ulGridZ {};
-    cMeshFacetGrid.GetCtGrids(ulGridX, ulGridY, ulGridZ);
+using FacetPairs = std::vector<std::pair<FacetIndex, FacetIndex>>;
 
-    MeshFacetIterator cMFI(_rclMesh);
-    for (cMFI.Begin(); cMFI.More(); cMFI.Next()) {
-        boxes.push_back((*cMFI).GetBoundBox());
+bool shareCommonVertex(const MeshFacet& rface1, const MeshFacet& rface2)
+{
+    for (PointIndex p1 : rface1._aulPoints) {
+        for (PointIndex p2 : rface2._aulPoints) {
+            if (p1 == p2) {
+                return true;
+            }
+        }
     }
+    return false;
+}
 
-    // Calculates the intersections
-    Base::SequencerLauncher seq("Checking for self-intersections...", ulGridX * ulGridY * ulGridZ);
-    for (clGridIter.Init(); clGridIter.More(); clGridIter.Next()) {
-        // Get the facet indices, belonging to the current grid unit
-        std::vector<FacetIndex> aulGridElements;
-        clGridIter.GetElements(aulGridElements);
+// Checks the facets of the grid cells [begin, end) for intersections. If 'pairs' is
+// null the search stops at the first intersection, otherwise all of them are collected.
+// 'stop' is polled to cancel the search from another thread.
+bool intersectCells(const MeshKernel& rclMesh,
+                    const MeshFacetGrid& rclGrid,
+                    const std::vector<Base::BoundBox3f>& boxes,
+                    std::size_t begin,
+                    std::size_t end,
+                    FacetPairs* pairs,
+                    const std::atomic<bool>& stop)
+{
+    const MeshFacetArray& rFaces = rclMesh.GetFacets();
+    unsigned long ulGridX {}, ulGridY {}, ulGridZ {};
+    rclGrid.GetCtGrids(ulGridX, ulGridY, ulGridZ);
 
-        seq.next();
-        if (aulGridElements.empty()) {
-            continue;
+    bool found = false;
+    MeshGeomFacet facet1, facet2;
+    Base::Vector3f pt1, pt2;
+    for (std::size_t cell = begin; cell < end; cell++) {
+        if (stop) {
+            break;
         }
 
-        MeshGeomFacet facet1, facet2;
-        Base::Vector3f pt1, pt2;
-        for (auto it = aulGridElements.begin(); it != aulGridElements.end(); ++it) {
+        unsigned long ulX = cell % ulGridX;
+        unsigned long ulY = (cell / ulGridX) % ulGridY;
+        unsigned long ulZ = cell / (ulGridX * ulGridY);
+        auto elements = rclGrid.GetCell(ulX, ulY, ulZ);
+        for (auto it = elements.begin(); it != elements.end(); ++it) {
             const Base::BoundBox3f& box1 = boxes[*it];
-            cMFI.Set(*it);
-            facet1 = *cMFI;
             const MeshFacet& rface1 = rFaces[*it];
-            for (auto jt = it; jt != aulGridElements.end(); ++jt) {
-                if (jt == it) {  // the identical facet
-                    continue;
-                }
+            facet1 = rclMesh.GetFacet(rface1);
+            for (auto jt = it + 1; jt != elements.end(); ++jt) {
                 // If the facets share a common vertex we do not check for self-intersections
                 // because they could but usually do not intersect each other and the algorithm
                 // below would detect false-positives, otherwise
                 const MeshFacet& rface2 = rFaces[*jt];
-                if (rface1._aulPoints[0] == rface2._aulPoints[0]
-                    || rface1._aulPoints[0] == rface2._aulPoints[1]
-                    || rface1._aulPoints[0] == rface2._aulPoints[2]) {
-                    continue;  // ignore facets sharing a common vertex
-                }
-                if (rface1._aulPoints[1] == rface2._aulPoints[0]
-                    || rface1._aulPoints[1] == rface2._aulPoints[1]
-                    || rface1._aulPoints[1] == rface2._aulPoints[2]) {
-                    continue;  // ignore facets sharing a common vertex
-                }
-                if (rface1._aulPoints[2] == rface2._aulPoints[0]
-                    || rface1._aulPoints[2] == rface2._aulPoints[1]
-                    || rface1._aulPoints[2] == rface2._aulPoints[2]) {
-                    continue;  // ignore facets sharing a common vertex
+                if (shareCommonVertex(rface1, rface2)) {
+                    continue;
                 }
 
                 const Base::BoundBox3f& box2 = boxes[*jt];
                 if (box1 && box2) {
-                    cMFI.Set(*jt);
-                    facet2 = *cMFI;
+                    facet2 = rclMesh.GetFacet(rface2);
                     int ret = facet1.IntersectWithFacet(facet2, pt1, pt2);
                     if (ret == 2) {
-                        // abort after the first detected self-intersection
-                        return false;
+                        found = true;
+                        if (!pairs) {
+                            return true;
+                        }
+                        pairs->emplace_back(*it, *jt);
                     }
                 }
             }
         }
     }
 
-    return true;
+    return found;
+}
+
+// Searches the mesh for self-intersections. The grid cells are split into ranges that
+// are checked in parallel, the collected pairs are in the same order as if the cells
+// were processed one after another.
+bool findSelfIntersections(const MeshKernel& rclMesh, FacetPairs* pairs)
+{
+    // Splits the mesh using grid for speeding up the calculation
+    MeshFacetGrid cMeshFacetGrid(rclMesh);
+    unsigned long ulGridX {}, ulGridY {}, ulGridZ {};
+    cMeshFacetGrid.GetCtGrids(ulGridX, ulGridY, ulGridZ);
+    std::size_t numCells = std::size_t(ulGridX) * ulGridY * ulGridZ;
+
+    // Contains bounding boxes for every facet
+    const MeshFacetArray& rFaces = rclMesh.GetFacets();
+    std::vector<Base::BoundBox3f> boxes;
+    boxes.reserve(rFaces.size());
+    for (const auto& face : rFaces) {
+        boxes.push_back(rclMesh.GetFacet(face).GetBoundBox());
+    }
+
+    // the density of the cells varies a lot, so use more ranges than threads
+    std::size_t numThreads = available_threads();
+    std::size_t numRanges = std::min<std::size_t>(numCells, 4 * numThreads);
+    if (numThreads == 1 || rFaces.size() < 10000) {
+        numRanges = std::min<std::size_t>(numCells, 1);
+    }
+
+    std::atomic<bool> stop {false};
+    std::vector<FacetPairs> partial(numRanges);
+    std::vector<std::future<bool>> tasks;
+    tasks.reserve(numRanges);
+    for (std::size_t i = 0; i < numRanges; i++) {
+        std::size_t begin = numCells * i / numRanges;
+        std::size_t end = numCells * (i + 1) / numRanges;
+        FacetPairs* result = pairs ? &partial[i] : nullptr;
+        tasks.push_back(std::async(std::launch::async,
+                                   intersectCells,
+                                   std::cref(rclMesh),
+                                   std::cref(cMeshFacetGrid),
+                                   std::cref(boxes),
+                                   begin,
+                                   end,
+                                   result,
+                                   std::cref(stop)));
+    }
+
+    // Calculates the intersections
+    bool found = false;
+    Base::SequencerLauncher seq("Checking for self-intersections...", numRanges);
+    try {
+        for (auto& task : tasks) {
+            if (task.get()) {
+                found = true;
+                // abort after the first detected self-intersection
+                if (!pairs) {
+                    stop = true;
+                }
+            }
+            // only the full search can be cancelled by the user
+            seq.next(pairs != nullptr);
+        }
+    }
+    catch (...) {
+        stop = true;
+        throw;
+    }
+
+    if (pairs) {
+        for (const auto& it : partial) {
+            pairs->insert(pairs->end(), it.begin(), it.end());
+        }
+    }
+
+    return found;
+}
+
+}  // namespace
+
+bool MeshEvalSelfIntersection::Evaluate()
+{
+    return !findSelfIntersections(_rclMesh, nullptr);
 }
 
 void MeshEvalSelfIntersection::GetIntersections(
@@ -702,77 +781,7 @@ void MeshEvalSelfIntersection::GetIntersections(
 void MeshEvalSelfIntersection::GetIntersections(
     std::vector<std::pair<FacetIndex, FacetIndex>>& intersection) const
 {
-    // Contains bounding boxes for every facet
-    std::vector<Base::BoundBox3f> boxes;
-    // intersection.clear();
-
-    // Splits the mesh using grid for speeding up the calculation
-    MeshFacetGrid cMeshFacetGrid(_rclMesh);
-    const MeshFacetArray& rFaces = _rclMesh.GetFacets();
-    MeshGridIterator clGridIter(cMeshFacetGrid);
-    unsigned long ulGridX {}, ulGridY {}, ulGridZ {};
-    cMeshFacetGrid.GetCtGrids(ulGridX, ulGridY, ulGridZ);
-
-    MeshFacetIterator cMFI(_rclMesh);
-    for (cMFI.Begin(); cMFI.More(); cMFI.Next()) {
-        boxes.push_back((*cMFI).GetBoundBox());
-    }
-
-    // Calculates the intersections
-    Base::SequencerLauncher seq("Checking for self-intersections...", ulGridX * ulGridY * ulGridZ);
-    for (clGridIter.Init(); clGridIter.More(); clGridIter.Next()) {
-        // Get the facet indices, belonging to the current grid unit
-        std::vector<FacetIndex> aulGridElements;
-        clGridIter.GetElements(aulGridElements);
-
-        seq.next(true);
-        if (aulGridElements.empty()) {
-            continue;
-        }
-
-        MeshGeomFacet facet1, facet2;
-        Base::Vector3f pt1, pt2;
-        for (auto it = aulGridElements.begin(); it != aulGridElements.end(); ++it) {
-            const Base::BoundBox3f& box1 = boxes[*it];
-            cMFI.Set(*it);
-            facet1 = *cMFI;
-            const MeshFacet& rface1 = rFaces[*it];
-            for (auto jt = it; jt != aulGridElements.end(); ++jt) {
-                if (jt == it) {  // the identical facet
-                    continue;
-                }
-                // If the facets share a common vertex we do not check for self-intersections
-                // because they could but usually do not intersect each other and the algorithm
-                // below would detect false-positives, otherwise
-                const MeshFacet& rface2 = rFaces[*jt];
-                if (rface1._aulPoints[0] == rface2._aulPoints[0]
-                    || rface1._aulPoints[0] == rface2._aulPoints[1]
-                    || rface1._aulPoints[0] == rface2._aulPoints[2]) {
-                    continue;  // ignore facets sharing a common vertex
-                }
-                if (rface1._aulPoints[1] == rface2._aulPoints[0]
-                    || rface1._aulPoints[1] == rface2._aulPoints[1]
-                    || rface1._aulPoints[1] == rface2._aulPoints[2]) {
-                    continue;  // ignore facets sharing a common vertex
-                }
-                if (rface1._aulPoints[2] == rface2._aulPoints[0]
-                    || rface1._aulPoints[2] == rface2._aulPoints[1]
-                    || rface1._aulPoints[2] == rface2._aulPoints[2]) {
-                    continue;  // ignore facets sharing a common vertex
-                }
-
-                const Base::BoundBox3f& box2 = boxes[*jt];
-                if (box1 && box2) {
-                    cMFI.Set(*jt);
-                    facet2 = *cMFI;
-                    int ret = facet1.IntersectWithFacet(facet2, pt1, pt2);
-                    if (ret == 2) {
-                        intersection.emplace_back(*it, *jt);
-                    }
-                }
-            }
-        }
-    }
+    findSelfIntersections(_rclMesh, &intersection);
 }
 
 std::vector<FacetIndex> MeshFixSelfIntersection::GetFacets() const
@@ -985,7 +994,7 @@ void MeshKernel::RebuildNeighbours(FacetIndex index)
 
     // sort the edges
     // std::sort(edges.begin(), edges.end(), Edge_Less());
-    int threads = int(std::thread::hardware_concurrency());
+    int threads = int(MeshCore::available_threads());
     MeshCore::parallel_sort(edges.begin(), edges.end(), Edge_Less(), threads);
 
     PointIndex p0 = POINT_INDEX_MAX, p1 = POINT_INDEX_MAX;
@@ -127,8 +127,13 @@ private:
 class MeshExport MeshOrientationCollector: public MeshOrientationVisitor
 {
 public:
+    /** Facets with wrong orientation are marked in \a rclWrong which must have the size of
+     * \a rclFacets, the facets of the visited mesh.
+     */
     MeshOrientationCollector(std::vector<FacetIndex>& aulIndices,
-                             std::vector<FacetIndex>& aulComplement);
+                             std::vector<FacetIndex>& aulComplement,
+                             const MeshFacetArray& rclFacets,
+                             MeshFlagTable& rclWrong);
 
     /** Returns always true and collects the indices with wrong orientation. */
     bool Visit(const MeshFacet&, const MeshFacet&, FacetIndex, unsigned long) override;
@@ -136,6 +141,8 @@ public:
 private:
     std::vector<FacetIndex>& _aulIndices;
     std::vector<FacetIndex>& _aulComplement;
+    const MeshFacetArray& _rclFacets;
+    MeshFlagTable& _rclWrong;
 };
 
 /**
@@ -164,7 +171,7 @@ public:
     std::vector<FacetIndex> GetIndices() const;
 
 private:
-    unsigned long HasFalsePositives(const std::vector<FacetIndex>&) const;
+    unsigned long HasFalsePositives(const std::vector<FacetIndex>&, const MeshFlagTable&) const;
 };
 
 /**
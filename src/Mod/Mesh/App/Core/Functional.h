@@ -25,10 +25,54 @@
 
 #include <algorithm>
 #include <future>
+#include <thread>
+#include <vector>
 
 
 namespace MeshCore
 {
+/**
+ * While an instance exists the parallel algorithms run on the calling thread only. It is used
+ * by tasks that already run concurrently to each other, so that they don't oversubscribe the
+ * cores with nested threads.
+ */
+class SerialScope
+{
+public:
+    SerialScope()
+        : previous(isActive())
+    {
+        isActive() = true;
+    }
+    ~SerialScope()
+    {
+        isActive() = previous;
+    }
+    SerialScope(const SerialScope&) = delete;
+    SerialScope(SerialScope&&) = delete;
+    SerialScope& operator=(const SerialScope&) = delete;
+    SerialScope& operator=(SerialScope&&) = delete;
+
+    /// Returns true if the calling thread is inside a SerialScope
+    static bool& isActive()
+    {
+        thread_local bool active = false;
+        return active;
+    }
+
+private:
+    bool previous;
+};
+
+/// Returns the number of threads the parallel algorithms may use on the calling thread
+inline std::size_t available_threads()
+{
+    if (SerialScope::isActive()) {
+        return 1;
+    }
+    return std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+}
+
 template<class Iter, class Pred>
 static void parallel_sort(Iter begin, Iter end, Pred comp, int threads)
 {
@@ -62,6 +106,34 @@ static void parallel_sort(Iter begin, Iter end, Pred comp, int threads)
     }
 }
 
+/**
+ * Calls \a func(begin, end) for contiguous ranges of [0, count) on several threads and waits
+ * until all of them have finished. Each thread gets at least \a minPerThread elements, so small
+ * inputs are processed by the calling thread only.
+ */
+template<class Func>
+static void parallel_for(std::size_t count, std::size_t minPerThread, Func func)
+{
+    std::size_t threads = available_threads();
+    std::size_t maxThreads = count / std::max<std::size_t>(minPerThread, 1);
+    threads = std::min(threads, std::max<std::size_t>(maxThreads, 1));
+    if (threads < 2) {
+        func(std::size_t(0), count);
+        return;
+    }
+
+    std::vector<std::future<void>> tasks;
+    tasks.reserve(threads);
+    for (std::size_t i = 0; i < threads; i++) {
+        std::size_t begin = count * i / threads;
+        std::size_t end = count * (i + 1) / threads;
+        tasks.push_back(std::async(std::launch::async, func, begin, end));
+    }
+    for (auto& task : tasks) {
+        task.get();
+    }
+}
+
 }  // namespace MeshCore
 
 
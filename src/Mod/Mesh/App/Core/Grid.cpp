@@ -25,10 +25,13 @@
 #ifndef _PreComp_
 #include <algorithm>
 #include <cmath>
+#include <future>
 #include <limits>
+#include <thread>
 #endif
 
 #include "Algorithm.h"
+#include "Functional.h"
 #include "Grid.h"
 #include "Iterator.h"
 #include "MeshKernel.h"
@@ -72,7 +75,9 @@ void MeshGrid::Attach(const MeshKernel& rclM)
 
 void MeshGrid::Clear()
 {
-    _aulGrid.clear();
+    _aulCellElements.clear();
+    _aulCellStart.clear();
+    _aulNewElements.clear();
     _pclMesh = nullptr;
 }
 
@@ -130,14 +135,55 @@ void MeshGrid::InitGrid()
     }
 
     // Create data structure
-    _aulGrid.clear();
-    _aulGrid.resize(_ulCtGridsX);
-    for (unsigned long i = 0; i < _ulCtGridsX; i++) {
-        _aulGrid[i].resize(_ulCtGridsY);
-        for (unsigned long j = 0; j < _ulCtGridsY; j++) {
-            _aulGrid[i][j].resize(_ulCtGridsZ);
+    InitCells();
+}
+
+void MeshGrid::InitCells()
+{
+    _aulCellElements.clear();
+    _aulCellStart.assign(_ulCtGridsX * _ulCtGridsY * _ulCtGridsZ + 1, 0);
+    _aulNewElements.clear();
+}
+
+void MeshGrid::FinishCells()
+{
+    // counting sort of the collected entries by their grid index, afterwards
+    // each offset points to the first element of its grid
+    std::vector<std::size_t>& start = _aulCellStart;
+    for (const auto& it : _aulNewElements) {
+        start[it.first]++;
+    }
+    for (std::size_t i = 1; i < start.size(); i++) {
+        start[i] += start[i - 1];
+    }
+
+    _aulCellElements.resize(_aulNewElements.size());
+    for (auto it = _aulNewElements.rbegin(); it != _aulNewElements.rend(); ++it) {
+        _aulCellElements[--start[it->first]] = it->second;
+    }
+    CellEntries().swap(_aulNewElements);
+
+    // sort each grid and remove duplicates in place
+    std::size_t count = 0;
+    for (std::size_t i = 0; i + 1 < start.size(); i++) {
+        auto first = _aulCellElements.begin() + static_cast<std::ptrdiff_t>(start[i]);
+        auto last = _aulCellElements.begin() + static_cast<std::ptrdiff_t>(start[i + 1]);
+        if (!std::is_sorted(first, last)) {
+            std::sort(first, last);
+        }
+        last = std::unique(first, last);
+        start[i] = count;
+        auto dest = _aulCellElements.begin() + static_cast<std::ptrdiff_t>(count);
+        // the destination never lies behind the source, but std::copy must not
+        // start inside the source range, so an unmoved grid is skipped
+        if (dest != first) {
+            std::copy(first, last, dest);
         }
+        count += static_cast<std::size_t>(last - first);
     }
+    start.back() = count;
+    _aulCellElements.resize(count);
+    _aulCellElements.shrink_to_fit();
 }
 
 unsigned long MeshGrid::Inside(const Base::BoundBox3f& rclBB,
@@ -160,9 +206,8 @@ unsigned long MeshGrid::Inside(const Base::BoundBox3f& rclBB,
     for (auto i = ulMinX; i <= ulMaxX; i++) {
         for (auto j = ulMinY; j <= ulMaxY; j++) {
             for (auto k = ulMinZ; k <= ulMaxZ; k++) {
-                raulElements.insert(raulElements.end(),
-                                    _aulGrid[i][j][k].begin(),
-                                    _aulGrid[i][j][k].end());
+                auto cell = GetCell(i, j, k);
+                raulElements.insert(raulElements.end(), cell.begin(), cell.end());
             }
         }
     }
@@ -202,9 +247,8 @@ unsigned long MeshGrid::Inside(const Base::BoundBox3f& rclBB,
         for (auto j = ulMinY; j <= ulMaxY; j++) {
             for (auto k = ulMinZ; k <= ulMaxZ; k++) {
                 if (Base::DistanceP2(GetBoundBox(i, j, k).GetCenter(), rclOrg) < fMinDistP2) {
-                    raulElements.insert(raulElements.end(),
-                                        _aulGrid[i][j][k].begin(),
-                                        _aulGrid[i][j][k].end());
+                    auto cell = GetCell(i, j, k);
+                    raulElements.insert(raulElements.end(), cell.begin(), cell.end());
                 }
             }
         }
@@ -239,7 +283,8 @@ unsigned long MeshGrid::Inside(const Base::BoundBox3f& rclBB,
     for (auto i = ulMinX; i <= ulMaxX; i++) {
         for (auto j = ulMinY; j <= ulMaxY; j++) {
             for (auto k = ulMinZ; k <= ulMaxZ; k++) {
-                raulElements.insert(_aulGrid[i][j][k].begin(), _aulGrid[i][j][k].end());
+                auto cell = GetCell(i, j, k);
+                raulElements.insert(cell.begin(), cell.end());
             }
         }
     }
@@ -463,7 +508,8 @@ void MeshGrid::SearchNearestFromPoint(const Base::Vector3f& pnt,
                 while (indices.empty() && nX < _ulCtGridsX) {
                     for (unsigned long i = 0; i < _ulCtGridsY; i++) {
                         for (unsigned long j = 0; j < _ulCtGridsZ; j++) {
-                            indices.insert(_aulGrid[nX][i][j].begin(), _aulGrid[nX][i][j].end());
+                            auto cell = GetCell(nX, i, j);
+                            indices.insert(cell.begin(), cell.end());
                         }
                     }
                     nX++;
@@ -475,7 +521,8 @@ void MeshGrid::SearchNearestFromPoint(const Base::Vector3f& pnt,
                 while (indices.empty() && nX < _ulCtGridsX) {
                     for (unsigned long i = 0; i < _ulCtGridsY; i++) {
                         for (unsigned long j = 0; j < _ulCtGridsZ; j++) {
-                            indices.insert(_aulGrid[nX][i][j].begin(), _aulGrid[nX][i][j].end());
+                            auto cell = GetCell(nX, i, j);
+                            indices.insert(cell.begin(), cell.end());
                         }
                     }
                     nX++;
@@ -487,7 +534,8 @@ void MeshGrid::SearchNearestFromPoint(const Base::Vector3f& pnt,
                 while (indices.empty() && nY < _ulCtGridsY) {
                     for (unsigned long i = 0; i < _ulCtGridsX; i++) {
                         for (unsigned long j = 0; j < _ulCtGridsZ; j++) {
-                            indices.insert(_aulGrid[i][nY][j].begin(), _aulGrid[i][nY][j].end());
+                            auto cell = GetCell(i, nY, j);
+                            indices.insert(cell.begin(), cell.end());
                         }
                     }
                     nY++;
@@ -499,7 +547,8 @@ void MeshGrid::SearchNearestFromPoint(const Base::Vector3f& pnt,
                 while (indices.empty() && nY < _ulCtGridsY) {
                     for (unsigned long i = 0; i < _ulCtGridsX; i++) {
                         for (unsigned long j = 0; j < _ulCtGridsZ; j++) {
-                            indices.insert(_aulGrid[i][nY][j].begin(), _aulGrid[i][nY][j].end());
+                            auto cell = GetCell(i, nY, j);
+                            indices.insert(cell.begin(), cell.end());
                         }
                     }
                     nY--;
@@ -511,7 +560,8 @@ void MeshGrid::SearchNearestFromPoint(const Base::Vector3f& pnt,
                 while (indices.empty() && nZ < _ulCtGridsZ) {
                     for (unsigned long i = 0; i < _ulCtGridsX; i++) {
                         for (unsigned long j = 0; j < _ulCtGridsY; j++) {
-                            indices.insert(_aulGrid[i][j][nZ].begin(), _aulGrid[i][j][nZ].end());
+                            auto cell = GetCell(i, j, nZ);
+                            indices.insert(cell.begin(), cell.end());
                         }
                     }
                     nZ++;
@@ -523,7 +573,8 @@ void MeshGrid::SearchNearestFromPoint(const Base::Vector3f& pnt,
                 while (indices.empty() && nZ < _ulCtGridsZ) {
                     for (unsigned long i = 0; i < _ulCtGridsX; i++) {
                         for (unsigned long j = 0; j < _ulCtGridsY; j++) {
-                            indices.insert(_aulGrid[i][j][nZ].begin(), _aulGrid[i][j][nZ].end());
+                            auto cell = GetCell(i, j, nZ);
+                            indices.insert(cell.begin(), cell.end());
                         }
                     }
                     nZ--;
@@ -611,10 +662,10 @@ unsigned long MeshGrid::GetElements(unsigned long ulX,
                                     unsigned long ulZ,
                                     std::set<ElementIndex>& raclInd) const
 {
-    const std::set<ElementIndex>& rclSet = _aulGrid[ulX][ulY][ulZ];
-    if (!rclSet.empty()) {
-        raclInd.insert(rclSet.begin(), rclSet.end());
-        return rclSet.size();
+    auto cell = GetCell(ulX, ulY, ulZ);
+    if (!cell.empty()) {
+        raclInd.insert(cell.begin(), cell.end());
+        return cell.size();
     }
 
     return 0;
@@ -630,9 +681,8 @@ unsigned long MeshGrid::GetElements(const Base::Vector3f& rclPoint,
         return 0;
     }
 
-    aulFacets.resize(_aulGrid[ulX][ulY][ulZ].size());
-
-    std::copy(_aulGrid[ulX][ulY][ulZ].begin(), _aulGrid[ulX][ulY][ulZ].end(), aulFacets.begin());
+    auto cell = GetCell(ulX, ulY, ulZ);
+    aulFacets.assign(cell.begin(), cell.end());
     return aulFacets.size();
 }
 
@@ -749,13 +799,51 @@ void MeshFacetGrid::RebuildGrid()
     InitGrid();
 
     // Fill data structure
-    MeshFacetIterator clFIter(*_pclMesh);
+    // For large meshes the facets are split into contiguous ranges that are
+    // processed in parallel. The partial results are appended in order so that
+    // the outcome doesn't depend on the number of threads.
+    const ElementIndex numFacets = _ulCtElements;
+    const ElementIndex minFacetsPerThread = 50000;
+    auto numThreads = static_cast<ElementIndex>(available_threads());
+    numThreads = std::min<ElementIndex>(numThreads, numFacets / minFacetsPerThread);
+
+    if (numThreads < 2) {
+        _aulNewElements.reserve(numFacets);
+        for (ElementIndex i = 0; i < numFacets; i++) {
+            AddFacet(_pclMesh->GetFacet(i), i, _aulNewElements);
+        }
+    }
+    else {
+        auto fillRange = [this](ElementIndex begin, ElementIndex end) {
+            CellEntries entries;
+            entries.reserve(end - begin);
+            for (ElementIndex i = begin; i < end; i++) {
+                AddFacet(_pclMesh->GetFacet(i), i, entries);
+            }
+            return entries;
+        };
+
+        std::vector<std::future<CellEntries>> partial;
+        ElementIndex chunk = numFacets / numThreads;
+        for (ElementIndex t = 0; t < numThreads; t++) {
+            ElementIndex begin = t * chunk;
+            ElementIndex end = (t + 1 == numThreads) ? numFacets : begin + chunk;
+            partial.push_back(std::async(std::launch::async, fillRange, begin, end));
+        }
 
-    unsigned long i = 0;
-    for (clFIter.Init(); clFIter.More(); clFIter.Next()) {
-        //    AddFacet(*clFIter, i++, 2.0f);
-        AddFacet(*clFIter, i++);
+        std::vector<CellEntries> results;
+        std::size_t total = 0;
+        for (auto& it : partial) {
+            results.push_back(it.get());
+            total += results.back().size();
+        }
+        _aulNewElements.reserve(total);
+        for (const auto& it : results) {
+            _aulNewElements.insert(_aulNewElements.end(), it.begin(), it.end());
+        }
     }
+
+    FinishCells();
 }
 
 unsigned long MeshFacetGrid::SearchNearestFromPoint(const Base::Vector3f& rclPt) const
@@ -986,8 +1074,7 @@ void MeshFacetGrid::SearchNearestFacetInGrid(unsigned long ulX,
                                              float& rfMinDist,
                                              ElementIndex& rulFacetInd) const
 {
-    const std::set<ElementIndex>& rclSet = _aulGrid[ulX][ulY][ulZ];
-    for (ElementIndex pI : rclSet) {
+    for (ElementIndex pI : GetCell(ulX, ulY, ulZ)) {
         float fDist = _pclMesh->GetFacet(pI).DistanceToPoint(rclPt);
         if (fDist < rfMinDist) {
             rfMinDist = fDist;
@@ -1038,7 +1125,7 @@ void MeshPointGrid::AddPoint(const MeshPoint& rclPt, ElementIndex ulPtIndex, flo
     unsigned long ulZ {};
     Pos(Base::Vector3f(rclPt.x, rclPt.y, rclPt.z), ulX, ulY, ulZ);
     if ((ulX < _ulCtGridsX) && (ulY < _ulCtGridsY) && (ulZ < _ulCtGridsZ)) {
-        _aulGrid[ulX][ulY][ulZ].insert(ulPtIndex);
+        AddElement(ulX, ulY, ulZ, ulPtIndex);
     }
 }
 
@@ -1099,9 +1186,12 @@ void MeshPointGrid::RebuildGrid()
     MeshPointIterator cPIter(*_pclMesh);
 
     unsigned long i = 0;
+    _aulNewElements.reserve(_ulCtElements);
     for (cPIter.Init(); cPIter.More(); cPIter.Next()) {
         AddPoint(*cPIter, i++);
     }
+
+    FinishCells();
 }
 
 void MeshPointGrid::Pos(const Base::Vector3f& rclPoint,
@@ -1166,9 +1256,7 @@ bool MeshGridIterator::InitOnRay(const Base::Vector3f& rclPt,
     // point lies within global BB
     if (_rclGrid.GetBoundBox().IsInBox(rclPt)) {  // Determine the voxel by the starting point
         _rclGrid.Position(rclPt, _ulX, _ulY, _ulZ);
-        raulElements.insert(raulElements.end(),
-                            _rclGrid._aulGrid[_ulX][_ulY][_ulZ].begin(),
-                            _rclGrid._aulGrid[_ulX][_ulY][_ulZ].end());
+        GetElements(raulElements);
         _bValidRay = true;
     }
     else {  // Start point outside
@@ -1183,9 +1271,7 @@ bool MeshGridIterator::InitOnRay(const Base::Vector3f& rclPt,
                 _rclGrid.Position(cP1, _ulX, _ulY, _ulZ);
             }
 
-            raulElements.insert(raulElements.end(),
-                                _rclGrid._aulGrid[_ulX][_ulY][_ulZ].begin(),
-                                _rclGrid._aulGrid[_ulX][_ulY][_ulZ].end());
+            GetElements(raulElements);
             _bValidRay = true;
         }
     }
@@ -1249,9 +1335,7 @@ bool MeshGridIterator::NextOnRay(std::vector<ElementIndex>& raulElements)
     if (_bValidRay && _rclGrid.CheckPos(_ulX, _ulY, _ulZ)) {
         GridElement pos(_ulX, _ulY, _ulZ);
         _cSearchPositions.insert(pos);
-        raulElements.insert(raulElements.end(),
-                            _rclGrid._aulGrid[_ulX][_ulY][_ulZ].begin(),
-                            _rclGrid._aulGrid[_ulX][_ulY][_ulZ].end());
+        GetElements(raulElements);
     }
     else {
         _bValidRay = false;  // Beam leaked
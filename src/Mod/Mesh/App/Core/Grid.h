@@ -25,6 +25,9 @@
 
 #include <limits>
 #include <set>
+#include <span>
+#include <utility>
+#include <vector>
 
 #include <Base/BoundBox.h>
 
@@ -52,6 +55,10 @@ static constexpr float MESHGRID_BBOX_EXTENSION = 10.0F;
  *
  * Grids can be used within algorithms to avoid to iterate through all elements,
  * so grids can speed up algorithms dramatically.
+ *
+ * The element indices of all grid elements are kept in one contiguous array.
+ * Sub-classes fill the grid in RebuildGrid() with InitCells(), AddElement()
+ * and FinishCells().
  */
 class MeshExport MeshGrid
 {
@@ -152,7 +159,15 @@ public:
     /** Returns the number of elements in a given grid. */
     unsigned long GetCtElements(unsigned long ulX, unsigned long ulY, unsigned long ulZ) const
     {
-        return static_cast<unsigned long>(_aulGrid[ulX][ulY][ulZ].size());
+        return static_cast<unsigned long>(GetCell(ulX, ulY, ulZ).size());
+    }
+    /** Returns the indices of the elements in a given grid in ascending order. */
+    std::span<const ElementIndex>
+    GetCell(unsigned long ulX, unsigned long ulY, unsigned long ulZ) const
+    {
+        std::size_t index = (ulZ * _ulCtGridsY + ulY) * _ulCtGridsX + ulX;
+        return {_aulCellElements.data() + _aulCellStart[index],
+                _aulCellStart[index + 1] - _aulCellStart[index]};
     }
     /** Validates the grid structure and rebuilds it if needed. Must be implemented in sub-classes.
      */
@@ -185,6 +200,15 @@ public:
 protected:
     /** Initializes the size of the internal structure. */
     virtual void InitGrid();
+    /** Sets up empty grid elements for the current number of grids. */
+    void InitCells();
+    /** Adds an element to a grid, it is only visible after FinishCells(). */
+    void AddElement(unsigned long ulX, unsigned long ulY, unsigned long ulZ, ElementIndex ulIndex)
+    {
+        _aulNewElements.emplace_back((ulZ * _ulCtGridsY + ulY) * _ulCtGridsX + ulX, ulIndex);
+    }
+    /** Sorts the elements added with AddElement() into the grid structure. */
+    void FinishCells();
     /** Deletes the grid structure. */
     virtual void Clear();
     /** Calculates the grid length dependent on the number of grids per axis. */
@@ -195,10 +219,14 @@ protected:
     virtual unsigned long HasElements() const = 0;
 
 protected:
+    /** Pairs of grid index and element index. */
+    using CellEntries = std::vector<std::pair<std::size_t, ElementIndex>>;
+
     // NOLINTBEGIN
-    std::vector<std::vector<std::vector<std::set<ElementIndex>>>>
-        _aulGrid;                /**< Grid data structure. */
-    const MeshKernel* _pclMesh;  /**< The mesh kernel. */
+    std::vector<ElementIndex> _aulCellElements; /**< Elements of all grids, grid by grid. */
+    std::vector<std::size_t> _aulCellStart;     /**< Offset of each grid in _aulCellElements. */
+    CellEntries _aulNewElements;                /**< Elements added by AddElement(). */
+    const MeshKernel* _pclMesh;                 /**< The mesh kernel. */
     unsigned long _ulCtElements; /**< Number of grid elements for validation issues. */
     unsigned long _ulCtGridsX;   /**< Number of grid elements in z. */
     unsigned long _ulCtGridsY;   /**< Number of grid elements in z. */
@@ -290,6 +318,10 @@ protected:
      * element that intersects the facet. */
     inline void
     AddFacet(const MeshGeomFacet& rclFacet, ElementIndex ulFacetIndex, float fEpsilon = 0.0F);
+    /** Same as AddFacet() but collects the grid entries in \a entries. */
+    inline void AddFacet(const MeshGeomFacet& rclFacet,
+                         ElementIndex ulFacetIndex,
+                         CellEntries& entries) const;
     /** Returns the number of stored elements. */
     unsigned long HasElements() const override
     {
@@ -371,9 +403,8 @@ public:
     /** Returns indices of the elements in the current grid. */
     void GetElements(std::vector<ElementIndex>& raulElements) const
     {
-        raulElements.insert(raulElements.end(),
-                            _rclGrid._aulGrid[_ulX][_ulY][_ulZ].begin(),
-                            _rclGrid._aulGrid[_ulX][_ulY][_ulZ].end());
+        auto cell = _rclGrid.GetCell(_ulX, _ulY, _ulZ);
+        raulElements.insert(raulElements.end(), cell.begin(), cell.end());
     }
     /** Returns the number of elements in the current grid. */
     unsigned long GetCtElements() const
@@ -564,6 +595,13 @@ inline void MeshFacetGrid::PosWithCheck(const Base::Vector3f& rclPoint,
 inline void MeshFacetGrid::AddFacet(const MeshGeomFacet& rclFacet,
                                     ElementIndex ulFacetIndex,
                                     float /*fEpsilon*/)
+{
+    AddFacet(rclFacet, ulFacetIndex, _aulNewElements);
+}
+
+inline void MeshFacetGrid::AddFacet(const MeshGeomFacet& rclFacet,
+                                    ElementIndex ulFacetIndex,
+                                    CellEntries& entries) const
 {
     unsigned long ulX {};
     unsigned long ulY {};
@@ -605,14 +643,14 @@ inline void MeshFacetGrid::AddFacet(const MeshGeomFacet& rclFacet,
             for (ulY = ulY1; ulY <= ulY2; ulY++) {
                 for (ulZ = ulZ1; ulZ <= ulZ2; ulZ++) {
                     if (rclFacet.IntersectBoundingBox(GetBoundBox(ulX, ulY, ulZ))) {
-                        _aulGrid[ulX][ulY][ulZ].insert(ulFacetIndex);
+                        entries.emplace_back(GetIndexToPosition(ulX, ulY, ulZ), ulFacetIndex);
                     }
                 }
             }
         }
     }
     else {
-        _aulGrid[ulX1][ulY1][ulZ1].insert(ulFacetIndex);
+        entries.emplace_back(GetIndexToPosition(ulX1, ulY1, ulZ1), ulFacetIndex);
     }
 }
 
@@ -0,0 +1,143 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2025 FreeCAD Project Association                         *
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+#include "PreCompiled.h"
+#ifndef _PreComp_
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <cstdlib>
+#include <cstring>
+#include <istream>
+#include <sstream>
+#include <thread>
+#endif
+
+#include "LineParser.h"
+
+
+using namespace MeshCore;
+
+std::string_view LineParser::Rest()
+{
+    std::string_view rest = _line.substr(std::min(_pos, _line.size()));
+    while (!rest.empty() && isSpace(rest.front())) {
+        rest.remove_prefix(1);
+    }
+    while (!rest.empty() && isSpace(rest.back())) {
+        rest.remove_suffix(1);
+    }
+    _pos = _line.size();
+    return rest;
+}
+
+bool LineParser::IsEmptyLine() const
+{
+    return std::all_of(_line.begin(), _line.end(), [](char c) {
+        return isSpace(c);
+    });
+}
+
+bool LineParser::ToFloat(std::string_view token, float& value)
+{
+    // std::from_chars for floating point is not supported by all standard libraries and
+    // std::strtof needs a null-terminated string
+    constexpr std::size_t maxLength = 63;
+    if (token.empty() || token.size() > maxLength) {
+        return false;
+    }
+
+    char buf[maxLength + 1];
+    std::memcpy(buf, token.data(), token.size());
+    buf[token.size()] = '\0';
+
+    char* last = nullptr;
+    errno = 0;
+    value = std::strtof(buf, &last);
+    return last == buf + token.size() && errno != ERANGE;
+}
+
+bool LineParser::ToInt(std::string_view token, int& value)
+{
+    // std::from_chars doesn't accept a leading plus sign
+    if (!token.empty() && token.front() == '+') {
+        token.remove_prefix(1);
+    }
+
+    const char* end = token.data() + token.size();
+    auto [last, ec] = std::from_chars(token.data(), end, value);
+    return ec == std::errc() && last == end && !token.empty();
+}
+
+std::vector<std::string_view> LineParser::Split(std::string_view data, std::size_t minChunkSize)
+{
+    constexpr std::size_t chunksPerThread = 4;
+    std::size_t threads = std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+    std::size_t count = data.size() / std::max<std::size_t>(minChunkSize, 1);
+    count = std::clamp<std::size_t>(count, 1, chunksPerThread * threads);
+
+    std::vector<std::string_view> chunks;
+    chunks.reserve(count);
+
+    std::size_t start = 0;
+    for (std::size_t i = 1; i < count; i++) {
+        std::size_t pos = std::max(data.size() * i / count, start);
+        std::size_t end = data.find('\n', pos);
+        if (end == std::string_view::npos) {
+            break;
+        }
+        chunks.push_back(data.substr(start, end + 1 - start));
+        start = end + 1;
+    }
+
+    if (start < data.size() || chunks.empty()) {
+        chunks.push_back(data.substr(start));
+    }
+
+    return chunks;
+}
+
+bool LineParser::ReadAll(std::istream& input, std::string& data)
+{
+    std::streambuf* buf = input.rdbuf();
+    if (!input || !buf) {
+        return false;
+    }
+
+    std::streamoff pos = buf->pubseekoff(0, std::ios::cur, std::ios::in);
+    std::streamoff end = buf->pubseekoff(0, std::ios::end, std::ios::in);
+    if (pos >= 0 && end >= pos) {
+        buf->pubseekoff(pos, std::ios::beg, std::ios::in);
+        data.resize(static_cast<std::size_t>(end - pos));
+        input.read(data.data(), static_cast<std::streamsize>(data.size()));
+        data.resize(static_cast<std::size_t>(input.gcount()));
+    }
+    else {
+        // the stream doesn't support seeking
+        std::ostringstream str;
+        str << buf;
+        data = str.str();
+    }
+
+    return true;
+}
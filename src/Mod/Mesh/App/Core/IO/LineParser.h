@@ -0,0 +1,115 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2025 FreeCAD Project Association                         *
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+#ifndef MESH_IO_LINE_PARSER_H
+#define MESH_IO_LINE_PARSER_H
+
+#include <iosfwd>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <Mod/Mesh/MeshGlobal.h>
+
+
+namespace MeshCore
+{
+
+/**
+ * The LineParser class splits a block of text into lines and whitespace separated tokens
+ * without creating temporary strings.
+ *
+ * It is used by the readers of ASCII formats that split the data with Split() into chunks
+ * which can be parsed on several threads, each of them with its own LineParser.
+ */
+class MeshExport LineParser
+{
+public:
+    explicit LineParser(std::string_view text)
+        : _text(text)
+    {}
+
+    /** Moves to the next line, returns false if there is no further line. */
+    bool NextLine()
+    {
+        if (_next >= _text.size()) {
+            return false;
+        }
+
+        std::size_t end = _text.find('\n', _next);
+        if (end == std::string_view::npos) {
+            end = _text.size();
+        }
+        _line = _text.substr(_next, end - _next);
+        _next = end + 1;
+        _pos = 0;
+        return true;
+    }
+    /** Returns the next token of the current line or an empty token at the end of the line. */
+    std::string_view NextToken()
+    {
+        while (_pos < _line.size() && isSpace(_line[_pos])) {
+            _pos++;
+        }
+        std::size_t start = _pos;
+        while (_pos < _line.size() && !isSpace(_line[_pos])) {
+            _pos++;
+        }
+        return _line.substr(start, _pos - start);
+    }
+    /** Returns the remaining part of the current line without surrounding whitespace. */
+    std::string_view Rest();
+    /** Returns true if the current line has only whitespace characters. */
+    bool IsEmptyLine() const;
+
+    /** Converts the whole \a token into a float. */
+    static bool ToFloat(std::string_view token, float& value);
+    /** Converts the whole \a token into an int. */
+    static bool ToInt(std::string_view token, int& value);
+
+    /**
+     * Splits \a data into chunks that end at line boundaries, up to four for each thread so
+     * that parts with slower lines do not hold up the others. Each chunk has at least
+     * \a minChunkSize bytes apart from the last one.
+     */
+    static std::vector<std::string_view> Split(std::string_view data, std::size_t minChunkSize);
+    /** Reads the data of \a input from the current position to the end into \a data. */
+    static bool ReadAll(std::istream& input, std::string& data);
+
+private:
+    static bool isSpace(char c)
+    {
+        return c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+    }
+
+private:
+    std::string_view _text;
+    std::string_view _line;
+    std::size_t _next {0};
+    std::size_t _pos {0};
+};
+
+}  // namespace MeshCore
+
+
+#endif  // MESH_IO_LINE_PARSER_H
@@ -23,15 +23,19 @@
 #include "PreCompiled.h"
 #ifndef _PreComp_
 #include <boost/lexical_cast.hpp>
-#include <boost/regex.hpp>
 #include <boost/tokenizer.hpp>
+#include <algorithm>
+#include <array>
 #include <istream>
+#include <map>
 #endif
 
+#include "Core/Functional.h"
 #include "Core/MeshIO.h"
 #include "Core/MeshKernel.h"
 #include <Base/Tools.h>
 
+#include "LineParser.h"
 #include "ReaderOBJ.h"
 
 
@@ -42,109 +46,258 @@ ReaderOBJ::ReaderOBJ(MeshKernel& kernel, Material* material)
     , _material(material)
 {}
 
-bool ReaderOBJ::Load(std::istream& str)
+namespace
 {
-    boost::regex rx_m("^mtllib\\s+(.+)\\s*$");
-    boost::regex rx_u(R"(^usemtl\s+([\x21-\x7E]+)\s*$)");
-    boost::regex rx_g(R"(^g\s+([\x21-\x7E]+)\s*$)");
-    boost::regex rx_p("^v\\s+([-+]?[0-9]*)\\.?([0-9]+([eE][-+]?[0-9]+)?)"
-                      "\\s+([-+]?[0-9]*)\\.?([0-9]+([eE][-+]?[0-9]+)?)"
-                      "\\s+([-+]?[0-9]*)\\.?([0-9]+([eE][-+]?[0-9]+)?)\\s*$");
-    boost::regex rx_c("^v\\s+([-+]?[0-9]*)\\.?([0-9]+([eE][-+]?[0-9]+)?)"
-                      "\\s+([-+]?[0-9]*)\\.?([0-9]+([eE][-+]?[0-9]+)?)"
-                      "\\s+([-+]?[0-9]*)\\.?([0-9]+([eE][-+]?[0-9]+)?)"
-                      "\\s+(\\d{1,3})\\s+(\\d{1,3})\\s+(\\d{1,3})\\s*$");
-    boost::regex rx_t("^v\\s+([-+]?[0-9]*)\\.?([0-9]+([eE][-+]?[0-9]+)?)"
-                      "\\s+([-+]?[0-9]*)\\.?([0-9]+([eE][-+]?[0-9]+)?)"
-                      "\\s+([-+]?[0-9]*)\\.?([0-9]+([eE][-+]?[0-9]+)?)"
-                      "\\s+([-+]?[0-9]*)\\.?([0-9]+([eE][-+]?[0-9]+)?)"
-                      "\\s+([-+]?[0-9]*)\\.?([0-9]+([eE][-+]?[0-9]+)?)"
-                      "\\s+([-+]?[0-9]*)\\.?([0-9]+([eE][-+]?[0-9]+)?)\\s*$");
-    boost::regex rx_f3("^f\\s+([-+]?[0-9]+)/?[-+]?[0-9]*/?[-+]?[0-9]*"
-                       "\\s+([-+]?[0-9]+)/?[-+]?[0-9]*/?[-+]?[0-9]*"
-                       "\\s+([-+]?[0-9]+)/?[-+]?[0-9]*/?[-+]?[0-9]*\\s*$");
-    boost::regex rx_f4("^f\\s+([-+]?[0-9]+)/?[-+]?[0-9]*/?[-+]?[0-9]*"
-                       "\\s+([-+]?[0-9]+)/?[-+]?[0-9]*/?[-+]?[0-9]*"
-                       "\\s+([-+]?[0-9]+)/?[-+]?[0-9]*/?[-+]?[0-9]*"
-                       "\\s+([-+]?[0-9]+)/?[-+]?[0-9]*/?[-+]?[0-9]*\\s*$");
-    boost::cmatch what;
 
-    unsigned long segment = 0;
-    MeshPointArray meshPoints;
-    MeshFacetArray meshFacets;
+// The data of a part of an OBJ file that is parsed on its own thread
+struct ObjChunk
+{
+    struct Face
+    {
+        std::array<int, 4> indices {};
+        int count {};
+        // the number of points of the chunk before this face to resolve relative indices
+        std::size_t pointsBefore {};
+    };
+
+    struct Command
+    {
+        enum Type
+        {
+            Group,
+            Library,
+            Material
+        } type;
+        std::string name;
+        // the index of the next face of the chunk
+        std::size_t face;
+    };
+
+    MeshPointArray points;
+    std::vector<Face> faces;
+    std::vector<Command> commands;
+    bool hasColors = false;
+};
+
+// A name of a group or material must not contain whitespace or control characters
+bool isValidName(std::string_view name)
+{
+    return !name.empty() && std::all_of(name.begin(), name.end(), [](char c) {
+        return c >= '\x21' && c <= '\x7E';
+    });
+}
+
+// Color values with up to three digits are treated as integers in the range of [0, 255]
+bool isIntColor(std::string_view token)
+{
+    return !token.empty() && token.size() <= 3
+        && std::all_of(token.begin(), token.end(), [](char c) {
+               return c >= '0' && c <= '9';
+           });
+}
+
+void parseVertex(LineParser& parser, ObjChunk& chunk)
+{
+    constexpr std::size_t maxTokens = 7;
+    std::array<std::string_view, maxTokens> tokens;
+    std::size_t count = 0;
+    for (; count < maxTokens; count++) {
+        tokens[count] = parser.NextToken();
+        if (tokens[count].empty()) {
+            break;
+        }
+    }
+
+    constexpr std::size_t numCoords = 3;
+    constexpr std::size_t numColor = 6;
+    if (count != numCoords && count != numColor) {
+        return;
+    }
 
-    std::string line;
     float fX {}, fY {}, fZ {};
-    int i1 = 1, i2 = 1, i3 = 1, i4 = 1;
-    MeshFacet item;
+    if (!LineParser::ToFloat(tokens[0], fX) || !LineParser::ToFloat(tokens[1], fY)
+        || !LineParser::ToFloat(tokens[2], fZ)) {
+        return;
+    }
+
+    if (count == numCoords) {
+        chunk.points.push_back(MeshPoint(Base::Vector3f(fX, fY, fZ)));
+        return;
+    }
+
+    float r {}, g {}, b {};
+    if (isIntColor(tokens[3]) && isIntColor(tokens[4]) && isIntColor(tokens[5])) {
+        int ir {}, ig {}, ib {};
+        LineParser::ToInt(tokens[3], ir);
+        LineParser::ToInt(tokens[4], ig);
+        LineParser::ToInt(tokens[5], ib);
+        r = std::min<int>(ir, 255) / 255.0F;
+        g = std::min<int>(ig, 255) / 255.0F;
+        b = std::min<int>(ib, 255) / 255.0F;
+    }
+    else if (!LineParser::ToFloat(tokens[3], r) || !LineParser::ToFloat(tokens[4], g)
+             || !LineParser::ToFloat(tokens[5], b)) {
+        return;
+    }
+
+    chunk.points.push_back(MeshPoint(Base::Vector3f(fX, fY, fZ)));
+
+    Base::Color c(r, g, b);
+    unsigned long prop = static_cast<uint32_t>(c.getPackedValue());
+    chunk.points.back().SetProperty(prop);
+    chunk.hasColors = true;
+}
+
+void parseFace(LineParser& parser, ObjChunk& chunk)
+{
+    // a vertex is given as 'v', 'v/vt', 'v//vn' or 'v/vt/vn' and only 'v' is used
+    ObjChunk::Face face;
+    for (std::string_view token = parser.NextToken(); !token.empty();
+         token = parser.NextToken()) {
+        if (face.count == int(face.indices.size())) {
+            return;
+        }
+        if (!LineParser::ToInt(token.substr(0, token.find('/')), face.indices[face.count++])) {
+            return;
+        }
+    }
+
+    if (face.count >= 3) {
+        face.pointsBefore = chunk.points.size();
+        chunk.faces.push_back(face);
+    }
+}
+
+void parseCommand(LineParser& parser, ObjChunk& chunk, ObjChunk::Command::Type type)
+{
+    std::string_view name;
+    if (type == ObjChunk::Command::Library) {
+        name = parser.Rest();
+    }
+    else {
+        name = parser.NextToken();
+        if (!isValidName(name) || !parser.NextToken().empty()) {
+            return;
+        }
+    }
+
+    if (!name.empty()) {
+        chunk.commands.push_back({type, std::string(name), chunk.faces.size()});
+    }
+}
+
+void parseChunk(std::string_view text, ObjChunk& chunk)
+{
+    LineParser parser(text);
+    while (parser.NextLine()) {
+        std::string_view keyword = parser.NextToken();
+        if (keyword == "v") {
+            parseVertex(parser, chunk);
+        }
+        else if (keyword == "f") {
+            parseFace(parser, chunk);
+        }
+        else if (keyword == "g") {
+            parseCommand(parser, chunk, ObjChunk::Command::Group);
+        }
+        else if (keyword == "mtllib") {
+            parseCommand(parser, chunk, ObjChunk::Command::Library);
+        }
+        else if (keyword == "usemtl") {
+            parseCommand(parser, chunk, ObjChunk::Command::Material);
+        }
+    }
+}
+
+}  // namespace
 
+bool ReaderOBJ::Load(std::istream& str)
+{
     if (!str || str.bad()) {
         return false;
     }
 
-    std::streambuf* buf = str.rdbuf();
-    if (!buf) {
+    std::string data;
+    if (!LineParser::ReadAll(str, data)) {
         return false;
     }
 
+    return LoadData(data);
+}
+
+bool ReaderOBJ::Load(const char* data, std::size_t size)
+{
+    return LoadData(std::string_view(data, size));
+}
+
+bool ReaderOBJ::LoadData(std::string_view data)
+{
+    // the file is split at line boundaries and the parts are parsed in parallel
+    std::vector<std::string_view> parts = LineParser::Split(data, _minChunkSize);
+    std::vector<ObjChunk> chunks(parts.size());
+    MeshCore::parallel_for(parts.size(), 1, [&parts, &chunks](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            parseChunk(parts[i], chunks[i]);
+        }
+    });
+
+    unsigned long segment = 0;
+    MeshPointArray meshPoints;
+    MeshFacetArray meshFacets;
+    MeshFacet item;
+
     MeshIO::Binding rgb_value = MeshIO::OVERALL;
     bool new_segment = true;
     std::string groupName;
     std::string materialName;
     unsigned long countMaterialFacets = 0;
 
-    while (std::getline(str, line)) {
-        if (boost::regex_match(line.c_str(), what, rx_p)) {
-            fX = (float)std::atof(what[1].first);
-            fY = (float)std::atof(what[4].first);
-            fZ = (float)std::atof(what[7].first);
-            meshPoints.push_back(MeshPoint(Base::Vector3f(fX, fY, fZ)));
+    auto applyCommand = [&](const ObjChunk::Command& cmd) {
+        switch (cmd.type) {
+            case ObjChunk::Command::Group:
+                new_segment = true;
+                groupName = Base::Tools::escapedUnicodeToUtf8(cmd.name);
+                break;
+            case ObjChunk::Command::Library:
+                if (_material) {
+                    _material->library = Base::Tools::escapedUnicodeToUtf8(cmd.name);
+                }
+                break;
+            case ObjChunk::Command::Material:
+                if (!materialName.empty()) {
+                    _materialNames.emplace_back(materialName, countMaterialFacets);
+                }
+                materialName = Base::Tools::escapedUnicodeToUtf8(cmd.name);
+                countMaterialFacets = 0;
+                break;
         }
-        else if (boost::regex_match(line.c_str(), what, rx_c)) {
-            fX = (float)std::atof(what[1].first);
-            fY = (float)std::atof(what[4].first);
-            fZ = (float)std::atof(what[7].first);
-            float r = std::min<int>(std::atof(what[10].first), 255) / 255.0F;
-            float g = std::min<int>(std::atof(what[11].first), 255) / 255.0F;
-            float b = std::min<int>(std::atof(what[12].first), 255) / 255.0F;
-            meshPoints.push_back(MeshPoint(Base::Vector3f(fX, fY, fZ)));
-
-            Base::Color c(r, g, b);
-            unsigned long prop = static_cast<uint32_t>(c.getPackedValue());
-            meshPoints.back().SetProperty(prop);
-            rgb_value = MeshIO::PER_VERTEX;
+    };
+
+    std::size_t numPoints = 0;
+    std::size_t numFacets = 0;
+    for (const auto& chunk : chunks) {
+        numPoints += chunk.points.size();
+        for (const auto& face : chunk.faces) {
+            numFacets += face.count - 2;
         }
-        else if (boost::regex_match(line.c_str(), what, rx_t)) {
-            fX = (float)std::atof(what[1].first);
-            fY = (float)std::atof(what[4].first);
-            fZ = (float)std::atof(what[7].first);
-            float r = static_cast<float>(std::atof(what[10].first));
-            float g = static_cast<float>(std::atof(what[13].first));
-            float b = static_cast<float>(std::atof(what[16].first));
-            meshPoints.push_back(MeshPoint(Base::Vector3f(fX, fY, fZ)));
-
-            Base::Color c(r, g, b);
-            unsigned long prop = static_cast<uint32_t>(c.getPackedValue());
-            meshPoints.back().SetProperty(prop);
+    }
+    meshPoints.reserve(numPoints);
+    meshFacets.reserve(numFacets);
+
+    // merge the chunks in the order of the file to keep groups and materials intact
+    for (auto& chunk : chunks) {
+        int offset = static_cast<int>(meshPoints.size());
+        meshPoints.insert(meshPoints.end(), chunk.points.begin(), chunk.points.end());
+        if (chunk.hasColors) {
             rgb_value = MeshIO::PER_VERTEX;
         }
-        else if (boost::regex_match(line.c_str(), what, rx_g)) {
-            new_segment = true;
-            groupName = Base::Tools::escapedUnicodeToUtf8(what[1].first);
-        }
-        else if (boost::regex_match(line.c_str(), what, rx_m)) {
-            if (_material) {
-                _material->library = Base::Tools::escapedUnicodeToUtf8(what[1].first);
-            }
-        }
-        else if (boost::regex_match(line.c_str(), what, rx_u)) {
-            if (!materialName.empty()) {
-                _materialNames.emplace_back(materialName, countMaterialFacets);
+
+        auto cmd = chunk.commands.begin();
+        for (std::size_t i = 0; i < chunk.faces.size(); i++) {
+            for (; cmd != chunk.commands.end() && cmd->face <= i; ++cmd) {
+                applyCommand(*cmd);
             }
-            materialName = Base::Tools::escapedUnicodeToUtf8(what[1].first);
-            countMaterialFacets = 0;
-        }
-        else if (boost::regex_match(line.c_str(), what, rx_f3)) {
+
             // starts a new segment
             if (new_segment) {
                 if (!groupName.empty()) {
@@ -155,49 +308,35 @@ bool ReaderOBJ::Load(std::istream& str)
                 segment++;
             }
 
-            // 3-vertex face
-            i1 = std::atoi(what[1].first);
-            i1 = i1 > 0 ? i1 - 1 : i1 + static_cast<int>(meshPoints.size());
-            i2 = std::atoi(what[2].first);
-            i2 = i2 > 0 ? i2 - 1 : i2 + static_cast<int>(meshPoints.size());
-            i3 = std::atoi(what[3].first);
-            i3 = i3 > 0 ? i3 - 1 : i3 + static_cast<int>(meshPoints.size());
-            item.SetVertices(i1, i2, i3);
-            item.SetProperty(segment);
-            meshFacets.push_back(item);
-            countMaterialFacets++;
-        }
-        else if (boost::regex_match(line.c_str(), what, rx_f4)) {
-            // starts a new segment
-            if (new_segment) {
-                if (!groupName.empty()) {
-                    _groupNames.push_back(groupName);
-                    groupName.clear();
-                }
-                new_segment = false;
-                segment++;
+            // negative indices are relative to the number of points read so far
+            const ObjChunk::Face& face = chunk.faces[i];
+            int numRead = offset + static_cast<int>(face.pointsBefore);
+            std::array<int, 4> index {};
+            for (int j = 0; j < face.count; j++) {
+                int value = face.indices[j];
+                index[j] = value > 0 ? value - 1 : value + numRead;
             }
 
-            // 4-vertex face
-            i1 = std::atoi(what[1].first);
-            i1 = i1 > 0 ? i1 - 1 : i1 + static_cast<int>(meshPoints.size());
-            i2 = std::atoi(what[2].first);
-            i2 = i2 > 0 ? i2 - 1 : i2 + static_cast<int>(meshPoints.size());
-            i3 = std::atoi(what[3].first);
-            i3 = i3 > 0 ? i3 - 1 : i3 + static_cast<int>(meshPoints.size());
-            i4 = std::atoi(what[4].first);
-            i4 = i4 > 0 ? i4 - 1 : i4 + static_cast<int>(meshPoints.size());
-
-            item.SetVertices(i1, i2, i3);
+            item.SetVertices(index[0], index[1], index[2]);
             item.SetProperty(segment);
             meshFacets.push_back(item);
             countMaterialFacets++;
 
-            item.SetVertices(i3, i4, i1);
-            item.SetProperty(segment);
-            meshFacets.push_back(item);
-            countMaterialFacets++;
+            // 4-vertex face
+            if (face.count == 4) {
+                item.SetVertices(index[2], index[3], index[0]);
+                item.SetProperty(segment);
+                meshFacets.push_back(item);
+                countMaterialFacets++;
+            }
         }
+
+        for (; cmd != chunk.commands.end(); ++cmd) {
+            applyCommand(*cmd);
+        }
+
+        // release the memory of the chunk early
+        chunk = ObjChunk();
     }
 
     // Add the last added material name
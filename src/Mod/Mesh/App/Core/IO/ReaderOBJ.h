@@ -27,6 +27,7 @@
 #include <Mod/Mesh/App/Core/MeshKernel.h>
 #include <Mod/Mesh/MeshGlobal.h>
 #include <iosfwd>
+#include <string_view>
 
 namespace MeshCore
 {
@@ -47,6 +48,19 @@ public:
      * \return true on success and false otherwise
      */
     bool Load(std::istream& str);
+    /*!
+     * \brief Load the mesh from a block of memory, e.g. a mapped file
+     * \return true on success and false otherwise
+     */
+    bool Load(const char* data, std::size_t size);
+    /*!
+     * \brief Set the minimum number of bytes per part when the data is split
+     * to be parsed on several threads. The default is 1 MB.
+     */
+    void SetChunkSize(std::size_t size)
+    {
+        _minChunkSize = size;
+    }
     /*!
      * \brief Load the material file to the corresponding OBJ file.
      * This function must be called after \ref Load().
@@ -60,9 +74,13 @@ public:
         return _groupNames;
     }
 
+private:
+    bool LoadData(std::string_view data);
+
 private:
     MeshKernel& _kernel;
     Material* _material;
+    std::size_t _minChunkSize {1000000};
     std::vector<std::string> _groupNames;
     std::vector<std::pair<std::string, unsigned long>> _materialNames;
 };
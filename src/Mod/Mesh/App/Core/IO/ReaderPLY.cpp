@@ -24,12 +24,16 @@
 #include "PreCompiled.h"
 #ifndef _PreComp_
 #include <boost/lexical_cast.hpp>
+#include <atomic>
+#include <cstring>
 #include <istream>
 #endif
 
+#include "Core/Functional.h"
 #include "Core/MeshIO.h"
 #include "Core/MeshKernel.h"
 #include <Base/Stream.h>
+#include <Base/Swap.h>
 #include <Base/Tools.h>
 
 #include "ReaderPLY.h"
@@ -391,6 +395,38 @@ bool ReaderPLY::Load(std::istream& input)
     // clang-format on
 }
 
+bool ReaderPLY::Load(const char* data, std::size_t size)
+{
+    Base::MemoryStreambuf buf(data, size);
+    std::istream input(&buf);
+    if (!CheckHeader(input)) {
+        return false;
+    }
+
+    if (!ReadHeader(input)) {
+        return false;
+    }
+
+    if (!VerifyVertexProperty()) {
+        return false;
+    }
+
+    if (!VerifyColorProperty()) {
+        return false;
+    }
+
+    if (format == ascii) {
+        return LoadAscii(input);
+    }
+
+    std::streamoff offset = input.tellg();
+    if (offset < 0) {
+        return false;
+    }
+
+    return LoadBinary(data + offset, size - static_cast<std::size_t>(offset));
+}
+
 void ReaderPLY::CleanupMesh()
 {
     _kernel.Clear();  // remove all data before
@@ -518,6 +554,78 @@ void ReaderPLY::addVertexProperty(const PropertyArray& prop)
     }
 }
 
+void ReaderPLY::setVertexProperty(std::size_t index, const PropertyArray& prop)
+{
+    meshPoints[index].Set(prop[coord_x], prop[coord_y], prop[coord_z]);
+
+    if (_material && _material->binding == MeshIO::PER_VERTEX) {
+        // NOLINTBEGIN
+        float r = (prop[color_r]) / 255.0F;
+        float g = (prop[color_g]) / 255.0F;
+        float b = (prop[color_b]) / 255.0F;
+        // NOLINTEND
+        _material->diffuseColor[index].set(r, g, b);
+    }
+}
+
+std::size_t ReaderPLY::sizeOfNumber(Number number)
+{
+    switch (number) {
+        case int8:
+        case uint8:
+            return 1;
+        case int16:
+        case uint16:
+            return 2;
+        case int32:
+        case uint32:
+        case float32:
+            return 4;
+        case float64:
+            return 8;
+    }
+
+    return 0;
+}
+
+namespace
+{
+template<typename T>
+float readValue(const char* data, bool swap)
+{
+    T value {};
+    std::memcpy(&value, data, sizeof(T));
+    if (swap) {
+        Base::SwapEndian(value);
+    }
+    return static_cast<float>(value);
+}
+}  // namespace
+
+float ReaderPLY::readNumber(Number number, const char* data, bool swap)
+{
+    switch (number) {
+        case int8:
+            return readValue<int8_t>(data, swap);
+        case uint8:
+            return readValue<uint8_t>(data, swap);
+        case int16:
+            return readValue<int16_t>(data, swap);
+        case uint16:
+            return readValue<uint16_t>(data, swap);
+        case int32:
+            return readValue<int32_t>(data, swap);
+        case uint32:
+            return readValue<uint32_t>(data, swap);
+        case float32:
+            return readValue<float>(data, swap);
+        case float64:
+            return readValue<double>(data, swap);
+    }
+
+    return 0.0F;
+}
+
 bool ReaderPLY::ReadVertexes(Base::InputStream& is)
 {
     for (std::size_t i = 0; i < v_count; i++) {
@@ -662,3 +770,113 @@ bool ReaderPLY::LoadBinary(std::istream& input)
     CleanupMesh();
     return true;
 }
+
+bool ReaderPLY::ReadVertexes(const char* data, std::size_t size)
+{
+    // all vertexes have the same size
+    std::size_t v_size = 0;
+    for (const auto& it : vertex_props) {
+        v_size += sizeOfNumber(it.second);
+    }
+    if (v_count > size / std::max<std::size_t>(v_size, 1)) {
+        return false;
+    }
+
+    meshPoints.resize(v_count);
+    if (_material && _material->binding == MeshIO::PER_VERTEX) {
+        _material->diffuseColor.resize(v_count);
+    }
+
+    bool swap = (format == binary_big_endian);
+    MeshCore::parallel_for(v_count, 100000, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            const char* ptr = data + i * v_size;
+            PropertyArray prop_values {};
+            for (const auto& it : vertex_props) {
+                prop_values[it.first] = readNumber(it.second, ptr, swap);
+                ptr += sizeOfNumber(it.second);
+            }
+            setVertexProperty(i, prop_values);
+        }
+    });
+
+    return true;
+}
+
+bool ReaderPLY::ReadFaces(const char* data, std::size_t size)
+{
+    // Faces can only be read in parallel if all of them are triangles without list
+    // properties because only then all of them have the same size
+    std::size_t f_size = sizeof(unsigned char) + 3 * sizeof(uint32_t);
+    for (auto it : face_props) {
+        if (it == float32 || it == float64) {
+            return false;
+        }
+        f_size += sizeOfNumber(it);
+    }
+    if (f_count > size / f_size) {
+        return false;
+    }
+
+    meshFacets.resize(f_count);
+
+    // facets with out-of-range indices are removed in CleanupMesh()
+    bool swap = (format == binary_big_endian);
+    std::atomic<bool> triangles {true};
+    MeshCore::parallel_for(f_count, 100000, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end && triangles; i++) {
+            const char* ptr = data + i * f_size;
+            if (static_cast<unsigned char>(*ptr) != 3) {
+                triangles = false;
+                break;
+            }
+            MeshFacet& face = meshFacets[i];
+            for (int j = 0; j < 3; j++) {
+                const char* index = ptr + 1 + j * sizeof(uint32_t);
+                uint32_t value {};
+                std::memcpy(&value, index, sizeof(value));
+                if (swap) {
+                    Base::SwapEndian(value);
+                }
+                face._aulPoints[j] = value;
+            }
+        }
+    });
+
+    if (!triangles) {
+        meshFacets.clear();
+    }
+
+    return triangles;
+}
+
+bool ReaderPLY::LoadBinary(const char* data, std::size_t size)
+{
+    if (!ReadVertexes(data, size)) {
+        return false;
+    }
+
+    // the faces may have different sizes, then they must be read one after another
+    std::size_t offset = 0;
+    for (const auto& it : vertex_props) {
+        offset += v_count * sizeOfNumber(it.second);
+    }
+    if (!ReadFaces(data + offset, size - offset)) {
+        Base::MemoryStreambuf buf(data + offset, size - offset);
+        std::istream input(&buf);
+        Base::InputStream is(input);
+        if (format == binary_little_endian) {
+            is.setByteOrder(Base::Stream::LittleEndian);
+        }
+        else {
+            is.setByteOrder(Base::Stream::BigEndian);
+        }
+
+        if (!ReadFaces(is)) {
+            return false;
+        }
+    }
+
+    CleanupMesh();
+    return true;
+}
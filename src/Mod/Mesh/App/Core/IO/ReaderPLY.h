@@ -53,6 +53,12 @@ public:
      * \return true on success and false otherwise
      */
     bool Load(std::istream& input);
+    /*!
+     * \brief Load the mesh from a block of memory, e.g. a mapped file. Binary data
+     * is read on several threads.
+     * \return true on success and false otherwise
+     */
+    bool Load(const char* data, std::size_t size);
 
 private:
     bool CheckHeader(std::istream& input) const;
@@ -70,6 +76,9 @@ private:
     bool ReadFaces(Base::InputStream& is);
     bool LoadAscii(std::istream& input);
     bool LoadBinary(std::istream& input);
+    bool LoadBinary(const char* data, std::size_t size);
+    bool ReadVertexes(const char* data, std::size_t size);
+    bool ReadFaces(const char* data, std::size_t size);
     void CleanupMesh();
 
 private:
@@ -88,6 +97,7 @@ private:
     static Property propertyOfName(const std::string& name);
     using PropertyArray = std::array<float, num_props>;
     void addVertexProperty(const PropertyArray& prop);
+    void setVertexProperty(std::size_t index, const PropertyArray& prop);
 
     enum Number
     {
@@ -101,6 +111,9 @@ private:
         float64
     };
 
+    static std::size_t sizeOfNumber(Number number);
+    static float readNumber(Number number, const char* data, bool swap);
+
     struct PropertyComp
     {
         using argument_type_1st = std::pair<Property, int>;
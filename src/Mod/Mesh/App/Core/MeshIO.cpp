@@ -24,7 +24,9 @@
 
 #ifndef _PreComp_
 #include <algorithm>
+#include <bit>
 #include <cmath>
+#include <cstring>
 #include <iomanip>
 #include <sstream>
 #include <string_view>
@@ -36,6 +38,7 @@
 #include <boost/lexical_cast.hpp>
 #include <boost/regex.hpp>
 
+#include "IO/LineParser.h"
 #include "IO/Reader3MF.h"
 #include "IO/ReaderOBJ.h"
 #include "IO/ReaderPLY.h"
@@ -50,6 +53,7 @@
 #include <Base/Reader.h>
 #include <Base/Sequencer.h>
 #include <Base/Stream.h>
+#include <Base/Swap.h>
 #include <Base/Tools.h>
 #include <Base/Writer.h>
 #include <zipios++/gzipoutputstream.h>
@@ -58,6 +62,7 @@
 #include "Builder.h"
 #include "Definitions.h"
 #include "Degeneration.h"
+#include "Functional.h"
 #include "Iterator.h"
 #include "MeshIO.h"
 #include "MeshKernel.h"
@@ -65,6 +70,176 @@
 
 using namespace MeshCore;
 
+namespace
+{
+
+// The values of binary STL files are stored in little-endian byte order
+template<typename T>
+void fromLittleEndian(T& value)
+{
+    if constexpr (std::endian::native == std::endian::big) {
+        Base::SwapEndian(value);
+    }
+}
+
+void fromLittleEndian(Base::Vector3f& vec)
+{
+    fromLittleEndian(vec.x);
+    fromLittleEndian(vec.y);
+    fromLittleEndian(vec.z);
+}
+
+// Does the same check as MeshInput::LoadSTL() but on a block of memory
+bool isBinarySTL(const char* data, std::size_t size)
+{
+    uint32_t ulCt {};
+    std::size_t ulBytes = 50;
+    if (size < 80 + sizeof(ulCt)) {
+        return false;
+    }
+    std::memcpy(&ulCt, data + 80, sizeof(ulCt));
+    fromLittleEndian(ulCt);
+    if (ulCt > 1) {
+        ulBytes = 100;
+    }
+    if (size < 80 + sizeof(ulCt) + ulBytes) {
+        return false;
+    }
+
+    // like strstr() the search stops at the first null character
+    const char* start = data + 80 + sizeof(ulCt);
+    std::string buf(start, strnlen(start, ulBytes));
+    boost::algorithm::to_upper(buf);
+    for (const char* keyword : {"SOLID", "FACET", "NORMAL", "VERTEX", "ENDFACET", "ENDLOOP"}) {
+        if (buf.find(keyword) != std::string::npos) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// Reads an optional color 'r g b [a]' with values in the range of [0, 1] or [0, 255]
+bool readOFFColor(MeshCore::LineParser& parser, Base::Color& color)
+{
+    float r {}, g {}, b {}, a {};
+    if (!MeshCore::LineParser::ToFloat(parser.NextToken(), r)
+        || !MeshCore::LineParser::ToFloat(parser.NextToken(), g)
+        || !MeshCore::LineParser::ToFloat(parser.NextToken(), b)) {
+        return false;
+    }
+
+    // no transparency
+    if (!MeshCore::LineParser::ToFloat(parser.NextToken(), a)) {
+        a = 1.0F;
+    }
+
+    if (r > 1.0F || g > 1.0F || b > 1.0F || a > 1.0F) {
+        r = static_cast<float>(r) / 255.0F;
+        g = static_cast<float>(g) / 255.0F;
+        b = static_cast<float>(b) / 255.0F;
+        a = static_cast<float>(a) / 255.0F;
+    }
+
+    color.set(r, g, b, a);
+    return true;
+}
+
+// A line of the vertex section of an OFF file starts with the three coordinates
+bool readOFFPoint(MeshCore::LineParser& parser, Base::Vector3f& pnt)
+{
+    return MeshCore::LineParser::ToFloat(parser.NextToken(), pnt.x)
+        && MeshCore::LineParser::ToFloat(parser.NextToken(), pnt.y)
+        && MeshCore::LineParser::ToFloat(parser.NextToken(), pnt.z);
+}
+
+// The data of a part of an OFF file that is parsed on its own thread
+struct OFFChunk
+{
+    // the number of points of the whole file before this chunk
+    std::size_t firstPoint {};
+    std::size_t numPoints {};
+    std::size_t numColors {};
+    std::size_t numFaces {};
+    MeshCore::MeshFacetArray facets;
+    std::vector<Base::Color> faceColors;
+};
+
+// Counts the lines of a chunk that define a point
+std::size_t countOFFPoints(std::string_view text)
+{
+    std::size_t count = 0;
+    Base::Vector3f pnt;
+    MeshCore::LineParser parser(text);
+    while (parser.NextLine()) {
+        if (readOFFPoint(parser, pnt)) {
+            count++;
+        }
+    }
+    return count;
+}
+
+// Reads the points into the pre-allocated arrays and the faces into the chunk. Lines are
+// treated as points until all \a points are read.
+void parseOFFChunk(std::string_view text,
+                   std::size_t maxFaces,
+                   OFFChunk& chunk,
+                   MeshCore::MeshPointArray& points,
+                   std::vector<Base::Color>& pointColors)
+{
+    chunk.numPoints = 0;
+    chunk.numColors = 0;
+    chunk.numFaces = 0;
+    chunk.facets.clear();
+    chunk.faceColors.clear();
+
+    std::size_t index = chunk.firstPoint;
+    std::vector<int> faces;
+    MeshCore::LineParser parser(text);
+    while (parser.NextLine()) {
+        if (index < points.size()) {
+            Base::Vector3f pnt;
+            if (readOFFPoint(parser, pnt)) {
+                points[index].Set(pnt.x, pnt.y, pnt.z);
+                if (!pointColors.empty() && readOFFColor(parser, pointColors[index])) {
+                    chunk.numColors++;
+                }
+                chunk.numPoints++;
+                index++;
+            }
+            continue;
+        }
+
+        if (chunk.numFaces >= maxFaces) {
+            break;
+        }
+
+        int count {};
+        if (!MeshCore::LineParser::ToInt(parser.NextToken(), count) || count < 3) {
+            continue;
+        }
+
+        faces.resize(count);
+        if (!std::all_of(faces.begin(), faces.end(), [&parser](int& face) {
+                return MeshCore::LineParser::ToInt(parser.NextToken(), face);
+            })) {
+            continue;
+        }
+
+        for (int i = 0; i < count - 2; i++) {
+            chunk.facets.push_back(MeshCore::MeshFacet(faces[0], faces[i + 1], faces[i + 2]));
+        }
+        chunk.numFaces++;
+
+        Base::Color color;
+        if (readOFFColor(parser, color)) {
+            chunk.faceColors.insert(chunk.faceColors.end(), count - 2, color);
+        }
+    }
+}
+
+}  // namespace
+
 namespace MeshCore
 {
 
@@ -241,7 +416,17 @@ bool MeshInput::LoadAny(const char* FileName)
     // read file
     bool ok = false;
     if (fi.hasExtension({"stl", "ast"})) {
-        ok = LoadSTL(str);
+        // mapped files are parsed directly from memory
+        Base::MappedFile file(fi);
+        if (!file.isMapped()) {
+            ok = LoadSTL(str);
+        }
+        else if (isBinarySTL(file.data(), file.size())) {
+            ok = LoadBinarySTL(file.data(), file.size());
+        }
+        else {
+            ok = LoadAsciiSTL(file.data(), file.size());
+        }
     }
     else if (fi.hasExtension("iv")) {
         ok = LoadInventor(str);
@@ -253,7 +438,9 @@ bool MeshInput::LoadAny(const char* FileName)
         ok = LoadNastran(str);
     }
     else if (fi.hasExtension("obj")) {
-        ok = LoadOBJ(str, FileName);
+        Base::MappedFile file(fi);
+        ok = file.isMapped() ? LoadOBJ(file.data(), file.size(), FileName)
+                             : LoadOBJ(str, FileName);
     }
     else if (fi.hasExtension("smf")) {
         ok = LoadSMF(str);
@@ -268,10 +455,12 @@ bool MeshInput::LoadAny(const char* FileName)
         }
     }
     else if (fi.hasExtension("off")) {
-        ok = LoadOFF(str);
+        Base::MappedFile file(fi);
+        ok = file.isMapped() ? LoadOFF(file.data(), file.size()) : LoadOFF(str);
     }
     else if (fi.hasExtension("ply")) {
-        ok = LoadPLY(str);
+        Base::MappedFile file(fi);
+        ok = file.isMapped() ? LoadPLY(file.data(), file.size()) : LoadPLY(str);
     }
     else {
         throw Base::FileException("File extension not supported", FileName);
@@ -335,6 +524,7 @@ bool MeshInput::LoadSTL(std::istream& input)
     buf->pubseekoff(80, std::ios::beg, std::ios::in);
     uint32_t ulCt {}, ulBytes = 50;
     input.read((char*)&ulCt, sizeof(ulCt));
+    fromLittleEndian(ulCt);
     // if we have a binary STL with a single triangle we can only read-in 50 bytes
     if (ulCt > 1) {
         ulBytes = 100;
@@ -384,6 +574,7 @@ bool MeshInput::LoadSTL(std::istream& input)
 bool MeshInput::LoadOBJ(std::istream& input)
 {
     ReaderOBJ reader(this->_rclMesh, this->_material);
+    reader.SetChunkSize(_minChunkSize);
     if (reader.Load(input)) {
         _groupNames = reader.GetGroupNames();
         return true;
@@ -395,23 +586,40 @@ bool MeshInput::LoadOBJ(std::istream& input)
 bool MeshInput::LoadOBJ(std::istream& input, const char* filename)
 {
     ReaderOBJ reader(this->_rclMesh, this->_material);
+    reader.SetChunkSize(_minChunkSize);
     if (reader.Load(input)) {
-        _groupNames = reader.GetGroupNames();
-        if (this->_material && this->_material->binding == MeshCore::MeshIO::PER_FACE) {
-            Base::FileInfo fi(filename);
-            std::string fn = fi.dirPath() + "/" + this->_material->library;
-            fi.setFile(fn);
-            Base::ifstream mtl(fi, std::ios::in | std::ios::binary);
-            reader.LoadMaterial(mtl);
-            mtl.close();
-        }
+        LoadOBJMaterial(reader, filename);
+        return true;
+    }
 
+    return false;
+}
+
+bool MeshInput::LoadOBJ(const char* data, std::size_t size, const char* filename)
+{
+    ReaderOBJ reader(this->_rclMesh, this->_material);
+    reader.SetChunkSize(_minChunkSize);
+    if (reader.Load(data, size)) {
+        LoadOBJMaterial(reader, filename);
         return true;
     }
 
     return false;
 }
 
+void MeshInput::LoadOBJMaterial(ReaderOBJ& reader, const char* filename)
+{
+    _groupNames = reader.GetGroupNames();
+    if (this->_material && this->_material->binding == MeshCore::MeshIO::PER_FACE) {
+        Base::FileInfo fi(filename);
+        std::string fn = fi.dirPath() + "/" + this->_material->library;
+        fi.setFile(fn);
+        Base::ifstream mtl(fi, std::ios::in | std::ios::binary);
+        reader.LoadMaterial(mtl);
+        mtl.close();
+    }
+}
+
 /** Loads an SMF file. */
 bool MeshInput::LoadSMF(std::istream& input)
 {
@@ -475,18 +683,55 @@ bool MeshInput::LoadSMF(std::istream& input)
 
 /** Loads an OFF file. */
 bool MeshInput::LoadOFF(std::istream& input)
+{
+    bool colorPerVertex = false;
+    int numPoints = 0;
+    int numFaces = 0;
+    if (!ReadOFFHeader(input, colorPerVertex, numPoints, numFaces)) {
+        return false;
+    }
+
+    std::string data;
+    if (!LineParser::ReadAll(input, data)) {
+        return false;
+    }
+
+    return LoadOFFData(data, colorPerVertex, numPoints, numFaces);
+}
+
+bool MeshInput::LoadOFF(const char* data, std::size_t size)
+{
+    // only the header is read through the stream, the data is parsed in place
+    Base::MemoryStreambuf buf(data, size);
+    std::istream input(&buf);
+    bool colorPerVertex = false;
+    int numPoints = 0;
+    int numFaces = 0;
+    if (!ReadOFFHeader(input, colorPerVertex, numPoints, numFaces)) {
+        return false;
+    }
+
+    std::streamoff pos = input.eof() ? std::streamoff(size) : std::streamoff(input.tellg());
+    if (pos < 0 || static_cast<std::size_t>(pos) > size) {
+        return false;
+    }
+
+    return LoadOFFData(std::string_view(data + pos, size - static_cast<std::size_t>(pos)),
+                       colorPerVertex,
+                       numPoints,
+                       numFaces);
+}
+
+bool MeshInput::ReadOFFHeader(std::istream& input,
+                              bool& colorPerVertex,
+                              int& numPoints,
+                              int& numFaces)
 {
     // http://edutechwiki.unige.ch/en/3D_file_format
     boost::regex rx_n(R"(^\s*([0-9]+)\s+([0-9]+)\s+([0-9]+)\s*$)");
     boost::cmatch what;
 
-    bool colorPerVertex = false;
-    std::vector<Base::Color> diffuseColor;
-    MeshPointArray meshPoints;
-    MeshFacetArray meshFacets;
-
     std::string line;
-    MeshFacet item;
 
     if (!input || input.bad()) {
         return false;
@@ -508,10 +753,7 @@ bool MeshInput::LoadOFF(std::istream& input)
     }
 
     // get number of vertices and faces
-    int numPoints = 0, numFaces = 0;
-
-    while (true) {
-        std::getline(input, line);
+    while (std::getline(input, line)) {
         boost::algorithm::to_lower(line);
         if (boost::regex_match(line.c_str(), what, rx_n)) {
             numPoints = std::atoi(what[1].first);
@@ -520,113 +762,70 @@ bool MeshInput::LoadOFF(std::istream& input)
         }
     }
 
-    if (numPoints == 0 || numFaces == 0) {
-        return false;
+    return numPoints != 0 && numFaces != 0;
+}
+
+bool MeshInput::LoadOFFData(std::string_view data, bool colorPerVertex, int numPoints, int numFaces)
+{
+    std::vector<Base::Color> diffuseColor;
+    MeshPointArray meshPoints;
+    MeshFacetArray meshFacets;
+
+    // the rest of the file is split at line boundaries and the parts are parsed in parallel
+    std::vector<std::string_view> parts = LineParser::Split(data, _minChunkSize);
+    std::vector<OFFChunk> chunks(parts.size());
+
+    // the points of the previous chunks must be known to get the index of the first point
+    std::vector<std::size_t> pointCounts(parts.size());
+    MeshCore::parallel_for(parts.size(), 1, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            pointCounts[i] = countOFFPoints(parts[i]);
+        }
+    });
+    std::size_t firstPoint = 0;
+    for (std::size_t i = 0; i < parts.size(); i++) {
+        chunks[i].firstPoint = firstPoint;
+        firstPoint += pointCounts[i];
     }
 
-    meshPoints.reserve(numPoints);
-    meshFacets.reserve(numFaces);
+    std::vector<Base::Color> pointColors;
+    meshPoints.resize(numPoints);
     if (colorPerVertex) {
-        diffuseColor.reserve(numPoints);
-    }
-    else {
-        diffuseColor.reserve(numFaces);
+        pointColors.resize(numPoints);
     }
 
-    int cntPoints = 0;
-    while (cntPoints < numPoints) {
-        if (!std::getline(input, line)) {
-            break;
-        }
-        std::istringstream str(line);
-        str.unsetf(std::ios_base::skipws);
-        str >> std::ws;
-        if (str.eof()) {
-            continue;  // empty line
-        }
-
-        float fX {}, fY {}, fZ {};
-        str >> fX >> std::ws >> fY >> std::ws >> fZ;
-        if (str) {
-            meshPoints.push_back(MeshPoint(Base::Vector3f(fX, fY, fZ)));
-            cntPoints++;
-
-            if (colorPerVertex) {
-                std::size_t pos = std::size_t(str.tellg());
-                if (line.size() > pos) {
-                    float r {}, g {}, b {}, a {};
-                    str >> std::ws >> r >> std::ws >> g >> std::ws >> b;
-                    if (str) {
-                        str >> std::ws >> a;
-                        // no transparency
-                        if (!str) {
-                            a = 1.0F;
-                        }
-
-                        if (r > 1.0F || g > 1.0F || b > 1.0F || a > 1.0F) {
-                            r = static_cast<float>(r) / 255.0F;
-                            g = static_cast<float>(g) / 255.0F;
-                            b = static_cast<float>(b) / 255.0F;
-                            a = static_cast<float>(a) / 255.0F;
-                        }
-                        diffuseColor.emplace_back(r, g, b, a);
-                    }
-                }
-            }
+    std::size_t maxFaces = numFaces;
+    MeshCore::parallel_for(parts.size(), 1, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            parseOFFChunk(parts[i], maxFaces, chunks[i], meshPoints, pointColors);
         }
-    }
+    });
 
-    int cntFaces = 0;
-    while (cntFaces < numFaces) {
-        if (!std::getline(input, line)) {
-            break;
+    std::size_t cntPoints = 0;
+    std::size_t cntColors = 0;
+    std::size_t cntFaces = 0;
+    for (std::size_t i = 0; i < chunks.size(); i++) {
+        OFFChunk& chunk = chunks[i];
+        // ignore the data after the last face
+        if (cntFaces + chunk.numFaces > maxFaces) {
+            parseOFFChunk(parts[i], maxFaces - cntFaces, chunk, meshPoints, pointColors);
         }
-        std::istringstream str(line);
-        str.unsetf(std::ios_base::skipws);
-        str >> std::ws;
-        if (str.eof()) {
-            continue;  // empty line
-        }
-        int count {}, index {};
-        str >> count;
-        if (count >= 3) {
-            std::vector<int> faces;
-            faces.reserve(count);
-
-            for (int i = 0; i < count; i++) {
-                str >> std::ws;
-                str >> index;
-                faces.push_back(index);
-            }
 
-            for (int i = 0; i < count - 2; i++) {
-                item.SetVertices(faces[0], faces[i + 1], faces[i + 2]);
-                meshFacets.push_back(item);
-            }
-            cntFaces++;
-
-            std::size_t pos = std::size_t(str.tellg());
-            if (line.size() > pos) {
-                float r {}, g {}, b {}, a {};
-                str >> std::ws >> r >> std::ws >> g >> std::ws >> b;
-                if (str) {
-                    str >> std::ws >> a;
-                    // no transparency
-                    if (!str) {
-                        a = 1.0F;
-                    }
+        cntPoints += chunk.numPoints;
+        cntColors += chunk.numColors;
+        cntFaces += chunk.numFaces;
+        meshFacets.insert(meshFacets.end(), chunk.facets.begin(), chunk.facets.end());
+        diffuseColor.insert(diffuseColor.end(), chunk.faceColors.begin(), chunk.faceColors.end());
+        chunk = OFFChunk();
+    }
 
-                    if (r > 1.0F || g > 1.0F || b > 1.0F || a > 1.0F) {
-                        r = static_cast<float>(r) / 255.0F;
-                        g = static_cast<float>(g) / 255.0F;
-                        b = static_cast<float>(b) / 255.0F;
-                        a = static_cast<float>(a) / 255.0F;
-                    }
-                    for (int i = 0; i < count - 2; i++) {
-                        diffuseColor.emplace_back(r, g, b, a);
-                    }
-                }
-            }
+    // the file may have less points than expected
+    meshPoints.resize(cntPoints);
+    if (colorPerVertex) {
+        pointColors.resize(cntPoints);
+        diffuseColor.clear();
+        if (cntColors == cntPoints) {
+            diffuseColor.swap(pointColors);
         }
     }
 
@@ -664,6 +863,12 @@ bool MeshInput::LoadPLY(std::istream& input)
     return reader.Load(input);
 }
 
+bool MeshInput::LoadPLY(const char* data, std::size_t size)
+{
+    ReaderPLY reader(this->_rclMesh, this->_material);
+    return reader.Load(data, size);
+}
+
 bool MeshInput::LoadMeshNode(std::istream& input)
 {
     boost::regex rx_p("^v\\s+([-+]?[0-9]*)\\.?([0-9]+([eE][-+]?[0-9]+)?)"
@@ -723,75 +928,56 @@ bool MeshInput::LoadMeshNode(std::istream& input)
 /** Loads an ASCII STL file. */
 bool MeshInput::LoadAsciiSTL(std::istream& input)
 {
-    boost::regex rx_p("^\\s*VERTEX\\s+([-+]?[0-9]*)\\.?([0-9]+([eE][-+]?[0-9]+)?)"
-                      "\\s+([-+]?[0-9]*)\\.?([0-9]+([eE][-+]?[0-9]+)?)"
-                      "\\s+([-+]?[0-9]*)\\.?([0-9]+([eE][-+]?[0-9]+)?)\\s*$");
-    boost::regex rx_f("^\\s*FACET\\s+NORMAL\\s+([-+]?[0-9]*)\\.?([0-9]+([eE][-+]?[0-9]+)?)"
-                      "\\s+([-+]?[0-9]*)\\.?([0-9]+([eE][-+]?[0-9]+)?)"
-                      "\\s+([-+]?[0-9]*)\\.?([0-9]+([eE][-+]?[0-9]+)?)\\s*$");
-    boost::cmatch what;
-
-    std::string line;
-    float fX {}, fY {}, fZ {};
-    unsigned long ulVertexCt {}, ulFacetCt {};
-    MeshGeomFacet clFacet;
-
     if (!input || input.bad()) {
         return false;
     }
 
-    std::streamoff ulSize = 0;
-    std::streambuf* buf = input.rdbuf();
-    ulSize = buf->pubseekoff(0, std::ios::end, std::ios::in);
-    buf->pubseekoff(0, std::ios::beg, std::ios::in);
-    ulSize -= 20;
-
-    // count facets
-    while (std::getline(input, line)) {
-        boost::algorithm::to_upper(line);
-        if (line.find("ENDFACET") != std::string::npos) {
-            ulFacetCt++;
-        }
-        // prevent from reading EOF (as I don't know how to reread the file then)
-        if (input.tellg() > ulSize) {
-            break;
-        }
-        if (line.find("ENDSOLID") != std::string::npos) {
-            break;
-        }
+    std::string data;
+    if (!LineParser::ReadAll(input, data)) {
+        return false;
     }
 
-    // restart from the beginning
-    buf->pubseekoff(0, std::ios::beg, std::ios::in);
-
-#if 0
-    MeshBuilder builder(this->_rclMesh);
-#else
-    MeshFastBuilder builder(this->_rclMesh);
-#endif
-    builder.Initialize(ulFacetCt);
+    return LoadAsciiSTL(data.data(), data.size());
+}
 
-    ulVertexCt = 0;
-    while (std::getline(input, line)) {
-        boost::algorithm::to_upper(line);
-        if (boost::regex_match(line.c_str(), what, rx_f)) {
-            fX = (float)std::atof(what[1].first);
-            fY = (float)std::atof(what[4].first);
-            fZ = (float)std::atof(what[7].first);
-            clFacet.SetNormal(Base::Vector3f(fX, fY, fZ));
-        }
-        else if (boost::regex_match(line.c_str(), what, rx_p)) {
-            fX = (float)std::atof(what[1].first);
-            fY = (float)std::atof(what[4].first);
-            fZ = (float)std::atof(what[7].first);
-            clFacet._aclPoints[ulVertexCt++].Set(fX, fY, fZ);
-            if (ulVertexCt == 3) {
-                ulVertexCt = 0;
-                builder.AddFacet(clFacet);
+bool MeshInput::LoadAsciiSTL(const char* data, std::size_t size)
+{
+    // the data is split at line boundaries and the parts are parsed in parallel
+    std::vector<std::string_view> parts =
+        LineParser::Split(std::string_view(data, size), _minChunkSize);
+    std::vector<std::vector<Base::Vector3f>> vertexes(parts.size());
+    MeshCore::parallel_for(parts.size(), 1, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            LineParser parser(parts[i]);
+            Base::Vector3f pnt;
+            while (parser.NextLine()) {
+                if (boost::algorithm::iequals(parser.NextToken(), "vertex")
+                    && LineParser::ToFloat(parser.NextToken(), pnt.x)
+                    && LineParser::ToFloat(parser.NextToken(), pnt.y)
+                    && LineParser::ToFloat(parser.NextToken(), pnt.z)
+                    && parser.NextToken().empty()) {
+                    vertexes[i].push_back(pnt);
+                }
             }
         }
+    });
+
+    // the three points of a facet may be in different parts
+    std::vector<Base::Vector3f> points;
+    for (auto& it : vertexes) {
+        points.insert(points.end(), it.begin(), it.end());
+        it = std::vector<Base::Vector3f>();
     }
 
+    std::size_t ulFacetCt = points.size() / 3;
+    MeshFastBuilder builder(this->_rclMesh);
+    builder.Resize(static_cast<MeshFastBuilder::size_type>(ulFacetCt));
+    MeshCore::parallel_for(ulFacetCt, 100000, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            builder.SetFacet(static_cast<MeshFastBuilder::size_type>(i), &points[3 * i]);
+        }
+    });
+
     builder.Finish();
 
     return true;
@@ -817,6 +1003,7 @@ bool MeshInput::LoadBinarySTL(std::istream& input)
     if (input.bad()) {
         return false;
     }
+    fromLittleEndian(ulCt);
 
     // get file size and calculate the number of facets
     std::streamoff ulSize = 0;
@@ -845,6 +1032,9 @@ bool MeshInput::LoadBinarySTL(std::istream& input)
     for (uint32_t i = 0; i < ulCt; i++) {
         // read normal, points
         input.read((char*)&clVects, sizeof(clVects));
+        for (auto& vec : clVects) {
+            fromLittleEndian(vec);
+        }
 
         std::swap(clVects[0], clVects[3]);
         builder.AddFacet(clVects);
@@ -858,6 +1048,44 @@ bool MeshInput::LoadBinarySTL(std::istream& input)
     return true;
 }
 
+bool MeshInput::LoadBinarySTL(const char* data, std::size_t size)
+{
+    // 80 bytes header, number of facets and 50 bytes per facet
+    constexpr std::size_t headerSize = 80 + sizeof(uint32_t);
+    constexpr std::size_t recordSize = 50;
+    if (size < headerSize) {
+        return false;
+    }
+
+    uint32_t ulCt {};
+    std::memcpy(&ulCt, data + 80, sizeof(ulCt));
+    fromLittleEndian(ulCt);
+    if (ulCt > (size - headerSize) / recordSize) {
+        return false;  // not a valid STL file
+    }
+
+    MeshFastBuilder builder(this->_rclMesh);
+    builder.Resize(static_cast<MeshFastBuilder::size_type>(ulCt));
+
+    // the records are independent of each other, so they can be read on several threads
+    const char* records = data + headerSize;
+    MeshCore::parallel_for(ulCt, 100000, [&builder, records](std::size_t begin, std::size_t end) {
+        Base::Vector3f clVects[4];
+        for (std::size_t i = begin; i < end; i++) {
+            // normal and points, the 2 bytes attribute is ignored
+            std::memcpy(&clVects, records + i * recordSize, sizeof(clVects));
+            for (auto& vec : clVects) {
+                fromLittleEndian(vec);
+            }
+            builder.SetFacet(static_cast<MeshFastBuilder::size_type>(i), clVects + 1);
+        }
+    });
+
+    builder.Finish();
+
+    return true;
+}
+
 /** Loads the mesh object from an XML file. */
 void MeshInput::LoadXML(Base::XMLReader& reader)
 {
@@ -23,6 +23,8 @@
 #ifndef MESH_IO_H
 #define MESH_IO_H
 
+#include <string_view>
+
 #include <App/Material.h>
 #include <Base/Matrix.h>
 
@@ -39,6 +41,7 @@ namespace MeshCore
 {
 
 class MeshKernel;
+class ReaderOBJ;
 
 namespace MeshIO
 {
@@ -118,6 +121,13 @@ public:
     {
         return _groupNames;
     }
+    /** Sets the minimum number of bytes per part when text formats are split
+     * to be parsed on several threads. The default is 1 MB.
+     */
+    void SetChunkSize(std::size_t size)
+    {
+        _minChunkSize = size;
+    }
 
     /// Loads the file, decided by extension
     bool LoadAny(const char* FileName);
@@ -129,18 +139,32 @@ public:
     bool LoadSTL(std::istream& input);
     /** Loads an ASCII STL file. */
     bool LoadAsciiSTL(std::istream& input);
+    /** Loads an ASCII STL file from a block of memory, e.g. a mapped file. */
+    bool LoadAsciiSTL(const char* data, std::size_t size);
     /** Loads a binary STL file. */
     bool LoadBinarySTL(std::istream& input);
+    /** Loads a binary STL file from a block of memory, e.g. a mapped file.
+     * The facets are read on several threads.
+     */
+    bool LoadBinarySTL(const char* data, std::size_t size);
     /** Loads an OBJ Mesh file. */
     bool LoadOBJ(std::istream& input);
     /** Loads an OBJ Mesh file. */
     bool LoadOBJ(std::istream& input, const char* filename);
+    /** Loads an OBJ Mesh file from a block of memory, e.g. a mapped file.
+     * The material library is looked up next to \a filename.
+     */
+    bool LoadOBJ(const char* data, std::size_t size, const char* filename);
     /** Loads an SMF Mesh file. */
     bool LoadSMF(std::istream& input);
     /** Loads an OFF Mesh file. */
     bool LoadOFF(std::istream& input);
+    /** Loads an OFF Mesh file from a block of memory, e.g. a mapped file. */
+    bool LoadOFF(const char* data, std::size_t size);
     /** Loads a PLY Mesh file. */
     bool LoadPLY(std::istream& input);
+    /** Loads a PLY Mesh file from a block of memory, e.g. a mapped file. */
+    bool LoadPLY(const char* data, std::size_t size);
     /** Loads the mesh object from an XML file. */
     void LoadXML(Base::XMLReader& reader);
     /** Loads the mesh object from a 3MF file. */
@@ -157,10 +181,16 @@ public:
     static std::vector<std::string> supportedMeshFormats();
     static MeshIO::Format getFormat(const char* FileName);
 
+private:
+    void LoadOBJMaterial(ReaderOBJ& reader, const char* filename);
+    bool ReadOFFHeader(std::istream& input, bool& colorPerVertex, int& numPoints, int& numFaces);
+    bool LoadOFFData(std::string_view data, bool colorPerVertex, int numPoints, int numFaces);
+
 private:
     MeshKernel& _rclMesh; /**< reference to mesh data structure */
     Material* _material;
     std::vector<std::string> _groupNames;
+    std::size_t _minChunkSize {1000000};
 };
 
 /**
@@ -46,6 +46,12 @@
 
 using namespace MeshCore;
 
+namespace
+{
+// number of points or facets converted at once when writing or reading the binary format
+constexpr std::size_t streamBlockSize = 4096;
+}  // namespace
+
 MeshKernel::MeshKernel()
 {
     _clBoundBox.SetVoid();
@@ -898,17 +904,35 @@ void MeshKernel::Write(std::ostream& rclOut) const
     // write the number of points and facets
     str << static_cast<uint32_t>(CountPoints()) << static_cast<uint32_t>(CountFacets());
 
-    // write the data
-    for (const auto& it : _aclPointArray) {
-        str << it.x << it.y << it.z;
-    }
-
-    for (const auto& it : _aclFacetArray) {
-        str << static_cast<uint32_t>(it._aulPoints[0]) << static_cast<uint32_t>(it._aulPoints[1])
-            << static_cast<uint32_t>(it._aulPoints[2]);
-        str << static_cast<uint32_t>(it._aulNeighbours[0])
-            << static_cast<uint32_t>(it._aulNeighbours[1])
-            << static_cast<uint32_t>(it._aulNeighbours[2]);
+    // write the data block-wise
+    std::vector<float> points;
+    points.reserve(3 * streamBlockSize);
+    for (std::size_t pos = 0; pos < _aclPointArray.size(); pos += streamBlockSize) {
+        std::size_t end = std::min(pos + streamBlockSize, _aclPointArray.size());
+        points.clear();
+        for (std::size_t i = pos; i < end; i++) {
+            const MeshPoint& pnt = _aclPointArray[i];
+            points.insert(points.end(), {pnt.x, pnt.y, pnt.z});
+        }
+        str.writeArray(points.data(), points.size());
+    }
+
+    std::vector<uint32_t> indices;
+    indices.reserve(6 * streamBlockSize);
+    for (std::size_t pos = 0; pos < _aclFacetArray.size(); pos += streamBlockSize) {
+        std::size_t end = std::min(pos + streamBlockSize, _aclFacetArray.size());
+        indices.clear();
+        for (std::size_t i = pos; i < end; i++) {
+            const MeshFacet& face = _aclFacetArray[i];
+            indices.insert(indices.end(),
+                           {static_cast<uint32_t>(face._aulPoints[0]),
+                            static_cast<uint32_t>(face._aulPoints[1]),
+                            static_cast<uint32_t>(face._aulPoints[2]),
+                            static_cast<uint32_t>(face._aulNeighbours[0]),
+                            static_cast<uint32_t>(face._aulNeighbours[1]),
+                            static_cast<uint32_t>(face._aulNeighbours[2])});
+        }
+        str.writeArray(indices.data(), indices.size());
     }
 
     str << _clBoundBox.MinX << _clBoundBox.MaxX;
@@ -956,16 +980,31 @@ void MeshKernel::Read(std::istream& rclIn)
             // read the data
             MeshPointArray pointArray;
             pointArray.resize(uCtPts);
-            for (auto& it : pointArray) {
-                str >> it.x >> it.y >> it.z;
+            std::vector<float> points(3 * streamBlockSize);
+            for (std::size_t pos = 0; pos < pointArray.size(); pos += streamBlockSize) {
+                std::size_t num = std::min(streamBlockSize, pointArray.size() - pos);
+                str.readArray(points.data(), 3 * num);
+                for (std::size_t i = 0; i < num; i++) {
+                    pointArray[pos + i].Set(points[3 * i], points[3 * i + 1], points[3 * i + 2]);
+                }
             }
 
             MeshFacetArray facetArray;
             facetArray.resize(uCtFts);
 
+            std::vector<uint32_t> indices(6 * streamBlockSize);
             uint32_t v1 {}, v2 {}, v3 {};
-            for (auto& it : facetArray) {
-                str >> v1 >> v2 >> v3;
+            for (std::size_t index = 0; index < facetArray.size(); index++) {
+                std::size_t offset = 6 * (index % streamBlockSize);
+                if (offset == 0) {
+                    std::size_t num = std::min(streamBlockSize, facetArray.size() - index);
+                    str.readArray(indices.data(), 6 * num);
+                }
+
+                MeshFacet& it = facetArray[index];
+                v1 = indices[offset];
+                v2 = indices[offset + 1];
+                v3 = indices[offset + 2];
 
                 // make sure to have valid indices
                 if (v1 >= uCtPts || v2 >= uCtPts || v3 >= uCtPts) {
@@ -980,7 +1019,9 @@ void MeshKernel::Read(std::istream& rclIn)
                 // the empty neighbour must be explicitly set to 'FACET_INDEX_MAX'
                 // because in algorithms this value is always used to check
                 // for open edges.
-                str >> v1 >> v2 >> v3;
+                v1 = indices[offset + 3];
+                v2 = indices[offset + 4];
+                v3 = indices[offset + 5];
 
                 // make sure to have valid indices
                 if (v1 >= uCtFts && v1 < open_edge) {
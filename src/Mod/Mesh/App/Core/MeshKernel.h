@@ -48,6 +48,7 @@ class MeshGeomFacet;
 class MeshFacet;
 class MeshFacetVisitor;
 class MeshPointVisitor;
+class MeshFlagTable;
 class MeshFacetGrid;
 
 
@@ -244,12 +245,24 @@ public:
      */
     unsigned long VisitNeighbourFacets(MeshFacetVisitor& rclFVisitor,
                                        FacetIndex ulStartFacet) const;
+    /**
+     * Does the same as the method above but keeps the visitation state in \a rclVisited
+     * instead of the VISIT flag of the facets. The mesh is not modified, so several of these
+     * algorithms can run on the same mesh at the same time, each with its own table.
+     */
+    unsigned long VisitNeighbourFacets(MeshFacetVisitor& rclFVisitor,
+                                       FacetIndex ulStartFacet,
+                                       MeshFlagTable& rclVisited) const;
     /**
      * Does basically the same as the method above unless the facets that share just a common point
      * are regared as neighbours.
      */
     unsigned long VisitNeighbourFacetsOverCorners(MeshFacetVisitor& rclFVisitor,
                                                   FacetIndex ulStartFacet) const;
+    /** Same as above but keeps the visitation state in \a rclVisited. */
+    unsigned long VisitNeighbourFacetsOverCorners(MeshFacetVisitor& rclFVisitor,
+                                                  FacetIndex ulStartFacet,
+                                                  MeshFlagTable& rclVisited) const;
     //@}
 
     /** @name Point visitors
@@ -272,6 +285,10 @@ public:
      */
     unsigned long VisitNeighbourPoints(MeshPointVisitor& rclPVisitor,
                                        PointIndex ulStartPoint) const;
+    /** Same as above but keeps the visitation state in \a rclVisited. */
+    unsigned long VisitNeighbourPoints(MeshPointVisitor& rclPVisitor,
+                                       PointIndex ulStartPoint,
+                                       MeshFlagTable& rclVisited) const;
     //@}
 
     /** @name Iterators
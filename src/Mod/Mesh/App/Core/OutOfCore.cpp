@@ -0,0 +1,857 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2025 FreeCAD Project Association                         *
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+#include "PreCompiled.h"
+
+#ifndef _PreComp_
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cctype>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <numeric>
+#include <thread>
+#include <unordered_map>
+#endif
+
+#include <Base/Exception.h>
+#include <Base/FileInfo.h>
+#include <Base/Matrix.h>
+#include <Base/Stream.h>
+
+#include "Builder.h"
+#include "Decimation.h"
+#include "Degeneration.h"
+#include "Functional.h"
+#include "MeshKernel.h"
+#include "OutOfCore.h"
+
+
+using namespace MeshCore;
+
+namespace
+{
+constexpr uint32_t chunkFileMagic = 0x4B4E4843;  // "CHNK"
+constexpr uint32_t chunkFileVersion = 1;
+// magic, version, offset and size of the chunk table
+constexpr std::size_t chunkFileHeaderSize = 2 * sizeof(uint32_t) + 2 * sizeof(uint64_t);
+
+std::size_t numThreads()
+{
+    return std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+}
+
+// ----------------------------------------------------------------------------
+
+using FacetPoints = std::array<Base::Vector3f, 3>;
+
+// Gives sequential access to the facets of a mesh, the facets can be read several times
+class FacetSource
+{
+public:
+    FacetSource() = default;
+    virtual ~FacetSource() = default;
+    FacetSource(const FacetSource&) = delete;
+    FacetSource(FacetSource&&) = delete;
+    FacetSource& operator=(const FacetSource&) = delete;
+    FacetSource& operator=(FacetSource&&) = delete;
+
+    virtual void Rewind() = 0;
+    virtual bool Next(FacetPoints& facet) = 0;
+
+    // skips facets that cannot be sorted into the grid
+    bool NextValid(FacetPoints& facet)
+    {
+        while (Next(facet)) {
+            auto valid = [](const Base::Vector3f& pnt) {
+                return std::isfinite(pnt.x) && std::isfinite(pnt.y) && std::isfinite(pnt.z);
+            };
+            if (std::all_of(facet.begin(), facet.end(), valid)) {
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
+class KernelFacetSource: public FacetSource
+{
+public:
+    explicit KernelFacetSource(const MeshKernel& mesh)
+        : _mesh(mesh)
+    {}
+
+    void Rewind() override
+    {
+        _index = 0;
+    }
+
+    bool Next(FacetPoints& facet) override
+    {
+        if (_index >= _mesh.CountFacets()) {
+            return false;
+        }
+
+        const MeshFacet& face = _mesh.GetFacets()[_index++];
+        for (int i = 0; i < 3; i++) {
+            facet[i] = _mesh.GetPoint(face._aulPoints[i]);
+        }
+        return true;
+    }
+
+private:
+    const MeshKernel& _mesh;
+    FacetIndex _index {0};
+};
+
+// Reads the facets of a binary or ASCII STL file
+class STLFacetSource: public FacetSource
+{
+public:
+    explicit STLFacetSource(const std::string& filename)
+        : _str(Base::FileInfo(filename), std::ios::in | std::ios::binary)
+    {
+        if (!_str) {
+            throw Base::FileException("Cannot open file", filename);
+        }
+
+        // a binary STL has an 80 byte header, the number of facets and 50 bytes per facet
+        std::array<char, 84> header {};
+        _str.seekg(0, std::ios::end);
+        auto size = static_cast<uint64_t>(_str.tellg());
+        _str.seekg(0, std::ios::beg);
+        if (size >= header.size() && _str.read(header.data(), header.size())) {
+            uint32_t count {};
+            std::memcpy(&count, header.data() + 80, sizeof(count));
+            if (size == header.size() + 50 * uint64_t(count)) {
+                _binary = true;
+                _count = count;
+            }
+        }
+
+        if (!_binary) {
+            _str.clear();
+            _str.seekg(0, std::ios::beg);
+            std::string word;
+            _str >> word;
+            std::transform(word.begin(), word.end(), word.begin(), ::tolower);
+            if (word != "solid") {
+                throw Base::FileException("Unsupported file format", filename);
+            }
+        }
+        Rewind();
+    }
+
+    void Rewind() override
+    {
+        _str.clear();
+        _str.seekg(_binary ? 84 : 0, std::ios::beg);
+        _index = 0;
+    }
+
+    bool Next(FacetPoints& facet) override
+    {
+        return _binary ? NextBinary(facet) : NextAscii(facet);
+    }
+
+private:
+    bool NextBinary(FacetPoints& facet)
+    {
+        std::array<char, 50> data {};
+        if (_index >= _count || !_str.read(data.data(), data.size())) {
+            return false;
+        }
+
+        _index++;
+        std::array<float, 9> coords {};
+        // skip the normal
+        std::memcpy(coords.data(), data.data() + 12, sizeof(coords));
+        for (std::size_t i = 0; i < 3; i++) {
+            facet[i].Set(coords[3 * i], coords[3 * i + 1], coords[3 * i + 2]);
+        }
+        return true;
+    }
+
+    bool NextAscii(FacetPoints& facet)
+    {
+        std::string word;
+        int count = 0;
+        while (count < 3 && (_str >> word)) {
+            if (word == "vertex" || word == "VERTEX") {
+                float x {}, y {}, z {};
+                if (!(_str >> x >> y >> z)) {
+                    return false;
+                }
+                facet[count++].Set(x, y, z);
+            }
+        }
+        return count == 3;
+    }
+
+private:
+    Base::ifstream _str;
+    bool _binary {false};
+    uint32_t _count {0};
+    uint32_t _index {0};
+};
+
+// ----------------------------------------------------------------------------
+
+// A regular grid over the bounding box of the mesh that is much finer than the chunks. The
+// cells are grouped to chunks along a Z-order curve, so that the chunks are compact and have
+// roughly the same number of facets even if the density of the mesh varies a lot.
+class CellGrid
+{
+public:
+    CellGrid(const Base::BoundBox3f& box, std::size_t numCells)
+        : _box(box)
+    {
+        constexpr std::size_t maxPerAxis = std::size_t(1) << 20;
+        std::array<float, 3> length = {box.LengthX(), box.LengthY(), box.LengthZ()};
+        float size = std::max({length[0], length[1], length[2], 1.0e-6F});
+        auto countCells = [&]() {
+            std::size_t count = 1;
+            for (int i = 0; i < 3; i++) {
+                _dims[i] = std::clamp<std::size_t>(std::size_t(length[i] / size) + 1,
+                                                   1,
+                                                   maxPerAxis);
+                count *= _dims[i];
+            }
+            return count;
+        };
+        while (countCells() < numCells && size > 1.0e-6F) {
+            size *= 0.8F;
+        }
+        for (int i = 0; i < 3; i++) {
+            _scale[i] = length[i] > 0.0F ? float(_dims[i]) / length[i] : 0.0F;
+        }
+    }
+
+    std::size_t Count() const
+    {
+        return _dims[0] * _dims[1] * _dims[2];
+    }
+
+    std::size_t Index(const FacetPoints& facet) const
+    {
+        Base::Vector3f center = (facet[0] + facet[1] + facet[2]) / 3.0F;
+        std::array<float, 3> pos = {center.x - _box.MinX,
+                                    center.y - _box.MinY,
+                                    center.z - _box.MinZ};
+        std::array<std::size_t, 3> cell {};
+        for (int i = 0; i < 3; i++) {
+            float value = std::max(pos[i] * _scale[i], 0.0F);
+            cell[i] = std::min(std::size_t(value), _dims[i] - 1);
+        }
+        return (cell[2] * _dims[1] + cell[1]) * _dims[0] + cell[0];
+    }
+
+    // the position of the cell along the Z-order curve
+    uint64_t Order(std::size_t index) const
+    {
+        std::array<uint64_t, 3> cell = {index % _dims[0],
+                                        (index / _dims[0]) % _dims[1],
+                                        index / (_dims[0] * _dims[1])};
+        uint64_t key = 0;
+        for (int bit = 0; bit < 21; bit++) {
+            for (int i = 0; i < 3; i++) {
+                key |= ((cell[i] >> bit) & 1) << (3 * bit + i);
+            }
+        }
+        return key;
+    }
+
+private:
+    Base::BoundBox3f _box;
+    std::array<std::size_t, 3> _dims {1, 1, 1};
+    std::array<float, 3> _scale {};
+};
+
+// A temporary file next to the output that is removed when leaving the scope, also by an
+// exception
+class TemporaryFile
+{
+public:
+    explicit TemporaryFile(const std::string& filename)
+        : _fi(filename)
+        , _str(_fi.filePath().c_str(),
+               std::ios::in | std::ios::out | std::ios::trunc | std::ios::binary)
+    {
+        if (!_str) {
+            throw Base::FileException("Cannot create temporary file", _fi);
+        }
+    }
+    ~TemporaryFile()
+    {
+        _str.close();
+        _fi.deleteFile();
+    }
+    std::fstream& Stream()
+    {
+        return _str;
+    }
+    const Base::FileInfo& Info() const
+    {
+        return _fi;
+    }
+
+    TemporaryFile(const TemporaryFile&) = delete;
+    TemporaryFile(TemporaryFile&&) = delete;
+    TemporaryFile& operator=(const TemporaryFile&) = delete;
+    TemporaryFile& operator=(TemporaryFile&&) = delete;
+
+private:
+    Base::FileInfo _fi;
+    std::fstream _str;
+};
+
+void partition(FacetSource& source, const std::string& output, std::size_t facetsPerChunk)
+{
+    facetsPerChunk = std::max<std::size_t>(facetsPerChunk, 1);
+
+    // pass 1: bounding box
+    Base::BoundBox3f box;
+    uint64_t numFacets = 0;
+    FacetPoints facet;
+    source.Rewind();
+    while (source.NextValid(facet)) {
+        for (const auto& pnt : facet) {
+            box.Add(pnt);
+        }
+        numFacets++;
+    }
+
+    MeshChunkWriter writer(output);
+    if (numFacets == 0) {
+        writer.Close();
+        return;
+    }
+
+    // pass 2: the number of facets per cell, then the cells are grouped to chunks
+    uint64_t numChunks = (numFacets + facetsPerChunk - 1) / facetsPerChunk;
+    constexpr uint64_t maxCells = uint64_t(1) << 22;
+    CellGrid grid(box, std::size_t(std::min(8 * numChunks, maxCells)));
+    std::vector<uint64_t> cellCount(grid.Count(), 0);
+    source.Rewind();
+    while (source.NextValid(facet)) {
+        cellCount[grid.Index(facet)]++;
+    }
+
+    std::vector<std::size_t> cells(grid.Count());
+    std::iota(cells.begin(), cells.end(), 0);
+    std::vector<uint64_t> order(grid.Count());
+    for (std::size_t i = 0; i < cells.size(); i++) {
+        order[i] = grid.Order(i);
+    }
+    std::sort(cells.begin(), cells.end(), [&order](std::size_t a, std::size_t b) {
+        return order[a] < order[b];
+    });
+
+    std::vector<uint32_t> cellChunk(grid.Count(), 0);
+    uint32_t chunk = 0;
+    uint64_t size = 0;
+    for (std::size_t cell : cells) {
+        if (cellCount[cell] == 0) {
+            continue;
+        }
+        if (size >= facetsPerChunk) {
+            chunk++;
+            size = 0;
+        }
+        cellChunk[cell] = chunk;
+        size += cellCount[cell];
+    }
+    numChunks = chunk + 1;
+
+    // pass 3: the facets are sorted into the chunks and written block-wise to a temporary file
+    struct Block
+    {
+        uint64_t offset;
+        uint64_t count;
+    };
+    TemporaryFile tmp(output + ".part");
+    std::fstream& buffer = tmp.Stream();
+
+    constexpr std::size_t bufferBytes = 64 * 1024 * 1024;
+    std::size_t blockSize = std::clamp<std::size_t>(bufferBytes / (numChunks * sizeof(FacetPoints)),
+                                                    256,
+                                                    65536);
+    std::vector<std::vector<FacetPoints>> pending(numChunks);
+    std::vector<std::vector<Block>> blocks(numChunks);
+    uint64_t offset = 0;
+    auto flush = [&](std::size_t index) {
+        auto& facets = pending[index];
+        std::size_t bytes = facets.size() * sizeof(FacetPoints);
+        buffer.write(reinterpret_cast<const char*>(facets.data()), std::streamsize(bytes));
+        blocks[index].push_back({offset, facets.size()});
+        offset += bytes;
+        facets.clear();
+    };
+
+    source.Rewind();
+    while (source.NextValid(facet)) {
+        uint32_t index = cellChunk[grid.Index(facet)];
+        pending[index].push_back(facet);
+        if (pending[index].size() >= blockSize) {
+            flush(index);
+        }
+    }
+    for (std::size_t index = 0; index < numChunks; index++) {
+        if (!pending[index].empty()) {
+            flush(index);
+        }
+        pending[index].shrink_to_fit();
+    }
+    if (!buffer) {
+        throw Base::FileException("Failed to write temporary file", tmp.Info());
+    }
+
+    // pass 4: each chunk is built with exactly merged points, so the points on the borders of
+    // neighbouring chunks have the same coordinates
+    std::size_t threads = numThreads();
+    for (std::size_t first = 0; first < numChunks; first += threads) {
+        std::size_t count = std::min<std::size_t>(threads, numChunks - first);
+        std::vector<std::vector<FacetPoints>> facets(count);
+        for (std::size_t i = 0; i < count; i++) {
+            for (const auto& block : blocks[first + i]) {
+                std::size_t start = facets[i].size();
+                facets[i].resize(start + block.count);
+                auto bytes = std::streamsize(block.count * sizeof(FacetPoints));
+                buffer.seekg(std::streamoff(block.offset));
+                buffer.read(reinterpret_cast<char*>(facets[i].data() + start), bytes);
+                if (!buffer || buffer.gcount() != bytes) {
+                    throw Base::FileException("Failed to read temporary file", tmp.Info());
+                }
+            }
+        }
+
+        std::vector<MeshKernel> kernels(count);
+        parallel_for(count, 1, [&](std::size_t begin, std::size_t end) {
+            for (std::size_t i = begin; i < end; i++) {
+                MeshFastBuilder builder(kernels[i]);
+                builder.Initialize(MeshFastBuilder::size_type(facets[i].size()));
+                for (const auto& it : facets[i]) {
+                    builder.AddFacet(it.data());
+                }
+                builder.Finish();
+                std::vector<FacetPoints>().swap(facets[i]);
+            }
+        });
+
+        for (const auto& kernel : kernels) {
+            writer.Write(kernel);
+        }
+    }
+
+    writer.Close();
+}
+
+// ----------------------------------------------------------------------------
+
+// The bit pattern of a point, equal points of different chunks have the same key
+struct PointKey
+{
+    std::array<uint32_t, 3> bits;
+
+    explicit PointKey(const Base::Vector3f& pnt)
+        : bits {std::bit_cast<uint32_t>(pnt.x),
+                std::bit_cast<uint32_t>(pnt.y),
+                std::bit_cast<uint32_t>(pnt.z)}
+    {}
+
+    bool operator==(const PointKey& other) const
+    {
+        return bits == other.bits;
+    }
+};
+
+struct PointKeyHash
+{
+    std::size_t operator()(const PointKey& key) const
+    {
+        uint64_t hash = key.bits[0];
+        hash = hash * 0x9E3779B97F4A7C15ULL ^ key.bits[1];
+        hash = hash * 0x9E3779B97F4A7C15ULL ^ key.bits[2];
+        return std::size_t(hash ^ (hash >> 32));
+    }
+};
+
+// Assigns the global point indices for the PLY export. The points on open edges of a chunk are
+// looked up in a map that is shared by all chunks, all other points get a new index.
+class PointNumbering
+{
+public:
+    using Map = std::unordered_map<PointKey, uint64_t, PointKeyHash>;
+
+    // Returns the global indices of the points of the chunk and the points that are new
+    void Assign(const MeshKernel& kernel,
+                std::vector<uint64_t>& indices,
+                std::vector<PointIndex>& added)
+    {
+        const MeshPointArray& points = kernel.GetPoints();
+        const MeshFacetArray& facets = kernel.GetFacets();
+        std::vector<char> border(points.size(), 0);
+        for (const auto& face : facets) {
+            for (int i = 0; i < 3; i++) {
+                if (face._aulNeighbours[i] == FACET_INDEX_MAX) {
+                    border[face._aulPoints[i]] = 1;
+                    border[face._aulPoints[(i + 1) % 3]] = 1;
+                }
+            }
+        }
+
+        indices.resize(points.size());
+        added.clear();
+        for (std::size_t i = 0; i < points.size(); i++) {
+            if (border[i]) {
+                auto result = _map.try_emplace(PointKey(points[i]), _count);
+                if (!result.second) {
+                    indices[i] = result.first->second;
+                    continue;
+                }
+            }
+            indices[i] = _count++;
+            added.push_back(PointIndex(i));
+        }
+    }
+
+    uint64_t Count() const
+    {
+        return _count;
+    }
+
+private:
+    Map _map;
+    uint64_t _count {0};
+};
+
+}  // namespace
+
+// ----------------------------------------------------------------------------
+
+MeshChunkFile::MeshChunkFile(const std::string& filename)
+    : _str(std::make_unique<Base::ifstream>(Base::FileInfo(filename),
+                                            std::ios::in | std::ios::binary))
+{
+    if (!*_str) {
+        throw Base::FileException("Cannot open file", filename);
+    }
+
+    Base::InputStream str(*_str);
+    str.setByteOrder(Base::Stream::LittleEndian);
+    uint32_t magic {}, version {};
+    uint64_t tableOffset {}, numChunks {};
+    str >> magic >> version >> tableOffset >> numChunks;
+    if (!*_str || magic != chunkFileMagic || version != chunkFileVersion) {
+        throw Base::FileException("Not a chunked mesh file", filename);
+    }
+
+    _str->seekg(std::streamoff(tableOffset));
+    _chunks.resize(numChunks);
+    for (auto& chunk : _chunks) {
+        str >> chunk.offset >> chunk.size >> chunk.countPoints >> chunk.countFacets;
+        str >> chunk.box.MinX >> chunk.box.MinY >> chunk.box.MinZ;
+        str >> chunk.box.MaxX >> chunk.box.MaxY >> chunk.box.MaxZ;
+    }
+    if (!*_str) {
+        throw Base::FileException("Invalid chunk table", filename);
+    }
+}
+
+MeshChunkFile::~MeshChunkFile() = default;
+
+bool MeshChunkFile::IsChunkFile(const std::string& filename)
+{
+    Base::ifstream file(Base::FileInfo(filename), std::ios::in | std::ios::binary);
+    Base::InputStream str(file);
+    str.setByteOrder(Base::Stream::LittleEndian);
+    uint32_t magic {}, version {};
+    str >> magic >> version;
+    return file && magic == chunkFileMagic && version == chunkFileVersion;
+}
+
+uint64_t MeshChunkFile::CountFacets() const
+{
+    uint64_t count = 0;
+    for (const auto& chunk : _chunks) {
+        count += chunk.countFacets;
+    }
+    return count;
+}
+
+void MeshChunkFile::Read(std::size_t index, MeshKernel& kernel)
+{
+    _str->clear();
+    _str->seekg(std::streamoff(_chunks[index].offset));
+    kernel.Read(*_str);
+    if (!*_str) {
+        throw Base::BadFormatError("Failed to read chunk");
+    }
+}
+
+// ----------------------------------------------------------------------------
+
+MeshChunkWriter::MeshChunkWriter(const std::string& filename)
+    : _str(std::make_unique<Base::ofstream>(Base::FileInfo(filename),
+                                            std::ios::out | std::ios::trunc | std::ios::binary))
+{
+    if (!*_str) {
+        throw Base::FileException("Cannot create file", filename);
+    }
+
+    // the position of the chunk table is written by Close()
+    std::array<char, chunkFileHeaderSize> header {};
+    _str->write(header.data(), header.size());
+}
+
+MeshChunkWriter::~MeshChunkWriter()
+{
+    try {
+        Close();
+    }
+    catch (...) {
+    }
+}
+
+void MeshChunkWriter::Write(const MeshKernel& kernel)
+{
+    MeshChunkFile::Chunk chunk;
+    chunk.offset = static_cast<uint64_t>(_str->tellp());
+    chunk.countPoints = static_cast<uint32_t>(kernel.CountPoints());
+    chunk.countFacets = static_cast<uint32_t>(kernel.CountFacets());
+    chunk.box = kernel.GetBoundBox();
+    kernel.Write(*_str);
+    chunk.size = static_cast<uint64_t>(_str->tellp()) - chunk.offset;
+    if (!*_str) {
+        throw Base::FileException("Failed to write chunk");
+    }
+    _chunks.push_back(chunk);
+}
+
+void MeshChunkWriter::Close()
+{
+    if (!_str) {
+        return;
+    }
+
+    Base::OutputStream str(*_str);
+    str.setByteOrder(Base::Stream::LittleEndian);
+    auto tableOffset = static_cast<uint64_t>(_str->tellp());
+    for (const auto& chunk : _chunks) {
+        str << chunk.offset << chunk.size << chunk.countPoints << chunk.countFacets;
+        str << chunk.box.MinX << chunk.box.MinY << chunk.box.MinZ;
+        str << chunk.box.MaxX << chunk.box.MaxY << chunk.box.MaxZ;
+    }
+
+    _str->seekp(0);
+    str << chunkFileMagic << chunkFileVersion << tableOffset << uint64_t(_chunks.size());
+    bool ok = static_cast<bool>(*_str);
+    _str.reset();
+    if (!ok) {
+        throw Base::FileException("Failed to write chunk table");
+    }
+}
+
+// ----------------------------------------------------------------------------
+
+void MeshOutOfCore::Partition(const std::string& input,
+                              const std::string& output,
+                              std::size_t facetsPerChunk)
+{
+    STLFacetSource source(input);
+    partition(source, output, facetsPerChunk);
+}
+
+void MeshOutOfCore::Partition(const MeshKernel& mesh,
+                              const std::string& output,
+                              std::size_t facetsPerChunk)
+{
+    KernelFacetSource source(mesh);
+    partition(source, output, facetsPerChunk);
+}
+
+void MeshOutOfCore::Process(const std::string& input,
+                            const std::string& output,
+                            const Operation& op)
+{
+    if (Base::FileInfo(input).filePath() == Base::FileInfo(output).filePath()) {
+        throw Base::FileException("Input and output must be different files", output);
+    }
+
+    MeshChunkFile file(input);
+    MeshChunkWriter writer(output);
+
+    // a batch of chunks is read, processed in parallel and written in the original order
+    std::size_t threads = numThreads();
+    std::size_t numChunks = file.CountChunks();
+    for (std::size_t first = 0; first < numChunks; first += threads) {
+        std::size_t count = std::min(threads, numChunks - first);
+        std::vector<MeshKernel> kernels(count);
+        for (std::size_t i = 0; i < count; i++) {
+            file.Read(first + i, kernels[i]);
+        }
+
+        parallel_for(count, 1, [&](std::size_t begin, std::size_t end) {
+            for (std::size_t i = begin; i < end; i++) {
+                op(kernels[i]);
+            }
+        });
+
+        for (const auto& kernel : kernels) {
+            writer.Write(kernel);
+        }
+    }
+
+    writer.Close();
+}
+
+MeshOutOfCore::Operation MeshOutOfCore::Transform(const Base::Matrix4D& mat)
+{
+    return [mat](MeshKernel& kernel) {
+        kernel.Transform(mat);
+    };
+}
+
+MeshOutOfCore::Operation MeshOutOfCore::Cleanup()
+{
+    return [](MeshKernel& kernel) {
+        MeshFixCorruptedFacets(kernel).Fixup();
+        MeshFixDuplicateFacets(kernel).Fixup();
+    };
+}
+
+MeshOutOfCore::Operation MeshOutOfCore::Decimate(float reduction, float maxError)
+{
+    return [reduction, maxError](MeshKernel& kernel) {
+        float keep = 1.0F - std::clamp(reduction, 0.0F, 1.0F);
+        auto target = static_cast<std::size_t>(keep * static_cast<float>(kernel.CountFacets()));
+        MeshDecimation dm(kernel);
+        dm.SetMaxError(maxError);
+        dm.SetLockBorders(true);
+        dm.Decimate(target);
+    };
+}
+
+bool MeshOutOfCore::SaveBinarySTL(const std::string& input, std::ostream& output)
+{
+    if (!output || output.bad()) {
+        return false;
+    }
+
+    MeshChunkFile file(input);
+    if (file.CountFacets() > std::numeric_limits<uint32_t>::max()) {
+        throw Base::ValueError("Too many facets for STL format");
+    }
+
+    std::array<char, 80> header {};
+    std::strncpy(header.data(), "Chunked mesh", header.size());
+    output.write(header.data(), header.size());
+
+    Base::OutputStream str(output);
+    str.setByteOrder(Base::Stream::LittleEndian);
+    str << static_cast<uint32_t>(file.CountFacets());
+
+    MeshKernel kernel;
+    for (std::size_t index = 0; index < file.CountChunks(); index++) {
+        file.Read(index, kernel);
+        const MeshPointArray& points = kernel.GetPoints();
+        for (const auto& face : kernel.GetFacets()) {
+            const MeshPoint& p0 = points[face._aulPoints[0]];
+            const MeshPoint& p1 = points[face._aulPoints[1]];
+            const MeshPoint& p2 = points[face._aulPoints[2]];
+            Base::Vector3f normal = (p1 - p0) % (p2 - p0);
+            normal.Normalize();
+            str << normal.x << normal.y << normal.z;
+            for (const auto& pnt : {p0, p1, p2}) {
+                str << pnt.x << pnt.y << pnt.z;
+            }
+            str << uint16_t(0);
+        }
+    }
+
+    return static_cast<bool>(output);
+}
+
+bool MeshOutOfCore::SaveBinaryPLY(const std::string& input, std::ostream& output)
+{
+    if (!output || output.bad()) {
+        return false;
+    }
+
+    MeshChunkFile file(input);
+    MeshKernel kernel;
+    std::vector<uint64_t> indices;
+    std::vector<PointIndex> added;
+
+    // the chunks are read three times: to count the points, to write the points and to write
+    // the facets
+    PointNumbering counter;
+    for (std::size_t index = 0; index < file.CountChunks(); index++) {
+        file.Read(index, kernel);
+        counter.Assign(kernel, indices, added);
+    }
+    if (counter.Count() > uint64_t(std::numeric_limits<int32_t>::max())) {
+        throw Base::ValueError("Too many points for PLY format");
+    }
+
+    output << "ply\n"
+           << "format binary_little_endian 1.0\n"
+           << "comment Created by FreeCAD <https://www.freecad.org>\n"
+           << "element vertex " << counter.Count() << '\n'
+           << "property float32 x\n"
+           << "property float32 y\n"
+           << "property float32 z\n"
+           << "element face " << file.CountFacets() << '\n'
+           << "property list uchar int vertex_index\n"
+           << "end_header\n";
+
+    Base::OutputStream str(output);
+    str.setByteOrder(Base::Stream::LittleEndian);
+
+    PointNumbering points;
+    for (std::size_t index = 0; index < file.CountChunks(); index++) {
+        file.Read(index, kernel);
+        points.Assign(kernel, indices, added);
+        for (PointIndex it : added) {
+            const MeshPoint& pnt = kernel.GetPoints()[it];
+            str << pnt.x << pnt.y << pnt.z;
+        }
+    }
+
+    PointNumbering facets;
+    for (std::size_t index = 0; index < file.CountChunks(); index++) {
+        file.Read(index, kernel);
+        facets.Assign(kernel, indices, added);
+        for (const auto& face : kernel.GetFacets()) {
+            str << uint8_t(3);
+            for (PointIndex it : face._aulPoints) {
+                str << static_cast<int32_t>(indices[it]);
+            }
+        }
+    }
+
+    return static_cast<bool>(output);
+}
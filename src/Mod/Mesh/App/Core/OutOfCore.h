@@ -0,0 +1,177 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2025 FreeCAD Project Association                         *
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+#ifndef MESH_OUTOFCORE_H
+#define MESH_OUTOFCORE_H
+
+#include <cstdint>
+#include <functional>
+#include <iosfwd>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <Base/BoundBox.h>
+
+#include "Definitions.h"
+
+
+namespace Base
+{
+class Matrix4D;
+}
+
+namespace MeshCore
+{
+
+class MeshKernel;
+
+/**
+ * The MeshChunkFile class reads a chunked mesh file. Such a file holds a mesh that is split
+ * into spatially coherent chunks, each of them stored like a MeshKernel, so that meshes larger
+ * than the main memory can be processed one chunk after the other. Points on the border
+ * between chunks are stored in each of them with exactly the same coordinates.
+ *
+ * The file starts with a header followed by the chunks and a table with the position, size
+ * and bounding box of each chunk.
+ */
+class MeshExport MeshChunkFile
+{
+public:
+    struct Chunk
+    {
+        uint64_t offset {};
+        uint64_t size {};
+        uint32_t countPoints {};
+        uint32_t countFacets {};
+        Base::BoundBox3f box;
+    };
+
+    /** Opens the file \a filename, throws a Base::FileException if it isn't a chunked mesh
+     * file. */
+    explicit MeshChunkFile(const std::string& filename);
+    ~MeshChunkFile();
+    MeshChunkFile(const MeshChunkFile&) = delete;
+    MeshChunkFile(MeshChunkFile&&) = delete;
+    MeshChunkFile& operator=(const MeshChunkFile&) = delete;
+    MeshChunkFile& operator=(MeshChunkFile&&) = delete;
+
+    /** Returns true if \a filename is a chunked mesh file. */
+    static bool IsChunkFile(const std::string& filename);
+
+    std::size_t CountChunks() const
+    {
+        return _chunks.size();
+    }
+    /** Returns the number of facets of all chunks. */
+    uint64_t CountFacets() const;
+    const Chunk& GetChunk(std::size_t index) const
+    {
+        return _chunks[index];
+    }
+    /** Reads the chunk with index \a index into \a kernel. */
+    void Read(std::size_t index, MeshKernel& kernel);
+
+private:
+    std::unique_ptr<std::istream> _str;
+    std::vector<Chunk> _chunks;
+};
+
+/**
+ * The MeshChunkWriter class writes a chunked mesh file, see MeshChunkFile.
+ */
+class MeshExport MeshChunkWriter
+{
+public:
+    /** Creates the file \a filename, throws a Base::FileException on failure. */
+    explicit MeshChunkWriter(const std::string& filename);
+    /** Calls Close() if not done yet. */
+    ~MeshChunkWriter();
+    MeshChunkWriter(const MeshChunkWriter&) = delete;
+    MeshChunkWriter(MeshChunkWriter&&) = delete;
+    MeshChunkWriter& operator=(const MeshChunkWriter&) = delete;
+    MeshChunkWriter& operator=(MeshChunkWriter&&) = delete;
+
+    /** Appends \a kernel as the next chunk. */
+    void Write(const MeshKernel& kernel);
+    /** Writes the chunk table and closes the file. */
+    void Close();
+
+private:
+    std::unique_ptr<std::ostream> _str;
+    std::vector<MeshChunkFile::Chunk> _chunks;
+};
+
+/**
+ * The MeshOutOfCore class processes meshes that are too large for the main memory. The mesh is
+ * first split into a chunked mesh file, see MeshChunkFile, and then each operation streams the
+ * chunks from disk. Several chunks are processed in parallel, so the memory needed is about the
+ * size of a chunk times the number of threads.
+ *
+ * Operations on chunks must not move the points on the open borders of a chunk, as otherwise
+ * the chunks don't fit together any more.
+ */
+class MeshExport MeshOutOfCore
+{
+public:
+    using Operation = std::function<void(MeshKernel&)>;
+
+    /** Splits the facets of the STL file \a input into chunks of about \a facetsPerChunk facets
+     * and writes them to the chunked mesh file \a output. The input file is read three times
+     * and only a small part of it is kept in memory.
+     */
+    static void Partition(const std::string& input,
+                          const std::string& output,
+                          std::size_t facetsPerChunk);
+    /** Splits \a mesh into chunks of about \a facetsPerChunk facets. */
+    static void Partition(const MeshKernel& mesh,
+                          const std::string& output,
+                          std::size_t facetsPerChunk);
+
+    /** Applies \a op to each chunk of \a input and writes the result to \a output. The
+     * operation is called for several chunks at the same time.
+     */
+    static void Process(const std::string& input, const std::string& output, const Operation& op);
+
+    /** Returns an operation that transforms the points with \a mat. */
+    static Operation Transform(const Base::Matrix4D& mat);
+    /** Returns an operation that removes corrupted and duplicated facets. */
+    static Operation Cleanup();
+    /** Returns an operation that removes the fraction \a reduction of the facets with
+     * MeshDecimation. \a maxError limits the distance of the removed points to the surface.
+     * The borders of the chunks are kept.
+     */
+    static Operation Decimate(float reduction, float maxError);
+
+    /** Writes all chunks of \a input as binary STL. */
+    static bool SaveBinarySTL(const std::string& input, std::ostream& output);
+    /** Writes all chunks of \a input as binary PLY. Equal points on the borders of the chunks
+     * are merged again.
+     */
+    static bool SaveBinaryPLY(const std::string& input, std::ostream& output);
+};
+
+}  // namespace MeshCore
+
+
+#endif  // MESH_OUTOFCORE_H
@@ -556,34 +556,17 @@ bool MeshSurfaceVisitor::Visit(const MeshFacet& face,
 
 void MeshSegmentAlgorithm::FindSegments(std::vector<MeshSurfaceSegmentPtr>& segm)
 {
-    // reset VISIT flags
+    // the visited facets are kept outside of the mesh
     FacetIndex startFacet {};
-    MeshCore::MeshAlgorithm cAlgo(myKernel);
-    cAlgo.ResetFacetFlag(MeshCore::MeshFacet::VISIT);
-
-    const MeshCore::MeshFacetArray& rFAry = myKernel.GetFacets();
-    MeshCore::MeshFacetArray::_TConstIterator iCur = rFAry.begin();
-    MeshCore::MeshFacetArray::_TConstIterator iBeg = rFAry.begin();
-    MeshCore::MeshFacetArray::_TConstIterator iEnd = rFAry.end();
-
-    // start from the first not visited facet
-    cAlgo.CountFacetFlag(MeshCore::MeshFacet::VISIT);
+    MeshFlagTable visited(myKernel.CountFacets());
     std::vector<FacetIndex> resetVisited;
 
     for (auto& it : segm) {
-        cAlgo.ResetFacetsFlag(resetVisited, MeshCore::MeshFacet::VISIT);
+        visited.Unset(resetVisited);
         resetVisited.clear();
 
-        MeshCore::MeshIsNotFlag<MeshCore::MeshFacet> flag;
-        iCur = std::find_if(iBeg, iEnd, [flag](const MeshFacet& f) {
-            return flag(f, MeshFacet::VISIT);
-        });
-        if (iCur < iEnd) {
-            startFacet = iCur - iBeg;
-        }
-        else {
-            startFacet = FACET_INDEX_MAX;
-        }
+        // start from the first not visited facet
+        startFacet = visited.FindFirstUnset();
         while (startFacet != FACET_INDEX_MAX) {
             // collect all facets of the same geometry
             std::vector<FacetIndex> indices;
@@ -592,7 +575,7 @@ void MeshSegmentAlgorithm::FindSegments(std::vector<MeshSurfaceSegmentPtr>& segm
                 indices.push_back(startFacet);
             }
             MeshSurfaceVisitor pv(*it, indices);
-            myKernel.VisitNeighbourFacets(pv, startFacet);
+            myKernel.VisitNeighbourFacets(pv, startFacet, visited);
 
             // add or discard the segment
             if (indices.size() <= 1) {
@@ -603,15 +586,7 @@ void MeshSegmentAlgorithm::FindSegments(std::vector<MeshSurfaceSegmentPtr>& segm
             }
 
             // search for the next start facet
-            iCur = std::find_if(iCur, iEnd, [flag](const MeshFacet& f) {
-                return flag(f, MeshFacet::VISIT);
-            });
-            if (iCur < iEnd) {
-                startFacet = iCur - iBeg;
-            }
-            else {
-                startFacet = FACET_INDEX_MAX;
-            }
+            startFacet = visited.FindFirstUnset(startFacet);
         }
     }
 }
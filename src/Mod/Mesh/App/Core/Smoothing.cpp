@@ -22,6 +22,7 @@
 
 #include "PreCompiled.h"
 #ifndef _PreComp_
+#include <algorithm>
 #include <cmath>
 #endif
 
@@ -29,6 +30,7 @@
 
 #include "Algorithm.h"
 #include "Approximation.h"
+#include "Functional.h"
 #include "Iterator.h"
 #include "MeshKernel.h"
 #include "Smoothing.h"
@@ -36,6 +38,63 @@
 
 using namespace MeshCore;
 
+namespace
+{
+// Point coordinates as separate arrays. The smoothing sweeps read one buffer and write
+// another one so that the points can be processed in parallel.
+struct PointBuffer
+{
+    explicit PointBuffer(const MeshPointArray& points)
+        : x(points.size())
+        , y(points.size())
+        , z(points.size())
+    {
+        for (std::size_t i = 0; i < points.size(); i++) {
+            x[i] = static_cast<double>(points[i].x);
+            y[i] = static_cast<double>(points[i].y);
+            z[i] = static_cast<double>(points[i].z);
+        }
+    }
+
+    Base::Vector3d Get(std::size_t index) const
+    {
+        return Base::Vector3d(x[index], y[index], z[index]);
+    }
+
+    void Set(std::size_t index, const Base::Vector3d& pnt)
+    {
+        x[index] = pnt.x;
+        y[index] = pnt.y;
+        z[index] = pnt.z;
+    }
+
+    void Store(MeshKernel& kernel, const std::vector<PointIndex>& point_indices) const
+    {
+        parallel_for(point_indices.size(), 4096, [&](std::size_t begin, std::size_t end) {
+            for (std::size_t i = begin; i < end; i++) {
+                PointIndex pos = point_indices[i];
+                kernel.SetPoint(pos,
+                                static_cast<float>(x[pos]),
+                                static_cast<float>(y[pos]),
+                                static_cast<float>(z[pos]));
+            }
+        });
+    }
+
+    std::vector<double> x, y, z;
+};
+
+// Sorted copy of the point indices without duplicates, so that each point is written by
+// one thread only
+std::vector<PointIndex> uniqueIndices(const std::vector<PointIndex>& point_indices)
+{
+    std::vector<PointIndex> indices(point_indices);
+    std::sort(indices.begin(), indices.end());
+    indices.erase(std::unique(indices.begin(), indices.end()), indices.end());
+    return indices;
+}
+}  // namespace
+
 
 AbstractSmoothing::AbstractSmoothing(MeshKernel& m)
     : kernel(m)
@@ -169,99 +228,61 @@ LaplaceSmoothing::LaplaceSmoothing(MeshKernel& m)
     : AbstractSmoothing(m)
 {}
 
-void LaplaceSmoothing::Umbrella(const MeshRefPointToPoints& vv_it,
-                                const MeshRefPointToFacets& vf_it,
-                                double stepsize)
+void LaplaceSmoothing::Umbrella(const std::vector<PointIndex>& point_indices,
+                                const std::vector<double>& stepsizes)
 {
-    const MeshCore::MeshPointArray& points = kernel.GetPoints();
-    MeshCore::MeshPointArray::_TConstIterator v_it, v_beg = points.begin(), v_end = points.end();
-
-    PointIndex pos = 0;
-    for (v_it = points.begin(); v_it != v_end; ++v_it, ++pos) {
-        const std::set<PointIndex>& cv = vv_it[pos];
-        if (cv.size() < 3) {
-            continue;
-        }
-        if (cv.size() != vf_it[pos].size()) {
-            // do nothing for border points
-            continue;
-        }
-
-        size_t n_count = cv.size();
-        double w {};
-        w = 1.0 / double(n_count);
+    MeshCore::MeshCompactAdjacency vv_it(kernel, MeshCompactAdjacency::PointToPoints);
+    MeshCore::MeshCompactAdjacency vf_it(kernel, MeshCompactAdjacency::PointToFacets);
+    std::vector<PointIndex> indices = uniqueIndices(point_indices);
+
+    PointBuffer source(kernel.GetPoints());
+    PointBuffer target(source);
+    for (double stepsize : stepsizes) {
+        parallel_for(indices.size(), 1024, [&](std::size_t begin, std::size_t end) {
+            for (std::size_t i = begin; i < end; i++) {
+                PointIndex pos = indices[i];
+                std::span<const ElementIndex> cv = vv_it[pos];
+                double px = source.x[pos];
+                double py = source.y[pos];
+                double pz = source.z[pos];
+                // do nothing for border points
+                if (cv.size() < 3 || cv.size() != vf_it.CountNeighbours(pos)) {
+                    target.x[pos] = px;
+                    target.y[pos] = py;
+                    target.z[pos] = pz;
+                    continue;
+                }
 
-        double delx = 0.0, dely = 0.0, delz = 0.0;
-        std::set<PointIndex>::const_iterator cv_it;
-        for (cv_it = cv.begin(); cv_it != cv.end(); ++cv_it) {
-            delx += w * static_cast<double>((v_beg[*cv_it]).x - v_it->x);
-            dely += w * static_cast<double>((v_beg[*cv_it]).y - v_it->y);
-            delz += w * static_cast<double>((v_beg[*cv_it]).z - v_it->z);
-        }
+                double delx = 0.0, dely = 0.0, delz = 0.0;
+                for (ElementIndex it : cv) {
+                    delx += source.x[it];
+                    dely += source.y[it];
+                    delz += source.z[it];
+                }
 
-        float x = static_cast<float>(static_cast<double>(v_it->x) + stepsize * delx);
-        float y = static_cast<float>(static_cast<double>(v_it->y) + stepsize * dely);
-        float z = static_cast<float>(static_cast<double>(v_it->z) + stepsize * delz);
-        kernel.SetPoint(pos, x, y, z);
+                double w = stepsize / double(cv.size());
+                target.x[pos] = px + w * (delx - double(cv.size()) * px);
+                target.y[pos] = py + w * (dely - double(cv.size()) * py);
+                target.z[pos] = pz + w * (delz - double(cv.size()) * pz);
+            }
+        });
+        std::swap(source, target);
     }
-}
-
-void LaplaceSmoothing::Umbrella(const MeshRefPointToPoints& vv_it,
-                                const MeshRefPointToFacets& vf_it,
-                                double stepsize,
-                                const std::vector<PointIndex>& point_indices)
-{
-    const MeshCore::MeshPointArray& points = kernel.GetPoints();
-    MeshCore::MeshPointArray::_TConstIterator v_beg = points.begin();
 
-    for (PointIndex it : point_indices) {
-        const std::set<PointIndex>& cv = vv_it[it];
-        if (cv.size() < 3) {
-            continue;
-        }
-        if (cv.size() != vf_it[it].size()) {
-            // do nothing for border points
-            continue;
-        }
-
-        size_t n_count = cv.size();
-        double w {};
-        w = 1.0 / double(n_count);
-
-        double delx = 0.0, dely = 0.0, delz = 0.0;
-        std::set<PointIndex>::const_iterator cv_it;
-        for (cv_it = cv.begin(); cv_it != cv.end(); ++cv_it) {
-            delx += w * static_cast<double>((v_beg[*cv_it]).x - (v_beg[it]).x);
-            dely += w * static_cast<double>((v_beg[*cv_it]).y - (v_beg[it]).y);
-            delz += w * static_cast<double>((v_beg[*cv_it]).z - (v_beg[it]).z);
-        }
-
-        float x = static_cast<float>(static_cast<double>((v_beg[it]).x) + stepsize * delx);
-        float y = static_cast<float>(static_cast<double>((v_beg[it]).y) + stepsize * dely);
-        float z = static_cast<float>(static_cast<double>((v_beg[it]).z) + stepsize * delz);
-        kernel.SetPoint(it, x, y, z);
-    }
+    source.Store(kernel, indices);
 }
 
 void LaplaceSmoothing::Smooth(unsigned int iterations)
 {
-    MeshCore::MeshRefPointToPoints vv_it(kernel);
-    MeshCore::MeshRefPointToFacets vf_it(kernel);
-
-    for (unsigned int i = 0; i < iterations; i++) {
-        Umbrella(vv_it, vf_it, lambda);
-    }
+    std::vector<PointIndex> point_indices(kernel.CountPoints());
+    std::generate(point_indices.begin(), point_indices.end(), Base::iotaGen<PointIndex>(0));
+    Umbrella(point_indices, std::vector<double>(iterations, lambda));
 }
 
 void LaplaceSmoothing::SmoothPoints(unsigned int iterations,
                                     const std::vector<PointIndex>& point_indices)
 {
-    MeshCore::MeshRefPointToPoints vv_it(kernel);
-    MeshCore::MeshRefPointToFacets vf_it(kernel);
-
-    for (unsigned int i = 0; i < iterations; i++) {
-        Umbrella(vv_it, vf_it, lambda, point_indices);
-    }
+    Umbrella(point_indices, std::vector<double>(iterations, lambda));
 }
 
 TaubinSmoothing::TaubinSmoothing(MeshKernel& m)
@@ -270,29 +291,23 @@ TaubinSmoothing::TaubinSmoothing(MeshKernel& m)
 
 void TaubinSmoothing::Smooth(unsigned int iterations)
 {
-    MeshCore::MeshRefPointToPoints vv_it(kernel);
-    MeshCore::MeshRefPointToFacets vf_it(kernel);
-
-    // Theoretically Taubin does not shrink the surface
-    iterations = (iterations + 1) / 2;  // two steps per iteration
-    for (unsigned int i = 0; i < iterations; i++) {
-        Umbrella(vv_it, vf_it, GetLambda());
-        Umbrella(vv_it, vf_it, -(GetLambda() + micro));
-    }
+    std::vector<PointIndex> point_indices(kernel.CountPoints());
+    std::generate(point_indices.begin(), point_indices.end(), Base::iotaGen<PointIndex>(0));
+    SmoothPoints(iterations, point_indices);
 }
 
 void TaubinSmoothing::SmoothPoints(unsigned int iterations,
                                    const std::vector<PointIndex>& point_indices)
 {
-    MeshCore::MeshRefPointToPoints vv_it(kernel);
-    MeshCore::MeshRefPointToFacets vf_it(kernel);
-
     // Theoretically Taubin does not shrink the surface
     iterations = (iterations + 1) / 2;  // two steps per iteration
+    std::vector<double> stepsizes;
+    stepsizes.reserve(2 * iterations);
     for (unsigned int i = 0; i < iterations; i++) {
-        Umbrella(vv_it, vf_it, GetLambda(), point_indices);
-        Umbrella(vv_it, vf_it, -(GetLambda() + micro), point_indices);
+        stepsizes.push_back(GetLambda());
+        stepsizes.push_back(-(GetLambda() + micro));
     }
+    Umbrella(point_indices, stepsizes);
 }
 
 namespace
@@ -327,94 +342,103 @@ MedianFilterSmoothing::MedianFilterSmoothing(MeshKernel& m)
 
 void MedianFilterSmoothing::Smooth(unsigned int iterations)
 {
-    std::vector<unsigned long> point_indices(kernel.CountPoints());
-    std::generate(point_indices.begin(), point_indices.end(), Base::iotaGen<unsigned long>(0));
-    MeshCore::MeshRefFacetToFacets ff_it(kernel);
-    MeshCore::MeshRefPointToFacets vf_it(kernel);
-
-    for (unsigned int i = 0; i < iterations; i++) {
-        UpdatePoints(ff_it, vf_it, point_indices);
-    }
+    std::vector<PointIndex> point_indices(kernel.CountPoints());
+    std::generate(point_indices.begin(), point_indices.end(), Base::iotaGen<PointIndex>(0));
+    UpdatePoints(iterations, point_indices);
 }
 
 void MedianFilterSmoothing::SmoothPoints(unsigned int iterations,
                                          const std::vector<PointIndex>& point_indices)
 {
-    MeshCore::MeshRefFacetToFacets ff_it(kernel);
-    MeshCore::MeshRefPointToFacets vf_it(kernel);
-
-    for (unsigned int i = 0; i < iterations; i++) {
-        UpdatePoints(ff_it, vf_it, point_indices);
-    }
+    UpdatePoints(iterations, point_indices);
 }
 
-void MedianFilterSmoothing::UpdatePoints(const MeshRefFacetToFacets& ff_it,
-                                         const MeshRefPointToFacets& vf_it,
+void MedianFilterSmoothing::UpdatePoints(unsigned int iterations,
                                          const std::vector<PointIndex>& point_indices)
 {
-    const MeshCore::MeshPointArray& points = kernel.GetPoints();
     const MeshCore::MeshFacetArray& facets = kernel.GetFacets();
+    MeshCore::MeshCompactAdjacency ff_it(kernel, MeshCompactAdjacency::FacetToFacets);
+    MeshCore::MeshCompactAdjacency vf_it(kernel, MeshCompactAdjacency::PointToFacets);
+    std::vector<PointIndex> indices = uniqueIndices(point_indices);
+
+    PointBuffer source(kernel.GetPoints());
+    PointBuffer target(source);
+    std::vector<Base::Vector3d> realNormals(facets.size());
+    std::vector<Base::Vector3d> faceNormals(facets.size());
+    std::vector<Base::Vector3d> gravityPoints(facets.size());
+    std::vector<double> areas(facets.size());
+
+    for (unsigned int iteration = 0; iteration < iterations; iteration++) {
+        // Initialize the arrays with the real normals, centres and areas
+        parallel_for(facets.size(), 1024, [&](std::size_t begin, std::size_t end) {
+            for (std::size_t pos = begin; pos < end; pos++) {
+                const MeshCore::MeshFacet& facet = facets[pos];
+                Base::Vector3d p0 = source.Get(facet._aulPoints[0]);
+                Base::Vector3d p1 = source.Get(facet._aulPoints[1]);
+                Base::Vector3d p2 = source.Get(facet._aulPoints[2]);
+                Base::Vector3d normal = (p1 - p0) % (p2 - p0);
+                areas[pos] = 0.5 * normal.Length();
+                realNormals[pos] = normal.Normalize();
+                gravityPoints[pos] = (p0 + p1 + p2) / 3.0;
+            }
+        });
+
+        // Step 1: determine face normals
+        parallel_for(facets.size(), 1024, [&](std::size_t begin, std::size_t end) {
+            std::vector<AngleNormal> anglesWithFaces;
+            for (std::size_t pos = begin; pos < end; pos++) {
+                const Base::Vector3d& refNormal = realNormals[pos];
+                const MeshCore::MeshFacet& facet = facets[pos];
+
+                anglesWithFaces.clear();
+                for (ElementIndex fi : ff_it[pos]) {
+                    const Base::Vector3d& faceNormal = realNormals[fi];
+                    double angle = refNormal.GetAngle(faceNormal);
+
+                    int absWeight = std::abs(weights);
+                    if (absWeight > 1 && facet.IsNeighbour(fi)) {
+                        if (weights < 0) {
+                            angle = -angle;
+                        }
+                        for (int i = 0; i < absWeight; i++) {
+                            anglesWithFaces.emplace_back(angle, faceNormal);
+                        }
+                    }
+                    else {
+                        anglesWithFaces.emplace_back(angle, faceNormal);
+                    }
+                }
 
-    // Initialize the array with the real normals
-    std::vector<Base::Vector3d> faceNormals;
-    faceNormals.reserve(facets.size());
-    MeshCore::MeshFacetIterator iter(kernel);
-    for (iter.Init(); iter.More(); iter.Next()) {
-        faceNormals.emplace_back(Base::toVector<double>(iter->GetNormal()));
-    }
-
-    // Step 1: determine face normals
-    for (FacetIndex pos = 0; pos < facets.size(); pos++) {
-        iter.Set(pos);
-        Base::Vector3d refNormal = Base::toVector<double>(iter->GetNormal());
-        const std::set<FacetIndex>& cv = ff_it[pos];
-        const MeshCore::MeshFacet& facet = facets[pos];
-
-        std::vector<AngleNormal> anglesWithFaces;
-        for (auto fi : cv) {
-            iter.Set(fi);
-            Base::Vector3d faceNormal = Base::toVector<double>(iter->GetNormal());
-            double angle = refNormal.GetAngle(faceNormal);
-
-            int absWeight = std::abs(weights);
-            if (absWeight > 1 && facet.IsNeighbour(fi)) {
-                if (weights < 0) {
-                    angle = -angle;
+                faceNormals[pos] = find_median(anglesWithFaces);
+            }
+        });
+
+        // Step 2: move vertices
+        parallel_for(indices.size(), 1024, [&](std::size_t begin, std::size_t end) {
+            for (std::size_t i = begin; i < end; i++) {
+                PointIndex pos = indices[i];
+                Base::Vector3d P = source.Get(pos);
+
+                double totalArea = 0.0;
+                Base::Vector3d totalvT;
+                for (ElementIndex it : vf_it[pos]) {
+                    double faceArea = areas[it];
+                    totalArea += faceArea;
+
+                    Base::Vector3d PC = gravityPoints[it] - P;
+                    const Base::Vector3d& mT = faceNormals[it];
+                    Base::Vector3d vT = (PC * mT) * mT;
+                    totalvT += vT * faceArea;
                 }
-                for (int i = 0; i < absWeight; i++) {
-                    anglesWithFaces.emplace_back(angle, faceNormal);
+
+                if (totalArea > 0.0) {
+                    P = P + totalvT / totalArea;
                 }
+                target.Set(pos, P);
             }
-            else {
-                anglesWithFaces.emplace_back(angle, faceNormal);
-            }
-        }
-
-        faceNormals[pos] = find_median(anglesWithFaces);
+        });
+        std::swap(source, target);
     }
 
-    // Step 2: move vertices
-    for (auto pos : point_indices) {
-        Base::Vector3d P = Base::toVector<double>(points[pos]);
-        const std::set<FacetIndex>& cv = vf_it[pos];
-
-        double totalArea = 0.0;
-        Base::Vector3d totalvT;
-        for (auto it : cv) {
-            iter.Set(it);
-
-            double faceArea = iter->Area();
-            totalArea += faceArea;
-
-            Base::Vector3d C = Base::toVector<double>(iter->GetGravityPoint());
-
-            Base::Vector3d PC = C - P;
-            Base::Vector3d mT = faceNormals[it];
-            Base::Vector3d vT = (PC * mT) * mT;
-            totalvT += vT * faceArea;
-        }
-
-        P = P + totalvT / totalArea;
-        kernel.SetPoint(pos, Base::toVector<float>(P));
-    }
+    source.Store(kernel, indices);
 }
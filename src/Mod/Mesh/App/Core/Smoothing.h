@@ -32,9 +32,6 @@
 namespace MeshCore
 {
 class MeshKernel;
-class MeshRefPointToPoints;
-class MeshRefPointToFacets;
-class MeshRefFacetToFacets;
 
 /** Base class for smoothing algorithms. */
 class MeshExport AbstractSmoothing
@@ -107,11 +104,11 @@ public:
     }
 
 protected:
-    void Umbrella(const MeshRefPointToPoints&, const MeshRefPointToFacets&, double);
-    void Umbrella(const MeshRefPointToPoints&,
-                  const MeshRefPointToFacets&,
-                  double,
-                  const std::vector<PointIndex>&);
+    /** Moves the points \a point_indices towards the centre of their neighbours, once for
+     * each value of \a stepsizes. Border points are kept. The points are processed in
+     * parallel, each step reads the positions of the previous one. */
+    void Umbrella(const std::vector<PointIndex>& point_indices,
+                  const std::vector<double>& stepsizes);
 
 private:
     double lambda {0.6307};
@@ -149,9 +146,7 @@ public:
     void SmoothPoints(unsigned int, const std::vector<PointIndex>&) override;
 
 private:
-    void UpdatePoints(const MeshRefFacetToFacets&,
-                      const MeshRefPointToFacets&,
-                      const std::vector<PointIndex>&);
+    void UpdatePoints(unsigned int iterations, const std::vector<PointIndex>&);
 
 private:
     int weights {1};
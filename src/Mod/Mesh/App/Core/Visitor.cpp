@@ -34,28 +34,37 @@
 using namespace MeshCore;
 
 
-unsigned long MeshKernel::VisitNeighbourFacets(MeshFacetVisitor& rclFVisitor,
-                                               FacetIndex ulStartFacet) const
+namespace
+{
+
+// The visitation state is passed as a pair of functions so that the same code
+// works with the VISIT flags of the mesh and with an external MeshFlagTable.
+template<typename IsVisited, typename SetVisited>
+unsigned long visitNeighbourFacets(const MeshFacetArray& rFacets,
+                                   MeshFacetVisitor& rclFVisitor,
+                                   FacetIndex ulStartFacet,
+                                   IsVisited isVisited,
+                                   SetVisited setVisited)
 {
     unsigned long ulVisited = 0, ulLevel = 0;
-    unsigned long ulCount = _aclFacetArray.size();
+    unsigned long ulCount = rFacets.size();
     std::vector<FacetIndex> clCurrentLevel, clNextLevel;
     std::vector<FacetIndex>::iterator clCurrIter;
     MeshFacetArray::_TConstIterator clCurrFacet, clNBFacet;
 
-    if (ulStartFacet >= _aclFacetArray.size()) {
+    if (ulStartFacet >= rFacets.size()) {
         return 0;
     }
 
     // pick up start point
     clCurrentLevel.push_back(ulStartFacet);
-    _aclFacetArray[ulStartFacet].SetFlag(MeshFacet::VISIT);
+    setVisited(ulStartFacet);
 
     // as long as free neighbours
     while (!clCurrentLevel.empty()) {
         // visit all neighbours of the current level
         for (clCurrIter = clCurrentLevel.begin(); clCurrIter < clCurrentLevel.end(); ++clCurrIter) {
-            clCurrFacet = _aclFacetArray.begin() + *clCurrIter;
+            clCurrFacet = rFacets.begin() + *clCurrIter;
 
             // visit all neighbours of the current level if not yet done
             for (unsigned short i = 0; i < 3; i++) {
@@ -68,19 +77,19 @@ unsigned long MeshKernel::VisitNeighbourFacets(MeshFacetVisitor& rclFVisitor,
                     continue;  // error in data structure
                 }
 
-                clNBFacet = _aclFacetArray.begin() + j;
+                clNBFacet = rFacets.begin() + j;
 
                 if (!rclFVisitor.AllowVisit(*clNBFacet, *clCurrFacet, j, ulLevel, i)) {
                     continue;
                 }
-                if (clNBFacet->IsFlag(MeshFacet::VISIT)) {
+                if (isVisited(j)) {
                     continue;  // neighbour facet already visited
                 }
 
                 // visit and mark
                 ulVisited++;
                 clNextLevel.push_back(j);
-                clNBFacet->SetFlag(MeshFacet::VISIT);
+                setVisited(j);
                 if (!rclFVisitor.Visit(*clNBFacet, *clCurrFacet, j, ulLevel)) {
                     return ulVisited;
                 }
@@ -95,21 +104,25 @@ unsigned long MeshKernel::VisitNeighbourFacets(MeshFacetVisitor& rclFVisitor,
     return ulVisited;
 }
 
-unsigned long MeshKernel::VisitNeighbourFacetsOverCorners(MeshFacetVisitor& rclFVisitor,
-                                                          FacetIndex ulStartFacet) const
+template<typename IsVisited, typename SetVisited>
+unsigned long visitNeighbourFacetsOverCorners(const MeshKernel& rclMesh,
+                                              MeshFacetVisitor& rclFVisitor,
+                                              FacetIndex ulStartFacet,
+                                              IsVisited isVisited,
+                                              SetVisited setVisited)
 {
     unsigned long ulVisited = 0, ulLevel = 0;
-    MeshRefPointToFacets clRPF(*this);
-    const MeshFacetArray& raclFAry = _aclFacetArray;
+    const MeshFacetArray& raclFAry = rclMesh.GetFacets();
     MeshFacetArray::_TConstIterator pFBegin = raclFAry.begin();
     std::vector<FacetIndex> aclCurrentLevel, aclNextLevel;
 
-    if (ulStartFacet >= _aclFacetArray.size()) {
+    if (ulStartFacet >= raclFAry.size()) {
         return 0;
     }
 
+    MeshRefPointToFacets clRPF(rclMesh);
     aclCurrentLevel.push_back(ulStartFacet);
-    raclFAry[ulStartFacet].SetFlag(MeshFacet::VISIT);
+    setVisited(ulStartFacet);
 
     while (!aclCurrentLevel.empty()) {
         // visit all neighbours of the current level
@@ -119,12 +132,12 @@ unsigned long MeshKernel::VisitNeighbourFacetsOverCorners(MeshFacetVisitor& rclF
                 const MeshFacet& rclFacet = raclFAry[*pCurrFacet];
                 const std::set<FacetIndex>& raclNB = clRPF[rclFacet._aulPoints[i]];
                 for (FacetIndex pINb : raclNB) {
-                    if (!pFBegin[pINb].IsFlag(MeshFacet::VISIT)) {
-                        // only visit if VISIT Flag not set
+                    if (!isVisited(pINb)) {
+                        // only visit if not yet visited
                         ulVisited++;
                         FacetIndex ulFInd = pINb;
                         aclNextLevel.push_back(ulFInd);
-                        pFBegin[pINb].SetFlag(MeshFacet::VISIT);
+                        setVisited(pINb);
                         if (!rclFVisitor.Visit(pFBegin[pINb],
                                                raclFAry[*pCurrFacet],
                                                ulFInd,
@@ -143,17 +156,21 @@ unsigned long MeshKernel::VisitNeighbourFacetsOverCorners(MeshFacetVisitor& rclF
     return ulVisited;
 }
 
-unsigned long MeshKernel::VisitNeighbourPoints(MeshPointVisitor& rclPVisitor,
-                                               PointIndex ulStartPoint) const
+template<typename IsVisited, typename SetVisited>
+unsigned long visitNeighbourPoints(const MeshKernel& rclMesh,
+                                   MeshPointVisitor& rclPVisitor,
+                                   PointIndex ulStartPoint,
+                                   IsVisited isVisited,
+                                   SetVisited setVisited)
 {
     unsigned long ulVisited = 0, ulLevel = 0;
     std::vector<PointIndex> aclCurrentLevel, aclNextLevel;
     std::vector<PointIndex>::iterator clCurrIter;
-    MeshPointArray::_TConstIterator pPBegin = _aclPointArray.begin();
-    MeshRefPointToPoints clNPs(*this);
+    MeshPointArray::_TConstIterator pPBegin = rclMesh.GetPoints().begin();
+    MeshRefPointToPoints clNPs(rclMesh);
 
     aclCurrentLevel.push_back(ulStartPoint);
-    (pPBegin + ulStartPoint)->SetFlag(MeshPoint::VISIT);
+    setVisited(ulStartPoint);
 
     while (!aclCurrentLevel.empty()) {
         // visit all neighbours of the current level
@@ -161,12 +178,12 @@ unsigned long MeshKernel::VisitNeighbourPoints(MeshPointVisitor& rclPVisitor,
              ++clCurrIter) {
             const std::set<PointIndex>& raclNB = clNPs[*clCurrIter];
             for (PointIndex pINb : raclNB) {
-                if (!pPBegin[pINb].IsFlag(MeshPoint::VISIT)) {
-                    // only visit if VISIT Flag not set
+                if (!isVisited(pINb)) {
+                    // only visit if not yet visited
                     ulVisited++;
                     PointIndex ulPInd = pINb;
                     aclNextLevel.push_back(ulPInd);
-                    pPBegin[pINb].SetFlag(MeshPoint::VISIT);
+                    setVisited(pINb);
                     if (!rclPVisitor.Visit(pPBegin[pINb],
                                            *(pPBegin + (*clCurrIter)),
                                            ulPInd,
@@ -184,6 +201,104 @@ unsigned long MeshKernel::VisitNeighbourPoints(MeshPointVisitor& rclPVisitor,
     return ulVisited;
 }
 
+}  // namespace
+
+unsigned long MeshKernel::VisitNeighbourFacets(MeshFacetVisitor& rclFVisitor,
+                                               FacetIndex ulStartFacet) const
+{
+    const MeshFacetArray& rFacets = _aclFacetArray;
+    return visitNeighbourFacets(
+        rFacets,
+        rclFVisitor,
+        ulStartFacet,
+        [&rFacets](FacetIndex index) {
+            return rFacets[index].IsFlag(MeshFacet::VISIT);
+        },
+        [&rFacets](FacetIndex index) {
+            rFacets[index].SetFlag(MeshFacet::VISIT);
+        });
+}
+
+unsigned long MeshKernel::VisitNeighbourFacets(MeshFacetVisitor& rclFVisitor,
+                                               FacetIndex ulStartFacet,
+                                               MeshFlagTable& rclVisited) const
+{
+    return visitNeighbourFacets(
+        _aclFacetArray,
+        rclFVisitor,
+        ulStartFacet,
+        [&rclVisited](FacetIndex index) {
+            return rclVisited.IsSet(index);
+        },
+        [&rclVisited](FacetIndex index) {
+            rclVisited.Set(index);
+        });
+}
+
+unsigned long MeshKernel::VisitNeighbourFacetsOverCorners(MeshFacetVisitor& rclFVisitor,
+                                                          FacetIndex ulStartFacet) const
+{
+    const MeshFacetArray& rFacets = _aclFacetArray;
+    return visitNeighbourFacetsOverCorners(
+        *this,
+        rclFVisitor,
+        ulStartFacet,
+        [&rFacets](FacetIndex index) {
+            return rFacets[index].IsFlag(MeshFacet::VISIT);
+        },
+        [&rFacets](FacetIndex index) {
+            rFacets[index].SetFlag(MeshFacet::VISIT);
+        });
+}
+
+unsigned long MeshKernel::VisitNeighbourFacetsOverCorners(MeshFacetVisitor& rclFVisitor,
+                                                          FacetIndex ulStartFacet,
+                                                          MeshFlagTable& rclVisited) const
+{
+    return visitNeighbourFacetsOverCorners(
+        *this,
+        rclFVisitor,
+        ulStartFacet,
+        [&rclVisited](FacetIndex index) {
+            return rclVisited.IsSet(index);
+        },
+        [&rclVisited](FacetIndex index) {
+            rclVisited.Set(index);
+        });
+}
+
+unsigned long MeshKernel::VisitNeighbourPoints(MeshPointVisitor& rclPVisitor,
+                                               PointIndex ulStartPoint) const
+{
+    const MeshPointArray& rPoints = _aclPointArray;
+    return visitNeighbourPoints(
+        *this,
+        rclPVisitor,
+        ulStartPoint,
+        [&rPoints](PointIndex index) {
+            return rPoints[index].IsFlag(MeshPoint::VISIT);
+        },
+        [&rPoints](PointIndex index) {
+            rPoints[index].SetFlag(MeshPoint::VISIT);
+        });
+}
+
+unsigned long MeshKernel::VisitNeighbourPoints(MeshPointVisitor& rclPVisitor,
+                                               PointIndex ulStartPoint,
+                                               MeshFlagTable& rclVisited) const
+{
+    return visitNeighbourPoints(
+        *this,
+        rclPVisitor,
+        ulStartPoint,
+        [&rclVisited](PointIndex index) {
+            return rclVisited.IsSet(index);
+        },
+        [&rclVisited](PointIndex index) {
+            rclVisited.Set(index);
+        });
+}
+
 // -------------------------------------------------------------------------
 
 MeshSearchNeighbourFacetsVisitor::MeshSearchNeighbourFacetsVisitor(const MeshKernel& rclMesh,
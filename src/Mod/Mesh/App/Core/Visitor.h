@@ -24,6 +24,7 @@
 #define VISITOR_H
 
 #include "MeshKernel.h"
+#include <algorithm>
 #include <vector>
 
 
@@ -36,6 +37,77 @@ class MeshFacetVisitor;
 class MeshPoint;
 class PlaneFit;
 
+/**
+ * The MeshFlagTable class holds one flag per facet or point of a mesh outside of the mesh
+ * itself. Unlike the flags of MeshFacet and MeshPoint it is owned by a single algorithm, so
+ * several algorithms can work on the same mesh at the same time as long as they don't modify
+ * it. A table must not be shared between threads.
+ */
+class MeshExport MeshFlagTable
+{
+public:
+    /// Construction, all flags are unset
+    explicit MeshFlagTable(std::size_t size = 0)
+        : _flags(size, false)
+    {}
+    /** Sets the number of elements and unsets all flags. */
+    void Resize(std::size_t size)
+    {
+        _flags.assign(size, false);
+    }
+    /** Unsets all flags. */
+    void Reset()
+    {
+        _flags.assign(_flags.size(), false);
+    }
+    std::size_t Size() const
+    {
+        return _flags.size();
+    }
+    bool IsSet(ElementIndex index) const
+    {
+        return _flags[index];
+    }
+    void Set(ElementIndex index)
+    {
+        _flags[index] = true;
+    }
+    void Unset(ElementIndex index)
+    {
+        _flags[index] = false;
+    }
+    void Set(const std::vector<ElementIndex>& indices)
+    {
+        for (ElementIndex index : indices) {
+            _flags[index] = true;
+        }
+    }
+    void Unset(const std::vector<ElementIndex>& indices)
+    {
+        for (ElementIndex index : indices) {
+            _flags[index] = false;
+        }
+    }
+    /** Returns the number of set flags. */
+    std::size_t Count() const
+    {
+        return static_cast<std::size_t>(std::count(_flags.begin(), _flags.end(), true));
+    }
+    /** Returns the first index from \a start on whose flag is unset or ELEMENT_INDEX_MAX. */
+    ElementIndex FindFirstUnset(ElementIndex start = 0) const
+    {
+        for (std::size_t i = start; i < _flags.size(); i++) {
+            if (!_flags[i]) {
+                return static_cast<ElementIndex>(i);
+            }
+        }
+        return ELEMENT_INDEX_MAX;
+    }
+
+private:
+    std::vector<bool> _flags;
+};
+
 /**
  * Abstract base class for facet visitors.
  * The MeshFacetVisitor class can be used for the so called
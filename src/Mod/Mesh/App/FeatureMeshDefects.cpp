@@ -57,6 +57,27 @@ App::DocumentObjectExecReturn* FixDefects::execute()
     return App::DocumentObject::StdReturn;
 }
 
+App::DocumentObject::ConcurrentTask
+FixDefects::prepareFix(const std::function<void(MeshObject&)>& fix)
+{
+    // a missing source is reported by execute() on the main thread
+    App::DocumentObject* link = Source.getValue();
+    App::Property* prop = link ? link->getPropertyByName("Mesh") : nullptr;
+    if (!prop || !prop->is<Mesh::PropertyMeshKernel>()) {
+        return {};
+    }
+
+    auto kernel = static_cast<Mesh::PropertyMeshKernel*>(prop);
+    auto mesh = std::make_shared<MeshObject>(kernel->getValue());
+    return [this, mesh, fix]() -> ConcurrentResult {
+        fix(*mesh);
+        return [this, mesh]() {
+            this->Mesh.setValuePtr(new MeshObject(std::move(*mesh)));
+            return App::DocumentObject::StdReturn;
+        };
+    };
+}
+
 // ----------------------------------------------------------------------
 
 PROPERTY_SOURCE(Mesh::HarmonizeNormals, Mesh::FixDefects)
@@ -81,6 +102,13 @@ App::DocumentObjectExecReturn* HarmonizeNormals::execute()
     return App::DocumentObject::StdReturn;
 }
 
+App::DocumentObject::ConcurrentTask HarmonizeNormals::prepareConcurrentRecompute()
+{
+    return prepareFix([](MeshObject& mesh) {
+        mesh.harmonizeNormals();
+    });
+}
+
 // ----------------------------------------------------------------------
 
 PROPERTY_SOURCE(Mesh::FlipNormals, Mesh::FixDefects)
@@ -105,6 +133,13 @@ App::DocumentObjectExecReturn* FlipNormals::execute()
     return App::DocumentObject::StdReturn;
 }
 
+App::DocumentObject::ConcurrentTask FlipNormals::prepareConcurrentRecompute()
+{
+    return prepareFix([](MeshObject& mesh) {
+        mesh.flipNormals();
+    });
+}
+
 // ----------------------------------------------------------------------
 
 PROPERTY_SOURCE(Mesh::FixNonManifolds, Mesh::FixDefects)
@@ -309,3 +344,11 @@ App::DocumentObjectExecReturn* RemoveComponents::execute()
 
     return App::DocumentObject::StdReturn;
 }
+
+App::DocumentObject::ConcurrentTask RemoveComponents::prepareConcurrentRecompute()
+{
+    auto size = static_cast<unsigned long>(RemoveCompOfSize.getValue());
+    return prepareFix([size](MeshObject& mesh) {
+        mesh.removeComponents(size);
+    });
+}
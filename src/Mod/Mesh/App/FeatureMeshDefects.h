@@ -23,6 +23,8 @@
 #ifndef MESH_FEATURE_MESH_DEFECTS_H
 #define MESH_FEATURE_MESH_DEFECTS_H
 
+#include <functional>
+
 #include <App/PropertyLinks.h>
 
 #include "MeshFeature.h"
@@ -58,6 +60,10 @@ public:
 
     /// returns the type name of the ViewProvider
     //  virtual const char* getViewProviderName(void) const {return "MeshGui::ViewProviderDefects";}
+
+protected:
+    /// Returns a task that applies \a fix to a copy of the source mesh on a worker thread
+    ConcurrentTask prepareFix(const std::function<void(MeshObject&)>& fix);
 };
 
 /**
@@ -76,6 +82,7 @@ public:
     //@{
     /// recalculate the Feature
     App::DocumentObjectExecReturn* execute() override;
+    ConcurrentTask prepareConcurrentRecompute() override;
     //@}
 };
 
@@ -95,6 +102,7 @@ public:
     //@{
     /// recalculate the Feature
     App::DocumentObjectExecReturn* execute() override;
+    ConcurrentTask prepareConcurrentRecompute() override;
     //@}
 };
 
@@ -255,6 +263,7 @@ public:
     //@{
     /// recalculate the Feature
     App::DocumentObjectExecReturn* execute() override;
+    ConcurrentTask prepareConcurrentRecompute() override;
     //@}
 };
 
@@ -38,6 +38,8 @@
 #include <Base/ViewProj.h>
 #include <Base/Writer.h>
 
+#include "Core/BVH.h"
+#include "Core/Boolean.h"
 #include "Core/Builder.h"
 #include "Core/Decimation.h"
 #include "Core/Degeneration.h"
@@ -851,6 +853,64 @@ std::vector<MeshObject::TFaceSection> MeshObject::foraminate(const TRay& ray, do
     return output;
 }
 
+std::vector<MeshObject::TFaceSection>
+MeshObject::nearestFacetsOnRays(const std::vector<TRay>& rays, double maxAngle) const
+{
+    Base::Placement plm = getPlacement();
+    Base::Placement inv = plm.inverse();
+
+    // transform the rays relative to the mesh kernel
+    std::vector<MeshCore::MeshFacetBVH::Ray> kernelRays;
+    kernelRays.reserve(rays.size());
+    for (const auto& it : rays) {
+        Base::Vector3f pnt = Base::toVector<float>(it.first);
+        Base::Vector3f dir = Base::toVector<float>(it.second);
+        inv.multVec(pnt, pnt);
+        inv.getRotation().multVec(dir, dir);
+        kernelRays.emplace_back(pnt, dir);
+    }
+
+    MeshCore::MeshFacetBVH bvh(getKernel());
+    auto results = bvh.NearestFacetsOnRays(kernelRays, static_cast<float>(maxAngle));
+
+    std::vector<TFaceSection> output;
+    output.reserve(results.size());
+    for (auto& it : results) {
+        plm.multVec(it.second, it.second);
+        output.emplace_back(it.first, Base::toVector<double>(it.second));
+    }
+
+    return output;
+}
+
+std::vector<MeshObject::TFaceSection>
+MeshObject::nearestFacetsToPoints(const std::vector<Base::Vector3d>& points, double maxDist) const
+{
+    Base::Placement plm = getPlacement();
+    Base::Placement inv = plm.inverse();
+
+    // transform the points relative to the mesh kernel
+    std::vector<Base::Vector3f> kernelPoints;
+    kernelPoints.reserve(points.size());
+    for (const auto& it : points) {
+        Base::Vector3f pnt = Base::toVector<float>(it);
+        inv.multVec(pnt, pnt);
+        kernelPoints.push_back(pnt);
+    }
+
+    MeshCore::MeshFacetBVH bvh(getKernel());
+    auto results = bvh.NearestPointsFromPoints(kernelPoints, static_cast<float>(maxDist));
+
+    std::vector<TFaceSection> output;
+    output.reserve(results.size());
+    for (auto& it : results) {
+        plm.multVec(it.second, it.second);
+        output.emplace_back(it.first, Base::toVector<double>(it.second));
+    }
+
+    return output;
+}
+
 void MeshObject::updateMesh(const std::vector<FacetIndex>& facets) const
 {
     std::vector<PointIndex> points;
@@ -1088,6 +1148,41 @@ void MeshObject::decimate(int targetSize)
     dm.simplify(targetSize);
 }
 
+void MeshObject::decimate(int targetSize, float maxError, float featureAngle, bool keepSegments)
+{
+    MeshCore::MeshDecimation dm(this->_kernel);
+    dm.SetMaxError(maxError);
+    dm.SetFeatureAngle(featureAngle);
+    if (keepSegments) {
+        std::vector<std::vector<FacetIndex>> segments;
+        segments.reserve(this->_segments.size());
+        for (const auto& segment : this->_segments) {
+            segments.push_back(segment._indices);
+        }
+        dm.SetSegments(segments);
+    }
+
+    std::size_t countFacets = _kernel.CountFacets();
+    dm.Decimate(static_cast<std::size_t>(std::max(targetSize, 0)));
+
+    // a remaining facet belongs to the segments of the facet it originates from
+    const std::vector<FacetIndex>& origin = dm.GetOriginalFacets();
+    for (auto& segment : this->_segments) {
+        std::vector<bool> inSegment(countFacets, false);
+        for (FacetIndex index : segment._indices) {
+            inSegment[index] = true;
+        }
+
+        std::vector<FacetIndex> indices;
+        for (std::size_t i = 0; i < origin.size(); i++) {
+            if (inSegment[origin[i]]) {
+                indices.push_back(static_cast<FacetIndex>(i));
+            }
+        }
+        segment._indices = indices;
+    }
+}
+
 Base::Vector3d MeshObject::getPointNormal(PointIndex index) const
 {
     std::vector<Base::Vector3f> temp = _kernel.CalcVertexNormals();
@@ -1217,84 +1312,60 @@ void MeshObject::trimByPlane(const Base::Vector3f& base, const Base::Vector3f& n
     }
 }
 
-MeshObject* MeshObject::unite(const MeshObject& mesh) const
+namespace
+{
+// Computes the set operation of the two meshes with their placements applied
+MeshCore::MeshKernel setOperation(const MeshObject& mesh1,
+                                  const MeshObject& mesh2,
+                                  MeshCore::SetOperations::OperationType opType,
+                                  bool exact,
+                                  float epsilon)
 {
     MeshCore::MeshKernel result;
-    MeshCore::MeshKernel kernel1(this->_kernel);
-    kernel1.Transform(this->_Mtrx);
-    MeshCore::MeshKernel kernel2(mesh._kernel);
-    kernel2.Transform(mesh._Mtrx);
-    MeshCore::SetOperations setOp(kernel1,
-                                  kernel2,
-                                  result,
-                                  MeshCore::SetOperations::Union,
-                                  Epsilon);
-    setOp.Do();
-    return new MeshObject(result);
+    MeshCore::MeshKernel kernel1(mesh1.getKernel());
+    kernel1.Transform(mesh1.getTransform());
+    MeshCore::MeshKernel kernel2(mesh2.getKernel());
+    kernel2.Transform(mesh2.getTransform());
+    if (exact) {
+        MeshCore::MeshBoolean boolean(kernel1, kernel2, result, opType);
+        boolean.Do();
+    }
+    else {
+        MeshCore::SetOperations setOp(kernel1, kernel2, result, opType, epsilon);
+        setOp.Do();
+    }
+    return result;
 }
+}  // namespace
 
-MeshObject* MeshObject::intersect(const MeshObject& mesh) const
+MeshObject* MeshObject::unite(const MeshObject& mesh, bool exact) const
 {
-    MeshCore::MeshKernel result;
-    MeshCore::MeshKernel kernel1(this->_kernel);
-    kernel1.Transform(this->_Mtrx);
-    MeshCore::MeshKernel kernel2(mesh._kernel);
-    kernel2.Transform(mesh._Mtrx);
-    MeshCore::SetOperations setOp(kernel1,
-                                  kernel2,
-                                  result,
-                                  MeshCore::SetOperations::Intersect,
-                                  Epsilon);
-    setOp.Do();
-    return new MeshObject(result);
+    return new MeshObject(
+        setOperation(*this, mesh, MeshCore::SetOperations::Union, exact, Epsilon));
 }
 
-MeshObject* MeshObject::subtract(const MeshObject& mesh) const
+MeshObject* MeshObject::intersect(const MeshObject& mesh, bool exact) const
 {
-    MeshCore::MeshKernel result;
-    MeshCore::MeshKernel kernel1(this->_kernel);
-    kernel1.Transform(this->_Mtrx);
-    MeshCore::MeshKernel kernel2(mesh._kernel);
-    kernel2.Transform(mesh._Mtrx);
-    MeshCore::SetOperations setOp(kernel1,
-                                  kernel2,
-                                  result,
-                                  MeshCore::SetOperations::Difference,
-                                  Epsilon);
-    setOp.Do();
-    return new MeshObject(result);
+    return new MeshObject(
+        setOperation(*this, mesh, MeshCore::SetOperations::Intersect, exact, Epsilon));
 }
 
-MeshObject* MeshObject::inner(const MeshObject& mesh) const
+MeshObject* MeshObject::subtract(const MeshObject& mesh, bool exact) const
 {
-    MeshCore::MeshKernel result;
-    MeshCore::MeshKernel kernel1(this->_kernel);
-    kernel1.Transform(this->_Mtrx);
-    MeshCore::MeshKernel kernel2(mesh._kernel);
-    kernel2.Transform(mesh._Mtrx);
-    MeshCore::SetOperations setOp(kernel1,
-                                  kernel2,
-                                  result,
-                                  MeshCore::SetOperations::Inner,
-                                  Epsilon);
-    setOp.Do();
-    return new MeshObject(result);
+    return new MeshObject(
+        setOperation(*this, mesh, MeshCore::SetOperations::Difference, exact, Epsilon));
 }
 
-MeshObject* MeshObject::outer(const MeshObject& mesh) const
+MeshObject* MeshObject::inner(const MeshObject& mesh, bool exact) const
 {
-    MeshCore::MeshKernel result;
-    MeshCore::MeshKernel kernel1(this->_kernel);
-    kernel1.Transform(this->_Mtrx);
-    MeshCore::MeshKernel kernel2(mesh._kernel);
-    kernel2.Transform(mesh._Mtrx);
-    MeshCore::SetOperations setOp(kernel1,
-                                  kernel2,
-                                  result,
-                                  MeshCore::SetOperations::Outer,
-                                  Epsilon);
-    setOp.Do();
-    return new MeshObject(result);
+    return new MeshObject(
+        setOperation(*this, mesh, MeshCore::SetOperations::Inner, exact, Epsilon));
+}
+
+MeshObject* MeshObject::outer(const MeshObject& mesh, bool exact) const
+{
+    return new MeshObject(
+        setOperation(*this, mesh, MeshCore::SetOperations::Outer, exact, Epsilon));
 }
 
 std::vector<std::vector<Base::Vector3f>>
@@ -1485,6 +1556,13 @@ void MeshObject::snapVertex(FacetIndex facet, const Base::Vector3f& v)
     topalg.SnapVertex(facet, v);
 }
 
+MeshCore::MeshDefectReport MeshObject::analyze() const
+{
+    MeshCore::MeshEvalDefects eval(_kernel);
+    eval.Evaluate();
+    return eval.GetReport();
+}
+
 unsigned long MeshObject::countNonUniformOrientedFacets() const
 {
     MeshCore::MeshEvalOrientation cMeshEval(_kernel);
@@ -35,6 +35,7 @@
 #include <Base/Matrix.h>
 #include <Base/Tools3D.h>
 
+#include "Core/Defects.h"
 #include "Core/Iterator.h"
 #include "Core/MeshIO.h"
 #include "Core/MeshKernel.h"
@@ -173,6 +174,14 @@ public:
     std::vector<PointIndex> getPointsFromFacets(const std::vector<FacetIndex>& facets) const;
     bool nearestFacetOnRay(const TRay& ray, double maxAngle, TFaceSection& output) const;
     std::vector<TFaceSection> foraminate(const TRay& ray, double maxAngle) const;
+    /** Performs nearestFacetOnRay() for many rays using a bounding volume hierarchy.
+     * For rays without intersection the facet index is FACET_INDEX_MAX. */
+    std::vector<TFaceSection> nearestFacetsOnRays(const std::vector<TRay>& rays,
+                                                  double maxAngle) const;
+    /** Projects each point to its nearest facet using a bounding volume hierarchy.
+     * Points farther away than \a maxDist get the facet index FACET_INDEX_MAX. */
+    std::vector<TFaceSection> nearestFacetsToPoints(const std::vector<Base::Vector3d>& points,
+                                                    double maxDist) const;
     //@}
 
     void setKernel(const MeshCore::MeshKernel& m);
@@ -264,6 +273,13 @@ public:
     void smooth(int iterations, float d_max);
     void decimate(float fTolerance, float fReduction);
     void decimate(int targetSize);
+    /**
+     * Decimates the mesh in parallel to \a targetSize facets. If \a maxError is greater than
+     * zero the removed points keep at most this distance to the surface. Edges with a dihedral
+     * angle above \a featureAngle (in radian) and, if \a keepSegments is true, the borders of
+     * the segments are preserved. The segments are updated in any case.
+     */
+    void decimate(int targetSize, float maxError, float featureAngle, bool keepSegments);
     Base::Vector3d getPointNormal(PointIndex) const;
     std::vector<Base::Vector3d> getPointNormals() const;
     void crossSections(const std::vector<TPlane>&,
@@ -293,13 +309,15 @@ public:
     void clearPointSelection() const;
     //@}
 
-    /** @name Boolean operations */
+    /** @name Boolean operations
+     * If \a exact is true the operations use exact predicates, see MeshCore::MeshBoolean.
+     */
     //@{
-    MeshObject* unite(const MeshObject&) const;
-    MeshObject* intersect(const MeshObject&) const;
-    MeshObject* subtract(const MeshObject&) const;
-    MeshObject* inner(const MeshObject&) const;
-    MeshObject* outer(const MeshObject&) const;
+    MeshObject* unite(const MeshObject&, bool exact = false) const;
+    MeshObject* intersect(const MeshObject&, bool exact = false) const;
+    MeshObject* subtract(const MeshObject&, bool exact = false) const;
+    MeshObject* inner(const MeshObject&, bool exact = false) const;
+    MeshObject* outer(const MeshObject&, bool exact = false) const;
     std::vector<std::vector<Base::Vector3f>>
     section(const MeshObject&, bool connectLines, float fMinDist) const;
     //@}
@@ -323,6 +341,8 @@ public:
 
     /** @name Mesh validation */
     //@{
+    /** Runs all checks of the mesh concurrently and returns their results. */
+    MeshCore::MeshDefectReport analyze() const;
     unsigned long countNonUniformOrientedFacets() const;
     void flipNormals();
     void harmonizeNormals();
@@ -22,6 +22,7 @@
 
 #include "PreCompiled.h"
 
+#include <Base/Console.h>
 #include <Base/Converter.h>
 #include <Base/Exception.h>
 #include <Base/Reader.h>
@@ -148,9 +149,8 @@ void PropertyNormalList::SaveDocFile(Base::Writer& writer) const
     Base::OutputStream str(writer.Stream());
     uint32_t uCt = (uint32_t)getSize();
     str << uCt;
-    for (auto it : _lValueList) {
-        str << it.x << it.y << it.z;
-    }
+    static_assert(sizeof(Base::Vector3f) == 3 * sizeof(float));
+    str.writeArray(reinterpret_cast<const float*>(_lValueList.data()), 3 * _lValueList.size());
 }
 
 void PropertyNormalList::RestoreDocFile(Base::Reader& reader)
@@ -159,9 +159,7 @@ void PropertyNormalList::RestoreDocFile(Base::Reader& reader)
     uint32_t uCt = 0;
     str >> uCt;
     std::vector<Base::Vector3f> values(uCt);
-    for (auto& it : values) {
-        str >> it.x >> it.y >> it.z;
-    }
+    str.readArray(reinterpret_cast<float*>(values.data()), 3 * values.size());
     setValues(values);
 }
 
@@ -744,55 +742,70 @@ void PropertyMeshKernel::setValuePtr(MeshObject* mesh)
     // before calling hasSetValue()
     Base::Reference<MeshObject> tmp(_meshObject);
     aboutToSetValue();
-    _meshObject = mesh;
+    setMeshObject(mesh);
+    _lazyFile.reset();
     hasSetValue();
 }
 
 void PropertyMeshKernel::setValue(const MeshObject& mesh)
 {
+    // use the tmp. object to guarantee that the referenced mesh is not destroyed
+    // before calling hasSetValue()
+    Base::Reference<MeshObject> tmp(_meshObject);
     aboutToSetValue();
-    *_meshObject = mesh;
+    _lazyFile.reset();
+    // create a new mesh object instead of assigning to the existing one which
+    // then can be passed to the undo stack without copying it
+    setMeshObject(new MeshObject(mesh));
     hasSetValue();
 }
 
 void PropertyMeshKernel::setValue(const MeshCore::MeshKernel& mesh)
 {
+    Base::Reference<MeshObject> tmp(_meshObject);
     aboutToSetValue();
-    _meshObject->setKernel(mesh);
+    _lazyFile.reset();
+    setMeshObject(new MeshObject(mesh, _meshObject->getTransform()));
     hasSetValue();
 }
 
 void PropertyMeshKernel::swapMesh(MeshObject& mesh)
 {
+    loadLazyDocFile();
     aboutToSetValue();
-    _meshObject->swap(mesh);
+    detachMesh()->swap(mesh);
     hasSetValue();
 }
 
 void PropertyMeshKernel::swapMesh(MeshCore::MeshKernel& mesh)
 {
+    loadLazyDocFile();
     aboutToSetValue();
-    _meshObject->swap(mesh);
+    detachMesh()->swap(mesh);
     hasSetValue();
 }
 
 const MeshObject& PropertyMeshKernel::getValue() const
 {
+    loadLazyDocFile();
     return *_meshObject;
 }
 
 const MeshObject* PropertyMeshKernel::getValuePtr() const
 {
+    loadLazyDocFile();
     return static_cast<MeshObject*>(_meshObject);
 }
 
 const Data::ComplexGeoData* PropertyMeshKernel::getComplexData() const
 {
+    loadLazyDocFile();
     return static_cast<MeshObject*>(_meshObject);
 }
 
 Base::BoundBox3d PropertyMeshKernel::getBoundingBox() const
 {
+    loadLazyDocFile();
     return _meshObject->getBoundBox();
 }
 
@@ -806,8 +819,9 @@ unsigned int PropertyMeshKernel::getMemSize() const
 
 MeshObject* PropertyMeshKernel::startEditing()
 {
+    loadLazyDocFile();
     aboutToSetValue();
-    return static_cast<MeshObject*>(_meshObject);
+    return detachMesh();
 }
 
 void PropertyMeshKernel::finishEditing()
@@ -817,16 +831,18 @@ void PropertyMeshKernel::finishEditing()
 
 void PropertyMeshKernel::transformGeometry(const Base::Matrix4D& rclMat)
 {
+    loadLazyDocFile();
     aboutToSetValue();
-    _meshObject->transformGeometry(rclMat);
+    detachMesh()->transformGeometry(rclMat);
     hasSetValue();
 }
 
 void PropertyMeshKernel::setPointIndices(
     const std::vector<std::pair<PointIndex, Base::Vector3f>>& inds)
 {
+    loadLazyDocFile();
     aboutToSetValue();
-    MeshCore::MeshKernel& kernel = _meshObject->getKernel();
+    MeshCore::MeshKernel& kernel = detachMesh()->getKernel();
     for (const auto& it : inds) {
         kernel.SetPoint(it.first, it.second);
     }
@@ -835,16 +851,19 @@ void PropertyMeshKernel::setPointIndices(
 
 void PropertyMeshKernel::setTransform(const Base::Matrix4D& rclTrf)
 {
-    _meshObject->setTransform(rclTrf);
+    loadLazyDocFile();
+    detachMesh()->setTransform(rclTrf);
 }
 
 Base::Matrix4D PropertyMeshKernel::getTransform() const
 {
+    loadLazyDocFile();
     return _meshObject->getTransform();
 }
 
 PyObject* PropertyMeshKernel::getPyObject()
 {
+    loadLazyDocFile();
     if (!meshPyObject) {
         meshPyObject = new MeshPy(
             &*_meshObject);  // Lgtm[cpp/resource-not-released-in-destructor] ** Not destroyed in
@@ -882,6 +901,7 @@ void PropertyMeshKernel::setPyObject(PyObject* value)
 
 void PropertyMeshKernel::Save(Base::Writer& writer) const
 {
+    loadLazyDocFile();
     if (writer.isForceXML()) {
         writer.Stream() << writer.ind() << "<Mesh>" << std::endl;
         MeshCore::MeshOutput saver(_meshObject->getKernel());
@@ -897,6 +917,7 @@ void PropertyMeshKernel::Restore(Base::XMLReader& reader)
 {
     reader.readElement("Mesh");
     std::string file(reader.getAttribute<const char*>("file"));
+    _lazyFile.reset();
 
     if (file.empty()) {
         // read XML
@@ -910,7 +931,7 @@ void PropertyMeshKernel::Restore(Base::XMLReader& reader)
         kernel.Adopt(points, facets);
 
         aboutToSetValue();
-        _meshObject->getKernel().Adopt(points, facets);
+        detachMesh()->getKernel().Adopt(points, facets);
         hasSetValue();
     }
     else {
@@ -921,29 +942,90 @@ void PropertyMeshKernel::Restore(Base::XMLReader& reader)
 
 void PropertyMeshKernel::SaveDocFile(Base::Writer& writer) const
 {
+    loadLazyDocFile();
     _meshObject->save(writer.Stream());
 }
 
 void PropertyMeshKernel::RestoreDocFile(Base::Reader& reader)
 {
     aboutToSetValue();
-    _meshObject->load(reader);
+    _lazyFile.reset();
+    detachMesh()->load(reader);
     hasSetValue();
 }
 
+void PropertyMeshKernel::setLazyDocFile(const std::shared_ptr<Base::LazyDocFile>& file)
+{
+    aboutToSetValue();
+    _lazyFile = file;
+    hasSetValue();
+}
+
+void PropertyMeshKernel::loadLazyDocFile() const
+{
+    std::lock_guard<std::recursive_mutex> lock(_lazyMutex);
+    if (!_lazyFile) {
+        return;
+    }
+
+    // reset the handle first so that accessing the mesh while reading doesn't recurse
+    std::shared_ptr<Base::LazyDocFile> file;
+    file.swap(_lazyFile);
+    try {
+        file->restore(&*_meshObject);
+    }
+    catch (const Base::Exception& e) {
+        Base::Console().error("Reading failed from embedded file %s: %s\n",
+                              file->getFileName().c_str(),
+                              e.what());
+    }
+    catch (const std::exception& e) {
+        Base::Console().error("Reading failed from embedded file %s: %s\n",
+                              file->getFileName().c_str(),
+                              e.what());
+    }
+}
+
 App::Property* PropertyMeshKernel::Copy() const
 {
-    // Note: Copy the content, do NOT reference the same mesh object
+    loadLazyDocFile();
+    // Note: Share the mesh object, it gets copied before either property modifies it
     PropertyMeshKernel* prop = new PropertyMeshKernel();
-    *(prop->_meshObject) = *(this->_meshObject);
+    prop->_meshObject = this->_meshObject;
+    prop->_shared = true;
+    this->_shared = true;
     return prop;
 }
 
 void PropertyMeshKernel::Paste(const App::Property& from)
 {
-    // Note: Copy the content, do NOT reference the same mesh object
     aboutToSetValue();
     const PropertyMeshKernel& prop = dynamic_cast<const PropertyMeshKernel&>(from);
-    *(this->_meshObject) = *(prop._meshObject);
+    prop.loadLazyDocFile();
+    _lazyFile.reset();
+    // Note: Share the mesh object, it gets copied before either property modifies it
+    Base::Reference<MeshObject> tmp(_meshObject);
+    setMeshObject(prop._meshObject);
+    this->_shared = true;
+    prop._shared = true;
     hasSetValue();
 }
+
+void PropertyMeshKernel::setMeshObject(MeshObject* mesh)
+{
+    _meshObject = mesh;
+    _shared = false;
+    if (meshPyObject) {
+        meshPyObject->setTwinPointer(mesh);
+    }
+}
+
+MeshObject* PropertyMeshKernel::detachMesh()
+{
+    // Other references to the mesh, e.g. from the view provider, don't need a copy
+    if (_shared && _meshObject.getRefCount() > 1) {
+        setMeshObject(new MeshObject(*_meshObject));
+    }
+    _shared = false;
+    return static_cast<MeshObject*>(_meshObject);
+}
@@ -25,6 +25,7 @@
 
 #include <list>
 #include <map>
+#include <mutex>
 #include <set>
 #include <string>
 #include <vector>
@@ -315,13 +316,35 @@ public:
 
     void SaveDocFile(Base::Writer& writer) const override;
     void RestoreDocFile(Base::Reader& reader) override;
+    bool canRestoreDocFileLazily() const override
+    {
+        return true;
+    }
+    void setLazyDocFile(const std::shared_ptr<Base::LazyDocFile>& file) override;
 
     App::Property* Copy() const override;
     void Paste(const App::Property& from) override;
     //@}
 
+private:
+    /** Reads the mesh from the project file if its restore has been deferred
+     * Concurrent readers wait until the mesh is loaded.
+     */
+    void loadLazyDocFile() const;
+    /// Replaces the referenced mesh object and re-targets the Python wrapper
+    void setMeshObject(MeshObject* mesh);
+    /** Returns the mesh object for modification
+     * Copy() and Paste() share the mesh object instead of duplicating it, e.g.
+     * with the undo stack. So, before the first modification the mesh is copied
+     * if it is still shared.
+     */
+    MeshObject* detachMesh();
+
 private:
     Base::Reference<MeshObject> _meshObject;
+    mutable std::shared_ptr<Base::LazyDocFile> _lazyFile;
+    mutable std::recursive_mutex _lazyMutex;
+    mutable bool _shared {false};
     MeshPy* meshPyObject {nullptr};
 };
 
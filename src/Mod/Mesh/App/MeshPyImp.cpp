@@ -22,6 +22,9 @@
 
 #include "PreCompiled.h"
 
+#include <algorithm>
+#include <limits>
+
 #include <Base/Converter.h>
 #include <Base/GeometryPyCXX.h>
 #include <Base/MatrixPy.h>
@@ -457,7 +460,8 @@ PyObject* MeshPy::unite(PyObject* args) const
 {
     MeshPy* pcObject {};
     PyObject* pcObj {};
-    if (!PyArg_ParseTuple(args, "O!", &(MeshPy::Type), &pcObj)) {
+    PyObject* exact = Py_False;
+    if (!PyArg_ParseTuple(args, "O!|O!", &(MeshPy::Type), &pcObj, &PyBool_Type, &exact)) {
         return nullptr;
     }
 
@@ -465,7 +469,8 @@ PyObject* MeshPy::unite(PyObject* args) const
 
     PY_TRY
     {
-        MeshObject* mesh = getMeshObjectPtr()->unite(*pcObject->getMeshObjectPtr());
+        MeshObject* mesh =
+            getMeshObjectPtr()->unite(*pcObject->getMeshObjectPtr(), Base::asBoolean(exact));
         return new MeshPy(mesh);
     }
     PY_CATCH;
@@ -477,7 +482,8 @@ PyObject* MeshPy::intersect(PyObject* args) const
 {
     MeshPy* pcObject {};
     PyObject* pcObj {};
-    if (!PyArg_ParseTuple(args, "O!", &(MeshPy::Type), &pcObj)) {
+    PyObject* exact = Py_False;
+    if (!PyArg_ParseTuple(args, "O!|O!", &(MeshPy::Type), &pcObj, &PyBool_Type, &exact)) {
         return nullptr;
     }
 
@@ -485,7 +491,8 @@ PyObject* MeshPy::intersect(PyObject* args) const
 
     PY_TRY
     {
-        MeshObject* mesh = getMeshObjectPtr()->intersect(*pcObject->getMeshObjectPtr());
+        MeshObject* mesh =
+            getMeshObjectPtr()->intersect(*pcObject->getMeshObjectPtr(), Base::asBoolean(exact));
         return new MeshPy(mesh);
     }
     PY_CATCH;
@@ -497,7 +504,8 @@ PyObject* MeshPy::difference(PyObject* args) const
 {
     MeshPy* pcObject {};
     PyObject* pcObj {};
-    if (!PyArg_ParseTuple(args, "O!", &(MeshPy::Type), &pcObj)) {
+    PyObject* exact = Py_False;
+    if (!PyArg_ParseTuple(args, "O!|O!", &(MeshPy::Type), &pcObj, &PyBool_Type, &exact)) {
         return nullptr;
     }
 
@@ -505,7 +513,8 @@ PyObject* MeshPy::difference(PyObject* args) const
 
     PY_TRY
     {
-        MeshObject* mesh = getMeshObjectPtr()->subtract(*pcObject->getMeshObjectPtr());
+        MeshObject* mesh =
+            getMeshObjectPtr()->subtract(*pcObject->getMeshObjectPtr(), Base::asBoolean(exact));
         return new MeshPy(mesh);
     }
     PY_CATCH;
@@ -517,7 +526,8 @@ PyObject* MeshPy::inner(PyObject* args) const
 {
     MeshPy* pcObject {};
     PyObject* pcObj {};
-    if (!PyArg_ParseTuple(args, "O!", &(MeshPy::Type), &pcObj)) {
+    PyObject* exact = Py_False;
+    if (!PyArg_ParseTuple(args, "O!|O!", &(MeshPy::Type), &pcObj, &PyBool_Type, &exact)) {
         return nullptr;
     }
 
@@ -525,7 +535,8 @@ PyObject* MeshPy::inner(PyObject* args) const
 
     PY_TRY
     {
-        MeshObject* mesh = getMeshObjectPtr()->inner(*pcObject->getMeshObjectPtr());
+        MeshObject* mesh =
+            getMeshObjectPtr()->inner(*pcObject->getMeshObjectPtr(), Base::asBoolean(exact));
         return new MeshPy(mesh);
     }
     PY_CATCH;
@@ -537,7 +548,8 @@ PyObject* MeshPy::outer(PyObject* args) const
 {
     MeshPy* pcObject {};
     PyObject* pcObj {};
-    if (!PyArg_ParseTuple(args, "O!", &(MeshPy::Type), &pcObj)) {
+    PyObject* exact = Py_False;
+    if (!PyArg_ParseTuple(args, "O!|O!", &(MeshPy::Type), &pcObj, &PyBool_Type, &exact)) {
         return nullptr;
     }
 
@@ -545,7 +557,8 @@ PyObject* MeshPy::outer(PyObject* args) const
 
     PY_TRY
     {
-        MeshObject* mesh = getMeshObjectPtr()->outer(*pcObject->getMeshObjectPtr());
+        MeshObject* mesh =
+            getMeshObjectPtr()->outer(*pcObject->getMeshObjectPtr(), Base::asBoolean(exact));
         return new MeshPy(mesh);
     }
     PY_CATCH;
@@ -1197,6 +1210,47 @@ PyObject* MeshPy::getSelfIntersections(PyObject* args) const
     return Py::new_reference_to(tuple);
 }
 
+PyObject* MeshPy::analyze(PyObject* args) const
+{
+    if (!PyArg_ParseTuple(args, "")) {
+        return nullptr;
+    }
+
+    MeshCore::MeshDefectReport report = getMeshObjectPtr()->analyze();
+    auto toTuple = [](const std::vector<MeshCore::ElementIndex>& indices) {
+        Py::Tuple tuple(indices.size());
+        for (std::size_t i = 0; i < indices.size(); i++) {
+            tuple.setItem(i, Py::Long(indices[i]));
+        }
+        return tuple;
+    };
+
+    Py::Tuple selfIntersections(report.selfIntersections.size());
+    for (std::size_t i = 0; i < report.selfIntersections.size(); i++) {
+        Py::Tuple item(2);
+        item.setItem(0, Py::Long(report.selfIntersections[i].first));
+        item.setItem(1, Py::Long(report.selfIntersections[i].second));
+        selfIntersections.setItem(i, item);
+    }
+
+    Py::Dict dict;
+    dict.setItem("FacetsOutOfRange", toTuple(report.facetsOutOfRange));
+    dict.setItem("PointsOutOfRange", toTuple(report.pointsOutOfRange));
+    dict.setItem("CorruptedFacets", toTuple(report.corruptedFacets));
+    dict.setItem("WrongNeighbourhood", toTuple(report.wrongNeighbourhood));
+    dict.setItem("InvalidPoints", toTuple(report.invalidPoints));
+    dict.setItem("DuplicatedPoints", toTuple(report.duplicatedPoints));
+    dict.setItem("DuplicatedFacets", toTuple(report.duplicatedFacets));
+    dict.setItem("DegeneratedFacets", toTuple(report.degeneratedFacets));
+    dict.setItem("NonManifolds", toTuple(report.nonManifolds));
+    dict.setItem("NonManifoldPoints", toTuple(report.nonManifoldPoints));
+    dict.setItem("WrongOrientation", toTuple(report.wrongOrientation));
+    dict.setItem("SelfIntersections", selfIntersections);
+    dict.setItem("FoldsOnSurface", toTuple(report.foldsOnSurface));
+    dict.setItem("FoldsOnBoundary", toTuple(report.foldsOnBoundary));
+    return Py::new_reference_to(dict);
+}
+
 PyObject* MeshPy::fixSelfIntersections(PyObject* args)
 {
     if (!PyArg_ParseTuple(args, "")) {
@@ -2056,11 +2110,11 @@ PyObject* MeshPy::smooth(PyObject* args, PyObject* kwds) const
     Py_Return;
 }
 
-PyObject* MeshPy::decimate(PyObject* args)
+PyObject* MeshPy::decimate(PyObject* args, PyObject* kwds)
 {
     float fTol {};
     float fRed {};
-    if (PyArg_ParseTuple(args, "ff", &fTol, &fRed)) {
+    if (!kwds && PyArg_ParseTuple(args, "ff", &fTol, &fRed)) {
         PY_TRY
         {
             getMeshObjectPtr()->decimate(fTol, fRed);
@@ -2072,7 +2126,7 @@ PyObject* MeshPy::decimate(PyObject* args)
 
     PyErr_Clear();
     int targetSize {};
-    if (PyArg_ParseTuple(args, "i", &targetSize)) {
+    if (!kwds && PyArg_ParseTuple(args, "i", &targetSize)) {
         PY_TRY
         {
             getMeshObjectPtr()->decimate(targetSize);
@@ -2082,8 +2136,40 @@ PyObject* MeshPy::decimate(PyObject* args)
         Py_Return;
     }
 
+    PyErr_Clear();
+    float maxError {};
+    float featureAngle {};
+    PyObject* keepSegments = Py_False;
+    static const std::array<const char*, 5> keywords_decimate {"TargetSize",
+                                                               "MaxError",
+                                                               "FeatureAngle",
+                                                               "KeepSegments",
+                                                               nullptr};
+    if (Base::Wrapped_ParseTupleAndKeywords(args,
+                                            kwds,
+                                            "i|ffO!",
+                                            keywords_decimate,
+                                            &targetSize,
+                                            &maxError,
+                                            &featureAngle,
+                                            &PyBool_Type,
+                                            &keepSegments)) {
+        PY_TRY
+        {
+            getMeshObjectPtr()->decimate(targetSize,
+                                         maxError,
+                                         Base::toRadians(featureAngle),
+                                         Base::asBoolean(keepSegments));
+        }
+        PY_CATCH;
+
+        Py_Return;
+    }
+
     PyErr_SetString(PyExc_ValueError,
-                    "decimate(tolerance=float, reduction=float) or decimate(targetSize=int)");
+                    "decimate(tolerance=float, reduction=float), decimate(targetSize=int) or "
+                    "decimate(TargetSize=int, [MaxError=float, FeatureAngle=float, "
+                    "KeepSegments=bool])");
     return nullptr;
 }
 
@@ -2118,6 +2204,79 @@ PyObject* MeshPy::nearestFacetOnRay(PyObject* args) const
     }
 }
 
+namespace
+{
+Py::List faceSectionsToList(const std::vector<MeshObject::TFaceSection>& sections)
+{
+    Py::List list;
+    for (const auto& it : sections) {
+        if (it.first == MeshCore::FACET_INDEX_MAX) {
+            list.append(Py::None());
+        }
+        else {
+            Py::Tuple tuple(2);
+            tuple.setItem(0, Py::Long(it.first));
+            tuple.setItem(1, Py::Vector(it.second));
+            list.append(tuple);
+        }
+    }
+    return list;
+}
+}  // namespace
+
+PyObject* MeshPy::nearestFacetsOnRays(PyObject* args) const
+{
+    PyObject* list_p {};
+    double maxAngle = MeshCore::Mathd::PI;
+    if (!PyArg_ParseTuple(args, "O|d", &list_p, &maxAngle)) {
+        return nullptr;
+    }
+
+    try {
+        Py::Sequence list(list_p);
+        std::vector<MeshObject::TRay> rays;
+        rays.reserve(list.size());
+        for (Py::Sequence::iterator it = list.begin(); it != list.end(); ++it) {
+            Py::Sequence ray(*it);
+            Py::Vector pnt_t(ray.getItem(0).ptr(), false);
+            Py::Vector dir_t(ray.getItem(1).ptr(), false);
+            rays.emplace_back(pnt_t.toVector(), dir_t.toVector());
+        }
+
+        auto output = getMeshObjectPtr()->nearestFacetsOnRays(rays, maxAngle);
+        return Py::new_reference_to(faceSectionsToList(output));
+    }
+    catch (const Py::Exception&) {
+        return nullptr;
+    }
+}
+
+PyObject* MeshPy::nearestFacetsToPoints(PyObject* args) const
+{
+    PyObject* list_p {};
+    double maxDist = std::numeric_limits<float>::max();
+    if (!PyArg_ParseTuple(args, "O|d", &list_p, &maxDist)) {
+        return nullptr;
+    }
+
+    try {
+        Py::Sequence list(list_p);
+        std::vector<Base::Vector3d> points;
+        points.reserve(list.size());
+        for (Py::Sequence::iterator it = list.begin(); it != list.end(); ++it) {
+            Py::Vector pnt_t((*it).ptr(), false);
+            points.push_back(pnt_t.toVector());
+        }
+
+        maxDist = std::min<double>(maxDist, std::numeric_limits<float>::max());
+        auto output = getMeshObjectPtr()->nearestFacetsToPoints(points, maxDist);
+        return Py::new_reference_to(faceSectionsToList(output));
+    }
+    catch (const Py::Exception&) {
+        return nullptr;
+    }
+}
+
 PyObject* MeshPy::getPlanarSegments(PyObject* args) const
 {
     float dev {};
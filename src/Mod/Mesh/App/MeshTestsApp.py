@@ -224,6 +224,25 @@ class MeshSplitTestCases(unittest.TestCase):
         vec = plm.Rotation.multVec(vec)
         self.assertEqual(len(self.mesh.nearestFacetOnRay(pnt, vec)), 1)
 
+    def testFindNearestBatched(self):
+        rays = [
+            ((-2, 2, -6), (0, 0, 1)),
+            ((0.1, 0.3, 0.2), (0, 0, 1)),
+            ((0.2, 0.1, 0.2), (0, 0, -1)),
+        ]
+        results = self.mesh.nearestFacetsOnRays(rays)
+        self.assertEqual(len(results), 3)
+        self.assertIsNone(results[0])
+        for ray, result in zip(rays[1:], results[1:]):
+            single = self.mesh.nearestFacetOnRay(*ray)
+            index, point = result
+            self.assertIn(index, single)
+            self.assertAlmostEqual(point.distanceToPoint(Base.Vector(single[index])), 0.0)
+
+        results = self.mesh.nearestFacetsToPoints([(0.1, 0.2, 1.5), (5, 5, 5)], 1.5)
+        self.assertAlmostEqual(results[0][1].distanceToPoint(Base.Vector(0.1, 0.2, 0.5)), 0.0)
+        self.assertIsNone(results[1])
+
     def testForaminate(self):
         class FilterAngle:
             def __init__(self, mesh, vec, limit):
@@ -479,6 +498,75 @@ endsolid Simple"""
         mesh.read(Stream=data, Format="AST")
         self.assertTrue(mesh.hasSelfIntersections())
 
+    def testAnalyze(self):
+        mesh = Mesh.createBox(1.0, 1.0, 1.0)
+        report = mesh.analyze()
+        self.assertFalse(any(report.values()))
+
+        other = mesh.copy()
+        other.translate(0.5, 0.5, 0.5)
+        mesh.addMesh(other)
+        report = mesh.analyze()
+        self.assertTrue(len(report["SelfIntersections"]) > 0)
+        self.assertEqual(len(report["DuplicatedFacets"]), 0)
+
+    def testReadBinaryFiles(self):
+        mesh = Mesh.createSphere(10.0, 100)
+        for ext in ("stl", "ply"):
+            name = tempfile.gettempdir() + os.sep + "binary_mesh." + ext
+            mesh.write(name)
+            other = Mesh.Mesh(name)
+            os.remove(name)
+            self.assertEqual(other.CountPoints, mesh.CountPoints)
+            self.assertEqual(other.CountFacets, mesh.CountFacets)
+            self.assertFalse(any(other.analyze().values()))
+
+    def testDecimate(self):
+        mesh = Mesh.createSphere(10.0, 100)
+        target = mesh.CountFacets // 4
+        mesh.decimate(TargetSize=target, MaxError=0.5)
+        self.assertLessEqual(mesh.CountFacets, target)
+        self.assertFalse(any(mesh.analyze().values()))
+
+        mesh = Mesh.createCylinder(2.0, 10.0, True, 1.0, 360)
+        mesh.decimate(TargetSize=10, FeatureAngle=30)
+        self.assertGreater(mesh.CountFacets, 10)
+        self.assertTrue(mesh.isSolid())
+
+    def testProcessOutOfCore(self):
+        mesh = Mesh.createSphere(10.0, 100)
+        stl = tempfile.gettempdir() + os.sep + "out_of_core.stl"
+        ply = tempfile.gettempdir() + os.sep + "out_of_core.ply"
+        mesh.write(stl)
+        mat = FreeCAD.Matrix()
+        mat.move(FreeCAD.Vector(1, 2, 3))
+        Mesh.processOutOfCore(stl, ply, Matrix=mat, Cleanup=True, FacetsPerChunk=1000)
+        source = Mesh.Mesh(stl)
+        other = Mesh.Mesh(ply)
+        os.remove(stl)
+        os.remove(ply)
+        self.assertEqual(other.CountPoints, source.CountPoints)
+        self.assertEqual(other.CountFacets, source.CountFacets)
+        self.assertTrue(other.isSolid())
+        self.assertAlmostEqual(other.BoundBox.Center.x, 1.0, 3)
+
+    def testExactBoolean(self):
+        mesh = Mesh.createBox(1.0, 1.0, 1.0)
+        other = mesh.copy()
+        other.translate(0.5, 0.5, 0.5)
+
+        union = mesh.unite(other, True)
+        self.assertTrue(union.isSolid())
+        self.assertAlmostEqual(union.Volume, 1.875)
+
+        common = mesh.intersect(other, True)
+        self.assertTrue(common.isSolid())
+        self.assertAlmostEqual(common.Volume, 0.125)
+
+        diff = mesh.difference(other, True)
+        self.assertTrue(diff.isSolid())
+        self.assertAlmostEqual(diff.Volume, 0.875)
+
 
 class PivyTestCases(unittest.TestCase):
     def setUp(self):
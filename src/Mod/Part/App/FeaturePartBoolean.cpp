@@ -163,3 +163,10 @@ App::DocumentObjectExecReturn* Boolean::execute()
             "A fatal error occurred when running boolean operation");
     }
 }
+
+App::DocumentObjectExecReturn* Boolean::restoreCachedShape(const TopoShape& shape)
+{
+    this->Shape.setValue(shape);
+    copyMaterial(Base.getValue());
+    return Part::Feature::execute();
+}
@@ -51,12 +51,17 @@ public:
     short mustExecute() const override;
     //@}
 
+    bool isShapeCacheable() const override {
+        return true;
+    }
+
     /// returns the type name of the ViewProvider
     const char* getViewProviderName() const override {
         return "PartGui::ViewProviderBoolean";
     }
 
 protected:
+    App::DocumentObjectExecReturn *restoreCachedShape(const TopoShape& shape) override;
     virtual BRepAlgoAPI_BooleanOperation* makeOperation(const TopoDS_Shape&, const TopoDS_Shape&) const = 0;
     virtual const char *opCode() const = 0;
 };
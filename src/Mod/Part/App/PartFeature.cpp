@@ -76,6 +76,7 @@
 #include "PartFeature.h"
 #include "PartFeaturePy.h"
 #include "PartPyCXX.h"
+#include "PersistentShapeCache.h"
 #include "TopoShapePy.h"
 #include "Tools.h"
 
@@ -104,7 +105,25 @@ short Feature::mustExecute() const
 App::DocumentObjectExecReturn *Feature::recompute()
 {
     try {
-        return App::GeoFeature::recompute();
+        std::string key;
+        if (isShapeCacheable() && PersistentShapeCache::isEnabled()) {
+            key = PersistentShapeCache::makeKey(this);
+        }
+        if (!key.empty()) {
+            TopoShape shape;
+            if (PersistentShapeCache::find(key, shape)) {
+                FC_LOG("Take the shape of " << getFullName() << " from the cache");
+                return recomputeWith([this, &shape]() {
+                    return restoreCachedShape(shape);
+                });
+            }
+        }
+
+        auto ret = App::GeoFeature::recompute();
+        if (!key.empty() && ret == App::DocumentObject::StdReturn) {
+            PersistentShapeCache::store(key, Shape.getShape());
+        }
+        return ret;
     }
     catch (Standard_Failure& e) {
 
@@ -120,6 +139,12 @@ App::DocumentObjectExecReturn *Feature::execute()
     return GeoFeature::execute();
 }
 
+App::DocumentObjectExecReturn *Feature::restoreCachedShape(const TopoShape& shape)
+{
+    this->Shape.setValue(shape);
+    return Feature::execute();
+}
+
 PyObject *Feature::getPyObject()
 {
     if (PythonObject.is(Py::_None())){
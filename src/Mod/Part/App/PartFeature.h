@@ -65,6 +65,15 @@ public:
     short mustExecute() const override;
     //@}
 
+    /** Returns whether the shape made by execute() only depends on the properties added by
+     * the sub-class and the shapes of the objects they link to. Such a shape can be taken
+     * from the PersistentShapeCache when it is enabled.
+     */
+    virtual bool isShapeCacheable() const
+    {
+        return false;
+    }
+
     /// returns the type name of the ViewProvider
     const char* getViewProviderName() const override;
     const App::PropertyComplexGeoData* getPropertyOfGeometry() const override;
@@ -166,6 +175,8 @@ protected:
     App::DocumentObjectExecReturn *recompute() override;
     /// recalculate the feature
     App::DocumentObjectExecReturn *execute() override;
+    /// sets a shape from the PersistentShapeCache in place of execute()
+    virtual App::DocumentObjectExecReturn *restoreCachedShape(const TopoShape& shape);
     void onBeforeChange(const App::Property* prop) override;
     void onChanged(const App::Property* prop) override;
     void onDocumentRestored() override;
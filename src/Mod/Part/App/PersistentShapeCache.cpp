@@ -0,0 +1,351 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2025 FreeCAD Project Association                         *
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+#include "PreCompiled.h"
+
+#ifndef _PreComp_
+#include <Standard_Failure.hxx>
+#include <Standard_Version.hxx>
+#endif
+
+#include <algorithm>
+#include <filesystem>
+#include <sstream>
+#include <system_error>
+#include <vector>
+
+#include <QCryptographicHash>
+
+#include <App/Application.h>
+#include <App/DocumentObject.h>
+#include <App/PropertyLinks.h>
+#include <Base/Console.h>
+#include <Base/Exception.h>
+#include <Base/FileInfo.h>
+#include <Base/Parameter.h>
+#include <Base/Stream.h>
+#include <Base/Writer.h>
+
+#include "PartFeature.h"
+#include "PersistentShapeCache.h"
+#include "TopoShape.h"
+
+FC_LOG_LEVEL_INIT("Part", true, true)
+
+using namespace Part;
+namespace fs = std::filesystem;
+
+namespace
+{
+// increase if the stored data or the computation of the key changes
+constexpr const char* cacheFormat = "PartShapeCache2";
+constexpr const char* cacheExtension = ".fcshape";
+
+ParameterGrp::handle getParameter()
+{
+    return App::GetApplication().GetParameterGroupByPath(
+        "User parameter:BaseApp/Preferences/Mod/Part/ShapeCache");
+}
+
+void addData(QCryptographicHash& hash, const std::string& data)
+{
+    // include the terminating zero to separate the entries
+#if QT_VERSION < QT_VERSION_CHECK(6, 3, 0)
+    hash.addData(data.c_str(), static_cast<int>(data.size() + 1));
+#else
+    hash.addData(QByteArrayView(data.c_str(), static_cast<qsizetype>(data.size() + 1)));
+#endif
+}
+
+void addProperty(QCryptographicHash& hash, const App::Property* prop)
+{
+    Base::StringWriter writer;
+    prop->Save(writer);
+    addData(hash, prop->getName());
+    addData(hash, writer.getString());
+}
+
+bool isInput(const App::Property* prop)
+{
+    return !prop->testStatus(App::Property::Output) && !(prop->getType() & App::Prop_Output)
+        && !prop->testStatus(App::Property::Transient)
+        && !(prop->getType() & App::Prop_Transient);
+}
+
+void addShape(QCryptographicHash& hash, const TopoShape& shape)
+{
+    std::stringstream str;
+    shape.exportBinary(str);
+    addData(hash, str.str());
+    for (const auto& element : shape.getElementMap()) {
+        addData(hash, element.index.toString());
+        addData(hash, element.name.toString());
+    }
+}
+
+// Adds the content of an object a feature links to. Returns false if it can't be hashed.
+bool addUpstream(QCryptographicHash& hash, const App::DocumentObject* obj)
+{
+    // element names refer to the IDs of the objects they come from
+    addData(hash, obj->getTypeId().getName());
+    addData(hash, std::to_string(obj->getID()));
+    if (auto feature = freecad_cast<const Feature*>(obj)) {
+        addShape(hash, feature->Shape.getShape());
+        return true;
+    }
+
+    // Objects without links, like the planes and axes of an origin, are
+    // described by their property values. Anything else, e.g. a link or a
+    // group, would have to be followed recursively.
+    if (!obj->getOutList().empty()) {
+        return false;
+    }
+    std::vector<App::Property*> props;
+    obj->getPropertyList(props);
+    for (auto prop : props) {
+        if (isInput(prop) && prop != &obj->Label && prop != &obj->Label2
+            && prop != &obj->Visibility && prop != &obj->ExpressionEngine) {
+            addProperty(hash, prop);
+        }
+    }
+    return true;
+}
+
+void writeString(std::ostream& str, const std::string& data)
+{
+    Base::OutputStream out(str);
+    out << static_cast<uint32_t>(data.size());
+    str.write(data.data(), static_cast<std::streamsize>(data.size()));
+}
+
+std::string readString(std::istream& str)
+{
+    Base::InputStream in(str);
+    uint32_t size {};
+    in >> size;
+    std::string data(size, '\0');
+    str.read(data.data(), static_cast<std::streamsize>(size));
+    if (!str) {
+        throw Base::FileException("Unexpected end of file");
+    }
+    return data;
+}
+}  // namespace
+
+bool PersistentShapeCache::isEnabled()
+{
+    return getParameter()->GetBool("Enabled", false);
+}
+
+std::string PersistentShapeCache::makeKey(const Feature* feature)
+{
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    addData(hash, cacheFormat);
+    addData(hash, OCC_VERSION_COMPLETE);
+    addData(hash, feature->getTypeId().getName());
+
+    // The inputs are the properties added by the sub-classes. The properties of
+    // Part::Feature itself, like the placement, are applied after a lookup.
+    std::vector<App::Property*> props;
+    feature->getPropertyData().getPropertyList(feature, props);
+    std::vector<App::DocumentObject*> upstream;
+    for (auto prop : props) {
+        if (Feature::getPropertyDataPtr()->findProperty(feature, prop) || !isInput(prop)) {
+            continue;
+        }
+        addProperty(hash, prop);
+        if (auto link = freecad_cast<const App::PropertyLinkBase*>(prop)) {
+            link->getLinks(upstream, true);
+        }
+    }
+    if (!upstream.empty()) {
+        // the element map of the result refers to the IDs of the feature and its inputs
+        addData(hash, std::to_string(feature->getID()));
+    }
+    for (auto obj : upstream) {
+        if (!obj || !addUpstream(hash, obj)) {
+            FC_LOG("Can't hash the input " << (obj ? obj->getFullName() : std::string("null"))
+                                           << " of " << feature->getFullName());
+            return {};
+        }
+    }
+    return hash.result().toHex().constData();
+}
+
+std::string PersistentShapeCache::getDirectory()
+{
+    std::string dir = getParameter()->GetASCII("Directory");
+    if (dir.empty()) {
+        dir = App::Application::getUserCachePath() + "ShapeCache";
+    }
+    return dir;
+}
+
+bool PersistentShapeCache::find(const std::string& key, TopoShape& shape)
+{
+    Base::FileInfo fi(getDirectory() + "/" + key + cacheExtension);
+    if (!fi.isReadable()) {
+        return false;
+    }
+
+    try {
+        Base::ifstream str(fi, std::ios::in | std::ios::binary);
+        if (readString(str) != cacheFormat) {
+            return false;
+        }
+        std::istringstream brep(readString(str));
+        TopoShape result;
+        result.importBinary(brep);
+        if (result.isNull()) {
+            FC_WARN("Ignore invalid cached shape " << fi.filePath());
+            return false;
+        }
+        Base::InputStream in(str);
+        uint32_t count {};
+        in >> count;
+        std::vector<Data::MappedElement> elements;
+        elements.reserve(count);
+        for (uint32_t i = 0; i < count; i++) {
+            std::string index = readString(str);
+            std::string name = readString(str);
+            elements.emplace_back(Data::IndexedName(index.c_str()), Data::MappedName(name));
+        }
+        if (!elements.empty()) {
+            result.setElementMap(elements);
+        }
+        shape = result;
+    }
+    catch (const Standard_Failure& e) {
+        FC_WARN("Failed to read cached shape " << fi.filePath() << ": " << e.GetMessageString());
+        return false;
+    }
+    catch (const Base::Exception& e) {
+        FC_WARN("Failed to read cached shape " << fi.filePath() << ": " << e.what());
+        return false;
+    }
+
+    // mark the shape as recently used for the eviction
+    std::error_code ec;
+    fs::last_write_time(Base::FileInfo::stringToPath(fi.filePath()),
+                        fs::file_time_type::clock::now(),
+                        ec);
+    return true;
+}
+
+void PersistentShapeCache::store(const std::string& key, const TopoShape& shape)
+{
+    for (const auto& element : shape.getElementMap()) {
+        Data::ElementIDRefs sids;
+        shape.getMappedName(element.index, false, &sids);
+        if (!sids.isEmpty()) {
+            FC_LOG("Don't cache shape " << key << " with hashed element names");
+            return;
+        }
+    }
+
+    Base::FileInfo dir(getDirectory());
+    if (!dir.exists() && !dir.createDirectories()) {
+        FC_WARN("Failed to create shape cache directory " << dir.filePath());
+        return;
+    }
+
+    // Write to a process specific file first so that concurrent sessions never
+    // see an incomplete file
+    Base::FileInfo fi(dir.filePath() + "/" + key + cacheExtension);
+    Base::FileInfo tmp(fi.filePath() + "." + std::to_string(App::Application::applicationPid()));
+    try {
+        {
+            std::ostringstream brep;
+            TopoShape copy(shape);
+            copy.setTransform(Base::Matrix4D());
+            copy.exportBinary(brep);
+            auto elements = shape.getElementMap();
+
+            Base::ofstream str(tmp, std::ios::out | std::ios::binary);
+            writeString(str, cacheFormat);
+            writeString(str, brep.str());
+            Base::OutputStream out(str);
+            out << static_cast<uint32_t>(elements.size());
+            for (const auto& element : elements) {
+                writeString(str, element.index.toString());
+                writeString(str, element.name.toString());
+            }
+            if (!str) {
+                throw Base::FileException("Failed to write file", tmp);
+            }
+        }
+        if (!tmp.renameFile(fi.filePath().c_str())) {
+            tmp.deleteFile();
+        }
+    }
+    catch (const Standard_Failure& e) {
+        FC_WARN("Failed to cache shape " << fi.filePath() << ": " << e.GetMessageString());
+        tmp.deleteFile();
+    }
+    catch (const Base::Exception& e) {
+        FC_WARN("Failed to cache shape " << fi.filePath() << ": " << e.what());
+        tmp.deleteFile();
+    }
+
+    const std::uintmax_t megabyte = 1024 * 1024;
+    evict(std::uintmax_t(getParameter()->GetUnsigned("MaxSize", 1024)) * megabyte);
+}
+
+void PersistentShapeCache::evict(std::uintmax_t maxSize)
+{
+    struct Entry
+    {
+        fs::path path;
+        fs::file_time_type time;
+        std::uintmax_t size;
+    };
+    std::vector<Entry> entries;
+    std::uintmax_t total = 0;
+    std::error_code ec;
+    for (const auto& file : fs::directory_iterator(Base::FileInfo::stringToPath(getDirectory()), ec)) {
+        if (file.path().extension() != cacheExtension) {
+            continue;
+        }
+        Entry entry {file.path(), file.last_write_time(ec), file.file_size(ec)};
+        if (!ec) {
+            total += entry.size;
+            entries.push_back(std::move(entry));
+        }
+    }
+    if (total <= maxSize) {
+        return;
+    }
+
+    // remove the least recently used shapes first
+    std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) {
+        return a.time < b.time;
+    });
+    for (const auto& entry : entries) {
+        if (total <= maxSize) {
+            break;
+        }
+        if (fs::remove(entry.path, ec)) {
+            total -= entry.size;
+        }
+    }
+}
@@ -0,0 +1,73 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2025 FreeCAD Project Association                         *
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+#ifndef PART_PERSISTENTSHAPECACHE_H
+#define PART_PERSISTENTSHAPECACHE_H
+
+#include <cstdint>
+#include <string>
+
+#include <Mod/Part/PartGlobal.h>
+
+namespace Part
+{
+
+class Feature;
+class TopoShape;
+
+/** Content addressed cache of recomputed shapes on disk
+ *
+ * A feature that opts in with Feature::isShapeCacheable() looks up the shape
+ * of an earlier recompute, also of another session, by a hash over its type,
+ * its input property values and the shapes of the objects it links to. The
+ * shapes are stored as binary BREP without placement, together with their
+ * element map. Shapes whose element map refers to the string hasher of the
+ * document are not stored, since the hashed names can't be resolved in
+ * another session.
+ *
+ * The cache is off by default and is controlled by the parameter group
+ * "User parameter:BaseApp/Preferences/Mod/Part/ShapeCache" with the entries
+ * "Enabled", "Directory" and "MaxSize" in MB. When the cache grows beyond
+ * MaxSize the least recently used shapes are removed.
+ */
+class PartExport PersistentShapeCache
+{
+public:
+    static bool isEnabled();
+    /** Returns the key for the shape of \a feature
+     * The key is empty if the shape depends on an object whose content can't be hashed.
+     */
+    static std::string makeKey(const Feature* feature);
+    /// Loads the shape stored under \a key, returns false if there is none
+    static bool find(const std::string& key, TopoShape& shape);
+    /// Stores \a shape under \a key and evicts old shapes, failures are only logged
+    static void store(const std::string& key, const TopoShape& shape);
+
+private:
+    static std::string getDirectory();
+    static void evict(std::uintmax_t maxSize);
+};
+
+}  // namespace Part
+
+#endif  // PART_PERSISTENTSHAPECACHE_H
@@ -46,6 +46,10 @@ public:
     PyObject* getPyObject() override;
     //@}
 
+    bool isShapeCacheable() const override {
+        return true;
+    }
+
 protected:
     void Restore(Base::XMLReader &reader) override;
     void onChanged (const App::Property* prop) override;
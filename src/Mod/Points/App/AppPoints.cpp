@@ -25,6 +25,7 @@
 #include <Base/Console.h>
 #include <Base/Interpreter.h>
 
+#include "Downsample.h"
 #include "Points.h"
 #include "PointsPy.h"
 #include "Properties.h"
@@ -60,6 +61,7 @@ PyMOD_INIT_FUNC(Points)
     Points::FeatureCustom           ::init();
     Points::StructuredCustom        ::init();
     Points::FeaturePython           ::init();
+    Points::Downsample              ::init();
     PyMOD_Return(pointsModule);
     // clang-format on
 }
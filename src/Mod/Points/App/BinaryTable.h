@@ -0,0 +1,232 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2025 FreeCAD Project Association                         *
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+#ifndef POINTS_BINARYTABLE_H
+#define POINTS_BINARYTABLE_H
+
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <iterator>
+#include <optional>
+#include <vector>
+#include <Eigen/Core>
+
+#include <Base/Exception.h>
+#include <Base/FileInfo.h>
+#include <Base/Stream.h>
+#include <Base/Swap.h>
+
+
+namespace Points
+{
+
+/*!
+ * \brief The BinaryData class gives access to the binary section of a point cloud file
+ * that starts at the current position of the input stream. The file is mapped into
+ * memory if possible, otherwise the section is read into a buffer.
+ */
+class BinaryData
+{
+public:
+    BinaryData(const Base::FileInfo& fi, std::istream& inp)
+    {
+        std::streamoff pos = inp.tellg();
+        if (pos < 0) {
+            throw Base::BadFormatError("Failed to locate binary data");
+        }
+
+        auto start = static_cast<std::size_t>(pos);
+        file.emplace(fi);
+        if (file->isMapped() && start <= file->size()) {
+            begin = file->data() + start;
+            length = file->size() - start;
+        }
+        else {
+            readBuffer(inp);
+        }
+    }
+    /// Reads the rest of \a inp into a buffer
+    explicit BinaryData(std::istream& inp)
+    {
+        readBuffer(inp);
+    }
+    const char* data() const
+    {
+        return begin;
+    }
+    std::size_t size() const
+    {
+        return length;
+    }
+
+private:
+    void readBuffer(std::istream& inp)
+    {
+        buffer.assign(std::istreambuf_iterator<char>(inp), std::istreambuf_iterator<char>());
+        begin = buffer.data();
+        length = buffer.size();
+    }
+
+private:
+    std::optional<Base::MappedFile> file;
+    std::vector<char> buffer;
+    const char* begin {nullptr};
+    std::size_t length {0};
+};
+
+/*!
+ * \brief The BinaryTable class converts the fields of binary point data directly into
+ * the requested type. The values can be stored record-wise, i.e. all fields of a point
+ * next to each other, or block-wise, i.e. all values of a field next to each other.
+ */
+class BinaryTable
+{
+public:
+    enum class Type
+    {
+        Int8,
+        UInt8,
+        Int16,
+        UInt16,
+        Int32,
+        UInt32,
+        Float32,
+        Float64
+    };
+
+    BinaryTable(const char* data, bool swapByteOrder)
+        : data(data)
+        , swapByteOrder(swapByteOrder)
+    {}
+
+    static std::size_t sizeOf(Type type)
+    {
+        switch (type) {
+            case Type::Int8:
+            case Type::UInt8:
+                return 1;
+            case Type::Int16:
+            case Type::UInt16:
+                return 2;
+            case Type::Int32:
+            case Type::UInt32:
+            case Type::Float32:
+                return 4;
+            case Type::Float64:
+                return 8;
+        }
+        return 0;
+    }
+
+    /// The fields of a point are stored next to each other
+    void setRecords(const std::vector<Type>& types)
+    {
+        std::size_t stride = 0;
+        for (auto type : types) {
+            stride += sizeOf(type);
+        }
+
+        std::size_t offset = 0;
+        columns.clear();
+        for (auto type : types) {
+            columns.push_back({offset, stride, type});
+            offset += sizeOf(type);
+        }
+        rowBytes = stride;
+    }
+
+    /// The values of a field are stored next to each other
+    void setBlocks(const std::vector<Type>& types, std::size_t numRows)
+    {
+        std::size_t offset = 0;
+        columns.clear();
+        rowBytes = 0;
+        for (auto type : types) {
+            columns.push_back({offset, sizeOf(type), type});
+            offset += sizeOf(type) * numRows;
+            rowBytes += sizeOf(type);
+        }
+    }
+
+    /// Returns the number of bytes of all fields of a point
+    std::size_t rowSize() const
+    {
+        return rowBytes;
+    }
+
+    template<typename T>
+    T get(Eigen::Index row, Eigen::Index col) const
+    {
+        const Column& column = columns[col];
+        const char* ptr = data + column.offset + static_cast<std::size_t>(row) * column.stride;
+        switch (column.type) {
+            case Type::Int8:
+                return static_cast<T>(read<int8_t>(ptr));
+            case Type::UInt8:
+                return static_cast<T>(read<uint8_t>(ptr));
+            case Type::Int16:
+                return static_cast<T>(read<int16_t>(ptr));
+            case Type::UInt16:
+                return static_cast<T>(read<uint16_t>(ptr));
+            case Type::Int32:
+                return static_cast<T>(read<int32_t>(ptr));
+            case Type::UInt32:
+                return static_cast<T>(read<uint32_t>(ptr));
+            case Type::Float32:
+                return static_cast<T>(read<float>(ptr));
+            case Type::Float64:
+                return static_cast<T>(read<double>(ptr));
+        }
+        return T {};
+    }
+
+private:
+    template<typename V>
+    V read(const char* ptr) const
+    {
+        V value {};
+        std::memcpy(&value, ptr, sizeof(V));
+        if (swapByteOrder) {
+            Base::SwapEndian(value);
+        }
+        return value;
+    }
+
+    struct Column
+    {
+        std::size_t offset;
+        std::size_t stride;
+        Type type;
+    };
+
+    const char* data;
+    bool swapByteOrder;
+    std::size_t rowBytes {0};
+    std::vector<Column> columns;
+};
+
+}  // namespace Points
+
+
+#endif  // POINTS_BINARYTABLE_H
@@ -0,0 +1,166 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2025 FreeCAD Project Association                         *
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+#include "PreCompiled.h"
+
+#ifndef _PreComp_
+#include <limits>
+#include <vector>
+#endif
+
+#include <App/PropertyStandard.h>
+#include <Base/Exception.h>
+
+#include "Downsample.h"
+#include "PointsDownsample.h"
+#include "Properties.h"
+
+
+using namespace Points;
+
+namespace
+{
+const App::PropertyIntegerConstraint::Constraints countRange = {1,
+                                                                std::numeric_limits<int>::max(),
+                                                                1000};
+const App::PropertyIntegerConstraint::Constraints voxelRange = {1,
+                                                                std::numeric_limits<int>::max(),
+                                                                1};
+
+template<typename PropertyT, typename ValueT>
+void setDynamicValues(App::DocumentObject* obj,
+                      const char* propertyName,
+                      const std::vector<ValueT>& values)
+{
+    auto prop = freecad_cast<PropertyT*>(obj->getPropertyByName(propertyName));
+    if (values.empty()) {
+        if (prop && prop->testStatus(App::Property::PropDynamic)) {
+            obj->removeDynamicProperty(propertyName);
+        }
+        return;
+    }
+
+    if (!prop) {
+        prop = freecad_cast<PropertyT*>(
+            obj->addDynamicProperty(PropertyT::getClassTypeId().getName(), propertyName));
+    }
+    if (prop) {
+        prop->setValues(values);
+    }
+}
+}  // namespace
+
+//===========================================================================
+// Downsample
+//===========================================================================
+
+const char* Downsample::MethodEnums[] =
+    {"VoxelGrid", "Random", "PoissonDisk", "Curvature", nullptr};
+
+PROPERTY_SOURCE(Points::Downsample, Points::Feature)
+
+Downsample::Downsample()
+{
+    ADD_PROPERTY_TYPE(Source, (nullptr), "Downsample", App::Prop_None, "The points to reduce");
+    ADD_PROPERTY_TYPE(Method, (0L), "Downsample", App::Prop_None, "The downsampling method");
+    ADD_PROPERTY_TYPE(Size, (1.0), "Downsample", App::Prop_None, "Edge length of a voxel");
+    ADD_PROPERTY_TYPE(Radius,
+                      (1.0),
+                      "Downsample",
+                      App::Prop_None,
+                      "Minimum distance between two points");
+    ADD_PROPERTY_TYPE(Count, (100000), "Downsample", App::Prop_None, "Number of points to keep");
+    ADD_PROPERTY_TYPE(MaxPointsPerVoxel,
+                      (8),
+                      "Downsample",
+                      App::Prop_None,
+                      "Maximum number of points kept in a strongly curved voxel");
+    ADD_PROPERTY_TYPE(Seed, (0), "Downsample", App::Prop_None, "Seed of the random selection");
+    Method.setEnums(MethodEnums);
+    Count.setConstraints(&countRange);
+    MaxPointsPerVoxel.setConstraints(&voxelRange);
+}
+
+short Downsample::mustExecute() const
+{
+    if (Source.isTouched() || Method.isTouched() || Size.isTouched() || Radius.isTouched()
+        || Count.isTouched() || MaxPointsPerVoxel.isTouched() || Seed.isTouched()) {
+        return 1;
+    }
+    if (Source.getValue() && Source.getValue()->isTouched()) {
+        return 1;
+    }
+    return Feature::mustExecute();
+}
+
+App::DocumentObjectExecReturn* Downsample::execute()
+{
+    auto* source = freecad_cast<Points::Feature*>(Source.getValue());
+    if (!source || source->isError()) {
+        return new App::DocumentObjectExecReturn("No points object attached.");
+    }
+
+    PointDownsample downsample(source->Points.getValue());
+    if (auto grey =
+            freecad_cast<PropertyGreyValueList*>(source->getPropertyByName("Intensity"))) {
+        downsample.setIntensities(grey->getValues());
+    }
+    if (auto col = freecad_cast<App::PropertyColorList*>(source->getPropertyByName("Color"))) {
+        downsample.setColors(col->getValues());
+    }
+    if (auto nor = freecad_cast<PropertyNormalList*>(source->getPropertyByName("Normal"))) {
+        downsample.setNormals(nor->getValues());
+    }
+
+    auto seed = static_cast<unsigned int>(Seed.getValue());
+    try {
+        switch (Method.getValue()) {
+            case 0:
+                downsample.voxelGrid(Size.getValue());
+                break;
+            case 1:
+                downsample.random(static_cast<PointKernel::size_type>(Count.getValue()), seed);
+                break;
+            case 2:
+                downsample.poissonDisk(Radius.getValue(), seed);
+                break;
+            case 3:
+                downsample.curvature(
+                    Size.getValue(),
+                    static_cast<PointKernel::size_type>(MaxPointsPerVoxel.getValue()));
+                break;
+            default:
+                return new App::DocumentObjectExecReturn("Unknown downsampling method.");
+        }
+    }
+    catch (const Base::Exception& e) {
+        return new App::DocumentObjectExecReturn(e.what());
+    }
+
+    Points.setValue(downsample.getPoints());
+    setDynamicValues<PropertyGreyValueList>(this, "Intensity", downsample.getIntensities());
+    setDynamicValues<App::PropertyColorList>(this, "Color", downsample.getColors());
+    setDynamicValues<PropertyNormalList>(this, "Normal", downsample.getNormals());
+
+    return App::DocumentObject::StdReturn;
+}
@@ -0,0 +1,70 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2025 FreeCAD Project Association                         *
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+#ifndef POINTS_DOWNSAMPLE_FEATURE_H
+#define POINTS_DOWNSAMPLE_FEATURE_H
+
+#include <App/PropertyLinks.h>
+#include <App/PropertyStandard.h>
+#include <App/PropertyUnits.h>
+
+#include "PointsFeature.h"
+
+
+namespace Points
+{
+
+/*! The Downsample class reduces the points of a related points feature to a working density.
+  Intensities, colors and normals of the source are carried along.
+ */
+class PointsExport Downsample: public Feature
+{
+    PROPERTY_HEADER_WITH_OVERRIDE(Points::Downsample);
+
+public:
+    /// Constructor
+    Downsample();
+
+    App::PropertyLink Source;
+    App::PropertyEnumeration Method;
+    App::PropertyLength Size;                          /**< Edge length of a voxel. */
+    App::PropertyLength Radius;                        /**< Minimum distance for PoissonDisk. */
+    App::PropertyIntegerConstraint Count;              /**< Number of points for Random. */
+    App::PropertyIntegerConstraint MaxPointsPerVoxel;  /**< Maximum per voxel for Curvature. */
+    App::PropertyInteger Seed;                         /**< Seed for Random and PoissonDisk. */
+
+    /** @name methods override Feature */
+    //@{
+    short mustExecute() const override;
+    /// recalculate the Feature
+    App::DocumentObjectExecReturn* execute() override;
+    //@}
+
+private:
+    static const char* MethodEnums[];
+};
+
+}  // namespace Points
+
+
+#endif  // POINTS_DOWNSAMPLE_FEATURE_H
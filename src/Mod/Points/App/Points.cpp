@@ -193,9 +193,8 @@ void PointKernel::SaveDocFile(Base::Writer& writer) const
     uint32_t uCt = (uint32_t)size();
     str << uCt;
     // store the data without transforming it
-    for (const auto& pnt : _Points) {
-        str << pnt.x << pnt.y << pnt.z;
-    }
+    static_assert(sizeof(value_type) == 3 * sizeof(float));
+    str.writeArray(reinterpret_cast<const float*>(_Points.data()), 3 * _Points.size());
 }
 
 void PointKernel::Restore(Base::XMLReader& reader)
@@ -221,13 +220,7 @@ void PointKernel::RestoreDocFile(Base::Reader& reader)
     uint32_t uCt = 0;
     str >> uCt;
     _Points.resize(uCt);
-    for (unsigned long i = 0; i < uCt; i++) {
-        float x {};
-        float y {};
-        float z {};
-        str >> x >> y >> z;
-        _Points[i].Set(x, y, z);
-    }
+    str.readArray(reinterpret_cast<float*>(_Points.data()), 3 * _Points.size());
 }
 
 void PointKernel::save(const char* file) const
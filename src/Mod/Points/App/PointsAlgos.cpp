@@ -25,8 +25,15 @@
 #ifdef FC_OS_LINUX
 #include <unistd.h>
 #endif
+#include <QtConcurrentMap>
+#include <algorithm>
+#include <cmath>
+#include <exception>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <sstream>
+#include <unordered_set>
 
 #include <boost/algorithm/string.hpp>
 #include <boost/lexical_cast.hpp>
@@ -40,8 +47,11 @@
 #include <Base/FileInfo.h>
 #include <Base/Sequencer.h>
 #include <Base/Stream.h>
+#include <Base/Swap.h>
 
+#include "BinaryTable.h"
 #include "PointsAlgos.h"
+#include "Tools.h"
 #include <E57Format.h>
 
 
@@ -246,90 +256,6 @@ public:
 
 using ConverterPtr = std::shared_ptr<Converter>;
 
-class DataStreambuf: public std::streambuf
-{
-public:
-    explicit DataStreambuf(const std::vector<char>& data)
-        : _buffer(data)
-        , _end(int(data.size()))
-    {}
-    ~DataStreambuf() override = default;
-
-protected:
-    int_type uflow() override
-    {
-        if (_cur == _end) {
-            return traits_type::eof();
-        }
-
-        return static_cast<DataStreambuf::int_type>(_buffer[_cur++]) & 0x000000ff;
-    }
-    int_type underflow() override
-    {
-        if (_cur == _end) {
-            return traits_type::eof();
-        }
-
-        return static_cast<DataStreambuf::int_type>(_buffer[_cur]) & 0x000000ff;
-    }
-    int_type pbackfail(int_type ch) override
-    {
-        if (_cur == _beg || (ch != traits_type::eof() && ch != _buffer[_cur - 1])) {
-            return traits_type::eof();
-        }
-
-        return static_cast<DataStreambuf::int_type>(_buffer[--_cur]) & 0x000000ff;
-    }
-    std::streamsize showmanyc() override
-    {
-        return _end - _cur;
-    }
-    pos_type seekoff(std::streambuf::off_type off,
-                     std::ios_base::seekdir way,
-                     std::ios_base::openmode mode = std::ios::in | std::ios::out) override
-    {
-        (void)mode;
-        int p_pos = -1;
-        if (way == std::ios_base::beg) {
-            p_pos = _beg;
-        }
-        else if (way == std::ios_base::end) {
-            p_pos = _end;
-        }
-        else if (way == std::ios_base::cur) {
-            p_pos = _cur;
-        }
-
-        if (p_pos > _end) {
-            return traits_type::eof();
-        }
-
-        if (((p_pos + off) > _end) || ((p_pos + off) < _beg)) {
-            return traits_type::eof();
-        }
-
-        _cur = p_pos + off;
-
-        return ((p_pos + off) - _beg);
-    }
-    pos_type seekpos(std::streambuf::pos_type pos,
-                     std::ios_base::openmode which = std::ios::in | std::ios::out) override
-    {
-        (void)which;
-        return seekoff(pos, std::ios_base::beg);
-    }
-
-public:
-    DataStreambuf(const DataStreambuf&) = delete;
-    DataStreambuf(DataStreambuf&&) = delete;
-    DataStreambuf& operator=(const DataStreambuf&) = delete;
-    DataStreambuf& operator=(DataStreambuf&&) = delete;
-
-private:
-    const std::vector<char>& _buffer;
-    int _beg {0}, _end {0}, _cur {0};
-};
-
 // NOLINTBEGIN
 // Taken from https://github.com/PointCloudLibrary/pcl/blob/master/io/src/lzf.cpp
 unsigned int
@@ -543,6 +469,103 @@ lzfDecompress(const void* const in_data, unsigned int in_len, void* out_data, un
 }  // namespace Points
 // NOLINTEND
 
+namespace
+{
+/*!
+ * \brief The MatrixTable class gives the same access to values that have been parsed
+ * from an ASCII file.
+ */
+class MatrixTable
+{
+public:
+    explicit MatrixTable(const Eigen::MatrixXd& data)
+        : data(data)
+    {}
+
+    template<typename T>
+    T get(Eigen::Index row, Eigen::Index col) const
+    {
+        return static_cast<T>(data(row, col));
+    }
+
+private:
+    const Eigen::MatrixXd& data;
+};
+
+BinaryTable::Type plyType(const std::string& t)
+{
+    if (t == "char" || t == "int8") {
+        return BinaryTable::Type::Int8;
+    }
+    if (t == "uchar" || t == "uint8") {
+        return BinaryTable::Type::UInt8;
+    }
+    if (t == "short" || t == "int16") {
+        return BinaryTable::Type::Int16;
+    }
+    if (t == "ushort" || t == "uint16") {
+        return BinaryTable::Type::UInt16;
+    }
+    if (t == "int" || t == "int32") {
+        return BinaryTable::Type::Int32;
+    }
+    if (t == "uint" || t == "uint32") {
+        return BinaryTable::Type::UInt32;
+    }
+    if (t == "float" || t == "float32") {
+        return BinaryTable::Type::Float32;
+    }
+    if (t == "double" || t == "float64") {
+        return BinaryTable::Type::Float64;
+    }
+
+    throw Base::BadFormatError("Unexpected type");
+}
+
+BinaryTable::Type pcdType(const std::string& type, int size)
+{
+    char t = type.empty() ? '\0' : type[0];
+    switch (size) {
+        case 1:
+            if (t == 'I') {
+                return BinaryTable::Type::Int8;
+            }
+            if (t == 'U') {
+                return BinaryTable::Type::UInt8;
+            }
+            break;
+        case 2:
+            if (t == 'I') {
+                return BinaryTable::Type::Int16;
+            }
+            if (t == 'U') {
+                return BinaryTable::Type::UInt16;
+            }
+            break;
+        case 4:
+            if (t == 'I') {
+                return BinaryTable::Type::Int32;
+            }
+            if (t == 'U') {
+                return BinaryTable::Type::UInt32;
+            }
+            if (t == 'F') {
+                return BinaryTable::Type::Float32;
+            }
+            break;
+        case 8:
+            if (t == 'F') {
+                return BinaryTable::Type::Float64;
+            }
+            break;
+        default:
+            break;
+    }
+
+    throw Base::BadFormatError("Unexpected type");
+}
+}  // namespace
+
 PlyReader::PlyReader() = default;
 
 void PlyReader::read(const std::string& filename)
@@ -562,17 +585,6 @@ void PlyReader::read(const std::string& filename)
     this->width = numPoints;
     this->height = 1;
 
-    Eigen::MatrixXd data(numPoints, fields.size());
-    if (format == "ascii") {
-        readAscii(inp, offset, data);
-    }
-    else if (format == "binary_little_endian") {
-        readBinary(false, inp, offset, types, sizes, data);
-    }
-    else if (format == "binary_big_endian") {
-        readBinary(true, inp, offset, types, sizes, data);
-    }
-
     std::vector<std::string>::iterator it;
     Eigen::Index max_size = std::numeric_limits<Eigen::Index>::max();
 
@@ -663,57 +675,81 @@ void PlyReader::read(const std::string& filename)
     bool hasData = (x != max_size && y != max_size && z != max_size);
     bool hasNormal = (normal_x != max_size && normal_y != max_size && normal_z != max_size);
     bool hasIntensity = (greyvalue != max_size);
-    bool hasColor = (red != max_size && green != max_size && blue != max_size);
+    bool hasColor = (red != max_size && green != max_size && blue != max_size)
+        && (types[red] == "uchar" || types[red] == "float");
+    bool hasAlpha = (alpha != max_size);
 
-    if (hasData) {
-        points.reserve(numPoints);
-        for (Eigen::Index i = 0; i < numPoints; i++) {
-            points.push_back(Base::Vector3d(data(i, x), data(i, y), data(i, z)));
+    auto transfer = [&](const auto& table) {
+        if (!hasData) {
+            return;
         }
-    }
 
-    if (hasData && hasNormal) {
-        normals.reserve(numPoints);
-        for (Eigen::Index i = 0; i < numPoints; i++) {
-            normals.emplace_back(data(i, normal_x), data(i, normal_y), data(i, normal_z));
+        points.resize(static_cast<PointKernel::size_type>(numPoints));
+        if (hasNormal) {
+            normals.resize(numPoints);
         }
-    }
-
-    if (hasData && hasIntensity) {
-        intensity.reserve(numPoints);
-        for (Eigen::Index i = 0; i < numPoints; i++) {
-            intensity.push_back(static_cast<float>(data(i, greyvalue)));
+        if (hasIntensity) {
+            intensity.resize(numPoints);
+        }
+        if (hasColor) {
+            colors.resize(numPoints);
         }
-    }
 
-    if (hasData && hasColor) {
-        colors.reserve(numPoints);
-        float a = 1.0;
-        if (types[red] == "uchar") {
-            for (Eigen::Index i = 0; i < numPoints; i++) {
-                float r = static_cast<float>(data(i, red));
-                float g = static_cast<float>(data(i, green));
-                float b = static_cast<float>(data(i, blue));
-                if (alpha != max_size) {
-                    a = static_cast<float>(data(i, alpha));
+        std::vector<Base::Vector3f>& kernel = points.getBasicPoints();
+        bool byteColor = hasColor && types[red] == "uchar";
+        forEachBlock(numPoints, 65536, [&](std::size_t begin, std::size_t end) {
+            for (auto i = Eigen::Index(begin); i < Eigen::Index(end); i++) {
+                kernel[i].Set(table.template get<float>(i, x),
+                              table.template get<float>(i, y),
+                              table.template get<float>(i, z));
+                if (hasNormal) {
+                    normals[i].Set(table.template get<float>(i, normal_x),
+                                   table.template get<float>(i, normal_y),
+                                   table.template get<float>(i, normal_z));
                 }
-                colors.emplace_back(static_cast<float>(r) / 255.0F,
-                                    static_cast<float>(g) / 255.0F,
-                                    static_cast<float>(b) / 255.0F,
-                                    static_cast<float>(a) / 255.0F);
-            }
-        }
-        else if (types[red] == "float") {
-            for (Eigen::Index i = 0; i < numPoints; i++) {
-                float r = static_cast<float>(data(i, red));
-                float g = static_cast<float>(data(i, green));
-                float b = static_cast<float>(data(i, blue));
-                if (alpha != max_size) {
-                    a = static_cast<float>(data(i, alpha));
+                if (hasIntensity) {
+                    intensity[i] = table.template get<float>(i, greyvalue);
+                }
+                if (hasColor) {
+                    float r = table.template get<float>(i, red);
+                    float g = table.template get<float>(i, green);
+                    float b = table.template get<float>(i, blue);
+                    float a = hasAlpha ? table.template get<float>(i, alpha) : 1.0F;
+                    if (byteColor) {
+                        colors[i] = Base::Color(r / 255.0F, g / 255.0F, b / 255.0F, a / 255.0F);
+                    }
+                    else {
+                        colors[i] = Base::Color(r, g, b, a);
+                    }
                 }
-                colors.emplace_back(r, g, b, a);
             }
+        });
+    };
+
+    if (format == "ascii") {
+        Eigen::MatrixXd data(numPoints, fields.size());
+        readAscii(inp, offset, data);
+        transfer(MatrixTable(data));
+    }
+    else {
+        // convert the fields directly from the mapped file
+        std::vector<BinaryTable::Type> columns;
+        for (const auto& t : types) {
+            columns.push_back(plyType(t));
+        }
+
+        BinaryData binary(fi, inp);
+        if (offset > binary.size()) {
+            throw Base::BadFormatError("File expects too many elements");
+        }
+
+        BinaryTable table(binary.data() + offset, format == "binary_big_endian");
+        table.setRecords(columns);
+        if (table.rowSize() * static_cast<std::size_t>(numPoints) > binary.size() - offset) {
+            throw Base::BadFormatError("File expects too many elements");
         }
+
+        transfer(table);
     }
 }
 
@@ -920,103 +956,6 @@ void PlyReader::readAscii(std::istream& inp, std::size_t offset, Eigen::MatrixXd
     }
 }
 
-void PlyReader::readBinary(bool swapByteOrder,
-                           std::istream& inp,
-                           std::size_t offset,
-                           const std::vector<std::string>& types,
-                           const std::vector<int>& sizes,
-                           Eigen::MatrixXd& data)
-{
-    Eigen::Index numPoints = data.rows();
-    Eigen::Index numFields = data.cols();
-
-    int neededSize = 0;
-    ConverterPtr convert_float32(new ConverterT<float>);
-    ConverterPtr convert_float64(new ConverterT<double>);
-    ConverterPtr convert_int8(new ConverterT<int8_t>);
-    ConverterPtr convert_uint8(new ConverterT<uint8_t>);
-    ConverterPtr convert_int16(new ConverterT<int16_t>);
-    ConverterPtr convert_uint16(new ConverterT<uint16_t>);
-    ConverterPtr convert_int32(new ConverterT<int32_t>);
-    ConverterPtr convert_uint32(new ConverterT<uint32_t>);
-
-    std::vector<ConverterPtr> converters;
-    for (Eigen::Index j = 0; j < numFields; j++) {
-        const std::string& t = types[j];
-        switch (sizes[j]) {
-            case 1:
-                if (t == "char" || t == "int8") {
-                    converters.push_back(convert_int8);
-                }
-                else if (t == "uchar" || t == "uint8") {
-                    converters.push_back(convert_uint8);
-                }
-                else {
-                    throw Base::BadFormatError("Unexpected type");
-                }
-                break;
-            case 2:
-                if (t == "short" || t == "int16") {
-                    converters.push_back(convert_int16);
-                }
-                else if (t == "ushort" || t == "uint16") {
-                    converters.push_back(convert_uint16);
-                }
-                else {
-                    throw Base::BadFormatError("Unexpected type");
-                }
-                break;
-            case 4:
-                if (t == "int" || t == "int32") {
-                    converters.push_back(convert_int32);
-                }
-                else if (t == "uint" || t == "uint32") {
-                    converters.push_back(convert_uint32);
-                }
-                else if (t == "float" || t == "float32") {
-                    converters.push_back(convert_float32);
-                }
-                else {
-                    throw Base::BadFormatError("Unexpected type");
-                }
-                break;
-            case 8:
-                if (t == "double" || t == "float64") {
-                    converters.push_back(convert_float64);
-                }
-                else {
-                    throw Base::BadFormatError("Unexpected type");
-                }
-                break;
-            default:
-                throw Base::BadFormatError("Unexpected type");
-        }
-
-        neededSize += converters.back()->getSizeOf();
-    }
-
-    std::streamoff ulSize = 0;
-    std::streamoff ulCurr = 0;
-    std::streambuf* buf = inp.rdbuf();
-    if (buf) {
-        ulCurr = buf->pubseekoff(static_cast<std::streamoff>(offset), std::ios::cur, std::ios::in);
-        ulSize = buf->pubseekoff(0, std::ios::end, std::ios::in);
-        buf->pubseekoff(ulCurr, std::ios::beg, std::ios::in);
-        if (ulCurr + neededSize * static_cast<std::streamoff>(numPoints) > ulSize) {
-            throw Base::BadFormatError("File expects too many elements");
-        }
-    }
-
-    Base::InputStream str(inp);
-    str.setByteOrder(swapByteOrder ? Base::Stream::BigEndian : Base::Stream::LittleEndian);
-    for (Eigen::Index i = 0; i < numPoints; i++) {
-        for (Eigen::Index j = 0; j < numFields; j++) {
-            double value = converters[j]->toDouble(str);
-            data(i, j) = value;
-        }
-    }
-}
-
 // ----------------------------------------------------------------------------
 
 PcdReader::PcdReader() = default;
@@ -1036,33 +975,6 @@ void PcdReader::read(const std::string& filename)
     std::vector<int> sizes;
     Eigen::Index numPoints = Eigen::Index(readHeader(inp, format, fields, types, sizes));
 
-    Eigen::MatrixXd data(numPoints, fields.size());
-    if (format == "ascii") {
-        readAscii(inp, data);
-    }
-    else if (format == "binary") {
-        readBinary(false, inp, types, sizes, data);
-    }
-    else if (format == "binary_compressed") {
-        unsigned int c {};
-        unsigned int u {};
-        Base::InputStream str(inp);
-        str >> c >> u;
-
-        std::vector<char> compressed(c);
-        inp.read(compressed.data(), c);
-        std::vector<char> uncompressed(u);
-        if (lzfDecompress(compressed.data(), c, uncompressed.data(), u) == u) {
-            DataStreambuf ibuf(uncompressed);
-            std::istream istr(nullptr);
-            istr.rdbuf(&ibuf);
-            readBinary(true, istr, types, sizes, data);
-        }
-        else {
-            throw Base::BadFormatError("Failed to decompress binary data");
-        }
-    }
-
     std::vector<std::string>::iterator it;
     Eigen::Index max_size = std::numeric_limits<Eigen::Index>::max();
 
@@ -1138,50 +1050,103 @@ void PcdReader::read(const std::string& filename)
     bool hasData = (x != max_size && y != max_size && z != max_size);
     bool hasNormal = (normal_x != max_size && normal_y != max_size && normal_z != max_size);
     bool hasIntensity = (greyvalue != max_size);
-    bool hasColor = (rgba != max_size);
+    bool hasColor = (rgba != max_size) && (types[rgba] == "U" || types[rgba] == "F");
 
-    if (hasData) {
-        points.reserve(numPoints);
-        for (Eigen::Index i = 0; i < numPoints; i++) {
-            points.push_back(Base::Vector3d(data(i, x), data(i, y), data(i, z)));
+    auto transfer = [&](const auto& table) {
+        if (!hasData) {
+            return;
         }
-    }
 
-    if (hasData && hasNormal) {
-        normals.reserve(numPoints);
-        for (Eigen::Index i = 0; i < numPoints; i++) {
-            normals.emplace_back(data(i, normal_x), data(i, normal_y), data(i, normal_z));
+        points.resize(static_cast<PointKernel::size_type>(numPoints));
+        if (hasNormal) {
+            normals.resize(numPoints);
         }
-    }
-
-    if (hasData && hasIntensity) {
-        intensity.reserve(numPoints);
-        for (Eigen::Index i = 0; i < numPoints; i++) {
-            intensity.push_back(data(i, greyvalue));
+        if (hasIntensity) {
+            intensity.resize(numPoints);
         }
+        if (hasColor) {
+            colors.resize(numPoints);
+        }
+
+        static_assert(sizeof(float) == sizeof(uint32_t), "float and uint32_t have different sizes");
+        std::vector<Base::Vector3f>& kernel = points.getBasicPoints();
+        bool floatColor = hasColor && types[rgba] == "F";
+        forEachBlock(numPoints, 65536, [&](std::size_t begin, std::size_t end) {
+            for (auto i = Eigen::Index(begin); i < Eigen::Index(end); i++) {
+                kernel[i].Set(table.template get<float>(i, x),
+                              table.template get<float>(i, y),
+                              table.template get<float>(i, z));
+                if (hasNormal) {
+                    normals[i].Set(table.template get<float>(i, normal_x),
+                                   table.template get<float>(i, normal_y),
+                                   table.template get<float>(i, normal_z));
+                }
+                if (hasIntensity) {
+                    intensity[i] = table.template get<float>(i, greyvalue);
+                }
+                if (hasColor) {
+                    uint32_t packed {};
+                    if (floatColor) {
+                        float f = table.template get<float>(i, rgba);
+                        std::memcpy(&packed, &f, sizeof(packed));
+                    }
+                    else {
+                        packed = table.template get<uint32_t>(i, rgba);
+                    }
+                    colors[i].setPackedARGB(packed);
+                }
+            }
+        });
+    };
+
+    if (format == "ascii") {
+        Eigen::MatrixXd data(numPoints, fields.size());
+        readAscii(inp, data);
+        transfer(MatrixTable(data));
     }
+    else if (format == "binary" || format == "binary_compressed") {
+        std::vector<BinaryTable::Type> columns;
+        for (std::size_t i = 0; i < types.size(); i++) {
+            columns.push_back(pcdType(types[i], sizes[i]));
+        }
 
-    if (hasData && hasColor) {
-        colors.reserve(numPoints);
-        if (types[rgba] == "U") {
-            for (Eigen::Index i = 0; i < numPoints; i++) {
-                uint32_t packed = static_cast<uint32_t>(data(i, rgba));
-                Base::Color col;
-                col.setPackedARGB(packed);
-                colors.emplace_back(col);
+        BinaryData binary(fi, inp);
+        if (format == "binary") {
+            // convert the fields directly from the mapped file
+            BinaryTable table(binary.data(), false);
+            table.setRecords(columns);
+            if (table.rowSize() * static_cast<std::size_t>(numPoints) > binary.size()) {
+                throw Base::BadFormatError("File expects too many elements");
             }
+
+            transfer(table);
         }
-        else if (types[rgba] == "F") {
-            static_assert(sizeof(float) == sizeof(uint32_t),
-                          "float and uint32_t have different sizes");
-            for (Eigen::Index i = 0; i < numPoints; i++) {
-                float f = static_cast<float>(data(i, rgba));
-                uint32_t packed {};
-                std::memcpy(&packed, &f, sizeof(packed));
-                Base::Color col;
-                col.setPackedARGB(packed);
-                colors.emplace_back(col);
+        else {
+            unsigned int c {};
+            unsigned int u {};
+            if (binary.size() < sizeof(c) + sizeof(u)) {
+                throw Base::BadFormatError("Failed to decompress binary data");
             }
+            std::memcpy(&c, binary.data(), sizeof(c));
+            std::memcpy(&u, binary.data() + sizeof(c), sizeof(u));
+            if (c > binary.size() - sizeof(c) - sizeof(u)) {
+                throw Base::BadFormatError("Failed to decompress binary data");
+            }
+
+            std::vector<char> uncompressed(u);
+            if (lzfDecompress(binary.data() + sizeof(c) + sizeof(u), c, uncompressed.data(), u)
+                != u) {
+                throw Base::BadFormatError("Failed to decompress binary data");
+            }
+
+            // the decompressed data is stored field by field
+            BinaryTable table(uncompressed.data(), false);
+            table.setBlocks(columns, static_cast<std::size_t>(numPoints));
+            if (table.rowSize() * static_cast<std::size_t>(numPoints) > uncompressed.size()) {
+                throw Base::BadFormatError("File expects too many elements");
+            }
+
+            transfer(table);
         }
     }
 }
@@ -1285,123 +1250,53 @@ void PcdReader::readAscii(std::istream& inp, Eigen::MatrixXd& data)
     }
 }
 
-void PcdReader::readBinary(bool transpose,
-                           std::istream& inp,
-                           const std::vector<std::string>& types,
-                           const std::vector<int>& sizes,
-                           Eigen::MatrixXd& data)
-{
-    Eigen::Index numPoints = data.rows();
-    Eigen::Index numFields = data.cols();
-
-    int neededSize = 0;
-    ConverterPtr convert_float32(new ConverterT<float>);
-    ConverterPtr convert_float64(new ConverterT<double>);
-    ConverterPtr convert_int8(new ConverterT<int8_t>);
-    ConverterPtr convert_uint8(new ConverterT<uint8_t>);
-    ConverterPtr convert_int16(new ConverterT<int16_t>);
-    ConverterPtr convert_uint16(new ConverterT<uint16_t>);
-    ConverterPtr convert_int32(new ConverterT<int32_t>);
-    ConverterPtr convert_uint32(new ConverterT<uint32_t>);
-
-    std::vector<ConverterPtr> converters;
-    for (Eigen::Index j = 0; j < numFields; j++) {
-        char t = types[j][0];
-        switch (sizes[j]) {
-            case 1:
-                if (t == 'I') {
-                    converters.push_back(convert_int8);
-                }
-                else if (t == 'U') {
-                    converters.push_back(convert_uint8);
-                }
-                else {
-                    throw Base::BadFormatError("Unexpected type");
-                }
-                break;
-            case 2:
-                if (t == 'I') {
-                    converters.push_back(convert_int16);
-                }
-                else if (t == 'U') {
-                    converters.push_back(convert_uint16);
-                }
-                else {
-                    throw Base::BadFormatError("Unexpected type");
-                }
-                break;
-            case 4:
-                if (t == 'I') {
-                    converters.push_back(convert_int32);
-                }
-                else if (t == 'U') {
-                    converters.push_back(convert_uint32);
-                }
-                else if (t == 'F') {
-                    converters.push_back(convert_float32);
-                }
-                else {
-                    throw Base::BadFormatError("Unexpected type");
-                }
-                break;
-            case 8:
-                if (t == 'F') {
-                    converters.push_back(convert_float64);
-                }
-                else {
-                    throw Base::BadFormatError("Unexpected type");
-                }
-                break;
-            default:
-                throw Base::BadFormatError("Unexpected type");
-        }
+// ----------------------------------------------------------------------------
 
-        neededSize += converters.back()->getSizeOf();
-    }
+namespace
+{
+// the integer coordinates of the cube of a voxel grid that contains a point
+struct VoxelKey
+{
+    int64_t x;
+    int64_t y;
+    int64_t z;
+
+    VoxelKey(const Base::Vector3f& pt, double size)
+        : x {static_cast<int64_t>(std::floor(double(pt.x) / size))}
+        , y {static_cast<int64_t>(std::floor(double(pt.y) / size))}
+        , z {static_cast<int64_t>(std::floor(double(pt.z) / size))}
+    {}
 
-    std::streamoff ulSize = 0;
-    std::streamoff ulCurr = 0;
-    std::streambuf* buf = inp.rdbuf();
-    if (buf) {
-        ulCurr = buf->pubseekoff(0, std::ios::cur, std::ios::in);
-        ulSize = buf->pubseekoff(0, std::ios::end, std::ios::in);
-        buf->pubseekoff(ulCurr, std::ios::beg, std::ios::in);
-        if (ulCurr + neededSize * static_cast<std::streamoff>(numPoints) > ulSize) {
-            throw Base::BadFormatError("File expects too many elements");
-        }
-    }
+    bool operator==(const VoxelKey&) const = default;
+};
 
-    Base::InputStream str(inp);
-    if (transpose) {
-        for (Eigen::Index j = 0; j < numFields; j++) {
-            for (Eigen::Index i = 0; i < numPoints; i++) {
-                double value = converters[j]->toDouble(str);
-                data(i, j) = value;
-            }
-        }
-    }
-    else {
-        for (Eigen::Index i = 0; i < numPoints; i++) {
-            for (Eigen::Index j = 0; j < numFields; j++) {
-                double value = converters[j]->toDouble(str);
-                data(i, j) = value;
-            }
-        }
+struct VoxelKeyHash
+{
+    std::size_t operator()(const VoxelKey& key) const
+    {
+        std::size_t seed = std::hash<int64_t> {}(key.x);
+        seed ^= std::hash<int64_t> {}(key.y) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+        seed ^= std::hash<int64_t> {}(key.z) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+        return seed;
     }
-}
+};
 
-// ----------------------------------------------------------------------------
+using VoxelSet = std::unordered_set<VoxelKey, VoxelKeyHash>;
 
-namespace
-{
 class E57ReaderImp
 {
 public:
-    E57ReaderImp(const std::string& filename, bool color, bool state, double distance)
-        : imfi(filename, "r")
+    E57ReaderImp(const std::string& filename,
+                 bool color,
+                 bool state,
+                 double distance,
+                 double voxel)
+        : filename(filename)
+        , imfi(filename, "r")
         , useColor {color}
         , checkState {state}
         , minDistance {distance}
+        , voxelSize {voxel}
     {}
 
     void read()
@@ -1413,41 +1308,176 @@ public:
         }
     }
 
-    std::vector<Base::Color> getColors() const
+    std::vector<Base::Color>& getColors()
     {
         return colors;
     }
 
-    std::vector<float> getItensity() const
+    std::vector<float>& getItensity()
     {
         return intensity;
     }
 
-    const PointKernel& getPoints() const
+    PointKernel& getPoints()
     {
         return points;
     }
 
-    const std::vector<Base::Vector3f>& getNormals() const
+    std::vector<Base::Vector3f>& getNormals()
     {
         return normals;
     }
 
 private:
+    struct Scan
+    {
+        int64_t child = 0;
+        bool hasPlacement = false;
+        Base::Placement plm;
+        bool hasColor = false;
+        bool hasItensity = false;
+        bool hasNormal = false;
+        std::size_t count = 0;
+        // the points that passed the filters
+        std::vector<Base::Vector3f> points;
+        std::vector<Base::Color> colors;
+        std::vector<float> intensity;
+        std::vector<Base::Vector3f> normals;
+    };
+
+    bool hasVoxelFilter() const
+    {
+        return voxelSize > 0.0;
+    }
+
     void readData3D(const e57::VectorNode& data3D)
     {
-        for (int child = 0; child < data3D.childCount(); ++child) {
+        // Every scan is decoded concurrently into its own buffers that only grow by the points
+        // that pass the filters. Afterwards the buffers are appended to the output arrays.
+        std::vector<Scan> scans;
+        for (int64_t child = 0; child < data3D.childCount(); ++child) {
             e57::StructureNode scan_data(data3D.get(child));
-            Base::Placement plm;
-            bool hasPlacement = getPlacement(scan_data, plm);
-
             e57::CompressedVectorNode cvn(scan_data.get("points"));
             e57::StructureNode prototype(cvn.prototype());
-            Proto proto = readProto(prototype);
-            processProto(cvn, proto, hasPlacement, plm);
+
+            Scan scan;
+            scan.child = child;
+            scan.hasPlacement = getPlacement(scan_data, scan.plm);
+            scan.hasColor = useColor
+                && hasChannels(prototype, {"colorRed", "colorGreen", "colorBlue"});
+            scan.hasItensity = hasChannels(prototype, {"intensity"});
+            scan.hasNormal = hasChannels(prototype, {"nor:normalX", "nor:normalY", "nor:normalZ"});
+            scan.count = static_cast<std::size_t>(cvn.childCount());
+            scans.push_back(std::move(scan));
+        }
+
+        std::mutex mutex;
+        std::exception_ptr error;
+        QtConcurrent::blockingMap(scans, [&](Scan& scan) {
+            try {
+                std::optional<e57::ImageFile> file = acquireFile();
+                readScan(*file, scan);
+                releaseFile(*file);
+            }
+            catch (...) {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (!error) {
+                    error = std::current_exception();
+                }
+            }
+        });
+
+        for (auto& file : files) {
+            file.close();
+        }
+        files.clear();
+        if (error) {
+            std::rethrow_exception(error);
+        }
+
+        appendScans(scans);
+    }
+
+    void appendScans(std::vector<Scan>& scans)
+    {
+        // scans without colors, intensities or normals get default values
+        bool hasColor = std::ranges::any_of(scans, &Scan::hasColor);
+        bool hasItensity = std::ranges::any_of(scans, &Scan::hasItensity);
+        bool hasNormal = std::ranges::any_of(scans, &Scan::hasNormal);
+        std::size_t total = 0;
+        for (const Scan& scan : scans) {
+            total += scan.points.size();
+        }
+
+        std::vector<Base::Vector3f>& kernel = points.getBasicPoints();
+        kernel.reserve(total);
+        colors.reserve(hasColor ? total : 0);
+        intensity.reserve(hasItensity ? total : 0);
+        normals.reserve(hasNormal ? total : 0);
+
+        // the voxel filter of a scan only knows its own points, so overlapping scans are
+        // filtered here once more in the order of the scans
+        VoxelSet voxels;
+        for (Scan& scan : scans) {
+            for (std::size_t i = 0; i < scan.points.size(); ++i) {
+                if (hasVoxelFilter() && !voxels.emplace(scan.points[i], voxelSize).second) {
+                    continue;
+                }
+                kernel.push_back(scan.points[i]);
+                if (hasColor) {
+                    colors.push_back(scan.hasColor ? scan.colors[i] : Base::Color());
+                }
+                if (hasItensity) {
+                    intensity.push_back(scan.hasItensity ? scan.intensity[i] : 0.0F);
+                }
+                if (hasNormal) {
+                    normals.push_back(scan.hasNormal ? scan.normals[i] : Base::Vector3f());
+                }
+            }
+
+            // give the memory of the scan back before appending the next one
+            scan = Scan();
         }
     }
 
+    static bool hasChannels(const e57::StructureNode& prototype,
+                            std::initializer_list<const char*> names)
+    {
+        return std::ranges::all_of(names, [&prototype](const char* name) {
+            return prototype.isDefined(name);
+        });
+    }
+
+    // Each thread decodes through its own handle to the file. Opening a file parses its XML
+    // section with Xerces whose initialization isn't thread-safe, so this is serialized.
+    std::optional<e57::ImageFile> acquireFile()
+    {
+        std::lock_guard<std::mutex> lock(filesMutex);
+        if (!files.empty()) {
+            std::optional<e57::ImageFile> file(files.back());
+            files.pop_back();
+            return file;
+        }
+        return std::optional<e57::ImageFile>(std::in_place, filename, "r");
+    }
+
+    void releaseFile(const e57::ImageFile& file)
+    {
+        std::lock_guard<std::mutex> lock(filesMutex);
+        files.push_back(file);
+    }
+
+    void readScan(e57::ImageFile& file, Scan& scan)
+    {
+        e57::StructureNode root = file.root();
+        e57::VectorNode data3D(root.get("data3D"));
+        e57::StructureNode scan_data(data3D.get(scan.child));
+        e57::CompressedVectorNode cvn(scan_data.get("points"));
+        e57::StructureNode prototype(cvn.prototype());
+        Proto proto = readProto(file, prototype);
+        processProto(cvn, proto, scan);
+    }
+
     struct Proto
     {
         bool inty = false;
@@ -1475,7 +1505,7 @@ private:
         std::vector<e57::SourceDestBuffer> sdb;
     };
 
-    Proto readProto(const e57::StructureNode& prototype)
+    Proto readProto(e57::ImageFile& file, const e57::StructureNode& prototype)
     {
         Proto proto;
         resizeArrays(proto);
@@ -1483,18 +1513,18 @@ private:
         for (int i = 0; i < prototype.childCount(); ++i) {
             e57::Node node(prototype.get(i));
             if ((node.type() == e57::E57_FLOAT) || (node.type() == e57::E57_SCALED_INTEGER)) {
-                if (readCartesian(node, proto)) {}
-                else if (readNormal(node, proto)) {}
-                else if (readItensity(node, proto)) {}
+                if (readCartesian(file, node, proto)) {}
+                else if (readNormal(file, node, proto)) {}
+                else if (readItensity(file, node, proto)) {}
                 else {
-                    readOther(node, proto);
+                    readOther(file, node, proto);
                 }
             }
             else if (node.type() == e57::E57_INTEGER) {
-                if (readColor(node, proto)) {}
-                else if (readCartesianInvalidState(node, proto)) {}
+                if (readColor(file, node, proto)) {}
+                else if (readCartesianInvalidState(file, node, proto)) {}
                 else {
-                    readOther(node, proto);
+                    readOther(file, node, proto);
                 }
             }
         }
@@ -1502,12 +1532,12 @@ private:
         return proto;
     }
 
-    bool readCartesian(const e57::Node& node, Proto& proto)
+    bool readCartesian(e57::ImageFile& file, const e57::Node& node, Proto& proto)
     {
         if (node.elementName() == "cartesianX") {
             proto.cnt_xyz++;
             proto.sdb
-                .emplace_back(imfi, node.elementName(), proto.xData.data(), buf_size, true, true
+                .emplace_back(file, node.elementName(), proto.xData.data(), buf_size, true, true
 
                 );
             return true;
@@ -1515,7 +1545,7 @@ private:
         else if (node.elementName() == "cartesianY") {
             proto.cnt_xyz++;
             proto.sdb
-                .emplace_back(imfi, node.elementName(), proto.yData.data(), buf_size, true, true
+                .emplace_back(file, node.elementName(), proto.yData.data(), buf_size, true, true
 
                 );
             return true;
@@ -1523,7 +1553,7 @@ private:
         else if (node.elementName() == "cartesianZ") {
             proto.cnt_xyz++;
             proto.sdb
-                .emplace_back(imfi, node.elementName(), proto.zData.data(), buf_size, true, true
+                .emplace_back(file, node.elementName(), proto.zData.data(), buf_size, true, true
 
                 );
             return true;
@@ -1532,12 +1562,12 @@ private:
         return false;
     }
 
-    bool readNormal(const e57::Node& node, Proto& proto)
+    bool readNormal(e57::ImageFile& file, const e57::Node& node, Proto& proto)
     {
         if (node.elementName() == "nor:normalX") {
             proto.cnt_nor++;
             proto.sdb
-                .emplace_back(imfi, node.elementName(), proto.xNormal.data(), buf_size, true, true
+                .emplace_back(file, node.elementName(), proto.xNormal.data(), buf_size, true, true
 
                 );
             return true;
@@ -1545,7 +1575,7 @@ private:
         else if (node.elementName() == "nor:normalY") {
             proto.cnt_nor++;
             proto.sdb
-                .emplace_back(imfi, node.elementName(), proto.yNormal.data(), buf_size, true, true
+                .emplace_back(file, node.elementName(), proto.yNormal.data(), buf_size, true, true
 
                 );
             return true;
@@ -1553,7 +1583,7 @@ private:
         else if (node.elementName() == "nor:normalZ") {
             proto.cnt_nor++;
             proto.sdb
-                .emplace_back(imfi, node.elementName(), proto.zNormal.data(), buf_size, true, true
+                .emplace_back(file, node.elementName(), proto.zNormal.data(), buf_size, true, true
 
                 );
             return true;
@@ -1562,12 +1592,12 @@ private:
         return false;
     }
 
-    bool readCartesianInvalidState(const e57::Node& node, Proto& proto)
+    bool readCartesianInvalidState(e57::ImageFile& file, const e57::Node& node, Proto& proto)
     {
         if (node.elementName() == "cartesianInvalidState") {
             proto.inv_state = true;
             proto.sdb
-                .emplace_back(imfi, node.elementName(), proto.state.data(), buf_size, true, true
+                .emplace_back(file, node.elementName(), proto.state.data(), buf_size, true, true
 
                 );
             return true;
@@ -1576,12 +1606,12 @@ private:
         return false;
     }
 
-    bool readColor(const e57::Node& node, Proto& proto)
+    bool readColor(e57::ImageFile& file, const e57::Node& node, Proto& proto)
     {
         if (node.elementName() == "colorRed") {
             proto.cnt_rgb++;
             proto.sdb
-                .emplace_back(imfi, node.elementName(), proto.redData.data(), buf_size, true, true
+                .emplace_back(file, node.elementName(), proto.redData.data(), buf_size, true, true
 
                 );
             return true;
@@ -1589,7 +1619,7 @@ private:
         if (node.elementName() == "colorGreen") {
             proto.cnt_rgb++;
             proto.sdb
-                .emplace_back(imfi, node.elementName(), proto.greenData.data(), buf_size, true, true
+                .emplace_back(file, node.elementName(), proto.greenData.data(), buf_size, true, true
 
                 );
             return true;
@@ -1597,7 +1627,7 @@ private:
         if (node.elementName() == "colorBlue") {
             proto.cnt_rgb++;
             proto.sdb
-                .emplace_back(imfi, node.elementName(), proto.blueData.data(), buf_size, true, true
+                .emplace_back(file, node.elementName(), proto.blueData.data(), buf_size, true, true
 
                 );
             return true;
@@ -1606,12 +1636,12 @@ private:
         return false;
     }
 
-    bool readItensity(const e57::Node& node, Proto& proto)
+    bool readItensity(e57::ImageFile& file, const e57::Node& node, Proto& proto)
     {
         if (node.elementName() == "intensity") {
             proto.inty = true;
             proto.sdb
-                .emplace_back(imfi, node.elementName(), proto.intensity.data(), buf_size, true, true
+                .emplace_back(file, node.elementName(), proto.intensity.data(), buf_size, true, true
 
                 );
             return true;
@@ -1620,23 +1650,19 @@ private:
         return false;
     }
 
-    void readOther(const e57::Node& node, Proto& proto)
+    void readOther(e57::ImageFile& file, const e57::Node& node, Proto& proto)
     {
-        proto.sdb.emplace_back(imfi, node.elementName(), proto.nil.data(), buf_size, true, true
+        proto.sdb.emplace_back(file, node.elementName(), proto.nil.data(), buf_size, true, true
 
         );
     }
 
-    void processProto(e57::CompressedVectorNode& cvn,
-                      const Proto& proto,
-                      bool hasPlacement,
-                      const Base::Placement& plm)
+    void processProto(e57::CompressedVectorNode& cvn, const Proto& proto, Scan& scan)
     {
         if (proto.cnt_xyz != 3) {
             throw Base::BadFormatError("Missing channels xyz");
         }
         unsigned count;
-        unsigned cnt_pts = 0;
         Base::Vector3d pt, last;
         e57::CompressedVectorReader cvr(cvn.reader(proto.sdb));
         bool hasColor = (proto.cnt_rgb == 3) && useColor;
@@ -1644,6 +1670,15 @@ private:
         bool hasNormal = (proto.cnt_nor == 3);
         bool hasState = proto.inv_state && checkState;
         bool filter = false;
+        VoxelSet voxels;
+
+        // without filters the final size is known, otherwise the buffers grow by the kept points
+        if (!hasState && minDistance <= 0.0 && !hasVoxelFilter()) {
+            scan.points.reserve(scan.count);
+            scan.colors.reserve(hasColor ? scan.count : 0);
+            scan.intensity.reserve(hasItensity ? scan.count : 0);
+            scan.normals.reserve(hasNormal ? scan.count : 0);
+        }
 
         while ((count = cvr.read())) {
             for (size_t i = 0; i < count; ++i) {
@@ -1654,29 +1689,36 @@ private:
                     }
                 }
 
-                pt = getCoord(proto, i, hasPlacement, plm);
+                pt = getCoord(proto, i, scan.hasPlacement, scan.plm);
 
-                if ((!filter) && (cnt_pts > 0)) {
+                if ((!filter) && (!scan.points.empty())) {
                     if (Base::Distance(last, pt) < minDistance) {
                         filter = true;
                     }
                 }
+                // keep only the first point of each voxel
+                if ((!filter) && hasVoxelFilter()) {
+                    if (!voxels.emplace(Base::toVector<float>(pt), voxelSize).second) {
+                        filter = true;
+                    }
+                }
                 if (!filter) {
-                    cnt_pts++;
-                    points.push_back(pt);
+                    scan.points.push_back(Base::toVector<float>(pt));
                     last = pt;
                     if (hasColor) {
-                        colors.push_back(getColor(proto, i));
+                        scan.colors.push_back(getColor(proto, i));
                     }
                     if (hasItensity) {
-                        intensity.push_back(proto.intensity[i]);
+                        scan.intensity.push_back(static_cast<float>(proto.intensity[i]));
                     }
                     if (hasNormal) {
-                        normals.push_back(getNormal(proto, i, hasPlacement, plm.getRotation()));
+                        scan.normals.push_back(
+                            getNormal(proto, i, scan.hasPlacement, scan.plm.getRotation()));
                     }
                 }
             }
         }
+        cvr.close();
     }
 
     Base::Vector3d
@@ -1764,11 +1806,15 @@ private:
     }
 
 private:
+    std::string filename;
     e57::ImageFile imfi;
+    std::mutex filesMutex;
+    std::vector<e57::ImageFile> files;
     bool useColor;
     bool checkState;
     double minDistance;
-    const size_t buf_size = 1024;
+    double voxelSize;
+    const size_t buf_size = 65536;
     std::vector<Base::Color> colors;
     std::vector<float> intensity;
     PointKernel points;
@@ -1776,21 +1822,22 @@ private:
 };
 }  // namespace
 
-E57Reader::E57Reader(bool Color, bool State, double Distance)
+E57Reader::E57Reader(bool Color, bool State, double Distance, double VoxelSize)
     : useColor {Color}
     , checkState {State}
     , minDistance {Distance}
+    , voxelSize {VoxelSize}
 {}
 
 void E57Reader::read(const std::string& filename)
 {
     try {
-        E57ReaderImp reader(filename, useColor, checkState, minDistance);
+        E57ReaderImp reader(filename, useColor, checkState, minDistance, voxelSize);
         reader.read();
-        points = reader.getPoints();
-        normals = reader.getNormals();
-        colors = reader.getColors();
-        intensity = reader.getItensity();
+        points = std::move(reader.getPoints());
+        normals = std::move(reader.getNormals());
+        colors = std::move(reader.getColors());
+        intensity = std::move(reader.getItensity());
         width = points.size();
         height = 1;
     }
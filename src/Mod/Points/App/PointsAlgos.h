@@ -102,12 +102,6 @@ private:
                            std::vector<std::string>& types,
                            std::vector<int>& sizes);
     void readAscii(std::istream&, std::size_t offset, Eigen::MatrixXd& data);
-    void readBinary(bool swapByteOrder,
-                    std::istream&,
-                    std::size_t offset,
-                    const std::vector<std::string>& types,
-                    const std::vector<int>& sizes,
-                    Eigen::MatrixXd& data);
 };
 
 class PointsExport PcdReader: public Reader
@@ -123,22 +117,21 @@ private:
                            std::vector<std::string>& types,
                            std::vector<int>& sizes);
     void readAscii(std::istream&, Eigen::MatrixXd& data);
-    void readBinary(bool transpose,
-                    std::istream&,
-                    const std::vector<std::string>& types,
-                    const std::vector<int>& sizes,
-                    Eigen::MatrixXd& data);
 };
 
 class PointsExport E57Reader: public Reader
 {
 public:
-    E57Reader(bool Color, bool State, double Distance);
+    /** Points closer than \a Distance to the previously kept point of a scan are skipped. With a
+     * positive \a VoxelSize only the first point inside each cube of this edge length is kept.
+     */
+    E57Reader(bool Color, bool State, double Distance, double VoxelSize = 0.0);
     void read(const std::string& filename) override;
 
 protected:
     bool useColor, checkState;
     double minDistance;
+    double voxelSize;
 };
 
 class PointsExport Writer
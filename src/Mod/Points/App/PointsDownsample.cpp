@@ -0,0 +1,448 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2025 FreeCAD Project Association                         *
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+#include "PreCompiled.h"
+
+#ifndef _PreComp_
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <unordered_map>
+#include <utility>
+#endif
+
+#include <Eigen/Eigenvalues>
+
+#include <Base/BoundBox.h>
+#include <Base/Exception.h>
+
+#include "PointsDownsample.h"
+#include "Tools.h"
+
+
+using namespace Points;
+
+namespace
+{
+// number of bits per axis of a cell key
+constexpr uint64_t cellBits = 21;
+constexpr uint64_t cellMask = (uint64_t(1) << cellBits) - 1;
+
+uint64_t makeKey(uint64_t x, uint64_t y, uint64_t z)
+{
+    return x << (2 * cellBits) | y << cellBits | z;
+}
+
+std::array<uint64_t, 3> splitKey(uint64_t key)
+{
+    return {(key >> (2 * cellBits)) & cellMask, (key >> cellBits) & cellMask, key & cellMask};
+}
+
+std::vector<PointKernel::size_type> validIndices(const PointKernel& kernel)
+{
+    const std::vector<PointKernel::value_type>& pts = kernel.getBasicPoints();
+    std::vector<PointKernel::size_type> indices;
+    indices.reserve(pts.size());
+    for (PointKernel::size_type index = 0; index < pts.size(); index++) {
+        if (isValid(pts[index])) {
+            indices.push_back(index);
+        }
+    }
+    return indices;
+}
+}  // namespace
+
+PointDownsample::PointDownsample(const PointKernel& kernel)
+    : kernel(kernel)
+{}
+
+void PointDownsample::setIntensities(const std::vector<float>& values)
+{
+    sourceIntensities = values.size() == kernel.size() ? &values : nullptr;
+}
+
+void PointDownsample::setColors(const std::vector<Base::Color>& values)
+{
+    sourceColors = values.size() == kernel.size() ? &values : nullptr;
+}
+
+void PointDownsample::setNormals(const std::vector<Base::Vector3f>& values)
+{
+    sourceNormals = values.size() == kernel.size() ? &values : nullptr;
+}
+
+void PointDownsample::clearResult()
+{
+    points = PointKernel();
+    points.setTransform(kernel.getTransform());
+    intensities.clear();
+    colors.clear();
+    normals.clear();
+    indices.clear();
+}
+
+std::vector<PointDownsample::Cell>
+PointDownsample::sortIntoCells(double size, std::vector<size_type>& order) const
+{
+    const std::vector<PointKernel::value_type>& pts = kernel.getBasicPoints();
+    Base::BoundBox3d box;
+    for (size_type index : order) {
+        box.Add(Base::Vector3d(pts[index].x, pts[index].y, pts[index].z));
+    }
+
+    std::vector<Cell> cells;
+    if (order.empty()) {
+        return cells;
+    }
+
+    // one spare cell per axis so that the neighbours of each cell have a valid key
+    double scale = 1.0 / size;
+    double extent = std::max({box.LengthX(), box.LengthY(), box.LengthZ()});
+    if (extent * scale >= double(cellMask)) {
+        throw Base::ValueError("The cell size is too small for the extent of the points");
+    }
+
+    // sorting by the position in 'order' as second criterion keeps the order inside a cell
+    std::vector<std::pair<uint64_t, size_type>> keys(order.size());
+    forEachBlock(order.size(), 65536, [&](size_type begin, size_type end) {
+        for (size_type i = begin; i < end; i++) {
+            const auto& pnt = pts[order[i]];
+            auto x = uint64_t((double(pnt.x) - box.MinX) * scale);
+            auto y = uint64_t((double(pnt.y) - box.MinY) * scale);
+            auto z = uint64_t((double(pnt.z) - box.MinZ) * scale);
+            keys[i] = std::make_pair(makeKey(x, y, z), i);
+        }
+    });
+    std::sort(keys.begin(), keys.end());
+
+    std::vector<size_type> sorted(order.size());
+    for (size_type i = 0; i < keys.size(); i++) {
+        sorted[i] = order[keys[i].second];
+        if (i == 0 || keys[i].first != keys[i - 1].first) {
+            cells.push_back({keys[i].first, i, i});
+        }
+        cells.back().end = i + 1;
+    }
+
+    order.swap(sorted);
+    return cells;
+}
+
+void PointDownsample::keepSubset(std::vector<size_type>&& subset)
+{
+    indices = std::move(subset);
+
+    size_type count = indices.size();
+    const std::vector<PointKernel::value_type>& pts = kernel.getBasicPoints();
+    std::vector<PointKernel::value_type>& result = points.getBasicPoints();
+    result.resize(count);
+    if (sourceIntensities) {
+        intensities.resize(count);
+    }
+    if (sourceColors) {
+        colors.resize(count);
+    }
+    if (sourceNormals) {
+        normals.resize(count);
+    }
+
+    forEachBlock(count, 65536, [&](size_type begin, size_type end) {
+        for (size_type i = begin; i < end; i++) {
+            size_type index = indices[i];
+            result[i] = pts[index];
+            if (sourceIntensities) {
+                intensities[i] = (*sourceIntensities)[index];
+            }
+            if (sourceColors) {
+                colors[i] = (*sourceColors)[index];
+            }
+            if (sourceNormals) {
+                normals[i] = (*sourceNormals)[index];
+            }
+        }
+    });
+}
+
+void PointDownsample::voxelGrid(double size)
+{
+    if (size <= 0.0) {
+        throw Base::ValueError("The voxel size must be positive");
+    }
+
+    clearResult();
+    std::vector<size_type> order = validIndices(kernel);
+    std::vector<Cell> cells = sortIntoCells(size, order);
+
+    size_type count = cells.size();
+    const std::vector<PointKernel::value_type>& pts = kernel.getBasicPoints();
+    std::vector<PointKernel::value_type>& result = points.getBasicPoints();
+    result.resize(count);
+    if (sourceIntensities) {
+        intensities.resize(count);
+    }
+    if (sourceColors) {
+        colors.resize(count);
+    }
+    if (sourceNormals) {
+        normals.resize(count);
+    }
+
+    forEachBlock(count, 1024, [&](size_type begin, size_type end) {
+        for (size_type c = begin; c < end; c++) {
+            const Cell& cell = cells[c];
+            auto num = double(cell.end - cell.begin);
+
+            Base::Vector3d center;
+            double grey = 0.0;
+            double red = 0.0;
+            double green = 0.0;
+            double blue = 0.0;
+            double alpha = 0.0;
+            Base::Vector3d normal;
+            for (size_type i = cell.begin; i < cell.end; i++) {
+                size_type index = order[i];
+                center += Base::Vector3d(pts[index].x, pts[index].y, pts[index].z);
+                if (sourceIntensities) {
+                    grey += (*sourceIntensities)[index];
+                }
+                if (sourceColors) {
+                    const Base::Color& col = (*sourceColors)[index];
+                    red += col.r;
+                    green += col.g;
+                    blue += col.b;
+                    alpha += col.a;
+                }
+                if (sourceNormals) {
+                    const Base::Vector3f& nor = (*sourceNormals)[index];
+                    normal += Base::Vector3d(nor.x, nor.y, nor.z);
+                }
+            }
+
+            center /= num;
+            result[c].Set(float(center.x), float(center.y), float(center.z));
+            if (sourceIntensities) {
+                intensities[c] = float(grey / num);
+            }
+            if (sourceColors) {
+                colors[c] = Base::Color(float(red / num),
+                                        float(green / num),
+                                        float(blue / num),
+                                        float(alpha / num));
+            }
+            if (sourceNormals) {
+                // opposite normals cancel out, in this case the normal stays zero
+                if (normal.Length() > 0.0) {
+                    normal.Normalize();
+                }
+                normals[c].Set(float(normal.x), float(normal.y), float(normal.z));
+            }
+        }
+    });
+}
+
+void PointDownsample::random(size_type count, unsigned int seed)
+{
+    if (count == 0) {
+        throw Base::ValueError("The count must be positive");
+    }
+
+    clearResult();
+    std::vector<size_type> order = validIndices(kernel);
+    if (count < order.size()) {
+        // partial Fisher-Yates shuffle
+        std::mt19937 generator(seed);
+        for (size_type i = 0; i < count; i++) {
+            std::uniform_int_distribution<size_type> distribution(i, order.size() - 1);
+            std::swap(order[i], order[distribution(generator)]);
+        }
+        order.resize(count);
+        std::sort(order.begin(), order.end());
+    }
+
+    keepSubset(std::move(order));
+}
+
+void PointDownsample::poissonDisk(double radius, unsigned int seed)
+{
+    if (radius <= 0.0) {
+        throw Base::ValueError("The radius must be positive");
+    }
+
+    clearResult();
+    std::vector<size_type> order = validIndices(kernel);
+    std::shuffle(order.begin(), order.end(), std::mt19937(seed));
+
+    // with the radius as cell size only points of adjacent cells can be too close
+    std::vector<Cell> cells = sortIntoCells(radius, order);
+    std::unordered_map<uint64_t, size_type> lookup;
+    lookup.reserve(cells.size());
+    for (size_type c = 0; c < cells.size(); c++) {
+        lookup[cells[c].key] = c;
+    }
+
+    // cells whose coordinates are equal modulo three have no common neighbour, so all cells of
+    // one phase can be processed concurrently and the result doesn't depend on the scheduling
+    std::array<std::vector<size_type>, 27> phases;
+    for (size_type c = 0; c < cells.size(); c++) {
+        auto [x, y, z] = splitKey(cells[c].key);
+        phases[(x % 3) * 9 + (y % 3) * 3 + z % 3].push_back(c);
+    }
+
+    const std::vector<PointKernel::value_type>& pts = kernel.getBasicPoints();
+    auto sqrRadius = float(radius * radius);
+    std::vector<std::vector<size_type>> accepted(cells.size());
+    for (const auto& phase : phases) {
+        forEachBlock(phase.size(), 64, [&](size_type begin, size_type end) {
+            std::vector<const std::vector<size_type>*> neighbours;
+            for (size_type p = begin; p < end; p++) {
+                size_type c = phase[p];
+                auto [x, y, z] = splitKey(cells[c].key);
+
+                neighbours.clear();
+                for (uint64_t i = std::max<uint64_t>(x, 1) - 1; i <= x + 1; i++) {
+                    for (uint64_t j = std::max<uint64_t>(y, 1) - 1; j <= y + 1; j++) {
+                        for (uint64_t k = std::max<uint64_t>(z, 1) - 1; k <= z + 1; k++) {
+                            auto it = lookup.find(makeKey(i, j, k));
+                            if (it != lookup.end() && it->second != c
+                                && !accepted[it->second].empty()) {
+                                neighbours.push_back(&accepted[it->second]);
+                            }
+                        }
+                    }
+                }
+
+                std::vector<size_type>& kept = accepted[c];
+                auto isFree = [&](const Base::Vector3f& pnt, const std::vector<size_type>& list) {
+                    return std::ranges::all_of(list, [&](size_type index) {
+                        return Base::DistanceP2(pnt, pts[index]) >= sqrRadius;
+                    });
+                };
+                for (size_type i = cells[c].begin; i < cells[c].end; i++) {
+                    const auto& pnt = pts[order[i]];
+                    if (isFree(pnt, kept)
+                        && std::ranges::all_of(neighbours, [&](const auto* list) {
+                               return isFree(pnt, *list);
+                           })) {
+                        kept.push_back(order[i]);
+                    }
+                }
+            }
+        });
+    }
+
+    std::vector<size_type> subset;
+    for (const auto& kept : accepted) {
+        subset.insert(subset.end(), kept.begin(), kept.end());
+    }
+    std::sort(subset.begin(), subset.end());
+
+    keepSubset(std::move(subset));
+}
+
+void PointDownsample::curvature(double size, size_type maxPoints)
+{
+    if (size <= 0.0) {
+        throw Base::ValueError("The voxel size must be positive");
+    }
+    maxPoints = std::max<size_type>(maxPoints, 1);
+
+    clearResult();
+    std::vector<size_type> order = validIndices(kernel);
+    std::vector<Cell> cells = sortIntoCells(size, order);
+
+    // the surface variation, i.e. the smallest eigenvalue of the covariance matrix relative to
+    // the sum of all eigenvalues, is zero for planar points and at most 1/3 for isotropic ones
+    const std::vector<PointKernel::value_type>& pts = kernel.getBasicPoints();
+    std::vector<size_type> counts(cells.size());
+    std::vector<size_type> centers(cells.size());
+    forEachBlock(cells.size(), 1024, [&](size_type begin, size_type end) {
+        for (size_type c = begin; c < end; c++) {
+            const Cell& cell = cells[c];
+            size_type num = cell.end - cell.begin;
+
+            Eigen::Vector3d mean = Eigen::Vector3d::Zero();
+            for (size_type i = cell.begin; i < cell.end; i++) {
+                const auto& pnt = pts[order[i]];
+                mean += Eigen::Vector3d(pnt.x, pnt.y, pnt.z);
+            }
+            mean /= double(num);
+
+            Eigen::Matrix3d covariance = Eigen::Matrix3d::Zero();
+            size_type center = cell.begin;
+            double minDistance = std::numeric_limits<double>::max();
+            for (size_type i = cell.begin; i < cell.end; i++) {
+                const auto& pnt = pts[order[i]];
+                Eigen::Vector3d diff = Eigen::Vector3d(pnt.x, pnt.y, pnt.z) - mean;
+                covariance += diff * diff.transpose();
+                if (diff.squaredNorm() < minDistance) {
+                    minDistance = diff.squaredNorm();
+                    center = i;
+                }
+            }
+
+            double variation = 0.0;
+            if (num > 3) {
+                Eigen::SelfAdjointEigenSolver<Eigen::Matrix3d> solver(covariance,
+                                                                      Eigen::EigenvaluesOnly);
+                const Eigen::Vector3d& values = solver.eigenvalues();
+                double sum = values.sum();
+                if (sum > 0.0) {
+                    variation = std::max(values(0), 0.0) / sum;
+                }
+            }
+
+            double weight = std::min(3.0 * variation, 1.0);
+            auto count = size_type(std::lround(double(maxPoints - 1) * weight)) + 1;
+            counts[c] = std::min(count, num);
+            centers[c] = center;
+        }
+    });
+
+    std::vector<size_type> offsets(cells.size() + 1, 0);
+    std::partial_sum(counts.begin(), counts.end(), offsets.begin() + 1);
+
+    // a flat cell is represented by the point closest to its centroid, otherwise the points are
+    // taken at regular steps
+    std::vector<size_type> subset(offsets.back());
+    forEachBlock(cells.size(), 1024, [&](size_type begin, size_type end) {
+        for (size_type c = begin; c < end; c++) {
+            const Cell& cell = cells[c];
+            size_type num = cell.end - cell.begin;
+            size_type count = counts[c];
+            if (count == 1) {
+                subset[offsets[c]] = order[centers[c]];
+            }
+            else {
+                for (size_type j = 0; j < count; j++) {
+                    subset[offsets[c] + j] = order[cell.begin + j * num / count];
+                }
+            }
+        }
+    });
+    std::sort(subset.begin(), subset.end());
+
+    keepSubset(std::move(subset));
+}
@@ -0,0 +1,138 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2025 FreeCAD Project Association                         *
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+#ifndef POINTS_DOWNSAMPLE_H
+#define POINTS_DOWNSAMPLE_H
+
+#include <cstdint>
+#include <vector>
+
+#include <Base/Color.h>
+#include <Base/Vector3D.h>
+
+#include "Points.h"
+
+
+namespace Points
+{
+
+/**
+ * The PointDownsample class reduces a point cloud to a working density.
+ *
+ * Intensities, colors and normals that belong to the points are carried along: the methods that
+ * keep a subset of the points copy the values of the kept points, the voxel grid averages them
+ * over the points of a voxel. Points with invalid (NaN) coordinates are dropped.
+ *
+ * All coordinates are in the local system of the point kernel and the result keeps the
+ * transformation of the kernel.
+ */
+class PointsExport PointDownsample
+{
+public:
+    using size_type = PointKernel::size_type;
+
+    explicit PointDownsample(const PointKernel& kernel);
+
+    /** @name Attributes
+     * The values are carried along if their number matches the number of points, otherwise
+     * they are ignored. The vectors must outlive the object.
+     */
+    //@{
+    void setIntensities(const std::vector<float>& values);
+    void setColors(const std::vector<Base::Color>& values);
+    void setNormals(const std::vector<Base::Vector3f>& values);
+    //@}
+
+    /** @name Methods */
+    //@{
+    /** Replaces the points inside each occupied cube of edge length \a size by their centroid. */
+    void voxelGrid(double size);
+    /** Keeps \a count randomly chosen points, \a count must be positive. The same \a seed always
+     * gives the same result.
+     */
+    void random(size_type count, unsigned int seed = 0);
+    /** Keeps a subset of the points where no two points are closer than \a radius. The points
+     * are visited in an order determined by \a seed.
+     */
+    void poissonDisk(double radius, unsigned int seed = 0);
+    /** Keeps between one and \a maxPoints points inside each occupied cube of edge length
+     * \a size. The more the points of a cube deviate from a plane the more of them are kept, so
+     * that edges and strongly curved regions retain their detail while flat regions are thinned
+     * out.
+     */
+    void curvature(double size, size_type maxPoints);
+    //@}
+
+    /** @name Result */
+    //@{
+    const PointKernel& getPoints() const
+    {
+        return points;
+    }
+    const std::vector<float>& getIntensities() const
+    {
+        return intensities;
+    }
+    const std::vector<Base::Color>& getColors() const
+    {
+        return colors;
+    }
+    const std::vector<Base::Vector3f>& getNormals() const
+    {
+        return normals;
+    }
+    /// the indices of the kept points, empty for the voxel grid as it creates new points
+    const std::vector<size_type>& getIndices() const
+    {
+        return indices;
+    }
+    //@}
+
+private:
+    struct Cell
+    {
+        uint64_t key;
+        size_type begin;
+        size_type end;
+    };
+    std::vector<Cell> sortIntoCells(double size, std::vector<size_type>& order) const;
+    void keepSubset(std::vector<size_type>&& subset);
+    void clearResult();
+
+private:
+    const PointKernel& kernel;
+    const std::vector<float>* sourceIntensities {nullptr};
+    const std::vector<Base::Color>* sourceColors {nullptr};
+    const std::vector<Base::Vector3f>* sourceNormals {nullptr};
+
+    PointKernel points;
+    std::vector<float> intensities;
+    std::vector<Base::Color> colors;
+    std::vector<Base::Vector3f> normals;
+    std::vector<size_type> indices;
+};
+
+}  // namespace Points
+
+
+#endif  // POINTS_DOWNSAMPLE_H
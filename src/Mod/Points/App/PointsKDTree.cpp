@@ -0,0 +1,193 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2025 FreeCAD Project Association                         *
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+#include "PreCompiled.h"
+
+#ifndef _PreComp_
+#include <QtConcurrentMap>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#endif
+
+#include <Base/BoundBox.h>
+
+#include "PointsKDTree.h"
+#include "Tools.h"
+
+
+using namespace Points;
+
+namespace
+{
+// the depth is limited so that the traversal stack of a query has a fixed size
+constexpr int maxDepth = 60;
+
+float coordinate(const Base::Vector3f& pnt, uint8_t axis)
+{
+    return axis == 0 ? pnt.x : (axis == 1 ? pnt.y : pnt.z);
+}
+}  // namespace
+
+PointKDTree::PointKDTree(const PointKernel& kernel, size_type maxPointsPerLeaf)
+    : PointKDTree(kernel.getBasicPoints(), maxPointsPerLeaf)
+{}
+
+PointKDTree::PointKDTree(const std::vector<PointKernel::value_type>& points,
+                         size_type maxPointsPerLeaf)
+    : _points(points)
+    , _maxPointsPerLeaf(std::max<size_type>(maxPointsPerLeaf, 1))
+{
+    build();
+}
+
+void PointKDTree::build()
+{
+    _indices.reserve(_points.size());
+    for (size_type index = 0; index < _points.size(); index++) {
+        if (isValid(_points[index])) {
+            _indices.push_back(index);
+        }
+    }
+
+    // all leaves are on the same level and the node p of level l covers the index range
+    // [p * n / 2^l, (p + 1) * n / 2^l)
+    size_type num = _indices.size();
+    while (_depth < maxDepth && (num >> _depth) > _maxPointsPerLeaf) {
+        _depth++;
+    }
+
+    _splitValues.resize(size_type(1) << _depth);
+    _splitAxes.resize(size_type(1) << _depth);
+    for (int level = 0; level < _depth; level++) {
+        std::vector<size_type> nodes(size_type(1) << level);
+        for (size_type p = 0; p < nodes.size(); p++) {
+            nodes[p] = p;
+        }
+
+        // the nodes of one level cover disjoint ranges and can be split concurrently
+        QtConcurrent::blockingMap(nodes, [this, level, num](size_type p) {
+            size_type begin = (p * num) >> level;
+            size_type end = ((p + 1) * num) >> level;
+            size_type mid = ((2 * p + 1) * num) >> (level + 1);
+
+            Base::BoundBox3f box;
+            for (size_type i = begin; i < end; i++) {
+                box.Add(_points[_indices[i]]);
+            }
+
+            uint8_t axis = 0;
+            if (box.LengthY() > box.LengthX() && box.LengthY() >= box.LengthZ()) {
+                axis = 1;
+            }
+            else if (box.LengthZ() > box.LengthX() && box.LengthZ() > box.LengthY()) {
+                axis = 2;
+            }
+
+            auto first = _indices.begin() + std::ptrdiff_t(begin);
+            std::nth_element(first,
+                             _indices.begin() + std::ptrdiff_t(mid),
+                             _indices.begin() + std::ptrdiff_t(end),
+                             [this, axis](size_type lhs, size_type rhs) {
+                                 return coordinate(_points[lhs], axis)
+                                     < coordinate(_points[rhs], axis);
+                             });
+
+            size_type node = (size_type(1) << level) + p;
+            _splitAxes[node] = axis;
+            _splitValues[node] = coordinate(_points[_indices[mid]], axis);
+        });
+    }
+
+    _leafPoints.reserve(num);
+    for (size_type index : _indices) {
+        _leafPoints.push_back(_points[index]);
+    }
+}
+
+void PointKDTree::nearest(const Base::Vector3f& pnt,
+                          size_type count,
+                          std::vector<size_type>& indices,
+                          std::vector<float>& sqrDistances) const
+{
+    indices.clear();
+    sqrDistances.clear();
+    size_type num = _indices.size();
+    count = std::min(count, num);
+    if (count == 0) {
+        return;
+    }
+
+    // the candidates are kept sorted by distance
+    auto worst = [&]() {
+        return sqrDistances.size() < count ? std::numeric_limits<float>::max()
+                                           : sqrDistances.back();
+    };
+    auto insert = [&](size_type index, float sqrDistance) {
+        if (sqrDistances.size() == count) {
+            indices.pop_back();
+            sqrDistances.pop_back();
+        }
+        auto pos = std::upper_bound(sqrDistances.begin(), sqrDistances.end(), sqrDistance);
+        auto offset = pos - sqrDistances.begin();
+        sqrDistances.insert(pos, sqrDistance);
+        indices.insert(indices.begin() + offset, index);
+    };
+
+    struct Item
+    {
+        size_type node;
+        int level;
+        float sqrPlaneDistance;
+    };
+    std::array<Item, 2 * maxDepth + 2> stack {};
+    std::size_t top = 0;
+    stack[top++] = {1, 0, 0.0F};
+    while (top > 0) {
+        Item item = stack[--top];
+        if (item.sqrPlaneDistance >= worst()) {
+            continue;
+        }
+
+        if (item.level == _depth) {
+            size_type p = item.node - (size_type(1) << item.level);
+            size_type begin = (p * num) >> item.level;
+            size_type end = ((p + 1) * num) >> item.level;
+            for (size_type i = begin; i < end; i++) {
+                float sqrDistance = Base::DistanceP2(pnt, _leafPoints[i]);
+                if (sqrDistance < worst()) {
+                    insert(_indices[i], sqrDistance);
+                }
+            }
+            continue;
+        }
+
+        // visit the near side first, the far side only if the splitting plane is close enough
+        float diff = coordinate(pnt, _splitAxes[item.node]) - _splitValues[item.node];
+        size_type nearChild = 2 * item.node + (diff < 0.0F ? 0 : 1);
+        size_type farChild = 2 * item.node + (diff < 0.0F ? 1 : 0);
+        stack[top++] = {farChild, item.level + 1, std::max(item.sqrPlaneDistance, diff * diff)};
+        stack[top++] = {nearChild, item.level + 1, item.sqrPlaneDistance};
+    }
+}
@@ -0,0 +1,100 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2025 FreeCAD Project Association                         *
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+#ifndef POINTS_KDTREE_H
+#define POINTS_KDTREE_H
+
+#include <cstdint>
+#include <vector>
+
+#include <Base/Vector3D.h>
+
+#include "Points.h"
+
+
+namespace Points
+{
+
+/**
+ * The PointKDTree class is a balanced k-d tree for nearest-neighbour queries on large point
+ * clouds.
+ *
+ * The tree doesn't allocate a node per point: the point indices are partitioned in place around
+ * the median of the longest axis so that every node covers a contiguous range of the index array.
+ * Only the splitting planes are stored, the ranges of the nodes follow from the number of points.
+ *
+ * All coordinates are in the local system of the point kernel. Points with invalid (NaN)
+ * coordinates are skipped. The points must outlive the tree and must not be modified while the
+ * tree is in use. Queries are thread-safe.
+ */
+class PointsExport PointKDTree
+{
+public:
+    using size_type = PointKernel::size_type;
+
+    explicit PointKDTree(const PointKernel& kernel, size_type maxPointsPerLeaf = 16);
+    explicit PointKDTree(const std::vector<PointKernel::value_type>& points,
+                         size_type maxPointsPerLeaf = 16);
+
+    /// the number of valid points
+    size_type countPoints() const
+    {
+        return _indices.size();
+    }
+    /** Returns the indices of the valid points ordered by the leaves of the tree. Running the
+     * queries for the points in this order keeps the visited points in the cache.
+     */
+    const std::vector<size_type>& getIndices() const
+    {
+        return _indices;
+    }
+
+    /** Searches for the \a count points nearest to \a pnt. The indices are sorted by increasing
+     * distance and \a sqrDistances holds the squared distances. Fewer points are returned if the
+     * tree has less than \a count points.
+     */
+    void nearest(const Base::Vector3f& pnt,
+                 size_type count,
+                 std::vector<size_type>& indices,
+                 std::vector<float>& sqrDistances) const;
+
+private:
+    void build();
+
+private:
+    const std::vector<PointKernel::value_type>& _points;
+    std::vector<size_type> _indices;
+    // a copy of the points in the order of the indices so that the leaves are scanned linearly
+    std::vector<Base::Vector3f> _leafPoints;
+    // the splitting planes of the inner nodes in heap order, i.e. the children of node i are
+    // 2i and 2i+1 and the root is 1
+    std::vector<float> _splitValues;
+    std::vector<uint8_t> _splitAxes;
+    int _depth {0};
+    size_type _maxPointsPerLeaf;
+};
+
+}  // namespace Points
+
+
+#endif  // POINTS_KDTREE_H
@@ -0,0 +1,223 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2025 FreeCAD Project Association                         *
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+#include "PreCompiled.h"
+
+#ifndef _PreComp_
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <queue>
+#include <tuple>
+#endif
+
+#include <Eigen/Eigenvalues>
+
+#include <Base/Exception.h>
+
+#include "PointsNormals.h"
+#include "Tools.h"
+
+
+using namespace Points;
+
+PointNormalEstimation::PointNormalEstimation(const PointKernel& kernel)
+    : _points(kernel.getBasicPoints())
+    , _tree(kernel)
+{}
+
+void PointNormalEstimation::perform(std::vector<Base::Vector3f>& normals) const
+{
+    // the points are processed in the order of the tree so that neighbouring queries visit the
+    // same leaves
+    const std::vector<size_type>& order = _tree.getIndices();
+    normals.assign(_points.size(), Base::Vector3f());
+    forEachBlock(order.size(), 4096, [&](size_type begin, size_type end) {
+        std::vector<size_type> indices;
+        std::vector<float> sqrDistances;
+        for (size_type pos = begin; pos < end; pos++) {
+            size_type index = order[pos];
+            _tree.nearest(_points[index], _kSearch, indices, sqrDistances);
+            if (indices.size() < 3) {
+                continue;
+            }
+
+            // the covariance is accumulated relative to the point to avoid cancellation
+            const auto& origin = _points[index];
+            Eigen::Vector3d mean = Eigen::Vector3d::Zero();
+            for (size_type it : indices) {
+                Base::Vector3f diff = _points[it] - origin;
+                mean += Eigen::Vector3d(diff.x, diff.y, diff.z);
+            }
+            mean /= double(indices.size());
+
+            Eigen::Matrix3d covariance = Eigen::Matrix3d::Zero();
+            for (size_type it : indices) {
+                Base::Vector3f pnt = _points[it] - origin;
+                Eigen::Vector3d diff = Eigen::Vector3d(pnt.x, pnt.y, pnt.z) - mean;
+                covariance += diff * diff.transpose();
+            }
+
+            Eigen::SelfAdjointEigenSolver<Eigen::Matrix3d> solver;
+            solver.computeDirect(covariance);
+            Eigen::Vector3d normal = solver.eigenvectors().col(0);
+            double length = normal.norm();
+            if (length > 0.0 && std::isfinite(length)) {
+                normal /= length;
+                normals[index].Set(float(normal.x()), float(normal.y()), float(normal.z()));
+            }
+        }
+    });
+}
+
+void PointNormalEstimation::orient(std::vector<Base::Vector3f>& normals) const
+{
+    if (normals.size() != _points.size()) {
+        throw Base::ValueError("Number of normals doesn't match number of points");
+    }
+    if (_points.size() >= std::numeric_limits<uint32_t>::max()) {
+        throw Base::ValueError("Too many points to orient normals");
+    }
+
+    // the neighbourhood graph, the neighbours are stored compactly because they dominate the
+    // memory for large clouds
+    const uint32_t none = uint32_t(-1);
+    const size_type numNeighbours = _kSearch;
+    const std::vector<size_type>& order = _tree.getIndices();
+    std::vector<uint32_t> neighbours(_points.size() * numNeighbours, none);
+    forEachBlock(order.size(), 4096, [&](size_type begin, size_type end) {
+        std::vector<size_type> indices;
+        std::vector<float> sqrDistances;
+        for (size_type pos = begin; pos < end; pos++) {
+            size_type index = order[pos];
+            _tree.nearest(_points[index], numNeighbours, indices, sqrDistances);
+            for (size_type i = 0; i < indices.size(); i++) {
+                neighbours[index * numNeighbours + i] = uint32_t(indices[i]);
+            }
+        }
+    });
+
+    // A point can be among the nearest neighbours of another point without having it as a
+    // neighbour itself, e.g. an outlier next to a dense region. The missing reverse edges are
+    // added so that the graph is undirected and every part is reached from its highest point.
+    auto isNeighbour = [&](uint32_t index, uint32_t other) {
+        auto first = neighbours.begin() + std::ptrdiff_t(index * numNeighbours);
+        auto last = first + std::ptrdiff_t(numNeighbours);
+        return std::find(first, last, other) != last;
+    };
+    auto forEachEdge = [&](auto&& func) {
+        for (size_type index = 0; index < _points.size(); index++) {
+            for (size_type i = 0; i < numNeighbours; i++) {
+                uint32_t next = neighbours[index * numNeighbours + i];
+                if (next == none) {
+                    break;
+                }
+                if (next != index) {
+                    func(uint32_t(index), next, !isNeighbour(next, uint32_t(index)));
+                }
+            }
+        }
+    };
+
+    // the adjacency lists of all points in one array, the list of a point starts at its offset
+    std::vector<size_type> offsets(_points.size() + 1, 0);
+    forEachEdge([&](uint32_t index, uint32_t next, bool reverse) {
+        offsets[index]++;
+        if (reverse) {
+            offsets[next]++;
+        }
+    });
+    std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+    std::vector<uint32_t> adjacency(offsets.back());
+    forEachEdge([&](uint32_t index, uint32_t next, bool reverse) {
+        adjacency[--offsets[index]] = next;
+        if (reverse) {
+            adjacency[--offsets[next]] = index;
+        }
+    });
+    neighbours = std::vector<uint32_t>();
+
+    // start every connected part at its highest point
+    std::vector<uint32_t> seeds(order.begin(), order.end());
+    std::sort(seeds.begin(), seeds.end(), [this](uint32_t lhs, uint32_t rhs) {
+        return _points[lhs].z > _points[rhs].z;
+    });
+
+    // Prim's algorithm on the graph with the weight 1 - |ni * nj|, so that the sign is
+    // propagated between the most parallel normals first
+    std::vector<bool> visited(_points.size(), false);
+    std::vector<float> weights(_points.size(), std::numeric_limits<float>::max());
+    using Entry = std::tuple<float, uint32_t, uint32_t>;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<>> queue;
+    for (uint32_t seed : seeds) {
+        if (visited[seed]) {
+            continue;
+        }
+
+        if (normals[seed].z < 0.0F) {
+            normals[seed] = -normals[seed];
+        }
+        queue.emplace(0.0F, seed, none);
+        while (!queue.empty()) {
+            auto [weight, index, parent] = queue.top();
+            queue.pop();
+            if (visited[index]) {
+                continue;
+            }
+
+            visited[index] = true;
+            if (parent != none && normals[parent] * normals[index] < 0.0F) {
+                normals[index] = -normals[index];
+            }
+
+            for (size_type i = offsets[index]; i < offsets[index + 1]; i++) {
+                uint32_t next = adjacency[i];
+                if (!visited[next]) {
+                    float cost = 1.0F - std::fabs(normals[index] * normals[next]);
+                    if (cost < weights[next]) {
+                        weights[next] = cost;
+                        queue.emplace(cost, next, index);
+                    }
+                }
+            }
+        }
+    }
+}
+
+void PointNormalEstimation::orientTowards(const Base::Vector3f& viewpoint,
+                                          std::vector<Base::Vector3f>& normals) const
+{
+    if (normals.size() != _points.size()) {
+        throw Base::ValueError("Number of normals doesn't match number of points");
+    }
+
+    forEachBlock(_points.size(), 65536, [&](size_type begin, size_type end) {
+        for (size_type index = begin; index < end; index++) {
+            if (normals[index] * (viewpoint - _points[index]) < 0.0F) {
+                normals[index] = -normals[index];
+            }
+        }
+    });
+}
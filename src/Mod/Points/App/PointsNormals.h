@@ -0,0 +1,87 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2025 FreeCAD Project Association                         *
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+#ifndef POINTS_NORMALS_H
+#define POINTS_NORMALS_H
+
+#include <vector>
+
+#include <Base/Vector3D.h>
+
+#include "Points.h"
+#include "PointsKDTree.h"
+
+
+namespace Points
+{
+
+/**
+ * The PointNormalEstimation class estimates the normals of a point cloud without an external
+ * library.
+ *
+ * The normal of a point is the direction of least variance of its k nearest neighbours. The sign
+ * of such a normal is arbitrary, so it can afterwards be made consistent over the surface by
+ * propagating it along a minimum spanning tree of the neighbourhood graph, or be turned towards
+ * the position of the scanner.
+ *
+ * All coordinates are in the local system of the point kernel. Points with invalid (NaN)
+ * coordinates or too few neighbours get a zero normal. The kernel must outlive the object.
+ */
+class PointsExport PointNormalEstimation
+{
+public:
+    using size_type = PointKernel::size_type;
+
+    explicit PointNormalEstimation(const PointKernel& kernel);
+
+    /// the number of neighbours including the point itself, the default is 10
+    void setKSearch(size_type count)
+    {
+        _kSearch = count;
+    }
+    size_type getKSearch() const
+    {
+        return _kSearch;
+    }
+
+    /// Computes a unit normal with an arbitrary sign for every point
+    void perform(std::vector<Base::Vector3f>& normals) const;
+    /** Flips the normals so that neighbouring normals point to the same side of the surface.
+     * The highest point of every connected part of the cloud is turned upwards (+z) and its sign
+     * is propagated along the neighbours whose normals are closest to parallel. Two points are
+     * neighbours if either of them is among the nearest neighbours of the other.
+     */
+    void orient(std::vector<Base::Vector3f>& normals) const;
+    /// Flips the normals so that they point towards \a viewpoint
+    void orientTowards(const Base::Vector3f& viewpoint, std::vector<Base::Vector3f>& normals) const;
+
+private:
+    const std::vector<PointKernel::value_type>& _points;
+    PointKDTree _tree;
+    size_type _kSearch {10};
+};
+
+}  // namespace Points
+
+
+#endif  // POINTS_NORMALS_H
@@ -0,0 +1,403 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2025 FreeCAD Project Association                         *
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+#include "PreCompiled.h"
+
+#ifndef _PreComp_
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <queue>
+#include <utility>
+#endif
+
+#include "PointsOctree.h"
+#include "Tools.h"
+
+
+using namespace Points;
+
+namespace
+{
+// number of bits per axis of the Z-order code, this is also the maximum depth of the octree
+constexpr int maxLevel = 21;
+
+uint64_t spreadBits(uint32_t value)
+{
+    uint64_t bits = value & 0x1fffff;
+    bits = (bits | bits << 32) & 0x1f00000000ffff;
+    bits = (bits | bits << 16) & 0x1f0000ff0000ff;
+    bits = (bits | bits << 8) & 0x100f00f00f00f00f;
+    bits = (bits | bits << 4) & 0x10c30c30c30c30c3;
+    bits = (bits | bits << 2) & 0x1249249249249249;
+    return bits;
+}
+
+float sqrDistance(const Base::BoundBox3f& box, const Base::Vector3f& pnt)
+{
+    float dx = std::max({box.MinX - pnt.x, 0.0F, pnt.x - box.MaxX});
+    float dy = std::max({box.MinY - pnt.y, 0.0F, pnt.y - box.MaxY});
+    float dz = std::max({box.MinZ - pnt.z, 0.0F, pnt.z - box.MaxZ});
+    return dx * dx + dy * dy + dz * dz;
+}
+}  // namespace
+
+PointOctree::PointOctree(const PointKernel& kernel, size_type maxPointsPerNode)
+    : PointOctree(kernel.getBasicPoints(), maxPointsPerNode)
+{}
+
+PointOctree::PointOctree(const std::vector<PointKernel::value_type>& points,
+                         size_type maxPointsPerNode)
+    : _points(points)
+    , _maxPointsPerNode(std::max<size_type>(maxPointsPerNode, 1))
+{
+    build();
+}
+
+void PointOctree::build()
+{
+    for (const auto& pnt : _points) {
+        if (isValid(pnt)) {
+            _box.Add(pnt);
+        }
+    }
+    if (!_box.IsValid()) {
+        return;
+    }
+
+    // sort the points along a Z-order curve inside the cube around all points
+    float side = std::max({_box.LengthX(), _box.LengthY(), _box.LengthZ(), FLT_MIN});
+    float scale = float(1 << maxLevel) / side;
+    float maxCell = float((1 << maxLevel) - 1);
+    auto quantize = [scale, maxCell](float value, float origin) {
+        return uint32_t(std::clamp((value - origin) * scale, 0.0F, maxCell));
+    };
+
+    std::vector<std::pair<uint64_t, size_type>> keys;
+    keys.reserve(_points.size());
+    for (size_type index = 0; index < _points.size(); index++) {
+        const auto& pnt = _points[index];
+        if (isValid(pnt)) {
+            uint64_t code = spreadBits(quantize(pnt.x, _box.MinX))
+                | spreadBits(quantize(pnt.y, _box.MinY)) << 1
+                | spreadBits(quantize(pnt.z, _box.MinZ)) << 2;
+            keys.emplace_back(code, index);
+        }
+    }
+    std::sort(keys.begin(), keys.end());
+
+    // split the nodes breadth-first so that the children of a node are stored consecutively
+    Node root;
+    root.end = keys.size();
+    _nodes.push_back(root);
+    for (size_type index = 0; index < _nodes.size(); index++) {
+        Node node = _nodes[index];
+        if (node.size() <= _maxPointsPerNode || node.level == maxLevel) {
+            continue;
+        }
+
+        int shift = 3 * (maxLevel - 1 - node.level);
+        auto first = keys.begin() + std::ptrdiff_t(node.begin);
+        auto last = keys.begin() + std::ptrdiff_t(node.end);
+        size_type firstChild = _nodes.size();
+        uint8_t countChildren = 0;
+        for (uint64_t octant = 0; octant < 8; octant++) {
+            auto next = std::partition_point(first, last, [shift, octant](const auto& key) {
+                return ((key.first >> shift) & 7) <= octant;
+            });
+            if (next != first) {
+                Node child;
+                child.begin = size_type(first - keys.begin());
+                child.end = size_type(next - keys.begin());
+                child.level = node.level + 1;
+                _nodes.push_back(child);
+                countChildren++;
+            }
+            first = next;
+        }
+
+        _nodes[index].firstChild = firstChild;
+        _nodes[index].countChildren = countChildren;
+    }
+
+    _indices.reserve(keys.size());
+    for (const auto& key : keys) {
+        _indices.push_back(key.second);
+    }
+
+    // the boxes of the leaves enclose their points, the boxes of the inner nodes their children
+    for (auto it = _nodes.rbegin(); it != _nodes.rend(); ++it) {
+        if (it->isLeaf()) {
+            for (size_type index : getPoints(*it)) {
+                it->box.Add(_points[index]);
+            }
+        }
+        else {
+            for (size_type child = 0; child < it->countChildren; child++) {
+                it->box.Add(_nodes[it->firstChild + child].box);
+            }
+        }
+    }
+}
+
+void PointOctree::traverse(const std::function<bool(const Node&)>& visit) const
+{
+    if (_nodes.empty()) {
+        return;
+    }
+
+    std::vector<size_type> stack;
+    stack.push_back(0);
+    while (!stack.empty()) {
+        const Node& node = _nodes[stack.back()];
+        stack.pop_back();
+        if (visit(node)) {
+            for (size_type child = 0; child < node.countChildren; child++) {
+                stack.push_back(node.firstChild + child);
+            }
+        }
+    }
+}
+
+void PointOctree::search(const Base::BoundBox3f& box, std::vector<size_type>& indices) const
+{
+    traverse([&](const Node& node) {
+        if (!(node.box && box)) {
+            return false;
+        }
+        if (box.IsInBox(node.box)) {
+            auto points = getPoints(node);
+            indices.insert(indices.end(), points.begin(), points.end());
+            return false;
+        }
+        if (node.isLeaf()) {
+            for (size_type index : getPoints(node)) {
+                if (box.IsInBox(_points[index])) {
+                    indices.push_back(index);
+                }
+            }
+            return false;
+        }
+        return true;
+    });
+}
+
+void PointOctree::search(const Base::Polygon2d& polygon,
+                         const std::function<Base::Vector2d(const Base::Vector3f&)>& project,
+                         const std::function<bool(const Base::Vector3f&)>& inFront,
+                         std::vector<size_type>& indices) const
+{
+    Base::BoundBox2d polyBox = polygon.CalcBoundBox();
+    traverse([&](const Node& node) {
+        bool cull = true;
+        Base::BoundBox2d nodeBox;
+        for (unsigned short corner = 0; corner < 8 && cull; corner++) {
+            Base::Vector3f pnt = node.box.CalcPoint(corner);
+            cull = inFront(pnt);
+            nodeBox.Add(project(pnt));
+        }
+        if (cull && !nodeBox.Intersect(polyBox)) {
+            return false;
+        }
+        if (!node.isLeaf()) {
+            return true;
+        }
+        for (size_type index : getPoints(node)) {
+            if (polygon.Contains(project(_points[index]))) {
+                indices.push_back(index);
+            }
+        }
+        return false;
+    });
+}
+
+bool PointOctree::nearest(const Base::Vector3f& pnt, size_type& index, float& distance) const
+{
+    if (_nodes.empty()) {
+        return false;
+    }
+
+    // best-first search ordered by the distance to the boxes of the nodes
+    using Entry = std::pair<float, size_type>;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<>> queue;
+    queue.emplace(sqrDistance(_nodes[0].box, pnt), 0);
+
+    float best = FLT_MAX;
+    while (!queue.empty() && queue.top().first < best) {
+        const Node& node = _nodes[queue.top().second];
+        queue.pop();
+        if (node.isLeaf()) {
+            for (size_type it : getPoints(node)) {
+                float dist = Base::DistanceP2(pnt, _points[it]);
+                if (dist < best) {
+                    best = dist;
+                    index = it;
+                }
+            }
+        }
+        else {
+            for (size_type child = 0; child < node.countChildren; child++) {
+                size_type pos = node.firstChild + child;
+                float dist = sqrDistance(_nodes[pos].box, pnt);
+                if (dist < best) {
+                    queue.emplace(dist, pos);
+                }
+            }
+        }
+    }
+
+    distance = std::sqrt(best);
+    return true;
+}
+
+void PointOctree::selectLevelOfDetail(const Base::BoundBox3f& box,
+                                      size_type budget,
+                                      std::vector<size_type>& indices) const
+{
+    select(
+        box,
+        budget,
+        [](const Node& node) {
+            return node.box.CalcDiagonalLength();
+        },
+        indices);
+}
+
+void PointOctree::selectLevelOfDetail(const Base::BoundBox3f& box,
+                                      const Base::Vector3f& eye,
+                                      size_type budget,
+                                      std::vector<size_type>& indices) const
+{
+    // the projected size of the node
+    select(
+        box,
+        budget,
+        [&eye](const Node& node) {
+            float dist = Base::Distance(eye, node.box.GetCenter());
+            return node.box.CalcDiagonalLength() / std::max(dist, FLT_MIN);
+        },
+        indices);
+}
+
+PointOctree::size_type PointOctree::countRepresentatives(const Node& node) const
+{
+    return std::min(node.size(), _maxPointsPerNode);
+}
+
+void PointOctree::appendRepresentatives(const Node& node,
+                                        size_type count,
+                                        const Base::BoundBox3f& box,
+                                        std::vector<size_type>& indices) const
+{
+    // the points are sorted along the Z-order curve, so every n-th point gives an even subset
+    bool inside = box.IsInBox(node.box);
+    size_type size = node.size();
+    for (size_type i = 0; i < count; i++) {
+        size_type index = _indices[node.begin + i * size / count];
+        if (inside || box.IsInBox(_points[index])) {
+            indices.push_back(index);
+        }
+    }
+}
+
+void PointOctree::select(const Base::BoundBox3f& box,
+                         size_type budget,
+                         const std::function<float(const Node&)>& priority,
+                         std::vector<size_type>& indices) const
+{
+    if (_nodes.empty() || budget == 0 || !(_nodes[0].box && box)) {
+        return;
+    }
+
+    // Refine the nodes with the highest priority as long as the representatives of the cut
+    // through the octree fit into the budget. Nodes of the same priority are refined together so
+    // that equally sized regions get the same level of detail.
+    using Entry = std::pair<float, size_type>;
+    std::priority_queue<Entry> queue;
+    queue.emplace(priority(_nodes[0]), 0);
+    size_type total = countRepresentatives(_nodes[0]);
+
+    std::vector<size_type> cut;
+    std::vector<size_type> group;
+    while (!queue.empty()) {
+        float limit = queue.top().first * (1.0F - FLT_EPSILON * 16);
+        size_type refined = total;
+        group.clear();
+        while (!queue.empty() && queue.top().first >= limit) {
+            const Node& node = _nodes[queue.top().second];
+            if (node.isLeaf()) {
+                cut.push_back(queue.top().second);
+            }
+            else {
+                group.push_back(queue.top().second);
+                refined -= countRepresentatives(node);
+                for (size_type child = 0; child < node.countChildren; child++) {
+                    const Node& sub = _nodes[node.firstChild + child];
+                    if (sub.box && box) {
+                        refined += countRepresentatives(sub);
+                    }
+                }
+            }
+            queue.pop();
+        }
+
+        if (refined > budget) {
+            cut.insert(cut.end(), group.begin(), group.end());
+            break;
+        }
+
+        total = refined;
+        for (size_type pos : group) {
+            const Node& node = _nodes[pos];
+            for (size_type child = 0; child < node.countChildren; child++) {
+                const Node& sub = _nodes[node.firstChild + child];
+                if (sub.box && box) {
+                    queue.emplace(priority(sub), node.firstChild + child);
+                }
+            }
+        }
+    }
+
+    while (!queue.empty()) {
+        cut.push_back(queue.top().second);
+        queue.pop();
+    }
+
+    // The nodes of the cut may be on different levels, so the remaining budget is spread over
+    // them according to their number of points to get the same density everywhere
+    size_type remaining = 0;
+    size_type leftover = budget - std::min(total, budget);
+    for (size_type pos : cut) {
+        remaining += _nodes[pos].size() - countRepresentatives(_nodes[pos]);
+    }
+
+    for (size_type pos : cut) {
+        const Node& node = _nodes[pos];
+        size_type count = countRepresentatives(node);
+        if (remaining > 0) {
+            double share = double(leftover) / double(remaining);
+            count += size_type(double(node.size() - count) * share);
+        }
+        appendRepresentatives(node, std::min({count, node.size(), budget}), box, indices);
+    }
+}
@@ -0,0 +1,171 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2025 FreeCAD Project Association                         *
+ *                                                                          *
+ *   This file is part of FreeCAD.                                          *
+ *                                                                          *
+ *   FreeCAD is free software: you can redistribute it and/or modify it     *
+ *   under the terms of the GNU Lesser General Public License as            *
+ *   published by the Free Software Foundation, either version 2.1 of the   *
+ *   License, or (at your option) any later version.                        *
+ *                                                                          *
+ *   FreeCAD is distributed in the hope that it will be useful, but         *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU       *
+ *   Lesser General Public License for more details.                        *
+ *                                                                          *
+ *   You should have received a copy of the GNU Lesser General Public       *
+ *   License along with FreeCAD. If not, see                                *
+ *   <https://www.gnu.org/licenses/>.                                       *
+ *                                                                          *
+ ***************************************************************************/
+
+#ifndef POINTS_OCTREE_H
+#define POINTS_OCTREE_H
+
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <vector>
+
+#include <Base/BoundBox.h>
+#include <Base/Tools2D.h>
+#include <Base/Vector3D.h>
+
+#include "Points.h"
+
+
+namespace Points
+{
+
+/**
+ * The PointOctree class sorts the points of a point kernel into an octree so that box,
+ * nearest-neighbour and level-of-detail queries only touch the points near the result.
+ *
+ * The point indices are ordered along a Z-order curve so that the points of every node form
+ * a contiguous range. Each node additionally offers an evenly distributed subset of its points
+ * as representatives which are used for level-of-detail queries: a coarse node stands in for
+ * all of its children until the point budget allows to refine it.
+ *
+ * All coordinates are in the local system of the point kernel, i.e. the transformation of the
+ * kernel is not applied. The kernel must outlive the octree and must not be modified while the
+ * octree is in use.
+ */
+class PointsExport PointOctree
+{
+public:
+    using size_type = PointKernel::size_type;
+
+    struct Node
+    {
+        /// the bounding box of the node's points
+        Base::BoundBox3f box;
+        /// the range of the node's points in the sorted index array
+        size_type begin {0};
+        size_type end {0};
+        /// the index of the first child node, the children are stored consecutively
+        size_type firstChild {0};
+        uint8_t countChildren {0};
+        uint8_t level {0};
+
+        size_type size() const
+        {
+            return end - begin;
+        }
+        bool isLeaf() const
+        {
+            return countChildren == 0;
+        }
+    };
+
+    /** Builds the octree. A node gets split as long as it has more than \a maxPointsPerNode
+     * points. Points with invalid (NaN) coordinates are skipped.
+     */
+    explicit PointOctree(const PointKernel& kernel, size_type maxPointsPerNode = 4096);
+    explicit PointOctree(const std::vector<PointKernel::value_type>& points,
+                         size_type maxPointsPerNode = 4096);
+
+    /// the number of valid points
+    size_type countPoints() const
+    {
+        return _indices.size();
+    }
+    size_type countNodes() const
+    {
+        return _nodes.size();
+    }
+    /// the root node has the index 0
+    const Node& getNode(size_type index) const
+    {
+        return _nodes[index];
+    }
+    /// the indices of the points of the node and all its children
+    std::span<const size_type> getPoints(const Node& node) const
+    {
+        return std::span<const size_type>(_indices).subspan(node.begin, node.size());
+    }
+    /// the bounding box of all valid points
+    const Base::BoundBox3f& getBoundBox() const
+    {
+        return _box;
+    }
+
+    /** @name Queries */
+    //@{
+    /// Appends the indices of all points inside \a box
+    void search(const Base::BoundBox3f& box, std::vector<size_type>& indices) const;
+    /** Appends the indices of all points whose projection by \a project lies inside \a polygon.
+     * Nodes are skipped if the projected corners of their box miss the polygon. This is only
+     * conclusive if all corners lie in front of the camera, so nodes with a corner for which
+     * \a inFront returns false are never skipped but refined down to their points.
+     */
+    void search(const Base::Polygon2d& polygon,
+                const std::function<Base::Vector2d(const Base::Vector3f&)>& project,
+                const std::function<bool(const Base::Vector3f&)>& inFront,
+                std::vector<size_type>& indices) const;
+    /** Searches for the nearest point to \a pnt. Returns false if the octree is empty. */
+    bool nearest(const Base::Vector3f& pnt, size_type& index, float& distance) const;
+    /** Appends at most \a budget evenly distributed points inside \a box. Larger nodes are
+     * refined first so that the result has the same density everywhere.
+     */
+    void selectLevelOfDetail(const Base::BoundBox3f& box,
+                             size_type budget,
+                             std::vector<size_type>& indices) const;
+    /** Appends at most \a budget points inside \a box as seen from \a eye. Nodes that appear
+     * larger on the screen are refined first so that nearby regions get more points.
+     */
+    void selectLevelOfDetail(const Base::BoundBox3f& box,
+                             const Base::Vector3f& eye,
+                             size_type budget,
+                             std::vector<size_type>& indices) const;
+    /** Traverses the octree top-down. A node's children are only visited if \a visit returns
+     * true for the node.
+     */
+    void traverse(const std::function<bool(const Node&)>& visit) const;
+    //@}
+
+private:
+    void build();
+    void select(const Base::BoundBox3f& box,
+                size_type budget,
+                const std::function<float(const Node&)>& priority,
+                std::vector<size_type>& indices) const;
+    size_type countRepresentatives(const Node& node) const;
+    void appendRepresentatives(const Node& node,
+                               size_type count,
+                               const Base::BoundBox3f& box,
+                               std::vector<size_type>& indices) const;
+
+private:
+    const std::vector<PointKernel::value_type>& _points;
+    std::vector<size_type> _indices;
+    std::vector<Node> _nodes;
+    Base::BoundBox3f _box;
+    size_type _maxPointsPerNode;
+};
+
+}  // namespace Points
+
+
+#endif  // POINTS_OCTREE_H
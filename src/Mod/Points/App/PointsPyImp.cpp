@@ -22,15 +22,25 @@
 
 #include "PreCompiled.h"
 #ifndef _PreComp_
+#include <algorithm>
+#include <array>
+#include <cstring>
+
 #include <boost/math/special_functions/fpclassify.hpp>
 #endif
 
+#include <App/DocumentObjectPy.h>
 #include <Base/Builder3D.h>
 #include <Base/Converter.h>
 #include <Base/GeometryPyCXX.h>
+#include <Base/PyWrapParseTupleAndKeywords.h>
 #include <Base/VectorPy.h>
 
 #include "Points.h"
+#include "PointsDownsample.h"
+#include "PointsFeature.h"
+#include "PointsNormals.h"
+#include "Properties.h"
 // inclusion of the generated files (generated out of PointsPy.xml)
 #include "PointsPy.h"
 #include "PointsPy.cpp"
@@ -242,6 +252,133 @@ PyObject* PointsPy::fromValid(PyObject* args) const
     }
 }
 
+PyObject* PointsPy::downsample(PyObject* args, PyObject* kwds) const
+{
+    const char* method = "VoxelGrid";
+    double size = 1.0;
+    double radius = 1.0;
+    int count = 0;
+    int maxPoints = 8;
+    unsigned int seed = 0;
+    static const std::array<const char*, 7>
+        keywords {"Method", "Size", "Radius", "Count", "MaxPointsPerVoxel", "Seed", nullptr};
+    if (!Base::Wrapped_ParseTupleAndKeywords(args,
+                                             kwds,
+                                             "|sddiiI",
+                                             keywords,
+                                             &method,
+                                             &size,
+                                             &radius,
+                                             &count,
+                                             &maxPoints,
+                                             &seed)) {
+        return nullptr;
+    }
+
+    PY_TRY
+    {
+        PointDownsample downsample(*getPointKernelPtr());
+        if (strcmp(method, "VoxelGrid") == 0) {
+            downsample.voxelGrid(size);
+        }
+        else if (strcmp(method, "Random") == 0) {
+            downsample.random(static_cast<PointKernel::size_type>(std::max(count, 0)), seed);
+        }
+        else if (strcmp(method, "PoissonDisk") == 0) {
+            downsample.poissonDisk(radius, seed);
+        }
+        else if (strcmp(method, "Curvature") == 0) {
+            downsample.curvature(size, static_cast<PointKernel::size_type>(std::max(maxPoints, 1)));
+        }
+        else {
+            throw Py::ValueError("No such downsampling method");
+        }
+
+        return new PointsPy(new PointKernel(downsample.getPoints()));
+    }
+    PY_CATCH;
+}
+
+PyObject* PointsPy::estimateNormals(PyObject* args, PyObject* kwds) const
+{
+    int ksearch = 10;
+    PyObject* orient = Py_True;
+    PyObject* viewpoint = Py_None;
+    PyObject* target = nullptr;
+    static const std::array<const char*, 5> keywords {"KSearch",
+                                                      "Orient",
+                                                      "Viewpoint",
+                                                      "Target",
+                                                      nullptr};
+    if (!Base::Wrapped_ParseTupleAndKeywords(args,
+                                             kwds,
+                                             "|iO!OO!",
+                                             keywords,
+                                             &ksearch,
+                                             &PyBool_Type,
+                                             &orient,
+                                             &viewpoint,
+                                             &App::DocumentObjectPy::Type,
+                                             &target)) {
+        return nullptr;
+    }
+
+    if (viewpoint != Py_None && !PyObject_TypeCheck(viewpoint, &Base::VectorPy::Type)) {
+        PyErr_SetString(PyExc_TypeError, "Viewpoint must be a vector or None");
+        return nullptr;
+    }
+
+    PY_TRY
+    {
+        const PointKernel* kernel = getPointKernelPtr();
+        Points::Feature* feature = nullptr;
+        if (target) {
+            App::DocumentObject* obj =
+                static_cast<App::DocumentObjectPy*>(target)->getDocumentObjectPtr();
+            feature = freecad_cast<Points::Feature*>(obj);
+            if (!feature || feature->Points.getValue().size() != kernel->size()) {
+                throw Py::ValueError(
+                    "Target must be a points object with the same number of points");
+            }
+        }
+
+        std::vector<Base::Vector3f> normals;
+        PointNormalEstimation estimation(*kernel);
+        estimation.setKSearch(static_cast<PointKernel::size_type>(std::max(ksearch, 3)));
+        estimation.perform(normals);
+        if (viewpoint != Py_None) {
+            // the normals are computed in the local system of the points
+            Base::Matrix4D inverse = kernel->getTransform();
+            inverse.inverseGauss();
+            Base::Vector3d pos = inverse * *static_cast<Base::VectorPy*>(viewpoint)->getVectorPtr();
+            estimation.orientTowards(Base::convertTo<Base::Vector3f>(pos), normals);
+        }
+        else if (Base::asBoolean(orient)) {
+            estimation.orient(normals);
+        }
+
+        if (feature) {
+            App::Property* prop = feature->getPropertyByName("Normal");
+            if (!prop) {
+                prop = feature->addDynamicProperty("Points::PropertyNormalList", "Normal");
+            }
+            auto normalList = freecad_cast<PropertyNormalList*>(prop);
+            if (!normalList) {
+                throw Py::TypeError("The 'Normal' property of the target isn't a normal list");
+            }
+            normalList->setValues(normals);
+            Py_Return;
+        }
+
+        Py::List list;
+        for (const auto& normal : normals) {
+            list.append(Py::asObject(new Base::VectorPy(normal)));
+        }
+        return Py::new_reference_to(list);
+    }
+    PY_CATCH;
+}
+
 Py::Long PointsPy::getCountPoints() const
 {
     return Py::Long((long)getPointKernelPtr()->size());
@@ -39,11 +39,20 @@
 
 // STL
 #include <algorithm>
+#include <array>
 #include <cmath>
+#include <cstring>
 #include <iostream>
+#include <limits>
 #include <memory>
+#include <numeric>
+#include <queue>
+#include <random>
 #include <set>
 #include <sstream>
+#include <tuple>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 // boost
@@ -150,9 +150,7 @@ void PropertyGreyValueList::SaveDocFile(Base::Writer& writer) const
     Base::OutputStream str(writer.Stream());
     uint32_t uCt = (uint32_t)getSize();
     str << uCt;
-    for (float it : _lValueList) {
-        str << it;
-    }
+    str.writeArray(_lValueList.data(), _lValueList.size());
 }
 
 void PropertyGreyValueList::RestoreDocFile(Base::Reader& reader)
@@ -161,9 +159,7 @@ void PropertyGreyValueList::RestoreDocFile(Base::Reader& reader)
     uint32_t uCt = 0;
     str >> uCt;
     std::vector<float> values(uCt);
-    for (float& value : values) {
-        str >> value;
-    }
+    str.readArray(values.data(), values.size());
     setValues(values);
 }
 
@@ -322,9 +318,8 @@ void PropertyNormalList::SaveDocFile(Base::Writer& writer) const
     Base::OutputStream str(writer.Stream());
     uint32_t uCt = (uint32_t)getSize();
     str << uCt;
-    for (const auto& it : _lValueList) {
-        str << it.x << it.y << it.z;
-    }
+    static_assert(sizeof(Base::Vector3f) == 3 * sizeof(float));
+    str.writeArray(reinterpret_cast<const float*>(_lValueList.data()), 3 * _lValueList.size());
 }
 
 void PropertyNormalList::RestoreDocFile(Base::Reader& reader)
@@ -333,9 +328,7 @@ void PropertyNormalList::RestoreDocFile(Base::Reader& reader)
     uint32_t uCt = 0;
     str >> uCt;
     std::vector<Base::Vector3f> values(uCt);
-    for (auto& value : values) {
-        str >> value.x >> value.y >> value.z;
-    }
+    str.readArray(reinterpret_cast<float*>(values.data()), 3 * values.size());
     setValues(values);
 }
 
@@ -28,9 +28,12 @@
 #include <iostream>
 #endif
 
+#include <Base/Console.h>
 #include <Base/Matrix.h>
+#include <Base/Reader.h>
 #include <Base/Writer.h>
 
+#include "PointsOctree.h"
 #include "PointsPy.h"
 #include "PropertyPointKernel.h"
 
@@ -46,37 +49,62 @@ PropertyPointKernel::PropertyPointKernel()
 void PropertyPointKernel::setValue(const PointKernel& m)
 {
     aboutToSetValue();
+    _lazyFile.reset();
+    resetOctree();
     *_cPoints = m;
     hasSetValue();
 }
 
 const PointKernel& PropertyPointKernel::getValue() const
 {
+    loadLazyDocFile();
     return *_cPoints;
 }
 
 const Data::ComplexGeoData* PropertyPointKernel::getComplexData() const
 {
+    loadLazyDocFile();
     return _cPoints;
 }
 
 void PropertyPointKernel::setTransform(const Base::Matrix4D& rclTrf)
 {
+    loadLazyDocFile();
     _cPoints->setTransform(rclTrf);
 }
 
 Base::Matrix4D PropertyPointKernel::getTransform() const
 {
+    loadLazyDocFile();
     return _cPoints->getTransform();
 }
 
 Base::BoundBox3d PropertyPointKernel::getBoundingBox() const
 {
+    loadLazyDocFile();
     return _cPoints->getBoundBox();
 }
 
+const PointOctree& PropertyPointKernel::getOctree() const
+{
+    loadLazyDocFile();
+    // concurrent callers wait until the first one has built the octree
+    std::lock_guard<std::mutex> lock(_octreeMutex);
+    if (!_octree) {
+        _octree = std::make_shared<PointOctree>(*_cPoints);
+    }
+    return *_octree;
+}
+
+void PropertyPointKernel::resetOctree()
+{
+    std::lock_guard<std::mutex> lock(_octreeMutex);
+    _octree.reset();
+}
+
 PyObject* PropertyPointKernel::getPyObject()
 {
+    loadLazyDocFile();
     PointsPy* points = new PointsPy(&*_cPoints);
     points->setConst();  // set immutable
     return points;
@@ -97,6 +125,7 @@ void PropertyPointKernel::setPyObject(PyObject* value)
 
 void PropertyPointKernel::Save(Base::Writer& writer) const
 {
+    loadLazyDocFile();
     _cPoints->Save(writer);
 }
 
@@ -104,6 +133,7 @@ void PropertyPointKernel::Restore(Base::XMLReader& reader)
 {
     reader.readElement("Points");
     std::string file(reader.getAttribute<const char*>("file"));
+    _lazyFile.reset();
 
     if (!file.empty()) {
         // initiate a file read
@@ -122,19 +152,57 @@ void PropertyPointKernel::Restore(Base::XMLReader& reader)
 
 void PropertyPointKernel::SaveDocFile(Base::Writer& writer) const
 {
-    // does nothing
+    // the points are written by PointKernel::SaveDocFile()
     (void)writer;
+    loadLazyDocFile();
 }
 
 void PropertyPointKernel::RestoreDocFile(Base::Reader& reader)
 {
     aboutToSetValue();
+    _lazyFile.reset();
+    resetOctree();
     _cPoints->RestoreDocFile(reader);
     hasSetValue();
 }
 
+void PropertyPointKernel::setLazyDocFile(const std::shared_ptr<Base::LazyDocFile>& file)
+{
+    aboutToSetValue();
+    _lazyFile = file;
+    resetOctree();
+    hasSetValue();
+}
+
+void PropertyPointKernel::loadLazyDocFile() const
+{
+    std::lock_guard<std::recursive_mutex> lock(_lazyMutex);
+    if (!_lazyFile) {
+        return;
+    }
+
+    // reset the handle first so that accessing the points while reading doesn't recurse
+    std::shared_ptr<Base::LazyDocFile> file;
+    file.swap(_lazyFile);
+    try {
+        // restores only the points, the placement has already been read in Restore()
+        file->restore(&*_cPoints);
+    }
+    catch (const Base::Exception& e) {
+        Base::Console().error("Reading failed from embedded file %s: %s\n",
+                              file->getFileName().c_str(),
+                              e.what());
+    }
+    catch (const std::exception& e) {
+        Base::Console().error("Reading failed from embedded file %s: %s\n",
+                              file->getFileName().c_str(),
+                              e.what());
+    }
+}
+
 App::Property* PropertyPointKernel::Copy() const
 {
+    loadLazyDocFile();
     PropertyPointKernel* prop = new PropertyPointKernel();
     (*prop->_cPoints) = (*this->_cPoints);
     return prop;
@@ -144,6 +212,9 @@ void PropertyPointKernel::Paste(const App::Property& from)
 {
     aboutToSetValue();
     const PropertyPointKernel& prop = dynamic_cast<const PropertyPointKernel&>(from);
+    prop.loadLazyDocFile();
+    _lazyFile.reset();
+    resetOctree();
     *(this->_cPoints) = *(prop._cPoints);
     hasSetValue();
 }
@@ -155,7 +226,9 @@ unsigned int PropertyPointKernel::getMemSize() const
 
 PointKernel* PropertyPointKernel::startEditing()
 {
+    loadLazyDocFile();
     aboutToSetValue();
+    resetOctree();
     return static_cast<PointKernel*>(_cPoints);
 }
 
@@ -166,6 +239,7 @@ void PropertyPointKernel::finishEditing()
 
 void PropertyPointKernel::removeIndices(const std::vector<unsigned long>& uIndices)
 {
+    loadLazyDocFile();
     // We need a sorted array
     std::vector<unsigned long> uSortedInds = uIndices;
     std::sort(uSortedInds.begin(), uSortedInds.end());
@@ -198,7 +272,9 @@ void PropertyPointKernel::removeIndices(const std::vector<unsigned long>& uIndic
 
 void PropertyPointKernel::transformGeometry(const Base::Matrix4D& rclMat)
 {
+    loadLazyDocFile();
     aboutToSetValue();
+    resetOctree();
     _cPoints->transformGeometry(rclMat);
     hasSetValue();
 }
@@ -24,10 +24,14 @@
 #ifndef POINTS_PROPERTYPOINTKERNEL_H
 #define POINTS_PROPERTYPOINTKERNEL_H
 
+#include <memory>
+#include <mutex>
+
 #include "Points.h"
 
 namespace Points
 {
+class PointOctree;
 
 /** The point kernel property
  */
@@ -53,6 +57,9 @@ public:
     //@{
     /** Returns the bounding box around the underlying mesh kernel */
     Base::BoundBox3d getBoundingBox() const override;
+    /** Returns the octree over the points. It is built once on first use, also if several threads
+     * ask for it, and discarded as soon as the points are modified. */
+    const PointOctree& getOctree() const;
     //@}
 
     /** @name Python interface */
@@ -76,6 +83,11 @@ public:
     void Restore(Base::XMLReader& reader) override;
     void SaveDocFile(Base::Writer& writer) const override;
     void RestoreDocFile(Base::Reader& reader) override;
+    bool canRestoreDocFileLazily() const override
+    {
+        return true;
+    }
+    void setLazyDocFile(const std::shared_ptr<Base::LazyDocFile>& file) override;
     //@}
 
     /** @name Modification */
@@ -87,8 +99,20 @@ public:
     void removeIndices(const std::vector<unsigned long>&);
     //@}
 
+private:
+    /** Reads the points from the project file if their restore has been deferred
+     * Concurrent readers wait until the points are loaded.
+     */
+    void loadLazyDocFile() const;
+    /// Drops the octree when the points change
+    void resetOctree();
+
 private:
     Base::Reference<PointKernel> _cPoints;
+    mutable std::shared_ptr<Base::LazyDocFile> _lazyFile;
+    mutable std::recursive_mutex _lazyMutex;
+    mutable std::mutex _octreeMutex;
+    mutable std::shared_ptr<PointOctree> _octree;
 };
 
 }  // namespace Points
@@ -24,8 +24,14 @@
 #ifndef POINTS_TOOLS_H
 #define POINTS_TOOLS_H
 
-#include <App/DocumentObject.h>
+#include <QtConcurrentMap>
 #include <algorithm>
+#include <cmath>
+#include <utility>
+#include <vector>
+
+#include <App/DocumentObject.h>
+#include <Base/Vector3D.h>
 
 namespace Points
 {
@@ -60,6 +66,28 @@ bool copyProperty(App::DocumentObject* target,
     return false;
 }
 
+/// Points with NaN coordinates mark invalid measurements and are skipped by the algorithms
+inline bool isValid(const Base::Vector3f& pnt)
+{
+    return !(std::isnan(pnt.x) || std::isnan(pnt.y) || std::isnan(pnt.z));
+}
+
+/*!
+ * \brief Calls \a func for consecutive blocks of \a count elements in parallel.
+ */
+template<typename Func>
+void forEachBlock(std::size_t count, std::size_t blockSize, const Func& func)
+{
+    std::vector<std::pair<std::size_t, std::size_t>> blocks;
+    for (std::size_t begin = 0; begin < count; begin += blockSize) {
+        blocks.emplace_back(begin, std::min(begin + blockSize, count));
+    }
+
+    QtConcurrent::blockingMap(blocks, [&func](const std::pair<std::size_t, std::size_t>& block) {
+        func(block.first, block.second);
+    });
+}
+
 }  // namespace Points
 
 #endif  // POINTS_TOOLS_H
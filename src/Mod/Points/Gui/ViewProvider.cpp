@@ -22,11 +22,16 @@
 
 #include "PreCompiled.h"
 #ifndef _PreComp_
+#include <algorithm>
 #include <boost/math/special_functions/fpclassify.hpp>
 #include <limits>
 
+#include <Inventor/actions/SoGLRenderAction.h>
+#include <Inventor/elements/SoModelMatrixElement.h>
+#include <Inventor/elements/SoViewVolumeElement.h>
 #include <Inventor/errors/SoDebugError.h>
 #include <Inventor/events/SoMouseButtonEvent.h>
+#include <Inventor/nodes/SoCallback.h>
 #include <Inventor/nodes/SoCamera.h>
 #include <Inventor/nodes/SoCoordinate3.h>
 #include <Inventor/nodes/SoDrawStyle.h>
@@ -35,6 +40,7 @@
 #include <Inventor/nodes/SoMaterialBinding.h>
 #include <Inventor/nodes/SoNormal.h>
 #include <Inventor/nodes/SoPointSet.h>
+#include <Inventor/sensors/SoOneShotSensor.h>
 #endif
 
 #include <App/Document.h>
@@ -44,6 +50,7 @@
 #include <Gui/Selection/SoFCSelection.h>
 #include <Gui/View3DInventorViewer.h>
 #include <Mod/Points/App/PointsFeature.h>
+#include <Mod/Points/App/PointsOctree.h>
 #include <Mod/Points/App/Properties.h>
 
 #include "ViewProvider.h"
@@ -52,6 +59,25 @@
 using namespace PointsGui;
 using namespace Points;
 
+namespace
+{
+// Copies the values of all points, or only of the shown subset, into a field of a node
+template<class Field, class Value, class Func>
+void setPointValues(Field& field,
+                    const std::vector<Value>& values,
+                    const std::vector<std::size_t>& subset,
+                    Func set)
+{
+    std::size_t count = subset.empty() ? values.size() : subset.size();
+    field.setNum(static_cast<int>(count));
+    auto* dst = field.startEditing();
+    for (std::size_t i = 0; i < count; i++) {
+        set(dst[i], values[subset.empty() ? i : subset[i]]);
+    }
+    field.finishEditing();
+}
+}  // namespace
+
 
 PROPERTY_SOURCE_ABSTRACT(PointsGui::ViewProviderPoints, Gui::ViewProviderGeometryObject)
 
@@ -113,52 +139,40 @@ void ViewProviderPoints::onChanged(const App::Property* prop)
 
 void ViewProviderPoints::setVertexColorMode(App::PropertyColorList* pcProperty)
 {
-    const std::vector<Base::Color>& val = pcProperty->getValues();
-
-    pcColorMat->diffuseColor.setNum(val.size());
-    SbColor* col = pcColorMat->diffuseColor.startEditing();
-
-    std::size_t i = 0;
-    for (const auto& it : val) {
-        col[i++].setValue(it.r, it.g, it.b);
-    }
-
-    pcColorMat->diffuseColor.finishEditing();
+    setPointValues(pcColorMat->diffuseColor,
+                   pcProperty->getValues(),
+                   shownIndices,
+                   [](SbColor& col, const Base::Color& it) {
+                       col.setValue(it.r, it.g, it.b);
+                   });
 }
 
 void ViewProviderPoints::setVertexGreyvalueMode(Points::PropertyGreyValueList* pcProperty)
 {
-    const std::vector<float>& val = pcProperty->getValues();
-
-    pcColorMat->diffuseColor.setNum(val.size());
-    SbColor* col = pcColorMat->diffuseColor.startEditing();
-
-    std::size_t i = 0;
-    for (float it : val) {
-        col[i++].setValue(it, it, it);
-    }
-
-    pcColorMat->diffuseColor.finishEditing();
+    setPointValues(pcColorMat->diffuseColor,
+                   pcProperty->getValues(),
+                   shownIndices,
+                   [](SbColor& col, float it) {
+                       col.setValue(it, it, it);
+                   });
 }
 
 void ViewProviderPoints::setVertexNormalMode(Points::PropertyNormalList* pcProperty)
 {
-    const std::vector<Base::Vector3f>& val = pcProperty->getValues();
-
-    pcPointsNormal->vector.setNum(val.size());
-    SbVec3f* norm = pcPointsNormal->vector.startEditing();
-
-    std::size_t i = 0;
-    for (const auto& it : val) {
-        norm[i++].setValue(it.x, it.y, it.z);
-    }
-
-    pcPointsNormal->vector.finishEditing();
+    setPointValues(pcPointsNormal->vector,
+                   pcProperty->getValues(),
+                   shownIndices,
+                   [](SbVec3f& norm, const Base::Vector3f& it) {
+                       norm.setValue(it.x, it.y, it.z);
+                   });
 }
 
 void ViewProviderPoints::setDisplayMode(const char* ModeName)
 {
-    int numPoints = pcPointsCoord->point.getNum();
+    // with a level of detail the coordinate node holds only a subset of the points
+    Points::Feature* fea = dynamic_cast<Points::Feature*>(pcObject);
+    int numPoints = fea ? static_cast<int>(fea->Points.getValue().size())
+                        : pcPointsCoord->point.getNum();
 
     if (strcmp("Color", ModeName) == 0) {
         std::map<std::string, App::Property*> Map;
@@ -366,17 +380,134 @@ void ViewProviderPoints::clipPointsCallback(void*, SoEventCallback* n)
 
 PROPERTY_SOURCE(PointsGui::ViewProviderScattered, PointsGui::ViewProviderPoints)
 
+App::PropertyIntegerConstraint::Constraints ViewProviderScattered::budgetRange = {
+    0,
+    std::numeric_limits<int>::max(),
+    100000};
+
 ViewProviderScattered::ViewProviderScattered()
 {
+    static const char* osgroup = "Object Style";
+
+    ADD_PROPERTY_TYPE(PointBudget,
+                      (5000000),
+                      osgroup,
+                      App::Prop_None,
+                      "Maximum number of displayed points, 0 shows all points");
+    PointBudget.setConstraints(&budgetRange);
+
     pcPoints = new SoPointSet();
     pcPoints->ref();
+
+    // watches the eye of the rendered views to adjust the subset of shown points
+    pcRenderCallback = new SoCallback();
+    pcRenderCallback->ref();
+    pcRenderCallback->setCallback(renderCallback, this);
+    levelOfDetailSensor = new SoOneShotSensor(levelOfDetailCallback, this);
 }
 
 ViewProviderScattered::~ViewProviderScattered()
 {
+    delete levelOfDetailSensor;
+    pcRenderCallback->unref();
     pcPoints->unref();
 }
 
+void ViewProviderScattered::onChanged(const App::Property* prop)
+{
+    if (prop == &PointBudget) {
+        if (pcObject) {
+            updateLevelOfDetail();
+            setActiveMode();
+        }
+    }
+    else {
+        ViewProviderPoints::onChanged(prop);
+    }
+}
+
+void ViewProviderScattered::updateLevelOfDetail()
+{
+    Points::Feature* fea = dynamic_cast<Points::Feature*>(pcObject);
+    if (!fea) {
+        return;
+    }
+
+    const Points::PointKernel& points = fea->Points.getValue();
+    auto budget = static_cast<std::size_t>(PointBudget.getValue());
+    shownIndices.clear();
+    if (budget == 0 || points.size() <= budget) {
+        ViewProviderPointsBuilder builder;
+        builder.createPoints(&fea->Points, pcPointsCoord, pcPoints);
+        return;
+    }
+
+    // the octree selects a subset with the same density everywhere or, as seen from the eye,
+    // with more points nearby
+    const Points::PointOctree& octree = fea->Points.getOctree();
+    shownIndices.reserve(budget);
+    if (levelOfDetailEye) {
+        octree.selectLevelOfDetail(octree.getBoundBox(), *levelOfDetailEye, budget, shownIndices);
+    }
+    else {
+        octree.selectLevelOfDetail(octree.getBoundBox(), budget, shownIndices);
+    }
+
+    // only the coordinates of the subset are passed to Coin
+    const std::vector<Points::PointKernel::value_type>& kernel = points.getBasicPoints();
+    pcPointsCoord->point.setNum(static_cast<int>(shownIndices.size()));
+    SbVec3f* vec = pcPointsCoord->point.startEditing();
+    for (std::size_t index : shownIndices) {
+        const auto& pnt = kernel[index];
+        (vec++)->setValue(pnt.x, pnt.y, pnt.z);
+    }
+    pcPointsCoord->point.finishEditing();
+    pcPoints->numPoints = static_cast<int>(shownIndices.size());
+}
+
+void ViewProviderScattered::renderCallback(void* ud, SoAction* action)
+{
+    auto that = static_cast<ViewProviderScattered*>(ud);
+    if (that->shownIndices.empty() || !action->isOfType(SoGLRenderAction::getClassTypeId())) {
+        return;
+    }
+
+    // the eye in the coordinate system of the points
+    SoState* state = action->getState();
+    const SbViewVolume& vol = SoViewVolumeElement::get(state);
+    std::optional<Base::Vector3f> eye;
+    if (vol.getProjectionType() == SbViewVolume::PERSPECTIVE) {
+        SbVec3f pos;
+        SoModelMatrixElement::get(state).inverse().multVecMatrix(vol.getProjectionPoint(), pos);
+        eye = Base::Vector3f(pos[0], pos[1], pos[2]);
+    }
+
+    // moving by a tenth of the distance to the cloud noticeably changes the projected sizes
+    const std::optional<Base::Vector3f>& last = that->levelOfDetailEye;
+    bool moved = eye.has_value() != last.has_value();
+    if (eye && last) {
+        Points::Feature* fea = static_cast<Points::Feature*>(that->pcObject);
+        Base::Vector3f center = fea->Points.getOctree().getBoundBox().GetCenter();
+        moved = Base::Distance(*eye, *last) > 0.1F * Base::Distance(*last, center);
+    }
+
+    // the scene graph must not be modified while it is traversed
+    if (moved) {
+        that->nextEye = eye;
+        that->levelOfDetailSensor->schedule();
+    }
+}
+
+void ViewProviderScattered::levelOfDetailCallback(void* ud, SoSensor* /*sensor*/)
+{
+    auto that = static_cast<ViewProviderScattered*>(ud);
+    that->levelOfDetailEye = that->nextEye;
+    that->updateLevelOfDetail();
+
+    // the colors and normals must match the new subset
+    that->setActiveMode();
+}
+
 void ViewProviderScattered::attach(App::DocumentObject* pcObj)
 {
     // call parent's attach to define display modes
@@ -387,6 +518,7 @@ void ViewProviderScattered::attach(App::DocumentObject* pcObj)
     pcHighlight->subElementName = "Main";
 
     // Highlight for selection
+    pcHighlight->addChild(pcRenderCallback);
     pcHighlight->addChild(pcPointsCoord);
     pcHighlight->addChild(pcPoints);
 
@@ -427,8 +559,7 @@ void ViewProviderScattered::updateData(const App::Property* prop)
 {
     ViewProviderPoints::updateData(prop);
     if (prop->is<Points::PropertyPointKernel>()) {
-        ViewProviderPointsBuilder builder;
-        builder.createPoints(prop, pcPointsCoord, pcPoints);
+        updateLevelOfDetail();
 
         // The number of points might have changed, so force also a resize of the Inventor internals
         setActiveMode();
@@ -460,21 +591,36 @@ void ViewProviderScattered::cut(const std::vector<SbVec2f>& picked,
     SoCamera* pCam = Viewer.getSoRenderManager()->getCamera();
     SbViewVolume vol = pCam->getViewVolume();
 
-    // search for all points inside/outside the polygon
-    std::vector<unsigned long> removeIndices;
-    removeIndices.reserve(points.size());
-
-    unsigned long index = 0;
-    for (Points::PointKernel::const_iterator jt = points.begin(); jt != points.end();
-         ++jt, ++index) {
-        SbVec3f pt(jt->x, jt->y, jt->z);
-
-        // project from 3d to 2d
+    // project from 3d to 2d
+    Base::Matrix4D mat = points.getTransform();
+    auto project = [&mat, &vol](const Base::Vector3f& pnt) {
+        Base::Vector3d pos = mat * Base::toVector<double>(pnt);
+        SbVec3f pt(float(pos.x), float(pos.y), float(pos.z));
         vol.projectToScreen(pt, pt);
-        if (cPoly.Contains(Base::Vector2d(pt[0], pt[1]))) {
-            removeIndices.push_back(index);
+        return Base::Vector2d(pt[0], pt[1]);
+    };
+
+    // with a perspective camera a box that reaches behind the near plane doesn't project
+    // onto the box of its projected corners
+    bool perspective = vol.getProjectionType() == SbViewVolume::PERSPECTIVE;
+    SbVec3f eye = vol.getProjectionPoint();
+    SbVec3f dir = vol.getProjectionDirection();
+    float nearDist = vol.getNearDist();
+    auto inFront = [&](const Base::Vector3f& pnt) {
+        if (!perspective) {
+            return true;
         }
-    }
+        Base::Vector3d pos = mat * Base::toVector<double>(pnt);
+        SbVec3f pt(float(pos.x), float(pos.y), float(pos.z));
+        return (pt - eye).dot(dir) >= nearDist;
+    };
+
+    // search for all points inside/outside the polygon and skip the octree nodes whose
+    // projected box misses the polygon
+    std::vector<Points::PointOctree::size_type> indices;
+    fea->Points.getOctree().search(cPoly, project, inFront, indices);
+    std::vector<unsigned long> removeIndices(indices.begin(), indices.end());
+    std::sort(removeIndices.begin(), removeIndices.end());
 
     if (removeIndices.empty()) {
         return;  // nothing needs to be done
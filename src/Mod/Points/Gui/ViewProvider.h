@@ -23,15 +23,21 @@
 #ifndef POINTSGUI_VIEWPROVIDERPOINTS_H
 #define POINTSGUI_VIEWPROVIDERPOINTS_H
 
+#include <optional>
+#include <vector>
 #include <Inventor/SbVec2f.h>
 
+#include <Base/Vector3D.h>
 #include <Gui/ViewProviderBuilder.h>
 #include <Gui/ViewProviderGeometryObject.h>
 #include <Gui/ViewProviderFeaturePython.h>
 #include <Mod/Points/PointsGlobal.h>
 
 
-class SoSwitch;
+class SoAction;
+class SoCallback;
+class SoOneShotSensor;
+class SoSensor;
 class SoPointSet;
 class SoIndexedPointSet;
 class SoLocateHighlight;
@@ -112,6 +118,8 @@ protected:
     SoMaterial* pcColorMat;
     SoNormal* pcPointsNormal;
     SoDrawStyle* pcPointStyle;
+    /// The indices of the points in pcPointsCoord if only a subset of the cloud is shown
+    std::vector<std::size_t> shownIndices;
 
 private:
     static App::PropertyFloatConstraint::Constraints floatRange;
@@ -130,6 +138,9 @@ public:
     ViewProviderScattered();
     ~ViewProviderScattered() override;
 
+    /// The maximum number of displayed points, 0 shows all points
+    App::PropertyIntegerConstraint PointBudget;
+
     /**
      * Extracts the point data from the feature \a pcFeature and creates
      * an Inventor node \a SoNode with these data.
@@ -139,10 +150,28 @@ public:
     void updateData(const App::Property*) override;
 
 protected:
+    void onChanged(const App::Property* prop) override;
     void cut(const std::vector<SbVec2f>& picked, Gui::View3DInventorViewer& Viewer) override;
 
+private:
+    /** Shows only a subset of the points if there are more than the budget. The subset is
+     * denser near the eye of the last rendered perspective view.
+     */
+    void updateLevelOfDetail();
+    /// Schedules a new subset when the eye has moved noticeably
+    static void renderCallback(void* ud, SoAction* action);
+    static void levelOfDetailCallback(void* ud, SoSensor* sensor);
+
 protected:
     SoPointSet* pcPoints;
+    SoCallback* pcRenderCallback;
+
+private:
+    SoOneShotSensor* levelOfDetailSensor;
+    /// The eye in the coordinate system of the points, none for a parallel projection
+    std::optional<Base::Vector3f> levelOfDetailEye;
+    std::optional<Base::Vector3f> nextEye;
+    static App::PropertyIntegerConstraint::Constraints budgetRange;
 };
 
 /**
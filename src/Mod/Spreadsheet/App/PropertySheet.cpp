@@ -73,6 +73,8 @@ void PropertySheet::clear()
     cellToPropertyNameMap.clear();
     documentObjectToCellMap.clear();
     cellToDocumentObjectMap.clear();
+    indirectDepCells.clear();
+    documentObjectToIndirectCellMap.clear();
     aliasProp.clear();
     revAliasProp.clear();
 
@@ -289,6 +291,8 @@ PropertySheet::PropertySheet(const PropertySheet& other)
     , cellToPropertyNameMap(other.cellToPropertyNameMap)
     , documentObjectToCellMap(other.documentObjectToCellMap)
     , cellToDocumentObjectMap(other.cellToDocumentObjectMap)
+    , indirectDepCells(other.indirectDepCells)
+    , documentObjectToIndirectCellMap(other.documentObjectToIndirectCellMap)
     , aliasProp(other.aliasProp)
     , revAliasProp(other.revAliasProp)
     , updateCount(other.updateCount)
@@ -1365,15 +1369,24 @@ void PropertySheet::addDependencies(CellAddress key)
         return;
     }
 
+    std::vector<std::string> labels;
     for (auto& var : expression->getIdentifiers()) {
-        for (auto& dep : var.first.getDep(true)) {
+        // Hidden, label and sub-object references need the complete update in
+        // hasSetValue(), other references only if they add a new object
+        if (var.second || !var.first.getSubObjectName().empty()) {
+            indirectDepCells.insert(key);
+        }
+        for (auto& dep : var.first.getDep(true, &labels)) {
             App::DocumentObject* docObj = dep.first;
 
             std::string docObjName = docObj->getFullName();
 
-            documentObjectToCellMap[docObjName].insert(key);
+            auto& objCells = documentObjectToCellMap[docObjName];
+            if (objCells.empty()) {
+                ++updateCount;
+            }
+            objCells.insert(key);
             cellToDocumentObjectMap[key].insert(docObjName);
-            ++updateCount;
 
             for (auto& name : dep.second) {
                 std::string propName = docObjName + "." + name;
@@ -1400,6 +1413,16 @@ void PropertySheet::addDependencies(CellAddress key)
             }
         }
     }
+
+    if (!labels.empty()) {
+        indirectDepCells.insert(key);
+    }
+    if (indirectDepCells.contains(key)) {
+        for (auto& docObjName : cellToDocumentObjectMap[key]) {
+            documentObjectToIndirectCellMap[docObjName].insert(key);
+        }
+        ++updateCount;
+    }
 }
 
 /**
@@ -1435,6 +1458,10 @@ void PropertySheet::removeDependencies(CellAddress key)
 
     /* Remove from DocumentObject <-> Key maps */
 
+    if (indirectDepCells.erase(key) > 0) {
+        ++updateCount;
+    }
+
     std::map<CellAddress, std::set<std::string>>::iterator i2 = cellToDocumentObjectMap.find(key);
 
     if (i2 != cellToDocumentObjectMap.end()) {
@@ -1449,6 +1476,19 @@ void PropertySheet::removeDependencies(CellAddress key)
 
                 if (k->second.empty()) {
                     documentObjectToCellMap.erase(*j);
+                    ++updateCount;
+                }
+            }
+
+            // The hidden references of other cells may now be the only ones to this object
+            auto l = documentObjectToIndirectCellMap.find(*j);
+            if (l != documentObjectToIndirectCellMap.end()) {
+                l->second.erase(key);
+                if (l->second.empty()) {
+                    documentObjectToIndirectCellMap.erase(l);
+                }
+                else {
+                    ++updateCount;
                 }
             }
 
@@ -1456,7 +1496,6 @@ void PropertySheet::removeDependencies(CellAddress key)
         }
 
         cellToDocumentObjectMap.erase(i2);
-        ++updateCount;
     }
 }
 
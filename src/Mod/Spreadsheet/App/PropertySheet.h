@@ -323,6 +323,12 @@ private:
     /*! DocumentObject this cell depends on */
     std::map<App::CellAddress, std::set<std::string>> cellToDocumentObjectMap;
 
+    /*! Cells with hidden, label or sub-object references */
+    std::set<App::CellAddress> indirectDepCells;
+
+    /*! Cells with hidden, label or sub-object references to a DocumentObject */
+    std::map<std::string, std::set<App::CellAddress>> documentObjectToIndirectCellMap;
+
     /*! Mapping of cell position to alias property */
     std::map<App::CellAddress, std::string> aliasProp;
 
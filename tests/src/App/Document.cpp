@@ -5,10 +5,15 @@
 
 #include "App/Application.h"
 #include "App/Document.h"
+#include "App/FeatureTest.h"
 #include "App/StringHasher.h"
+#include "Base/Exception.h"
 #include "Base/Writer.h"
 #include <src/App/InitApplication.h>
 
+#include <set>
+#include <thread>
+
 using ::testing::Eq;
 using ::testing::Ne;
 
@@ -94,4 +99,225 @@ TEST_F(DocumentTest, getStringHasherGivesExpectedHasher)
     EXPECT_EQ(hasher, foundHasher);
 }
 
+TEST_F(DocumentTest, parallelRecomputeFollowsDependencies)
+{
+    // Arrange
+    auto hGrp = App::GetApplication().GetParameterGroupByPath(
+        "User parameter:BaseApp/Preferences/Document");
+    auto base = freecad_cast<App::FeatureTest*>(doc()->addObject("App::FeatureTest"));
+    auto left = freecad_cast<App::FeatureTest*>(doc()->addObject("App::FeatureTest"));
+    auto right = freecad_cast<App::FeatureTest*>(doc()->addObject("App::FeatureTest"));
+    auto top = freecad_cast<App::FeatureTest*>(doc()->addObject("App::FeatureTest"));
+    left->Source1.setValue(base);
+    right->Source1.setValue(base);
+    top->Source1.setValue(left);
+    top->Source2.setValue(right);
+    bool hasError = false;
+
+    // Act
+    hGrp->SetBool("ParallelRecompute", true);
+    int count = doc()->recompute({}, false, &hasError);
+    hGrp->RemoveBool("ParallelRecompute");
+
+    // Assert
+    EXPECT_EQ(count, 4);
+    EXPECT_FALSE(hasError);
+    for (auto obj : {base, left, right, top}) {
+        EXPECT_STREQ(obj->ExecResult.getValue(), "Exec");
+        EXPECT_FALSE(obj->isTouched());
+    }
+}
+
+TEST_F(DocumentTest, parallelRecomputeSkipsDependentsOfFailedObject)
+{
+    // Arrange
+    auto hGrp = App::GetApplication().GetParameterGroupByPath(
+        "User parameter:BaseApp/Preferences/Document");
+    auto base = freecad_cast<App::FeatureTest*>(doc()->addObject("App::FeatureTest"));
+    auto left = freecad_cast<App::FeatureTest*>(doc()->addObject("App::FeatureTestException"));
+    auto right = freecad_cast<App::FeatureTest*>(doc()->addObject("App::FeatureTest"));
+    auto top = freecad_cast<App::FeatureTest*>(doc()->addObject("App::FeatureTest"));
+    left->Source1.setValue(base);
+    right->Source1.setValue(base);
+    top->Source1.setValue(left);
+    top->Source2.setValue(right);
+    bool hasError = false;
+
+    // Act
+    hGrp->SetBool("ParallelRecompute", true);
+    doc()->recompute({}, false, &hasError);
+    hGrp->RemoveBool("ParallelRecompute");
+
+    // Assert
+    EXPECT_TRUE(hasError);
+    EXPECT_TRUE(left->isError());
+    EXPECT_STREQ(right->ExecResult.getValue(), "Exec");
+    EXPECT_STREQ(top->ExecResult.getValue(), "empty");
+}
+
+TEST_F(DocumentTest, parallelRecomputeRunsTasksOnWorkers)
+{
+    // Arrange
+    auto hGrp = App::GetApplication().GetParameterGroupByPath(
+        "User parameter:BaseApp/Preferences/Document");
+    auto base = freecad_cast<App::FeatureTestConcurrent*>(
+        doc()->addObject("App::FeatureTestConcurrent"));
+    auto left = freecad_cast<App::FeatureTestConcurrent*>(
+        doc()->addObject("App::FeatureTestConcurrent"));
+    auto right = freecad_cast<App::FeatureTestConcurrent*>(
+        doc()->addObject("App::FeatureTestConcurrent"));
+    auto top = freecad_cast<App::FeatureTestConcurrent*>(
+        doc()->addObject("App::FeatureTestConcurrent"));
+    left->Source1.setValue(base);
+    right->Source1.setValue(base);
+    top->Source1.setValue(left);
+    top->Source2.setValue(right);
+    std::set<std::thread::id> signalThreads;
+    auto connection = doc()->signalChangedObject.connect(
+        [&signalThreads](const App::DocumentObject&, const App::Property&) {
+            signalThreads.insert(std::this_thread::get_id());
+        });
+    bool hasError = false;
+
+    // Act
+    hGrp->SetBool("ParallelRecompute", true);
+    hGrp->SetInt("RecomputeThreads", 2);
+    int count = doc()->recompute({}, false, &hasError);
+    hGrp->RemoveBool("ParallelRecompute");
+    hGrp->RemoveInt("RecomputeThreads");
+    connection.disconnect();
+
+    // Assert
+    EXPECT_EQ(count, 4);
+    EXPECT_FALSE(hasError);
+    for (auto obj : {base, left, right, top}) {
+        EXPECT_TRUE(obj->ComputedOnWorker.getValue());
+        EXPECT_EQ(obj->ExecCount.getValue(), 1);
+        EXPECT_FALSE(obj->isTouched());
+    }
+    EXPECT_EQ(base->Integer.getValue(), 1);
+    EXPECT_EQ(left->Integer.getValue(), 2);
+    EXPECT_EQ(right->Integer.getValue(), 2);
+    EXPECT_EQ(top->Integer.getValue(), 5);
+    EXPECT_EQ(signalThreads, std::set<std::thread::id> {std::this_thread::get_id()});
+}
+
+TEST_F(DocumentTest, parallelRecomputeRecordsUndo)
+{
+    // Arrange
+    auto hGrp = App::GetApplication().GetParameterGroupByPath(
+        "User parameter:BaseApp/Preferences/Document");
+    auto base = freecad_cast<App::FeatureTestConcurrent*>(
+        doc()->addObject("App::FeatureTestConcurrent"));
+    auto top = freecad_cast<App::FeatureTestConcurrent*>(
+        doc()->addObject("App::FeatureTestConcurrent"));
+    top->Source1.setValue(base);
+    doc()->setUndoMode(1);
+
+    // Act
+    hGrp->SetBool("ParallelRecompute", true);
+    doc()->openTransaction("Recompute");
+    doc()->recompute();
+    doc()->commitTransaction();
+    hGrp->RemoveBool("ParallelRecompute");
+    int afterRecompute = top->Integer.getValue();
+    doc()->undo();
+
+    // Assert
+    EXPECT_EQ(afterRecompute, 2);
+    EXPECT_EQ(base->Integer.getValue(), 4711);
+    EXPECT_EQ(top->Integer.getValue(), 4711);
+}
+
+TEST_F(DocumentTest, parallelRecomputeMixesWorkerAndSerialObjects)
+{
+    // Arrange
+    auto hGrp = App::GetApplication().GetParameterGroupByPath(
+        "User parameter:BaseApp/Preferences/Document");
+    auto base = freecad_cast<App::FeatureTestConcurrent*>(
+        doc()->addObject("App::FeatureTestConcurrent"));
+    auto failing = freecad_cast<App::FeatureTest*>(doc()->addObject("App::FeatureTestException"));
+    auto serial = freecad_cast<App::FeatureTest*>(doc()->addObject("App::FeatureTest"));
+    auto concurrent = freecad_cast<App::FeatureTestConcurrent*>(
+        doc()->addObject("App::FeatureTestConcurrent"));
+    auto top = freecad_cast<App::FeatureTestConcurrent*>(
+        doc()->addObject("App::FeatureTestConcurrent"));
+    failing->Source1.setValue(base);
+    serial->Source1.setValue(base);
+    concurrent->Source1.setValue(base);
+    top->Source1.setValue(failing);
+    top->Source2.setValue(concurrent);
+    bool hasError = false;
+
+    // Act
+    hGrp->SetBool("ParallelRecompute", true);
+    doc()->recompute({}, false, &hasError);
+    hGrp->RemoveBool("ParallelRecompute");
+
+    // Assert
+    EXPECT_TRUE(hasError);
+    EXPECT_TRUE(failing->isError());
+    EXPECT_STREQ(serial->ExecResult.getValue(), "Exec");
+    EXPECT_TRUE(concurrent->ComputedOnWorker.getValue());
+    EXPECT_EQ(concurrent->Integer.getValue(), 2);
+    EXPECT_STREQ(top->ExecResult.getValue(), "empty");
+}
+
+TEST_F(DocumentTest, getDependencyListFollowsLinkChanges)
+{
+    // Arrange
+    auto first = freecad_cast<App::FeatureTest*>(doc()->addObject("App::FeatureTest"));
+    auto second = freecad_cast<App::FeatureTest*>(doc()->addObject("App::FeatureTest"));
+    second->Source1.setValue(first);
+    auto before = App::Document::getDependencyList({second}, App::Document::DepSort);
+
+    // Act
+    second->Source1.setValue(nullptr);
+    first->Source1.setValue(second);
+    auto after = App::Document::getDependencyList({first, second}, App::Document::DepSort);
+
+    // Assert
+    EXPECT_EQ(before, (std::vector<App::DocumentObject*> {first, second}));
+    EXPECT_EQ(after, (std::vector<App::DocumentObject*> {second, first}));
+}
+
+TEST_F(DocumentTest, getDependencyListSurvivesAddRemoveCycles)
+{
+    // Arrange
+    auto first = freecad_cast<App::FeatureTest*>(doc()->addObject("App::FeatureTest"));
+    auto second = freecad_cast<App::FeatureTest*>(doc()->addObject("App::FeatureTest"));
+    second->Source1.setValue(first);
+    App::Document::getDependencyList({second}, App::Document::DepSort);
+
+    // Act
+    for (int i = 0; i < 200; ++i) {
+        auto temp = doc()->addObject("App::FeatureTest");
+        doc()->removeObject(temp->getNameInDocument());
+    }
+    auto third = freecad_cast<App::FeatureTest*>(doc()->addObject("App::FeatureTest"));
+    first->Source1.setValue(third);
+    auto deps = App::Document::getDependencyList({second}, App::Document::DepSort);
+
+    // Assert
+    EXPECT_EQ(deps, (std::vector<App::DocumentObject*> {third, first, second}));
+}
+
+TEST_F(DocumentTest, getDependencyListReportsCycle)
+{
+    // Arrange
+    auto first = freecad_cast<App::FeatureTest*>(doc()->addObject("App::FeatureTest"));
+    auto second = freecad_cast<App::FeatureTest*>(doc()->addObject("App::FeatureTest"));
+    second->Source1.setValue(first);
+    App::Document::getDependencyList({second}, App::Document::DepSort);
+
+    // Act
+    first->Source1.setValue(second);
+
+    // Assert
+    EXPECT_THROW(App::Document::getDependencyList({first},
+                                                  App::Document::DepSort
+                                                      | App::Document::DepNoCycle),
+                 Base::RuntimeError);
+}
+
 // NOLINTEND(readability-magic-numbers)
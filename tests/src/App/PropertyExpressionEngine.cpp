@@ -90,4 +90,30 @@ TEST_F(PropertyExpressionEngineTest, executeCrossPropertyReference)
     ;
 }
 
+TEST_F(PropertyExpressionEngineTest, executeReevaluatesChangedBindingsOnly)
+{
+    auto source_path = App::ObjectIdentifier::parse(this_obj(), source_name());
+    source_prop()->setPathValue(source_path, std::string("1.5 m"));
+
+    auto target_path = App::ObjectIdentifier::parse(this_obj(), target_name());
+    std::shared_ptr<App::Expression> target_rule(App::Expression::parse(this_obj(), "parsequant(" + source_name() + ")"));
+    this_obj()->setExpression(target_path, target_rule);
+    this_obj() -> ExpressionEngine.execute();
+
+    // unchanged inputs leave the bound property alone
+    auto stamp = target_prop() -> getChangeStamp();
+    this_obj() -> ExpressionEngine.execute();
+    EXPECT_EQ(target_prop() -> getChangeStamp(), stamp);
+
+    // a changed input is picked up
+    source_prop()->setPathValue(source_path, std::string("2 m"));
+    this_obj() -> ExpressionEngine.execute();
+    EXPECT_EQ(App::any_cast<Base::Quantity>(target_prop() -> getPathValue(target_path)), Base::Quantity::parse("2000 mm"));
+
+    // a changed bound property is reset to the value of the expression
+    target_prop()->setPathValue(target_path, Base::Quantity::parse("5 mm"));
+    this_obj() -> ExpressionEngine.execute();
+    EXPECT_EQ(App::any_cast<Base::Quantity>(target_prop() -> getPathValue(target_path)), Base::Quantity::parse("2000 mm"));
+}
+
 // clang-format on
@@ -7,13 +7,17 @@
 #endif
 
 #include "Base/Exception.h"
+#include "Base/Persistence.h"
 #include "Base/Reader.h"
+#include "Base/Writer.h"
 #include <array>
 #include <filesystem>
 #include <fstream>
 #include <random>
 #include <string>
 #include <xercesc/util/PlatformUtils.hpp>
+#include <zipios++/zipfile.h>
+#include <zipios++/zipinputstream.h>
 #include <QString>
 
 namespace fs = std::filesystem;
@@ -459,3 +463,115 @@ TEST_F(ReaderTest, validDefaults)
     EXPECT_THROW({ xml.Reader()->getAttribute<TimesIGoToBed>("missing"); }, Base::XMLBaseException);
     EXPECT_EQ(value20, TimesIGoToBed::Late);
 }
+
+TEST_F(ReaderTest, attributesOfCurrentElementOnly)
+{
+    // Arrange
+    auto xmlBody = R"(
+<node1 count='12' value='-2.5e1' text='Grüße' flag='1' padded=' 7'/>
+<node2 count='3'/>
+)";
+
+    ReaderXML xml;
+    xml.givenDataAsXMLStream(xmlBody);
+
+    // Act
+    xml.Reader()->readElement("node1");
+    auto count1 = xml.Reader()->getAttribute<long>("count");
+    auto value = xml.Reader()->getAttribute<double>("value");
+    std::string text = xml.Reader()->getAttribute<const char*>("text");
+    auto flag = xml.Reader()->getAttribute<bool>("flag");
+    auto padded = xml.Reader()->getAttribute<int>("padded");
+    auto countAttributes1 = xml.Reader()->getAttributeCount();
+    xml.Reader()->readElement("node2");
+    auto count2 = xml.Reader()->getAttribute<unsigned long>("count");
+    auto countAttributes2 = xml.Reader()->getAttributeCount();
+
+    // Assert
+    EXPECT_EQ(count1, 12);
+    EXPECT_DOUBLE_EQ(value, -25.0);
+    EXPECT_EQ(text, "Grüße");
+    EXPECT_TRUE(flag);
+    EXPECT_EQ(padded, 7);
+    EXPECT_EQ(countAttributes1, 5);
+    EXPECT_EQ(count2, 3);
+    EXPECT_EQ(countAttributes2, 1);
+    EXPECT_FALSE(xml.Reader()->hasAttribute("value"));
+}
+
+class DocFileRestore: public Base::Persistence
+{
+public:
+    DocFileRestore(std::string content, bool lazy)
+        : content(std::move(content))
+        , lazy(lazy)
+    {}
+    unsigned int getMemSize() const override
+    {
+        return static_cast<unsigned int>(content.size());
+    }
+    void Save(Base::Writer& /*writer*/) const override
+    {}
+    void Restore(Base::XMLReader& /*reader*/) override
+    {}
+    void SaveDocFile(Base::Writer& writer) const override
+    {
+        writer.Stream() << content;
+    }
+    void RestoreDocFile(Base::Reader& reader) override
+    {
+        content.assign(std::istreambuf_iterator<char>(reader), std::istreambuf_iterator<char>());
+    }
+    bool canRestoreDocFileLazily() const override
+    {
+        return lazy;
+    }
+    void setLazyDocFile(const std::shared_ptr<Base::LazyDocFile>& file) override
+    {
+        lazyFile = file;
+    }
+
+    std::string content;
+    bool lazy;
+    std::shared_ptr<Base::LazyDocFile> lazyFile;
+};
+
+TEST_F(ReaderTest, readFilesRestoresLazyFilesOnDemand)
+{
+    // Arrange
+    fs::path archive =
+        fs::temp_directory_path() / (std::string("unit_test_Reader-") + random_string(4) + ".zip");
+    DocFileRestore eagerOut("eager data", false);
+    DocFileRestore lazyOut("lazy data", true);
+    std::string eagerName;
+    std::string lazyName;
+    {
+        std::ofstream file(archive.string(), std::ios::out | std::ios::binary);
+        Base::ZipWriter writer(file);
+        writer.putNextEntry("Document.xml");
+        writer.Stream() << R"(<?xml version="1.0" encoding="UTF-8"?><Document/>)";
+        eagerName = writer.addFile("Eager.bin", &eagerOut);
+        lazyName = writer.addFile("Lazy.bin", &lazyOut);
+        writer.writeFiles();
+    }
+    DocFileRestore eagerIn("", false);
+    DocFileRestore lazyIn("", true);
+    {
+        std::ifstream file(archive.string(), std::ios::in | std::ios::binary);
+        zipios::ZipInputStream zipstream(file);
+        Base::XMLReader reader(archive.string().c_str(), zipstream);
+        reader.addFile(eagerName.c_str(), &eagerIn);
+        reader.addFile(lazyName.c_str(), &lazyIn);
+
+        // Act
+        reader.readFiles(std::make_shared<zipios::ZipFile>(archive.string()));
+    }
+
+    // Assert
+    EXPECT_EQ(eagerIn.content, "eager data");
+    EXPECT_TRUE(lazyIn.content.empty());
+    ASSERT_TRUE(lazyIn.lazyFile);
+    lazyIn.lazyFile->restore(&lazyIn);
+    EXPECT_EQ(lazyIn.content, "lazy data");
+    fs::remove(archive);
+}
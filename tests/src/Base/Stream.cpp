@@ -125,3 +125,46 @@ TEST_F(TextStreamIntegrationTest, OutputThenInputMultiLineWithCarriageReturns)
     // Assert
     EXPECT_EQ(multiLineStringResult, result);
 }
+
+TEST(BinaryStreamTest, writeArrayMatchesSingleValues)
+{
+    // Arrange
+    const std::vector<float> values {1.5F, -2.25F, 3.0F, 1.0e10F};
+    std::ostringstream single;
+    std::ostringstream block;
+    Base::OutputStream singleStream(single);
+    Base::OutputStream blockStream(block);
+    singleStream.setByteOrder(Base::Stream::BigEndian);
+    blockStream.setByteOrder(Base::Stream::BigEndian);
+
+    // Act
+    for (float value : values) {
+        singleStream << value;
+    }
+    blockStream.writeArray(values.data(), values.size());
+
+    // Assert
+    EXPECT_EQ(single.str(), block.str());
+}
+
+TEST(BinaryStreamTest, readArrayRestoresWrittenArray)
+{
+    // Arrange
+    std::vector<double> values(10000);
+    for (std::size_t i = 0; i < values.size(); i++) {
+        values[i] = 0.5 * static_cast<double>(i);
+    }
+    std::stringstream ss;
+    Base::OutputStream out(ss);
+    Base::InputStream in(ss);
+    out.setByteOrder(Base::Stream::BigEndian);
+    in.setByteOrder(Base::Stream::BigEndian);
+    std::vector<double> result(values.size());
+
+    // Act
+    out.writeArray(values.data(), values.size());
+    in.readArray(result.data(), result.size());
+
+    // Assert
+    EXPECT_EQ(values, result);
+}
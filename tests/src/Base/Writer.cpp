@@ -2,7 +2,10 @@
 
 #include <gtest/gtest.h>
 
+#include <zipios++/zipinputstream.h>
+
 #include "Base/Exception.h"
+#include "Base/Persistence.h"
 #include "Base/Writer.h"
 
 // Writer is designed to be a base class, so for testing we actually instantiate a StringWriter,
@@ -129,3 +132,135 @@ TEST_F(WriterTest, charStreamBase64Encoded)
     // Conversion done using https://www.base64encode.org for testing purposes
     EXPECT_EQ(std::string("RnJlZUNBRCByb2NrcyEg8J+qqPCfqqjwn6qo\n"), _writer.getString());
 }
+
+class DocFilePersistence: public Base::Persistence
+{
+public:
+    explicit DocFilePersistence(std::string content)
+        : content(std::move(content))
+    {}
+    unsigned int getMemSize() const override
+    {
+        return static_cast<unsigned int>(content.size());
+    }
+    void Save(Base::Writer& /*writer*/) const override
+    {}
+    void Restore(Base::XMLReader& /*reader*/) override
+    {}
+    void SaveDocFile(Base::Writer& writer) const override
+    {
+        writer.Stream() << content;
+    }
+
+private:
+    std::string content;
+};
+
+TEST(ZipWriterTest, writeFilesKeepsOrderAndContent)
+{
+    // Arrange
+    std::ostringstream archive;
+    std::vector<std::unique_ptr<DocFilePersistence>> objects;
+    std::vector<std::string> contents;
+    {
+        Base::ZipWriter writer(archive);
+        writer.setLevel(7);
+        writer.putNextEntry("Document.xml");
+        writer.Stream() << "<Document/>";
+        for (int i = 0; i < 20; ++i) {
+            contents.push_back(std::string(1000 * i, char('a' + i)) + std::to_string(i));
+            objects.push_back(std::make_unique<DocFilePersistence>(contents.back()));
+            writer.addFile("Data.bin", objects.back().get());
+        }
+
+        // Act
+        writer.writeFiles();
+    }
+
+    // Assert
+    std::istringstream input(archive.str());
+    zipios::ZipInputStream zipstream(input);
+    std::string document;
+    std::getline(zipstream, document);
+    EXPECT_EQ(document, "<Document/>");
+    for (const auto& content : contents) {
+        auto entry = zipstream.getNextEntry();
+        ASSERT_TRUE(entry->isValid());
+        std::string data((std::istreambuf_iterator<char>(zipstream)),
+                         std::istreambuf_iterator<char>());
+        EXPECT_EQ(data, content);
+    }
+}
+
+TEST(ZipWriterTest, writeFilesKeepsEntriesLargerThanPendingLimit)
+{
+    // Arrange
+    std::ostringstream archive;
+    std::vector<std::unique_ptr<DocFilePersistence>> objects;
+    std::vector<std::string> contents;
+    {
+        Base::ZipWriter writer(archive);
+        writer.setLevel(1);
+        writer.putNextEntry("Document.xml");
+        writer.Stream() << "<Document/>";
+        for (int i = 0; i < 3; ++i) {
+            contents.push_back(std::string(std::size_t(40) << 20, char('a' + i)));
+            objects.push_back(std::make_unique<DocFilePersistence>(contents.back()));
+            writer.addFile("Data.bin", objects.back().get());
+        }
+
+        // Act
+        writer.writeFiles();
+    }
+
+    // Assert
+    std::istringstream input(archive.str());
+    zipios::ZipInputStream zipstream(input);
+    std::string document;
+    std::getline(zipstream, document);
+    EXPECT_EQ(document, "<Document/>");
+    for (const auto& content : contents) {
+        auto entry = zipstream.getNextEntry();
+        ASSERT_TRUE(entry->isValid());
+        std::string data((std::istreambuf_iterator<char>(zipstream)),
+                         std::istreambuf_iterator<char>());
+        EXPECT_EQ(data, content);
+    }
+}
+
+TEST(ZipWriterTest, writeFilesStreamsLargeEntriesBetweenPendingOnes)
+{
+    // Arrange
+    std::ostringstream archive;
+    std::vector<std::unique_ptr<DocFilePersistence>> objects;
+    std::vector<std::string> contents;
+    {
+        Base::ZipWriter writer(archive);
+        writer.setLevel(1);
+        writer.putNextEntry("Document.xml");
+        writer.Stream() << "<Document/>";
+        for (int i = 0; i < 5; ++i) {
+            std::size_t size = i % 2 == 0 ? 1000 : std::size_t(20) << 20;
+            contents.push_back(std::string(size, char('a' + i)) + std::to_string(i));
+            objects.push_back(std::make_unique<DocFilePersistence>(contents.back()));
+            writer.addFile("Data.bin", objects.back().get());
+        }
+
+        // Act
+        writer.writeFiles();
+    }
+
+    // Assert
+    std::istringstream input(archive.str());
+    zipios::ZipInputStream zipstream(input);
+    std::string document;
+    std::getline(zipstream, document);
+    EXPECT_EQ(document, "<Document/>");
+    for (const auto& content : contents) {
+        auto entry = zipstream.getNextEntry();
+        ASSERT_TRUE(entry->isValid());
+        std::string data((std::istreambuf_iterator<char>(zipstream)),
+                         std::istreambuf_iterator<char>());
+        EXPECT_EQ(data, content);
+    }
+}
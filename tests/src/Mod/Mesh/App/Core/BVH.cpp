@@ -0,0 +1,120 @@
+#include <gtest/gtest.h>
+#include <Mod/Mesh/App/Core/Algorithm.h>
+#include <Mod/Mesh/App/Core/BVH.h>
+#include <Mod/Mesh/App/Core/MeshKernel.h>
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+
+class BVHTest: public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        // a dense strip next to a few large facets
+        std::vector<MeshCore::MeshGeomFacet> facets;
+        for (int i = 0; i < 200; i++) {
+            float x = float(i) * 0.01F;
+            Base::Vector3f p1(x, 0.0F, 0.0F);
+            Base::Vector3f p2(x + 0.01F, 0.0F, 0.0F);
+            Base::Vector3f p3(x, 0.01F, 0.0F);
+            Base::Vector3f p4(x + 0.01F, 0.01F, 0.0F);
+            facets.emplace_back(p1, p2, p3);
+            facets.emplace_back(p3, p2, p4);
+        }
+        Base::Vector3f q1(0, 1, 1);
+        Base::Vector3f q2(10, 1, 1);
+        Base::Vector3f q3(0, 10, 1);
+        Base::Vector3f q4(10, 10, 1);
+        Base::Vector3f up(0, 0, 4);
+        facets.emplace_back(q1, q2, q3);
+        facets.emplace_back(q2, q4, q3);
+        facets.emplace_back(q1 + up, q2 + up, q3 + up);
+        kernel = facets;
+    }
+
+    MeshCore::MeshKernel kernel;
+};
+
+TEST_F(BVHTest, TestEmpty)
+{
+    MeshCore::MeshKernel empty;
+    MeshCore::MeshFacetBVH bvh(empty);
+    EXPECT_TRUE(bvh.IsEmpty());
+
+    Base::Vector3f res;
+    MeshCore::FacetIndex index {};
+    Base::Vector3f dir(0, 0, 1);
+    EXPECT_FALSE(bvh.NearestFacetOnRay(Base::Vector3f(), dir, 4.0F, res, index));
+    EXPECT_FALSE(bvh.NearestPointFromPoint(Base::Vector3f(), 1.0e6F, index, res));
+}
+
+TEST_F(BVHTest, TestRayMatchesBruteForce)
+{
+    MeshCore::MeshFacetBVH bvh(kernel);
+    MeshCore::MeshAlgorithm alg(kernel);
+    EXPECT_FALSE(bvh.IsEmpty());
+
+    const Base::Vector3f dir(0.1F, 0.05F, 1.0F);
+    for (int i = 0; i < 50; i++) {
+        Base::Vector3f pnt(float(i) * 0.17F, float(i % 7) * 0.9F, 3.0F);
+        Base::Vector3f res1, res2;
+        MeshCore::FacetIndex index1 {}, index2 {};
+        bool hit1 = alg.NearestFacetOnRay(pnt, dir, MeshCore::Mathf::PI, res1, index1);
+        bool hit2 = bvh.NearestFacetOnRay(pnt, dir, MeshCore::Mathf::PI, res2, index2);
+        EXPECT_EQ(hit1, hit2);
+        if (hit1 && hit2) {
+            EXPECT_FLOAT_EQ(Base::Distance(pnt, res1), Base::Distance(pnt, res2));
+        }
+    }
+}
+
+TEST_F(BVHTest, TestPointMatchesBruteForce)
+{
+    MeshCore::MeshFacetBVH bvh(kernel);
+    MeshCore::MeshAlgorithm alg(kernel);
+
+    for (int i = 0; i < 50; i++) {
+        Base::Vector3f pnt(float(i) * 0.23F - 1.0F, float(i % 5) * 2.1F, float(i % 3) * 1.7F);
+        Base::Vector3f res1, res2;
+        MeshCore::FacetIndex index1 {}, index2 {};
+        EXPECT_TRUE(alg.NearestPointFromPoint(pnt, index1, res1));
+        EXPECT_TRUE(bvh.NearestPointFromPoint(pnt, 1.0e6F, index2, res2));
+        EXPECT_NEAR(Base::Distance(pnt, res1), Base::Distance(pnt, res2), 1.0e-5F);
+    }
+
+    Base::Vector3f res;
+    MeshCore::FacetIndex index {};
+    EXPECT_FALSE(bvh.NearestPointFromPoint(Base::Vector3f(50, 50, 50), 1.0F, index, res));
+}
+
+TEST_F(BVHTest, TestBatchedQueries)
+{
+    MeshCore::MeshFacetBVH bvh(kernel);
+
+    std::vector<MeshCore::MeshFacetBVH::Ray> rays;
+    std::vector<Base::Vector3f> points;
+    for (int i = 0; i < 5000; i++) {
+        Base::Vector3f pnt(float(i % 100) * 0.1F, float(i / 100) * 0.2F, 3.0F);
+        rays.emplace_back(pnt, Base::Vector3f(0, 0, -1));
+        points.push_back(pnt);
+    }
+
+    auto hits = bvh.NearestFacetsOnRays(rays, MeshCore::Mathf::PI);
+    auto proj = bvh.NearestPointsFromPoints(points, 1.0e6F);
+    ASSERT_EQ(hits.size(), rays.size());
+    ASSERT_EQ(proj.size(), points.size());
+    for (std::size_t i = 0; i < rays.size(); i++) {
+        Base::Vector3f res;
+        MeshCore::FacetIndex index {};
+        if (bvh.NearestFacetOnRay(rays[i].first, rays[i].second, MeshCore::Mathf::PI, res, index)) {
+            EXPECT_EQ(hits[i].first, index);
+        }
+        else {
+            EXPECT_EQ(hits[i].first, MeshCore::FACET_INDEX_MAX);
+        }
+        EXPECT_TRUE(bvh.NearestPointFromPoint(points[i], 1.0e6F, index, res));
+        EXPECT_EQ(proj[i].first, index);
+    }
+}
+
+// NOLINTEND(cppcoreguidelines-*,readability-*)
@@ -0,0 +1,110 @@
+#include <gtest/gtest.h>
+#include <Base/Matrix.h>
+#include <Mod/Mesh/App/Core/Boolean.h>
+#include <Mod/Mesh/App/Core/MeshKernel.h>
+#include "MeshTestHelpers.h"
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+
+using MeshTestHelpers::CreateBox;
+using MeshTestHelpers::IsSolid;
+
+class BooleanTest: public ::testing::Test
+{
+protected:
+    static MeshCore::MeshKernel Compute(const MeshCore::MeshKernel& mesh1,
+                                        const MeshCore::MeshKernel& mesh2,
+                                        MeshCore::SetOperations::OperationType type)
+    {
+        MeshCore::MeshKernel result;
+        MeshCore::MeshBoolean boolean(mesh1, mesh2, result, type);
+        boolean.Do();
+        return result;
+    }
+};
+
+TEST_F(BooleanTest, TestOverlappingBoxes)
+{
+    MeshCore::MeshKernel box1 = CreateBox(Base::Vector3f(0, 0, 0), Base::Vector3f(1, 1, 1));
+    MeshCore::MeshKernel box2 =
+        CreateBox(Base::Vector3f(0.5F, 0.5F, 0.5F), Base::Vector3f(1.5F, 1.5F, 1.5F));
+
+    MeshCore::MeshKernel result = Compute(box1, box2, MeshCore::SetOperations::Union);
+    EXPECT_TRUE(IsSolid(result));
+    EXPECT_NEAR(result.GetVolume(), 1.875F, 1.0e-5F);
+
+    result = Compute(box1, box2, MeshCore::SetOperations::Intersect);
+    EXPECT_TRUE(IsSolid(result));
+    EXPECT_NEAR(result.GetVolume(), 0.125F, 1.0e-5F);
+
+    result = Compute(box1, box2, MeshCore::SetOperations::Difference);
+    EXPECT_TRUE(IsSolid(result));
+    EXPECT_NEAR(result.GetVolume(), 0.875F, 1.0e-5F);
+}
+
+TEST_F(BooleanTest, TestCoplanarFaces)
+{
+    // four faces of the boxes are coplanar and the meshes have different tessellations
+    MeshCore::MeshKernel box1 = CreateBox(Base::Vector3f(0, 0, 0), Base::Vector3f(1, 1, 1), 3);
+    MeshCore::MeshKernel box2 =
+        CreateBox(Base::Vector3f(0.5F, 0, 0), Base::Vector3f(1.5F, 1, 1), 4);
+
+    MeshCore::MeshKernel result = Compute(box1, box2, MeshCore::SetOperations::Union);
+    EXPECT_TRUE(IsSolid(result));
+    EXPECT_NEAR(result.GetVolume(), 1.5F, 1.0e-5F);
+
+    result = Compute(box1, box2, MeshCore::SetOperations::Intersect);
+    EXPECT_TRUE(IsSolid(result));
+    EXPECT_NEAR(result.GetVolume(), 0.5F, 1.0e-5F);
+
+    result = Compute(box1, box2, MeshCore::SetOperations::Difference);
+    EXPECT_TRUE(IsSolid(result));
+    EXPECT_NEAR(result.GetVolume(), 0.5F, 1.0e-5F);
+}
+
+TEST_F(BooleanTest, TestIdenticalBoxes)
+{
+    MeshCore::MeshKernel box = CreateBox(Base::Vector3f(0, 0, 0), Base::Vector3f(1, 1, 1), 2);
+
+    MeshCore::MeshKernel result = Compute(box, box, MeshCore::SetOperations::Union);
+    EXPECT_TRUE(IsSolid(result));
+    EXPECT_NEAR(result.GetVolume(), 1.0F, 1.0e-5F);
+
+    result = Compute(box, box, MeshCore::SetOperations::Intersect);
+    EXPECT_NEAR(result.GetVolume(), 1.0F, 1.0e-5F);
+
+    result = Compute(box, box, MeshCore::SetOperations::Difference);
+    EXPECT_EQ(result.CountFacets(), 0);
+}
+
+TEST_F(BooleanTest, TestRotatedBox)
+{
+    MeshCore::MeshKernel box1 = CreateBox(Base::Vector3f(0, 0, 0), Base::Vector3f(1, 1, 1), 8);
+    MeshCore::MeshKernel box2 =
+        CreateBox(Base::Vector3f(-0.5F, -0.5F, -0.5F), Base::Vector3f(0.5F, 0.5F, 0.5F), 5);
+    Base::Matrix4D mat;
+    mat.rotZ(0.3);
+    mat.rotX(0.2);
+    mat.move(0.5, 0.5, 1.0);
+    box2.Transform(mat);
+
+    MeshCore::MeshKernel result = Compute(box1, box2, MeshCore::SetOperations::Union);
+    EXPECT_TRUE(IsSolid(result));
+    float unionVolume = result.GetVolume();
+
+    result = Compute(box1, box2, MeshCore::SetOperations::Intersect);
+    EXPECT_TRUE(IsSolid(result));
+    float intersectVolume = result.GetVolume();
+    EXPECT_NEAR(unionVolume + intersectVolume, 2.0F, 1.0e-4F);
+
+    result = Compute(box1, box2, MeshCore::SetOperations::Difference);
+    EXPECT_TRUE(IsSolid(result));
+    EXPECT_NEAR(result.GetVolume() + intersectVolume, 1.0F, 1.0e-4F);
+
+    result = Compute(box1, box2, MeshCore::SetOperations::Inner);
+    EXPECT_GT(result.CountFacets(), 0);
+    result = Compute(box1, box2, MeshCore::SetOperations::Outer);
+    EXPECT_GT(result.CountFacets(), 0);
+}
+
+// NOLINTEND(cppcoreguidelines-*,readability-*)
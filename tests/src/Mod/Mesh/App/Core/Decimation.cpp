@@ -0,0 +1,146 @@
+#include <gtest/gtest.h>
+#include <cfloat>
+#include <cmath>
+#include <Mod/Mesh/App/Core/Decimation.h>
+#include <Mod/Mesh/App/Core/Degeneration.h>
+#include <Mod/Mesh/App/Core/Evaluation.h>
+#include <Mod/Mesh/App/Core/MeshKernel.h>
+#include "MeshTestHelpers.h"
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+
+class DecimationTest: public ::testing::Test
+{
+protected:
+    // a grid over the unit square with a ridge along x = 0.5
+    void SetUp() override
+    {
+        kernel = MeshTestHelpers::MakeGrid(40, [](float x, float /*y*/) {
+            return 0.5F - std::fabs(x - 0.5F);
+        });
+    }
+
+    static float MaxDistance(const MeshCore::MeshKernel& original,
+                             const MeshCore::MeshKernel& decimated,
+                             std::size_t step = 1)
+    {
+        float maxDist = 0.0F;
+        const MeshCore::MeshPointArray& points = original.GetPoints();
+        for (std::size_t k = 0; k < points.size(); k += step) {
+            const auto& pnt = points[k];
+            float dist = FLT_MAX;
+            for (MeshCore::FacetIndex i = 0; i < decimated.CountFacets(); i++) {
+                dist = std::min(dist, decimated.GetFacet(i).DistanceToPoint(pnt));
+            }
+            maxDist = std::max(maxDist, dist);
+        }
+        return maxDist;
+    }
+
+    static bool IsValid(const MeshCore::MeshKernel& mesh)
+    {
+        float eps = MeshCore::MeshDefinitions::_fMinPointDistanceP2;
+        return MeshCore::MeshEvalTopology(mesh).Evaluate()
+            && MeshCore::MeshEvalOrientation(mesh).Evaluate()
+            && MeshCore::MeshEvalDegeneratedFacets(mesh, eps).Evaluate();
+    }
+
+    MeshCore::MeshKernel kernel;
+};
+
+TEST_F(DecimationTest, TestTargetSize)
+{
+    MeshCore::MeshDecimation dm(kernel);
+    dm.Decimate(200);
+    EXPECT_LE(kernel.CountFacets(), 200);
+    EXPECT_GT(kernel.CountFacets(), 100);
+    EXPECT_EQ(dm.GetOriginalFacets().size(), kernel.CountFacets());
+    EXPECT_TRUE(IsValid(kernel));
+
+    // the open border is kept
+    Base::BoundBox3f box = kernel.GetBoundBox();
+    EXPECT_FLOAT_EQ(box.MinX, 0.0F);
+    EXPECT_FLOAT_EQ(box.MaxX, 1.0F);
+    EXPECT_FLOAT_EQ(box.MinY, 0.0F);
+    EXPECT_FLOAT_EQ(box.MaxY, 1.0F);
+}
+
+TEST_F(DecimationTest, TestFeatureAngle)
+{
+    MeshCore::MeshDecimation dm(kernel);
+    dm.SetFeatureAngle(0.5F);
+    dm.Decimate(50);
+    EXPECT_TRUE(IsValid(kernel));
+
+    // all points lie on one of both planes
+    for (const auto& pnt : kernel.GetPoints()) {
+        EXPECT_NEAR(pnt.z, 0.5F - std::fabs(pnt.x - 0.5F), 1.0e-5F);
+    }
+}
+
+TEST_F(DecimationTest, TestMaxError)
+{
+    MeshCore::MeshKernel original = kernel;
+    const float maxError = 0.01F;
+    MeshCore::MeshDecimation dm(kernel);
+    dm.SetMaxError(maxError);
+    dm.Decimate(10);
+    EXPECT_GT(kernel.CountFacets(), 10);
+    EXPECT_TRUE(IsValid(kernel));
+
+    EXPECT_LE(MaxDistance(original, kernel), maxError * 1.001F);
+}
+
+TEST_F(DecimationTest, TestMaxErrorPartitioned)
+{
+    // enough facets to decimate several partitions concurrently in more than one pass, so
+    // that the error check handles locked points with already merged points
+    MeshCore::MeshKernel mesh = MeshTestHelpers::MakeGrid(150, [](float x, float y) {
+        return 0.1F * std::sin(6.0F * x) * std::cos(5.0F * y);
+    });
+    ASSERT_GT(mesh.CountFacets(), 40000);
+    MeshCore::MeshKernel original = mesh;
+    const float maxError = 0.002F;
+    MeshCore::MeshDecimation dm(mesh);
+    dm.SetMaxError(maxError);
+    dm.Decimate(100);
+    EXPECT_GT(mesh.CountFacets(), 100);
+    EXPECT_LT(mesh.CountFacets(), original.CountFacets() / 4);
+    EXPECT_TRUE(IsValid(mesh));
+    EXPECT_LE(MaxDistance(original, mesh, 7), maxError * 1.001F);
+}
+
+TEST_F(DecimationTest, TestSegments)
+{
+    std::vector<MeshCore::FacetIndex> segment;
+    for (MeshCore::FacetIndex i = 0; i < kernel.CountFacets(); i++) {
+        if (kernel.GetFacet(i).GetGravityPoint().y < 0.25F) {
+            segment.push_back(i);
+        }
+    }
+    std::vector<bool> inSegment(kernel.CountFacets(), false);
+    for (MeshCore::FacetIndex index : segment) {
+        inSegment[index] = true;
+    }
+
+    MeshCore::MeshDecimation dm(kernel);
+    dm.SetSegments({segment});
+    dm.Decimate(100);
+    EXPECT_TRUE(IsValid(kernel));
+
+    // the facets of the segment are still separated from the others at y = 0.25
+    const std::vector<MeshCore::FacetIndex>& origin = dm.GetOriginalFacets();
+    for (MeshCore::FacetIndex i = 0; i < kernel.CountFacets(); i++) {
+        MeshCore::MeshGeomFacet facet = kernel.GetFacet(i);
+        for (const auto& pnt : facet._aclPoints) {
+            if (inSegment[origin[i]]) {
+                EXPECT_LE(pnt.y, 0.25F + 1.0e-5F);
+            }
+            else {
+                EXPECT_GE(pnt.y, 0.25F - 1.0e-5F);
+            }
+        }
+    }
+}
+
+// NOLINTEND(cppcoreguidelines-*,readability-*)
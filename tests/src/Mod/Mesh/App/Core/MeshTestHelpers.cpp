@@ -0,0 +1,66 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <array>
+#include <map>
+#include <tuple>
+#include <vector>
+#include <Mod/Mesh/App/Core/Evaluation.h>
+#include "MeshTestHelpers.h"
+
+namespace MeshTestHelpers
+{
+
+MeshCore::MeshKernel CreateBox(const Base::Vector3f& min, const Base::Vector3f& max, int num)
+{
+    MeshCore::MeshPointArray points;
+    MeshCore::MeshFacetArray facets;
+    // the sides as corner and two directions whose cross product points outwards
+    Base::Vector3f size = max - min;
+    Base::Vector3f dx(size.x, 0, 0);
+    Base::Vector3f dy(0, size.y, 0);
+    Base::Vector3f dz(0, 0, size.z);
+    std::vector<std::array<Base::Vector3f, 3>> sides = {{min, dy, dx},
+                                                         {min + dz, dx, dy},
+                                                         {min, dx, dz},
+                                                         {min + dy, dz, dx},
+                                                         {min, dz, dy},
+                                                         {min + dx, dy, dz}};
+    // the points on the edges of the box are shared by the sides
+    std::map<std::tuple<float, float, float>, MeshCore::PointIndex> indices;
+    for (const auto& side : sides) {
+        std::vector<MeshCore::PointIndex> grid;
+        for (int j = 0; j <= num; j++) {
+            for (int i = 0; i <= num; i++) {
+                Base::Vector3f pnt =
+                    side[0] + side[1] * (float(i) / num) + side[2] * (float(j) / num);
+                auto it = indices.emplace(std::make_tuple(pnt.x, pnt.y, pnt.z),
+                                          MeshCore::PointIndex(points.size()));
+                if (it.second) {
+                    points.emplace_back(pnt);
+                }
+                grid.push_back(it.first->second);
+            }
+        }
+        auto index = [&grid, num](int i, int j) {
+            return grid[j * (num + 1) + i];
+        };
+        for (int j = 0; j < num; j++) {
+            for (int i = 0; i < num; i++) {
+                facets.emplace_back(index(i, j), index(i + 1, j), index(i + 1, j + 1));
+                facets.emplace_back(index(i, j), index(i + 1, j + 1), index(i, j + 1));
+            }
+        }
+    }
+
+    MeshCore::MeshKernel kernel;
+    kernel.Adopt(points, facets, true);
+    return kernel;
+}
+
+bool IsSolid(const MeshCore::MeshKernel& mesh)
+{
+    return MeshCore::MeshEvalSolid(mesh).Evaluate() && MeshCore::MeshEvalTopology(mesh).Evaluate()
+        && MeshCore::MeshEvalOrientation(mesh).Evaluate();
+}
+
+}  // namespace MeshTestHelpers
@@ -0,0 +1,57 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#pragma once
+
+#include <Base/Vector3D.h>
+#include <Mod/Mesh/App/Core/MeshKernel.h>
+
+namespace MeshTestHelpers
+{
+
+/**
+ * A closed box whose sides are split into num x num squares. The normals point outwards.
+ *
+ * @param min  The lower corner of the box
+ * @param max  The upper corner of the box
+ * @param num  The number of squares in each direction of a side
+ */
+MeshCore::MeshKernel CreateBox(const Base::Vector3f& min, const Base::Vector3f& max, int num = 1);
+
+/**
+ * Checks that the mesh is closed, has a valid topology and consistently oriented facets.
+ */
+bool IsSolid(const MeshCore::MeshKernel& mesh);
+
+/**
+ * A grid over the unit square with num x num squares, each split into two triangles.
+ *
+ * @param num     The number of squares in each direction
+ * @param height  The z coordinate of the point at (x, y)
+ */
+template<typename Func>
+MeshCore::MeshKernel MakeGrid(int num, Func height)
+{
+    MeshCore::MeshPointArray points;
+    MeshCore::MeshFacetArray facets;
+    for (int j = 0; j <= num; j++) {
+        for (int i = 0; i <= num; i++) {
+            float x = float(i) / num;
+            float y = float(j) / num;
+            points.emplace_back(x, y, height(x, y));
+        }
+    }
+    auto index = [num](int i, int j) {
+        return MeshCore::PointIndex(j * (num + 1) + i);
+    };
+    for (int j = 0; j < num; j++) {
+        for (int i = 0; i < num; i++) {
+            facets.emplace_back(index(i, j), index(i + 1, j), index(i + 1, j + 1));
+            facets.emplace_back(index(i, j), index(i + 1, j + 1), index(i, j + 1));
+        }
+    }
+    MeshCore::MeshKernel mesh;
+    mesh.Adopt(points, facets, true);
+    return mesh;
+}
+
+}  // namespace MeshTestHelpers
@@ -0,0 +1,148 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <Base/Exception.h>
+#include <Base/Matrix.h>
+#include <Mod/Mesh/App/Core/MeshIO.h>
+#include <Mod/Mesh/App/Core/MeshKernel.h>
+#include <Mod/Mesh/App/Core/OutOfCore.h>
+#include "MeshTestHelpers.h"
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+
+using MeshTestHelpers::CreateBox;
+using MeshTestHelpers::IsSolid;
+
+class OutOfCoreTest: public ::testing::Test
+{
+protected:
+    // a closed box over [0,1]^3 with each side split into num x num squares
+    void SetUp() override
+    {
+        kernel = CreateBox(Base::Vector3f(0, 0, 0), Base::Vector3f(1, 1, 1), 20);
+
+        std::string name = std::to_string(reinterpret_cast<std::uintptr_t>(this));
+        auto dir = std::filesystem::temp_directory_path();
+        input = (dir / ("outofcore_in_" + name + ".chunks")).string();
+        output = (dir / ("outofcore_out_" + name + ".chunks")).string();
+        mesh = (dir / ("outofcore_" + name + ".mesh")).string();
+    }
+
+    void TearDown() override
+    {
+        for (const auto& file : {input, output, mesh}) {
+            std::filesystem::remove(file);
+        }
+    }
+
+    MeshCore::MeshKernel ExportPLY(const std::string& file) const
+    {
+        std::ofstream str(mesh, std::ios::out | std::ios::binary);
+        EXPECT_TRUE(MeshCore::MeshOutOfCore::SaveBinaryPLY(file, str));
+        str.close();
+
+        MeshCore::MeshKernel result;
+        MeshCore::MeshInput reader(result);
+        std::ifstream ply(mesh, std::ios::in | std::ios::binary);
+        EXPECT_TRUE(reader.LoadPLY(ply));
+        return result;
+    }
+
+    MeshCore::MeshKernel kernel;
+    std::string input;
+    std::string output;
+    std::string mesh;
+};
+
+TEST_F(OutOfCoreTest, TestPartition)
+{
+    MeshCore::MeshOutOfCore::Partition(kernel, input, 500);
+    ASSERT_TRUE(MeshCore::MeshChunkFile::IsChunkFile(input));
+
+    MeshCore::MeshChunkFile file(input);
+    EXPECT_GT(file.CountChunks(), 4);
+    EXPECT_EQ(file.CountFacets(), kernel.CountFacets());
+
+    MeshCore::MeshKernel chunk;
+    for (std::size_t i = 0; i < file.CountChunks(); i++) {
+        file.Read(i, chunk);
+        EXPECT_EQ(chunk.CountFacets(), file.GetChunk(i).countFacets);
+        EXPECT_LE(chunk.CountFacets(), 1000);
+    }
+}
+
+TEST_F(OutOfCoreTest, TestPartitionRemovesTemporaryFile)
+{
+    MeshCore::MeshOutOfCore::Partition(kernel, input, 500);
+    EXPECT_TRUE(std::filesystem::exists(input));
+    EXPECT_FALSE(std::filesystem::exists(input + ".part"));
+}
+
+TEST_F(OutOfCoreTest, TestExportPLY)
+{
+    MeshCore::MeshOutOfCore::Partition(kernel, input, 500);
+
+    // the points on the borders of the chunks are merged again
+    MeshCore::MeshKernel result = ExportPLY(input);
+    EXPECT_EQ(result.CountPoints(), kernel.CountPoints());
+    EXPECT_EQ(result.CountFacets(), kernel.CountFacets());
+    EXPECT_TRUE(IsSolid(result));
+    EXPECT_NEAR(result.GetVolume(), 1.0F, 1.0e-4F);
+}
+
+TEST_F(OutOfCoreTest, TestExportSTL)
+{
+    MeshCore::MeshOutOfCore::Partition(kernel, input, 500);
+    {
+        std::ofstream str(mesh, std::ios::out | std::ios::binary);
+        EXPECT_TRUE(MeshCore::MeshOutOfCore::SaveBinarySTL(input, str));
+    }
+    EXPECT_EQ(std::filesystem::file_size(mesh), 84 + 50 * kernel.CountFacets());
+
+    // an STL file can be split into chunks directly
+    MeshCore::MeshOutOfCore::Partition(mesh, output, 1000);
+    MeshCore::MeshKernel result = ExportPLY(output);
+    EXPECT_EQ(result.CountPoints(), kernel.CountPoints());
+    EXPECT_TRUE(IsSolid(result));
+}
+
+TEST_F(OutOfCoreTest, TestTransform)
+{
+    MeshCore::MeshOutOfCore::Partition(kernel, input, 500);
+
+    Base::Matrix4D mat;
+    mat.move(Base::Vector3d(1.0, 2.0, 3.0));
+    MeshCore::MeshOutOfCore::Process(input, output, MeshCore::MeshOutOfCore::Transform(mat));
+
+    MeshCore::MeshKernel result = ExportPLY(output);
+    Base::BoundBox3f box = result.GetBoundBox();
+    EXPECT_FLOAT_EQ(box.MinX, 1.0F);
+    EXPECT_FLOAT_EQ(box.MinY, 2.0F);
+    EXPECT_FLOAT_EQ(box.MinZ, 3.0F);
+    EXPECT_TRUE(IsSolid(result));
+}
+
+TEST_F(OutOfCoreTest, TestDecimate)
+{
+    MeshCore::MeshOutOfCore::Partition(kernel, input, 500);
+    MeshCore::MeshOutOfCore::Process(input,
+                                     output,
+                                     MeshCore::MeshOutOfCore::Decimate(0.5F, 0.0F));
+
+    // the chunks still fit together
+    MeshCore::MeshKernel result = ExportPLY(output);
+    EXPECT_LT(result.CountFacets(), kernel.CountFacets());
+    EXPECT_TRUE(IsSolid(result));
+    EXPECT_NEAR(result.GetVolume(), 1.0F, 1.0e-4F);
+}
+
+TEST_F(OutOfCoreTest, TestSameFile)
+{
+    MeshCore::MeshOutOfCore::Partition(kernel, input, 500);
+    EXPECT_THROW(MeshCore::MeshOutOfCore::Process(input, input, MeshCore::MeshOutOfCore::Cleanup()),
+                 Base::FileException);
+}
+
+// NOLINTEND(cppcoreguidelines-*,readability-*)
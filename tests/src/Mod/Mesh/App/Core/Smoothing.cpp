@@ -0,0 +1,119 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <Mod/Mesh/App/Core/Algorithm.h>
+#include <Mod/Mesh/App/Core/MeshKernel.h>
+#include <Mod/Mesh/App/Core/Smoothing.h>
+#include "MeshTestHelpers.h"
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+
+class SmoothingTest: public ::testing::Test
+{
+protected:
+    // a grid over the unit square with alternating heights of +/- 0.01
+    void SetUp() override
+    {
+        kernel = MeshTestHelpers::MakeGrid(num, [](float x, float y) {
+            return std::lround((x + y) * num) % 2 == 0 ? 0.01F : -0.01F;
+        });
+    }
+
+    static MeshCore::PointIndex Index(int i, int j)
+    {
+        return MeshCore::PointIndex(j * (num + 1) + i);
+    }
+
+    static bool IsBorder(MeshCore::PointIndex index)
+    {
+        int i = int(index) % (num + 1);
+        int j = int(index) / (num + 1);
+        return i == 0 || j == 0 || i == num || j == num;
+    }
+
+    // the largest height of the inner points
+    float MaxHeight() const
+    {
+        float height = 0.0F;
+        const MeshCore::MeshPointArray& points = kernel.GetPoints();
+        for (std::size_t i = 0; i < points.size(); i++) {
+            if (!IsBorder(i)) {
+                height = std::max(height, std::fabs(points[i].z));
+            }
+        }
+        return height;
+    }
+
+    static constexpr int num = 30;
+    MeshCore::MeshKernel kernel;
+};
+
+TEST_F(SmoothingTest, TestCompactAdjacency)
+{
+    MeshCore::MeshRefPointToPoints vv(kernel);
+    MeshCore::MeshRefPointToFacets vf(kernel);
+    MeshCore::MeshRefFacetToFacets ff(kernel);
+    MeshCore::MeshCompactAdjacency cvv(kernel, MeshCore::MeshCompactAdjacency::PointToPoints);
+    MeshCore::MeshCompactAdjacency cvf(kernel, MeshCore::MeshCompactAdjacency::PointToFacets);
+    MeshCore::MeshCompactAdjacency cff(kernel, MeshCore::MeshCompactAdjacency::FacetToFacets);
+
+    ASSERT_EQ(cvv.Size(), kernel.CountPoints());
+    ASSERT_EQ(cvf.Size(), kernel.CountPoints());
+    ASSERT_EQ(cff.Size(), kernel.CountFacets());
+    for (MeshCore::PointIndex i = 0; i < kernel.CountPoints(); i++) {
+        EXPECT_TRUE(std::ranges::equal(cvv[i], vv[i]));
+        EXPECT_TRUE(std::ranges::equal(cvf[i], vf[i]));
+        EXPECT_EQ(cvf.CountNeighbours(i), vf[i].size());
+    }
+    for (MeshCore::FacetIndex i = 0; i < kernel.CountFacets(); i++) {
+        EXPECT_TRUE(std::ranges::equal(cff[i], ff[i]));
+    }
+}
+
+TEST_F(SmoothingTest, TestLaplace)
+{
+    MeshCore::MeshPointArray points = kernel.GetPoints();
+    MeshCore::LaplaceSmoothing smooth(kernel);
+    smooth.Smooth(10);
+    EXPECT_LT(MaxHeight(), 0.005F);
+
+    // border points are kept
+    for (std::size_t i = 0; i < points.size(); i++) {
+        if (IsBorder(i)) {
+            EXPECT_EQ(kernel.GetPoint(i), points[i]);
+        }
+    }
+}
+
+TEST_F(SmoothingTest, TestTaubin)
+{
+    MeshCore::TaubinSmoothing smooth(kernel);
+    smooth.Smooth(10);
+    EXPECT_LT(MaxHeight(), 0.005F);
+}
+
+TEST_F(SmoothingTest, TestMedianFilter)
+{
+    MeshCore::MedianFilterSmoothing smooth(kernel);
+    smooth.Smooth(5);
+    EXPECT_LT(MaxHeight(), 0.01F);
+}
+
+TEST_F(SmoothingTest, TestSmoothPoints)
+{
+    MeshCore::MeshPointArray points = kernel.GetPoints();
+    std::vector<MeshCore::PointIndex> indices {Index(10, 10), Index(11, 10), Index(10, 10)};
+    MeshCore::LaplaceSmoothing smooth(kernel);
+    smooth.SmoothPoints(4, indices);
+
+    for (std::size_t i = 0; i < points.size(); i++) {
+        if (i == Index(10, 10) || i == Index(11, 10)) {
+            EXPECT_LT(std::fabs(kernel.GetPoint(i).z), 0.01F);
+        }
+        else {
+            EXPECT_EQ(kernel.GetPoint(i), points[i]);
+        }
+    }
+}
+
+// NOLINTEND(cppcoreguidelines-*,readability-*)
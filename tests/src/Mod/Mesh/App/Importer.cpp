@@ -1,6 +1,12 @@
 #include <gtest/gtest.h>
 #include <Base/FileInfo.h>
+#include <Base/Stream.h>
+#include <Mod/Mesh/App/Core/IO/LineParser.h>
 #include <Mod/Mesh/App/Core/IO/Reader3MF.h>
+#include <Mod/Mesh/App/Core/IO/ReaderOBJ.h>
+#include <Mod/Mesh/App/Core/MeshIO.h>
+#include <array>
+#include <sstream>
 #include <xercesc/util/PlatformUtils.hpp>
 #include <zipios++/fcoll.h>
 
@@ -11,6 +17,92 @@ protected:
     {
         XERCES_CPP_NAMESPACE::XMLPlatformUtils::Initialize();
     }
+
+    // A grid of quads split into triangles, one group per row. The faces use
+    // relative indices and the lines have different lengths so that chunk
+    // boundaries fall into the middle of lines.
+    static std::string makeOBJ(int size)
+    {
+        std::ostringstream str;
+        str << "# grid with " << size << " x " << size << " points\n";
+        for (int i = 0; i < size; i++) {
+            for (int j = 0; j < size; j++) {
+                str << "v " << j << ".125 " << i << " " << (i * j) % 7 << "\n";
+            }
+        }
+        for (int i = 0; i + 1 < size; i++) {
+            str << "g row" << i << "\n";
+            for (int j = 0; j + 1 < size; j++) {
+                int p = i * size + j + 1;
+                str << "f " << p << " " << p + 1 << " " << p + size + 1 << "\n";
+                str << "f " << p - size * size - 1 << " " << p + size + 1 - size * size - 1 << " "
+                    << p + size - size * size - 1 << "\n";
+            }
+        }
+        return str.str();
+    }
+
+    static std::string makeOFF(int size)
+    {
+        std::ostringstream str;
+        str << "OFF\n" << size * size << " " << 2 * (size - 1) * (size - 1) << " 0\n";
+        for (int i = 0; i < size; i++) {
+            for (int j = 0; j < size; j++) {
+                str << j << ".125 " << i << " " << (i * j) % 7 << "\n";
+            }
+        }
+        for (int i = 0; i + 1 < size; i++) {
+            for (int j = 0; j + 1 < size; j++) {
+                int p = i * size + j;
+                str << "3 " << p << " " << p + 1 << " " << p + size + 1 << " 255 0 " << j % 256
+                    << "\n";
+                str << "3 " << p << " " << p + size + 1 << " " << p + size << " 0 255 0\n";
+            }
+        }
+        return str.str();
+    }
+
+    static std::string makeSTL(int size)
+    {
+        auto vertex = [size](std::ostringstream& str, int p) {
+            int i = p / size;
+            int j = p % size;
+            str << "      vertex " << j << ".125 " << i << " " << (i * j) % 7 << "\n";
+        };
+        std::ostringstream str;
+        str << "solid grid\n";
+        for (int i = 0; i + 1 < size; i++) {
+            for (int j = 0; j + 1 < size; j++) {
+                int p = i * size + j;
+                for (const auto& facet : {std::array<int, 3> {p, p + 1, p + size + 1},
+                                          std::array<int, 3> {p, p + size + 1, p + size}}) {
+                    str << "  facet normal 0 0 1\n    outer loop\n";
+                    for (int index : facet) {
+                        vertex(str, index);
+                    }
+                    str << "    endloop\n  endfacet\n";
+                }
+            }
+        }
+        str << "endsolid grid\n";
+        return str.str();
+    }
+
+    static void expectSameMesh(const MeshCore::MeshKernel& mesh1,
+                               const MeshCore::MeshKernel& mesh2)
+    {
+        ASSERT_EQ(mesh1.CountPoints(), mesh2.CountPoints());
+        ASSERT_EQ(mesh1.CountFacets(), mesh2.CountFacets());
+        for (std::size_t i = 0; i < mesh1.CountPoints(); i++) {
+            EXPECT_EQ(mesh1.GetPoint(i), mesh2.GetPoint(i));
+        }
+        for (std::size_t i = 0; i < mesh1.CountFacets(); i++) {
+            for (int j = 0; j < 3; j++) {
+                EXPECT_EQ(mesh1.GetFacets()[i]._aulPoints[j], mesh2.GetFacets()[i]._aulPoints[j]);
+            }
+            EXPECT_EQ(mesh1.GetFacets()[i]._ulProp, mesh2.GetFacets()[i]._ulProp);
+        }
+    }
 };
 
 // NOLINTBEGIN(cppcoreguidelines-*,readability-*)
@@ -37,4 +129,143 @@ TEST_F(ImporterTest, Test3MF)
     EXPECT_EQ(mesh2.CountEdges(), 1950);
     EXPECT_EQ(mesh2.CountFacets(), 1300);
 }
+
+TEST_F(ImporterTest, TestOBJ)
+{
+    std::stringstream str;
+    str << "mtllib box.mtl\n"
+        << "v 0 0 0\nv 1 0 0\nv 1 1 0\nv 0 1 0\n"
+        << "g bottom\n"
+        << "usemtl red\n"
+        << "f 1/1/1 2/2/1 3/3/1 4/4/1\n"
+        << "v 0 0 1\n"
+        << "g side\n"
+        << "usemtl green\n"
+        << "f 1 2 -1\n";
+
+    MeshCore::MeshKernel kernel;
+    MeshCore::Material mat;
+    MeshCore::ReaderOBJ reader(kernel, &mat);
+    EXPECT_EQ(reader.Load(str), true);
+    EXPECT_EQ(kernel.CountPoints(), 5);
+    EXPECT_EQ(kernel.CountFacets(), 3);
+    EXPECT_EQ(kernel.GetFacets()[2]._aulPoints[2], 4);
+    EXPECT_EQ(kernel.GetFacets()[1]._ulProp, 1);
+    EXPECT_EQ(kernel.GetFacets()[2]._ulProp, 2);
+    EXPECT_EQ(reader.GetGroupNames(), std::vector<std::string>({"bottom", "side"}));
+    EXPECT_EQ(mat.library, "box.mtl");
+    EXPECT_EQ(mat.binding, MeshCore::MeshIO::PER_FACE);
+    EXPECT_EQ(mat.diffuseColor.size(), 3);
+}
+
+TEST_F(ImporterTest, TestOFF)
+{
+    std::stringstream str;
+    str << "OFF\n"
+        << "4 2 0\n"
+        << "0 0 0\n1 0 0\n\n1 1 0\n0 1 0\n"
+        << "4 0 1 2 3 255 0 0\n"
+        << "3 0 2 3 0 1 0\n"
+        << "3 1 2 3\n";
+
+    MeshCore::MeshKernel kernel;
+    MeshCore::Material mat;
+    MeshCore::MeshInput input(kernel, &mat);
+    EXPECT_EQ(input.LoadOFF(str), true);
+    EXPECT_EQ(kernel.CountPoints(), 4);
+    EXPECT_EQ(kernel.CountFacets(), 3);
+    EXPECT_EQ(mat.binding, MeshCore::MeshIO::PER_FACE);
+    ASSERT_EQ(mat.diffuseColor.size(), 3);
+    EXPECT_EQ(mat.diffuseColor[2], Base::Color(0.0F, 1.0F, 0.0F));
+}
+
+TEST_F(ImporterTest, SplitEndsChunksAtLines)
+{
+    std::string data = makeOBJ(10);
+
+    auto parts = MeshCore::LineParser::Split(data, 64);
+
+    EXPECT_GT(parts.size(), 1);
+    std::string joined;
+    for (auto part : parts) {
+        EXPECT_EQ(part.back(), '\n');
+        joined.append(part);
+    }
+    EXPECT_EQ(joined, data);
+}
+
+TEST_F(ImporterTest, TestOBJChunks)
+{
+    std::string data = makeOBJ(30);
+    ASSERT_GT(MeshCore::LineParser::Split(data, 64).size(), 1);
+
+    MeshCore::MeshKernel whole;
+    MeshCore::ReaderOBJ reader1(whole, nullptr);
+    std::stringstream str1(data);
+    EXPECT_EQ(reader1.Load(str1), true);
+
+    MeshCore::MeshKernel chunked;
+    MeshCore::ReaderOBJ reader2(chunked, nullptr);
+    reader2.SetChunkSize(64);
+    std::stringstream str2(data);
+    EXPECT_EQ(reader2.Load(str2), true);
+
+    EXPECT_EQ(chunked.CountPoints(), 900);
+    EXPECT_EQ(chunked.CountFacets(), 2 * 29 * 29);
+    EXPECT_EQ(reader2.GetGroupNames().size(), 29);
+    EXPECT_EQ(reader2.GetGroupNames(), reader1.GetGroupNames());
+    expectSameMesh(whole, chunked);
+}
+
+TEST_F(ImporterTest, TestOFFChunks)
+{
+    std::string data = makeOFF(30);
+
+    MeshCore::MeshKernel whole;
+    MeshCore::Material mat1;
+    MeshCore::MeshInput input1(whole, &mat1);
+    std::stringstream str1(data);
+    EXPECT_EQ(input1.LoadOFF(str1), true);
+
+    MeshCore::MeshKernel chunked;
+    MeshCore::Material mat2;
+    MeshCore::MeshInput input2(chunked, &mat2);
+    input2.SetChunkSize(64);
+    std::stringstream str2(data);
+    EXPECT_EQ(input2.LoadOFF(str2), true);
+
+    EXPECT_EQ(chunked.CountPoints(), 900);
+    EXPECT_EQ(chunked.CountFacets(), 2 * 29 * 29);
+    expectSameMesh(whole, chunked);
+    EXPECT_EQ(mat2.binding, MeshCore::MeshIO::PER_FACE);
+    EXPECT_EQ(mat2.diffuseColor, mat1.diffuseColor);
+}
+
+TEST_F(ImporterTest, LoadAnyMapsOBJOFFAndSTL)
+{
+    for (const auto& [ext, data] : {std::make_pair(".obj", makeOBJ(20)),
+                                    std::make_pair(".off", makeOFF(20)),
+                                    std::make_pair(".stl", makeSTL(20))}) {
+        Base::FileInfo fi(Base::FileInfo::getTempFileName() + ext);
+        {
+            Base::ofstream file(fi, std::ios::out | std::ios::binary);
+            file << data;
+        }
+
+        MeshCore::MeshKernel mapped;
+        MeshCore::MeshInput input1(mapped);
+        input1.SetChunkSize(100);
+        EXPECT_EQ(input1.LoadAny(fi.filePath().c_str()), true);
+
+        MeshCore::MeshKernel streamed;
+        MeshCore::MeshInput input2(streamed);
+        std::stringstream str(data);
+        auto format = MeshCore::MeshInput::getFormat((std::string("mesh") + ext).c_str());
+        EXPECT_EQ(input2.LoadFormat(str, format), true);
+        fi.deleteFile();
+
+        EXPECT_EQ(mapped.CountPoints(), 400);
+        expectSameMesh(streamed, mapped);
+    }
+}
 // NOLINTEND(cppcoreguidelines-*,readability-*)
@@ -1,5 +1,8 @@
 #include <gtest/gtest.h>
+#include <algorithm>
 #include <Mod/Mesh/App/Mesh.h>
+#include <Mod/Mesh/App/Core/Algorithm.h>
+#include <Mod/Mesh/App/Core/Evaluation.h>
 #include <Mod/Mesh/App/Core/Grid.h>
 
 // NOLINTBEGIN(cppcoreguidelines-*,readability-*)
@@ -95,4 +98,94 @@ TEST(MeshTest, TestGrid2OfAlmostPlanarMesh)
     EXPECT_EQ(countY, 1);
     EXPECT_EQ(countZ, 1);
 }
+TEST(MeshTest, TestGridElementsOfLargeMesh)
+{
+    // big enough to fill the grid with more than one thread
+    const int size = 300;
+    std::vector<MeshCore::MeshGeomFacet> facets;
+    facets.reserve(2 * size * size);
+    for (int i = 0; i < size; i++) {
+        for (int j = 0; j < size; j++) {
+            Base::Vector3f p1(float(i), float(j), 0);
+            Base::Vector3f p2(float(i + 1), float(j), 0);
+            Base::Vector3f p3(float(i), float(j + 1), 0);
+            Base::Vector3f p4(float(i + 1), float(j + 1), 0);
+            facets.emplace_back(p1, p2, p3);
+            facets.emplace_back(p3, p2, p4);
+        }
+    }
+
+    MeshCore::MeshKernel kernel;
+    kernel = facets;
+    MeshCore::MeshFacetGrid grid(kernel, 20);
+
+    unsigned long countX {};
+    unsigned long countY {};
+    unsigned long countZ {};
+    grid.GetCtGrids(countX, countY, countZ);
+
+    std::vector<int> found(kernel.CountFacets());
+    for (unsigned long x = 0; x < countX; x++) {
+        for (unsigned long y = 0; y < countY; y++) {
+            for (unsigned long z = 0; z < countZ; z++) {
+                auto cell = grid.GetCell(x, y, z);
+                EXPECT_TRUE(std::is_sorted(cell.begin(), cell.end()));
+                EXPECT_EQ(std::adjacent_find(cell.begin(), cell.end()), cell.end());
+                for (auto index : cell) {
+                    found[index]++;
+                }
+            }
+        }
+    }
+
+    EXPECT_EQ(std::count(found.begin(), found.end(), 0), 0);
+
+    std::vector<MeshCore::ElementIndex> elements;
+    Base::Vector3f center = kernel.GetFacet(1000).GetGravityPoint();
+    grid.GetElements(center, elements);
+    EXPECT_NE(std::find(elements.begin(), elements.end(), 1000), elements.end());
+}
+TEST(MeshTest, TestOrientationDoesNotTouchFlags)
+{
+    MeshCore::MeshPointArray points;
+    points.emplace_back(0, 0, 0);
+    points.emplace_back(1, 0, 0);
+    points.emplace_back(0, 1, 0);
+    points.emplace_back(1, 1, 0);
+    points.emplace_back(2, 0, 0);
+    MeshCore::MeshFacetArray facets;
+    facets.emplace_back(0, 1, 2);
+    facets.emplace_back(2, 1, 3);
+    facets.emplace_back(1, 3, 4);  // wrong orientation
+    MeshCore::MeshKernel kernel;
+    kernel.Assign(points, facets);
+
+    MeshCore::MeshAlgorithm alg(kernel);
+    alg.SetFacetFlag(MeshCore::MeshFacet::VISIT);
+
+    std::vector<MeshCore::FacetIndex> indices = MeshCore::MeshEvalOrientation(kernel).GetIndices();
+    ASSERT_EQ(indices.size(), 1);
+    EXPECT_EQ(indices.front(), 2);
+    EXPECT_EQ(alg.CountFacetFlag(MeshCore::MeshFacet::VISIT), 3);
+    EXPECT_EQ(alg.CountFacetFlag(MeshCore::MeshFacet::TMP0), 0);
+}
+
+TEST(MeshTest, TestVisitWithFlagTable)
+{
+    MeshCore::MeshKernel kernel;
+    Base::Vector3f p1 {0, 0, 0};
+    Base::Vector3f p2 {1, 0, 0};
+    Base::Vector3f p3 {0, 1, 0};
+    Base::Vector3f p4 {1, 1, 0};
+    kernel.AddFacet(MeshCore::MeshGeomFacet(p1, p2, p3));
+    kernel.AddFacet(MeshCore::MeshGeomFacet(p3, p2, p4));
+
+    std::vector<MeshCore::FacetIndex> indices;
+    MeshCore::MeshSameOrientationCollector collect(indices);
+    MeshCore::MeshFlagTable visited(kernel.CountFacets());
+    EXPECT_EQ(kernel.VisitNeighbourFacets(collect, 0, visited), 1);
+    EXPECT_EQ(visited.Count(), 2);
+    EXPECT_EQ(visited.FindFirstUnset(), MeshCore::FACET_INDEX_MAX);
+    EXPECT_EQ(MeshCore::MeshAlgorithm(kernel).CountFacetFlag(MeshCore::MeshFacet::VISIT), 0);
+}
 // NOLINTEND(cppcoreguidelines-*,readability-*)
@@ -1,6 +1,13 @@
 #include "gtest/gtest.h"
+#include <set>
+#include <thread>
 #include <src/App/InitApplication.h>
+#include <App/Application.h>
+#include <App/Document.h>
+#include <Base/Interpreter.h>
+#include <Mod/Mesh/App/FeatureMeshDefects.h>
 #include <Mod/Mesh/App/MeshFeature.h>
+#include <Mod/Mesh/App/MeshProperties.h>
 
 class MeshFeatureTest: public ::testing::Test
 {
@@ -17,6 +24,36 @@ protected:
     {}
 };
 
+class MeshFeatureDocumentTest: public ::testing::Test
+{
+protected:
+    static void SetUpTestSuite()
+    {
+        tests::initApplication();
+        Base::Interpreter().runString("import Mesh");
+    }
+
+    void SetUp() override
+    {
+        _docName = App::GetApplication().getUniqueDocumentName("test");
+        _doc = App::GetApplication().newDocument(_docName.c_str(), "testUser");
+    }
+
+    void TearDown() override
+    {
+        App::GetApplication().closeDocument(_docName.c_str());
+    }
+
+    App::Document* doc()
+    {
+        return _doc;
+    }
+
+private:
+    std::string _docName;
+    App::Document* _doc {};
+};
+
 // NOLINTBEGIN(cppcoreguidelines-*,readability-*)
 TEST_F(MeshFeatureTest, getElementTypes)
 {
@@ -37,4 +74,78 @@ TEST_F(MeshFeatureTest, getComplexElementTypes)
     EXPECT_STREQ(types[0], "Mesh");
     EXPECT_STREQ(types[1], "Segment");
 }
+
+TEST_F(MeshFeatureTest, copyOfMeshPropertySharesMeshUntilModified)
+{
+    Mesh::PropertyMeshKernel prop;
+    Mesh::MeshObject mesh;
+    mesh.addFacet(MeshCore::MeshGeomFacet(Base::Vector3f(0, 0, 0),
+                                          Base::Vector3f(1, 0, 0),
+                                          Base::Vector3f(0, 1, 0)));
+    prop.setValue(mesh);
+
+    std::unique_ptr<App::Property> copy(prop.Copy());
+    auto copied = static_cast<Mesh::PropertyMeshKernel*>(copy.get());
+    EXPECT_EQ(copied->getValuePtr(), prop.getValuePtr());
+
+    prop.startEditing()->clear();
+    prop.finishEditing();
+
+    EXPECT_NE(copied->getValuePtr(), prop.getValuePtr());
+    EXPECT_EQ(copied->getValue().countFacets(), 1);
+    EXPECT_EQ(prop.getValue().countFacets(), 0);
+
+    prop.Paste(*copied);
+    EXPECT_EQ(copied->getValuePtr(), prop.getValuePtr());
+    EXPECT_EQ(prop.getValue().countFacets(), 1);
+}
+
+TEST_F(MeshFeatureDocumentTest, parallelRecomputeFixesMeshes)
+{
+    auto hGrp = App::GetApplication().GetParameterGroupByPath(
+        "User parameter:BaseApp/Preferences/Document");
+    auto source = freecad_cast<Mesh::Feature*>(doc()->addObject("Mesh::Feature", "Source"));
+    Mesh::MeshObject mesh;
+    mesh.addFacet(MeshCore::MeshGeomFacet(Base::Vector3f(0, 0, 0),
+                                          Base::Vector3f(1, 0, 0),
+                                          Base::Vector3f(0, 1, 0)));
+    mesh.addFacet(MeshCore::MeshGeomFacet(Base::Vector3f(5, 0, 0),
+                                          Base::Vector3f(6, 0, 0),
+                                          Base::Vector3f(5, 1, 0)));
+    source->Mesh.setValue(mesh);
+
+    // two independent features on the first level and one depending on both of them
+    auto flip = freecad_cast<Mesh::FlipNormals*>(doc()->addObject("Mesh::FlipNormals", "Flip"));
+    auto harmonize =
+        freecad_cast<Mesh::HarmonizeNormals*>(doc()->addObject("Mesh::HarmonizeNormals", "Fix"));
+    auto remove = freecad_cast<Mesh::RemoveComponents*>(
+        doc()->addObject("Mesh::RemoveComponents", "Remove"));
+    flip->Source.setValue(source);
+    harmonize->Source.setValue(source);
+    remove->Source.setValue(flip);
+    remove->RemoveCompOfSize.setValue(1);
+
+    std::set<std::thread::id> signalThreads;
+    auto connection = doc()->signalChangedObject.connect(
+        [&signalThreads](const App::DocumentObject&, const App::Property&) {
+            signalThreads.insert(std::this_thread::get_id());
+        });
+    bool hasError = false;
+
+    hGrp->SetBool("ParallelRecompute", true);
+    hGrp->SetInt("RecomputeThreads", 2);
+    doc()->recompute({}, false, &hasError);
+    hGrp->RemoveBool("ParallelRecompute");
+    hGrp->RemoveInt("RecomputeThreads");
+    connection.disconnect();
+
+    EXPECT_FALSE(hasError);
+    const MeshCore::MeshKernel& flipped = flip->Mesh.getValue().getKernel();
+    ASSERT_EQ(flipped.CountFacets(), 2);
+    EXPECT_FLOAT_EQ(flipped.GetFacet(0).GetNormal().z, -1.0F);
+    EXPECT_FLOAT_EQ(flipped.GetFacet(1).GetNormal().z, -1.0F);
+    EXPECT_EQ(harmonize->Mesh.getValue().countFacets(), 2);
+    EXPECT_EQ(remove->Mesh.getValue().countFacets(), 0);
+    EXPECT_EQ(signalThreads, std::set<std::thread::id> {std::this_thread::get_id()});
+}
 // NOLINTEND(cppcoreguidelines-*,readability-*)
@@ -0,0 +1,148 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+
+#include <App/Application.h>
+#include <App/Document.h>
+#include <Base/FileInfo.h>
+#include <Base/Parameter.h>
+#include <Mod/Part/App/FeaturePartBox.h>
+#include <Mod/Part/App/FeaturePartCut.h>
+#include <Mod/Part/App/PersistentShapeCache.h>
+#include <src/App/InitApplication.h>
+
+#include "PartTestHelpers.h"
+
+// NOLINTBEGIN(readability-magic-numbers,cppcoreguidelines-avoid-magic-numbers)
+
+class PersistentShapeCacheTest: public ::testing::Test
+{
+protected:
+    static void SetUpTestSuite()
+    {
+        tests::initApplication();
+    }
+
+    void SetUp() override
+    {
+        _cacheDir = Base::FileInfo::getTempPath() + "PersistentShapeCacheTest";
+        _hGrp = App::GetApplication().GetParameterGroupByPath(
+            "User parameter:BaseApp/Preferences/Mod/Part/ShapeCache");
+        _hGrp->SetBool("Enabled", true);
+        _hGrp->SetASCII("Directory", _cacheDir.c_str());
+        _docName = App::GetApplication().getUniqueDocumentName("test");
+        _doc = App::GetApplication().newDocument(_docName.c_str(), "testUser");
+    }
+
+    void TearDown() override
+    {
+        App::GetApplication().closeDocument(_docName.c_str());
+        _hGrp->RemoveBool("Enabled");
+        _hGrp->RemoveASCII("Directory");
+        _hGrp->RemoveUnsigned("MaxSize");
+        std::filesystem::remove_all(Base::FileInfo::stringToPath(_cacheDir));
+    }
+
+    std::size_t countCachedShapes() const
+    {
+        auto dir = Base::FileInfo::stringToPath(_cacheDir);
+        if (!std::filesystem::exists(dir)) {
+            return 0;
+        }
+        auto it = std::filesystem::directory_iterator(dir);
+        return std::distance(std::filesystem::begin(it), std::filesystem::end(it));
+    }
+
+    Part::Box* addBox(double length, double y)
+    {
+        auto box = _doc->addObject<Part::Box>();
+        box->Length.setValue(length);
+        box->Width.setValue(2);
+        box->Height.setValue(3);
+        box->Placement.setValue(
+            Base::Placement(Base::Vector3d(0, y, 0), Base::Rotation(), Base::Vector3d()));
+        return box;
+    }
+
+    App::Document* _doc {};         // NOLINT Can't be private in a test framework
+    ParameterGrp::handle _hGrp;  // NOLINT Can't be private in a test framework
+
+private:
+    std::string _cacheDir;
+    std::string _docName;
+};
+
+TEST_F(PersistentShapeCacheTest, sameInputsShareCachedShape)
+{
+    // Arrange
+    auto box1 = addBox(1, 0);
+    auto box2 = addBox(1, 5);
+
+    // Act
+    _doc->recompute();
+
+    // Assert
+    EXPECT_EQ(countCachedShapes(), 1);
+    EXPECT_DOUBLE_EQ(PartTestHelpers::getVolume(box2->Shape.getValue()), 6.0);
+    EXPECT_DOUBLE_EQ(box1->Shape.getShape().getBoundBox().MinY, 0.0);
+    EXPECT_DOUBLE_EQ(box2->Shape.getShape().getBoundBox().MinY, 5.0);
+}
+
+TEST_F(PersistentShapeCacheTest, changedInputsStoreNewShape)
+{
+    // Arrange
+    auto box = addBox(1, 0);
+    _doc->recompute();
+
+    // Act
+    box->Length.setValue(4);
+    _doc->recompute();
+
+    // Assert
+    EXPECT_EQ(countCachedShapes(), 2);
+    EXPECT_DOUBLE_EQ(PartTestHelpers::getVolume(box->Shape.getValue()), 24.0);
+}
+
+TEST_F(PersistentShapeCacheTest, linkedInputsAreHashedByTheirShape)
+{
+    // Arrange
+    auto base = addBox(4, 0);
+    auto tool = addBox(1, 0);
+    auto cut = _doc->addObject<Part::Cut>();
+    cut->Base.setValue(base);
+    cut->Tool.setValue(tool);
+    _doc->recompute();
+    auto cached = countCachedShapes();
+
+    // Act
+    tool->Placement.setValue(
+        Base::Placement(Base::Vector3d(0, 1, 0), Base::Rotation(), Base::Vector3d()));
+    _doc->recompute();
+    auto afterMove = countCachedShapes();
+    tool->Placement.setValue(Base::Placement());
+    _doc->recompute();
+
+    // Assert
+    EXPECT_EQ(cached, 3);
+    EXPECT_EQ(afterMove, 4);
+    EXPECT_EQ(countCachedShapes(), 4);
+    EXPECT_DOUBLE_EQ(PartTestHelpers::getVolume(cut->Shape.getValue()), 18.0);
+}
+
+TEST_F(PersistentShapeCacheTest, cacheIsBoundedByMaxSize)
+{
+    // Arrange
+    _hGrp->SetUnsigned("MaxSize", 0);
+    auto box = addBox(1, 0);
+
+    // Act
+    _doc->recompute();
+
+    // Assert
+    EXPECT_EQ(countCachedShapes(), 0);
+    EXPECT_DOUBLE_EQ(PartTestHelpers::getVolume(box->Shape.getValue()), 6.0);
+}
+
+// NOLINTEND(readability-magic-numbers,cppcoreguidelines-avoid-magic-numbers)
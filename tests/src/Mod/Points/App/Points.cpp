@@ -1,5 +1,12 @@
 #include <gtest/gtest.h>
+#include <array>
+#include <cmath>
+#include <set>
+#include <E57SimpleWriter.h>
 #include <Base/FileInfo.h>
+#include <Base/Stream.h>
+#include <Base/Swap.h>
+#include <Mod/Points/App/BinaryTable.h>
 #include <Mod/Points/App/Points.h>
 #include <Mod/Points/App/PointsAlgos.h>
 
@@ -46,6 +53,32 @@ protected:
         std::vector<Base::Vector3f> vec(8, Base::Vector3f(0, 0, 1));
         return vec;
     }
+    // a grid with more points than a block of the parallel conversion
+    std::vector<Base::Vector3f> getLargeGrid() const
+    {
+        std::vector<Base::Vector3f> points;
+        for (int i = 0; i < 100000; i++) {
+            points.emplace_back(float(i % 100), float(i / 100 % 100), float(i / 10000));
+        }
+        return points;
+    }
+    // LZF data that only consists of literal runs
+    static std::vector<char> lzfLiterals(const std::vector<char>& data)
+    {
+        std::vector<char> out;
+        for (std::size_t pos = 0; pos < data.size(); pos += 32) {
+            std::size_t len = std::min<std::size_t>(32, data.size() - pos);
+            out.push_back(char(len - 1));
+            out.insert(out.end(), data.begin() + pos, data.begin() + pos + len);
+        }
+        return out;
+    }
+    template<typename T>
+    static void writeSwapped(std::ostream& out, T value)
+    {
+        Base::SwapEndian(value);
+        out.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
     std::vector<Base::Color> getColors() const
     {
         std::vector<Base::Color> col(8);
@@ -177,6 +210,85 @@ TEST_F(PointsTest, TestPLYWithProperties)
     EXPECT_EQ(reader.getHeight(), 1);
 }
 
+TEST_F(PointsTest, TestBinaryPLY)
+{
+    std::string name = getFileName();
+    {
+        Base::ofstream out(Base::FileInfo(name), std::ios::out | std::ios::binary);
+        out << "ply\n"
+            << "format binary_little_endian 1.0\n"
+            << "element vertex 8\n"
+            << "property float x\n"
+            << "property float y\n"
+            << "property float z\n"
+            << "property float intensity\n"
+            << "property uchar red\n"
+            << "property uchar green\n"
+            << "property uchar blue\n"
+            << "end_header\n";
+        std::vector<float> intensity = getIntensity();
+        for (std::size_t i = 0; i < getKernel().size(); i++) {
+            Base::Vector3f pnt = getKernel().getBasicPoints()[i];
+            out.write(reinterpret_cast<const char*>(&pnt.x), sizeof(float));
+            out.write(reinterpret_cast<const char*>(&pnt.y), sizeof(float));
+            out.write(reinterpret_cast<const char*>(&pnt.z), sizeof(float));
+            out.write(reinterpret_cast<const char*>(&intensity[i]), sizeof(float));
+            unsigned char rgb[3] = {static_cast<unsigned char>(pnt.x * 255),
+                                    static_cast<unsigned char>(pnt.y * 255),
+                                    static_cast<unsigned char>(pnt.z * 255)};
+            out.write(reinterpret_cast<const char*>(rgb), sizeof(rgb));
+        }
+    }
+
+    Points::PlyReader reader;
+    reader.read(name);
+
+    EXPECT_TRUE(reader.hasIntensities());
+    EXPECT_TRUE(reader.hasColors());
+    EXPECT_FALSE(reader.hasNormals());
+    EXPECT_EQ(reader.getWidth(), 8);
+    EXPECT_EQ(reader.getPoints().getBasicPoints(), getKernel().getBasicPoints());
+    EXPECT_EQ(reader.getIntensities(), getIntensity());
+    EXPECT_FLOAT_EQ(reader.getColors()[5].r, 1.0F);
+    EXPECT_FLOAT_EQ(reader.getColors()[5].g, 0.0F);
+    EXPECT_FLOAT_EQ(reader.getColors()[5].b, 1.0F);
+}
+
+TEST_F(PointsTest, TestBinaryPCD)
+{
+    std::string name = getFileName();
+    {
+        Base::ofstream out(Base::FileInfo(name), std::ios::out | std::ios::binary);
+        out << "VERSION .7\n"
+            << "FIELDS x y z intensity\n"
+            << "SIZE 4 4 4 4\n"
+            << "TYPE F F F F\n"
+            << "COUNT 1 1 1 1\n"
+            << "WIDTH 8\n"
+            << "HEIGHT 1\n"
+            << "POINTS 8\n"
+            << "DATA binary\n";
+        std::vector<float> intensity = getIntensity();
+        for (std::size_t i = 0; i < getKernel().size(); i++) {
+            Base::Vector3f pnt = getKernel().getBasicPoints()[i];
+            out.write(reinterpret_cast<const char*>(&pnt.x), sizeof(float));
+            out.write(reinterpret_cast<const char*>(&pnt.y), sizeof(float));
+            out.write(reinterpret_cast<const char*>(&pnt.z), sizeof(float));
+            out.write(reinterpret_cast<const char*>(&intensity[i]), sizeof(float));
+        }
+    }
+
+    Points::PcdReader reader;
+    reader.read(name);
+
+    EXPECT_TRUE(reader.hasIntensities());
+    EXPECT_FALSE(reader.hasColors());
+    EXPECT_FALSE(reader.hasNormals());
+    EXPECT_EQ(reader.getWidth(), 8);
+    EXPECT_EQ(reader.getPoints().getBasicPoints(), getKernel().getBasicPoints());
+    EXPECT_EQ(reader.getIntensities(), getIntensity());
+}
+
 TEST_F(PointsTest, TestPlainPCD)
 {
     std::string name = getFileName();
@@ -238,4 +350,377 @@ TEST_F(PointsTest, TestPCDStructured)
     EXPECT_EQ(reader.getWidth(), 4);
     EXPECT_EQ(reader.getHeight(), 2);
 }
+
+TEST_F(PointsTest, TestE57MultipleScans)
+{
+    // more scans than threads so that the file handles get reused, the even scans have colors
+    // and the odd scans intensities
+    const int numScans = 12;
+    auto countPoints = [](int scan) {
+        return 100 + 37 * scan;
+    };
+    // every point is duplicated so that the distance filter drops every second one
+    auto getPoint = [](int scan, int index) {
+        return Base::Vector3f(float(index / 2), float(scan), 0.0F);
+    };
+    auto getColor = [](int scan, int index) {
+        return Base::Color(float(scan) / 255.0F, float(index % 256) / 255.0F, 0.0F);
+    };
+    auto getIntensity = [](int index) {
+        return float(index) / 1000.0F;
+    };
+
+    std::string name = getFileName();
+    {
+        e57::Writer writer(name);
+        for (int scan = 0; scan < numScans; scan++) {
+            bool hasColor = scan % 2 == 0;
+            int count = countPoints(scan);
+
+            e57::Data3D header;
+            header.name = "scan" + std::to_string(scan);
+            header.pointFields.cartesianXField = true;
+            header.pointFields.cartesianYField = true;
+            header.pointFields.cartesianZField = true;
+            if (hasColor) {
+                header.pointFields.colorRedField = true;
+                header.pointFields.colorGreenField = true;
+                header.pointFields.colorBlueField = true;
+                header.colorLimits.colorRedMaximum = 255;
+                header.colorLimits.colorGreenMaximum = 255;
+                header.colorLimits.colorBlueMaximum = 255;
+            }
+            else {
+                header.pointFields.intensityField = true;
+                header.pointFields.intensityScaledInteger = e57::E57_NOT_SCALED_USE_FLOAT;
+                header.intensityLimits.intensityMaximum = 1.0;
+            }
+            header.pointsSize = count;
+            int64_t index = writer.NewData3D(header);
+
+            std::vector<float> x(count), y(count), z(count), intensity(count);
+            std::vector<uint8_t> red(count), green(count), blue(count);
+            for (int i = 0; i < count; i++) {
+                Base::Vector3f pnt = getPoint(scan, i);
+                x[i] = pnt.x;
+                y[i] = pnt.y;
+                z[i] = pnt.z;
+                red[i] = uint8_t(scan);
+                green[i] = uint8_t(i % 256);
+                blue[i] = 0;
+                intensity[i] = getIntensity(i);
+            }
+
+            e57::Data3DPointsData buffers;
+            buffers.cartesianX = x.data();
+            buffers.cartesianY = y.data();
+            buffers.cartesianZ = z.data();
+            if (hasColor) {
+                buffers.colorRed = red.data();
+                buffers.colorGreen = green.data();
+                buffers.colorBlue = blue.data();
+            }
+            else {
+                buffers.intensity = intensity.data();
+            }
+            e57::CompressedVectorWriter data = writer.SetUpData3DPointsData(index, count, buffers);
+            data.write(count);
+            data.close();
+        }
+        writer.Close();
+    }
+
+    Points::E57Reader reader(true, false, 0.5);
+    reader.read(name);
+
+    // the kept points of all scans in order, scans without colors or intensities get defaults
+    std::vector<Base::Vector3f> points;
+    std::vector<Base::Color> colors;
+    std::vector<float> intensity;
+    for (int scan = 0; scan < numScans; scan++) {
+        bool hasColor = scan % 2 == 0;
+        for (int i = 0; i < countPoints(scan); i += 2) {
+            points.push_back(getPoint(scan, i));
+            colors.push_back(hasColor ? getColor(scan, i) : Base::Color());
+            intensity.push_back(hasColor ? 0.0F : getIntensity(i));
+        }
+    }
+
+    ASSERT_TRUE(reader.hasColors());
+    ASSERT_TRUE(reader.hasIntensities());
+    EXPECT_FALSE(reader.hasNormals());
+    EXPECT_EQ(reader.getWidth(), int(points.size()));
+    ASSERT_EQ(reader.getPoints().getBasicPoints(), points);
+    ASSERT_EQ(reader.getColors().size(), colors.size());
+    ASSERT_EQ(reader.getIntensities().size(), intensity.size());
+    for (std::size_t i = 0; i < points.size(); i++) {
+        EXPECT_FLOAT_EQ(reader.getColors()[i].r, colors[i].r);
+        EXPECT_FLOAT_EQ(reader.getColors()[i].g, colors[i].g);
+        EXPECT_FLOAT_EQ(reader.getColors()[i].b, colors[i].b);
+        EXPECT_FLOAT_EQ(reader.getIntensities()[i], intensity[i]);
+    }
+}
+
+TEST_F(PointsTest, TestE57VoxelFilter)
+{
+    // a line of points per scan, the first three scans share the same voxels
+    const float voxelSize = 2.0F;
+    std::vector<std::vector<Base::Vector3f>> scans(4);
+    for (int scan = 0; scan < 4; scan++) {
+        float y = scan < 3 ? float(scan) * 0.5F : 2.5F;
+        for (int i = 0; i < 40; i++) {
+            scans[scan].emplace_back(float(i) * 0.5F, y, 0.0F);
+        }
+    }
+
+    std::string name = getFileName();
+    {
+        e57::Writer writer(name);
+        for (auto& points : scans) {
+            int64_t count = int64_t(points.size());
+            e57::Data3D header;
+            header.pointFields.cartesianXField = true;
+            header.pointFields.cartesianYField = true;
+            header.pointFields.cartesianZField = true;
+            header.pointsSize = count;
+            int64_t index = writer.NewData3D(header);
+
+            std::vector<float> x, y, z;
+            for (const auto& pnt : points) {
+                x.push_back(pnt.x);
+                y.push_back(pnt.y);
+                z.push_back(pnt.z);
+            }
+
+            e57::Data3DPointsData buffers;
+            buffers.cartesianX = x.data();
+            buffers.cartesianY = y.data();
+            buffers.cartesianZ = z.data();
+            e57::CompressedVectorWriter data = writer.SetUpData3DPointsData(index, count, buffers);
+            data.write(count);
+            data.close();
+        }
+        writer.Close();
+    }
+
+    Points::E57Reader reader(false, false, -1.0, voxelSize);
+    reader.read(name);
+
+    // the first point of each voxel in the order of the scans
+    std::vector<Base::Vector3f> points;
+    std::set<std::array<int, 3>> voxels;
+    for (const auto& scan : scans) {
+        for (const auto& pnt : scan) {
+            std::array<int, 3> key {int(std::floor(pnt.x / voxelSize)),
+                                    int(std::floor(pnt.y / voxelSize)),
+                                    int(std::floor(pnt.z / voxelSize))};
+            if (voxels.insert(key).second) {
+                points.push_back(pnt);
+            }
+        }
+    }
+
+    EXPECT_FALSE(reader.hasColors());
+    EXPECT_FALSE(reader.hasIntensities());
+    EXPECT_EQ(points.size(), 20);
+    EXPECT_EQ(reader.getPoints().getBasicPoints(), points);
+}
+
+TEST_F(PointsTest, TestBigEndianPLY)
+{
+    std::string name = getFileName();
+    {
+        Base::ofstream out(Base::FileInfo(name), std::ios::out | std::ios::binary);
+        out << "ply\n"
+            << "format binary_big_endian 1.0\n"
+            << "element vertex 8\n"
+            << "property float x\n"
+            << "property float y\n"
+            << "property float z\n"
+            << "property double intensity\n"
+            << "property short nx\n"
+            << "property ushort ny\n"
+            << "property int nz\n"
+            << "end_header\n";
+        std::vector<float> intensity = getIntensity();
+        for (std::size_t i = 0; i < getKernel().size(); i++) {
+            Base::Vector3f pnt = getKernel().getBasicPoints()[i];
+            writeSwapped(out, pnt.x);
+            writeSwapped(out, pnt.y);
+            writeSwapped(out, pnt.z);
+            writeSwapped(out, double(intensity[i]));
+            writeSwapped(out, int16_t(-1));
+            writeSwapped(out, uint16_t(300));
+            writeSwapped(out, int32_t(i));
+        }
+    }
+
+    Points::PlyReader reader;
+    reader.read(name);
+
+    EXPECT_TRUE(reader.hasIntensities());
+    EXPECT_TRUE(reader.hasNormals());
+    EXPECT_EQ(reader.getWidth(), 8);
+    EXPECT_EQ(reader.getPoints().getBasicPoints(), getKernel().getBasicPoints());
+    EXPECT_EQ(reader.getIntensities(), getIntensity());
+    for (std::size_t i = 0; i < reader.getNormals().size(); i++) {
+        EXPECT_EQ(reader.getNormals()[i], Base::Vector3f(-1.0F, 300.0F, float(i)));
+    }
+}
+
+TEST_F(PointsTest, TestPLYVertexAfterOtherElement)
+{
+    std::string name = getFileName();
+    {
+        Base::ofstream out(Base::FileInfo(name), std::ios::out | std::ios::binary);
+        out << "ply\n"
+            << "format binary_little_endian 1.0\n"
+            << "comment the vertices start after the camera records\n"
+            << "element camera 3\n"
+            << "property float view_px\n"
+            << "property uchar flag\n"
+            << "element vertex 8\n"
+            << "property float x\n"
+            << "property float y\n"
+            << "property float z\n"
+            << "end_header\n";
+        for (int i = 0; i < 3; i++) {
+            float value = 42.0F;
+            unsigned char flag = 7;
+            out.write(reinterpret_cast<const char*>(&value), sizeof(value));
+            out.write(reinterpret_cast<const char*>(&flag), sizeof(flag));
+        }
+        for (const auto& pnt : getKernel().getBasicPoints()) {
+            out.write(reinterpret_cast<const char*>(&pnt.x), sizeof(float));
+            out.write(reinterpret_cast<const char*>(&pnt.y), sizeof(float));
+            out.write(reinterpret_cast<const char*>(&pnt.z), sizeof(float));
+        }
+    }
+
+    Points::PlyReader reader;
+    reader.read(name);
+
+    EXPECT_EQ(reader.getWidth(), 8);
+    EXPECT_EQ(reader.getPoints().getBasicPoints(), getKernel().getBasicPoints());
+}
+
+TEST_F(PointsTest, TestLargeBinaryPLY)
+{
+    std::vector<Base::Vector3f> points = getLargeGrid();
+    std::string name = getFileName();
+    {
+        Base::ofstream out(Base::FileInfo(name), std::ios::out | std::ios::binary);
+        out << "ply\n"
+            << "format binary_little_endian 1.0\n"
+            << "element vertex " << points.size() << "\n"
+            << "property float x\n"
+            << "property float y\n"
+            << "property float z\n"
+            << "property float intensity\n"
+            << "end_header\n";
+        for (std::size_t i = 0; i < points.size(); i++) {
+            float value = float(i);
+            out.write(reinterpret_cast<const char*>(&points[i]), 3 * sizeof(float));
+            out.write(reinterpret_cast<const char*>(&value), sizeof(value));
+        }
+    }
+
+    Points::PlyReader reader;
+    reader.read(name);
+
+    EXPECT_EQ(reader.getWidth(), int(points.size()));
+    EXPECT_EQ(reader.getPoints().getBasicPoints(), points);
+    ASSERT_EQ(reader.getIntensities().size(), points.size());
+    for (std::size_t i = 0; i < points.size(); i++) {
+        EXPECT_EQ(reader.getIntensities()[i], float(i));
+    }
+}
+
+TEST_F(PointsTest, TestCompressedPCD)
+{
+    // the decompressed data is stored field by field
+    std::vector<Base::Vector3f> points = getLargeGrid();
+    std::vector<char> data;
+    auto append = [&data](const auto& value) {
+        const char* ptr = reinterpret_cast<const char*>(&value);
+        data.insert(data.end(), ptr, ptr + sizeof(value));
+    };
+    for (const auto& pnt : points) {
+        append(pnt.x);
+    }
+    for (const auto& pnt : points) {
+        append(pnt.y);
+    }
+    for (const auto& pnt : points) {
+        append(pnt.z);
+    }
+    for (std::size_t i = 0; i < points.size(); i++) {
+        append(uint16_t(i % 65536));
+    }
+
+    std::string name = getFileName();
+    {
+        std::vector<char> compressed = lzfLiterals(data);
+        auto c = static_cast<unsigned int>(compressed.size());
+        auto u = static_cast<unsigned int>(data.size());
+        Base::ofstream out(Base::FileInfo(name), std::ios::out | std::ios::binary);
+        out << "VERSION .7\n"
+            << "FIELDS x y z intensity\n"
+            << "SIZE 4 4 4 2\n"
+            << "TYPE F F F U\n"
+            << "COUNT 1 1 1 1\n"
+            << "WIDTH " << points.size() << "\n"
+            << "HEIGHT 1\n"
+            << "POINTS " << points.size() << "\n"
+            << "DATA binary_compressed\n";
+        out.write(reinterpret_cast<const char*>(&c), sizeof(c));
+        out.write(reinterpret_cast<const char*>(&u), sizeof(u));
+        out.write(compressed.data(), std::streamsize(compressed.size()));
+    }
+
+    Points::PcdReader reader;
+    reader.read(name);
+
+    EXPECT_TRUE(reader.hasIntensities());
+    EXPECT_EQ(reader.getWidth(), int(points.size()));
+    EXPECT_EQ(reader.getPoints().getBasicPoints(), points);
+    ASSERT_EQ(reader.getIntensities().size(), points.size());
+    for (std::size_t i = 0; i < points.size(); i++) {
+        EXPECT_EQ(reader.getIntensities()[i], float(i % 65536));
+    }
+}
+
+TEST_F(PointsTest, TestBinaryDataBuffered)
+{
+    std::string name = getFileName();
+    std::vector<float> values {1.0F, -2.5F, 3.25F, 1e6F};
+    {
+        Base::ofstream out(Base::FileInfo(name), std::ios::out | std::ios::binary);
+        out << "header\n";
+        for (float value : values) {
+            writeSwapped(out, value);
+        }
+    }
+
+    std::string line;
+    Base::FileInfo fi(name);
+    Base::ifstream mappedInp(fi, std::ios::in | std::ios::binary);
+    std::getline(mappedInp, line);
+    Points::BinaryData mapped(fi, mappedInp);
+
+    // the fallback if the file cannot be mapped
+    Base::ifstream bufferedInp(fi, std::ios::in | std::ios::binary);
+    std::getline(bufferedInp, line);
+    Points::BinaryData buffered(bufferedInp);
+
+    ASSERT_EQ(buffered.size(), values.size() * sizeof(float));
+    ASSERT_EQ(mapped.size(), buffered.size());
+    EXPECT_EQ(std::memcmp(mapped.data(), buffered.data(), buffered.size()), 0);
+
+    Points::BinaryTable table(buffered.data(), true);
+    table.setRecords({Points::BinaryTable::Type::Float32});
+    for (std::size_t i = 0; i < values.size(); i++) {
+        EXPECT_EQ(table.get<float>(Eigen::Index(i), 0), values[i]);
+    }
+}
 // NOLINTEND(cppcoreguidelines-*,readability-*)
@@ -0,0 +1,140 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <Base/Exception.h>
+#include <Mod/Points/App/Points.h>
+#include <Mod/Points/App/PointsDownsample.h>
+#include "PointsTestHelpers.h"
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+
+class PointsDownsampleTest: public ::testing::Test
+{
+protected:
+    // a regular grid of num x num points over the unit square in the xy plane
+    void SetUp() override
+    {
+        grid.setBasicPoints(PointsTestHelpers::MakeGrid(num, 1, num));
+        for (std::size_t i = 0; i < grid.size(); i++) {
+            intensities.push_back(float(i % num));
+        }
+    }
+
+    static Points::PointKernel randomCube(std::size_t count)
+    {
+        Points::PointKernel kernel;
+        kernel.setBasicPoints(PointsTestHelpers::RandomCube(count));
+        return kernel;
+    }
+
+    static constexpr int num = 40;
+    Points::PointKernel grid;
+    std::vector<float> intensities;
+};
+
+TEST_F(PointsDownsampleTest, VoxelGrid)
+{
+    Points::PointDownsample downsample(grid);
+    downsample.setIntensities(intensities);
+    downsample.voxelGrid(0.5);
+
+    // 2 x 2 voxels with 20 x 20 points each
+    const auto& points = downsample.getPoints().getBasicPoints();
+    ASSERT_EQ(points.size(), 4);
+    ASSERT_EQ(downsample.getIntensities().size(), 4);
+    EXPECT_TRUE(downsample.getIndices().empty());
+    for (std::size_t i = 0; i < points.size(); i++) {
+        bool left = points[i].x < 0.5F;
+        EXPECT_NEAR(points[i].x, left ? 0.2375F : 0.7375F, 1e-5F);
+        EXPECT_FLOAT_EQ(downsample.getIntensities()[i], left ? 9.5F : 29.5F);
+        EXPECT_FLOAT_EQ(points[i].z, 0.0F);
+    }
+}
+
+TEST_F(PointsDownsampleTest, Random)
+{
+    Points::PointDownsample downsample(grid);
+    downsample.setIntensities(intensities);
+    downsample.random(100, 7);
+
+    std::vector<std::size_t> indices = downsample.getIndices();
+    ASSERT_EQ(indices.size(), 100);
+    EXPECT_TRUE(std::ranges::is_sorted(indices));
+    EXPECT_EQ(std::ranges::adjacent_find(indices), indices.end());
+    for (std::size_t i = 0; i < indices.size(); i++) {
+        EXPECT_EQ(downsample.getPoints().getBasicPoints()[i], grid.getBasicPoints()[indices[i]]);
+        EXPECT_EQ(downsample.getIntensities()[i], intensities[indices[i]]);
+    }
+
+    // same seed, same result
+    downsample.random(100, 7);
+    EXPECT_EQ(downsample.getIndices(), indices);
+
+    downsample.random(grid.size() + 1);
+    EXPECT_EQ(downsample.getPoints().size(), grid.size());
+
+    EXPECT_THROW(downsample.random(0), Base::ValueError);
+}
+
+TEST_F(PointsDownsampleTest, PoissonDisk)
+{
+    Points::PointKernel cube = randomCube(3000);
+    const auto& source = cube.getBasicPoints();
+    const float radius = 0.15F;
+
+    Points::PointDownsample downsample(cube);
+    downsample.poissonDisk(radius, 3);
+    const auto& points = downsample.getPoints().getBasicPoints();
+    ASSERT_GT(points.size(), 1);
+    ASSERT_LT(points.size(), source.size());
+
+    // no two kept points are closer than the radius
+    for (std::size_t i = 0; i < points.size(); i++) {
+        for (std::size_t j = i + 1; j < points.size(); j++) {
+            EXPECT_GE(Base::Distance(points[i], points[j]), radius);
+        }
+    }
+
+    // every dropped point is close to a kept point
+    for (const auto& pnt : source) {
+        auto it = std::ranges::find_if(points, [&](const Base::Vector3f& kept) {
+            return Base::Distance(pnt, kept) < radius;
+        });
+        EXPECT_NE(it, points.end());
+    }
+}
+
+TEST_F(PointsDownsampleTest, Curvature)
+{
+    // add a cluster of scattered points above the plane
+    Points::PointKernel kernel = grid;
+    Points::PointKernel cube = randomCube(500);
+    for (auto pnt : cube.getBasicPoints()) {
+        kernel.getBasicPoints().push_back(pnt * 0.2F + Base::Vector3f(0.0F, 0.0F, 0.5F));
+    }
+
+    Points::PointDownsample downsample(kernel);
+    downsample.curvature(0.25, 10);
+
+    // the flat cells keep one point each, the cell with the cluster keeps many
+    const auto& points = downsample.getPoints().getBasicPoints();
+    auto flat = std::ranges::count_if(points, [](const Base::Vector3f& pnt) {
+        return pnt.z == 0.0F;
+    });
+    EXPECT_EQ(flat, 16);
+    EXPECT_GT(points.size() - flat, 5);
+    EXPECT_LE(points.size() - flat, 10);
+}
+
+TEST_F(PointsDownsampleTest, InvalidPoints)
+{
+    Points::PointKernel kernel = grid;
+    kernel.getBasicPoints()[5].x = std::numeric_limits<float>::quiet_NaN();
+
+    Points::PointDownsample downsample(kernel);
+    downsample.random(kernel.size());
+    EXPECT_EQ(downsample.getPoints().size(), kernel.size() - 1);
+    EXPECT_EQ(std::ranges::count(downsample.getIndices(), 5), 0);
+}
+// NOLINTEND(cppcoreguidelines-*,readability-*)
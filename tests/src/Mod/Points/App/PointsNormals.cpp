@@ -0,0 +1,149 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <Base/Exception.h>
+#include <Mod/Points/App/Points.h>
+#include <Mod/Points/App/PointsKDTree.h>
+#include <Mod/Points/App/PointsNormals.h>
+#include "PointsTestHelpers.h"
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+
+class PointsNormalsTest: public ::testing::Test
+{
+protected:
+    // evenly spread points on a sphere around the origin
+    static Points::PointKernel sphere(std::size_t count, float radius)
+    {
+        std::vector<Base::Vector3f> points;
+        const double golden = M_PI * (3.0 - std::sqrt(5.0));
+        for (std::size_t i = 0; i < count; i++) {
+            double z = 1.0 - 2.0 * (double(i) + 0.5) / double(count);
+            double r = std::sqrt(1.0 - z * z);
+            double phi = golden * double(i);
+            points.emplace_back(float(r * std::cos(phi) * radius),
+                                float(r * std::sin(phi) * radius),
+                                float(z * radius));
+        }
+        Points::PointKernel kernel;
+        kernel.setBasicPoints(points);
+        return kernel;
+    }
+};
+
+TEST_F(PointsNormalsTest, NearestNeighbours)
+{
+    std::vector<Base::Vector3f> points = PointsTestHelpers::RandomCube(2000);
+    points[7].x = std::numeric_limits<float>::quiet_NaN();
+
+    Points::PointKDTree tree(points, 8);
+    EXPECT_EQ(tree.countPoints(), points.size() - 1);
+
+    std::mt19937 generator(7);
+    std::uniform_real_distribution<float> distribution(0.0F, 1.0F);
+    std::vector<std::size_t> indices;
+    std::vector<float> sqrDistances;
+    for (int i = 0; i < 50; i++) {
+        Base::Vector3f pnt(distribution(generator), distribution(generator), 0.5F);
+        tree.nearest(pnt, 12, indices, sqrDistances);
+
+        std::vector<float> expected = PointsTestHelpers::SortedSquaredDistances(points, pnt);
+        ASSERT_EQ(indices.size(), 12);
+        for (std::size_t j = 0; j < indices.size(); j++) {
+            EXPECT_FLOAT_EQ(sqrDistances[j], expected[j]);
+            EXPECT_FLOAT_EQ(sqrDistances[j], Base::DistanceP2(pnt, points[indices[j]]));
+        }
+    }
+
+    tree.nearest(Base::Vector3f(), points.size() + 5, indices, sqrDistances);
+    EXPECT_EQ(indices.size(), points.size() - 1);
+    EXPECT_TRUE(std::is_sorted(sqrDistances.begin(), sqrDistances.end()));
+}
+
+TEST_F(PointsNormalsTest, Plane)
+{
+    std::vector<Base::Vector3f> points;
+    for (int j = 0; j < 30; j++) {
+        for (int i = 0; i < 30; i++) {
+            points.emplace_back(float(i), float(j), 0.5F * float(i));
+        }
+    }
+    points.emplace_back(std::numeric_limits<float>::quiet_NaN(), 0.0F, 0.0F);
+    Points::PointKernel kernel;
+    kernel.setBasicPoints(points);
+
+    Points::PointNormalEstimation estimation(kernel);
+    std::vector<Base::Vector3f> normals;
+    estimation.perform(normals);
+    ASSERT_EQ(normals.size(), points.size());
+    EXPECT_EQ(normals.back(), Base::Vector3f());
+
+    // the normal of the plane z = x / 2
+    Base::Vector3f expected(-0.5F, 0.0F, 1.0F);
+    expected.Normalize();
+    for (std::size_t i = 0; i + 1 < normals.size(); i++) {
+        EXPECT_NEAR(std::fabs(normals[i] * expected), 1.0F, 1e-5F);
+    }
+
+    estimation.orient(normals);
+    for (std::size_t i = 0; i + 1 < normals.size(); i++) {
+        EXPECT_NEAR(normals[i] * expected, 1.0F, 1e-5F);
+    }
+}
+
+TEST_F(PointsNormalsTest, OrientSphere)
+{
+    Points::PointKernel kernel = sphere(3000, 2.0F);
+    const auto& points = kernel.getBasicPoints();
+
+    Points::PointNormalEstimation estimation(kernel);
+    estimation.setKSearch(8);
+    std::vector<Base::Vector3f> normals;
+    estimation.perform(normals);
+
+    // the top of the sphere is turned upwards, so all normals point outwards
+    estimation.orient(normals);
+    for (std::size_t i = 0; i < points.size(); i++) {
+        Base::Vector3f radial = points[i];
+        radial.Normalize();
+        EXPECT_GT(normals[i] * radial, 0.95F);
+    }
+}
+
+TEST_F(PointsNormalsTest, OrientOutlier)
+{
+    // a point below the sphere that has the points around the south pole as neighbours but is
+    // too far away to be a neighbour of any of them
+    Points::PointKernel kernel = sphere(3000, 2.0F);
+    kernel.getBasicPoints().emplace_back(0.0F, 0.0F, -2.4F);
+
+    Points::PointNormalEstimation estimation(kernel);
+    estimation.setKSearch(8);
+    std::vector<Base::Vector3f> normals;
+    estimation.perform(normals);
+
+    // the outlier gets the sign of its neighbours rather than being turned upwards on its own
+    normals.back() = Base::Vector3f(0.0F, 0.0F, 1.0F);
+    estimation.orient(normals);
+    EXPECT_EQ(normals.back(), Base::Vector3f(0.0F, 0.0F, -1.0F));
+}
+
+TEST_F(PointsNormalsTest, OrientTowards)
+{
+    Points::PointKernel kernel = sphere(500, 1.0F);
+    const auto& points = kernel.getBasicPoints();
+
+    Points::PointNormalEstimation estimation(kernel);
+    std::vector<Base::Vector3f> normals;
+    estimation.perform(normals);
+    estimation.orientTowards(Base::Vector3f(), normals);
+    for (std::size_t i = 0; i < points.size(); i++) {
+        EXPECT_LT(normals[i] * points[i], 0.0F);
+    }
+
+    normals.pop_back();
+    EXPECT_THROW(estimation.orient(normals), Base::ValueError);
+}
+// NOLINTEND(cppcoreguidelines-*,readability-*)
@@ -0,0 +1,172 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <Mod/Points/App/Points.h>
+#include <Mod/Points/App/PointsOctree.h>
+#include "PointsTestHelpers.h"
+
+// NOLINTBEGIN(cppcoreguidelines-*,readability-*)
+
+class PointsOctreeTest: public ::testing::Test
+{
+protected:
+    // a regular grid of num^3 points over the unit cube
+    void SetUp() override
+    {
+        kernel.setBasicPoints(PointsTestHelpers::MakeGrid(num, num, num - 1));
+    }
+
+    static constexpr int num = 40;
+    Points::PointKernel kernel;
+};
+
+TEST_F(PointsOctreeTest, TestBuild)
+{
+    Points::PointOctree octree(kernel, 100);
+    EXPECT_EQ(octree.countPoints(), kernel.size());
+    EXPECT_GT(octree.countNodes(), 64);
+
+    // every point is in exactly one leaf
+    std::vector<int> count(kernel.size(), 0);
+    octree.traverse([&](const Points::PointOctree::Node& node) {
+        if (node.isLeaf()) {
+            EXPECT_LE(node.size(), 100);
+            for (std::size_t index : octree.getPoints(node)) {
+                count[index]++;
+                EXPECT_TRUE(node.box.IsInBox(kernel.getBasicPoints()[index]));
+            }
+        }
+        return true;
+    });
+    EXPECT_TRUE(std::ranges::all_of(count, [](int value) {
+        return value == 1;
+    }));
+}
+
+TEST_F(PointsOctreeTest, TestInvalidPoints)
+{
+    const float nan = std::numeric_limits<float>::quiet_NaN();
+    std::vector<Base::Vector3f> points = kernel.getBasicPoints();
+    points[10].Set(nan, nan, nan);
+    kernel.setBasicPoints(points);
+
+    Points::PointOctree octree(kernel, 100);
+    EXPECT_EQ(octree.countPoints(), kernel.size() - 1);
+}
+
+TEST_F(PointsOctreeTest, TestSearch)
+{
+    Points::PointOctree octree(kernel, 100);
+    Base::BoundBox3f box(0.2F, 0.3F, 0.1F, 0.6F, 0.5F, 0.9F);
+    std::vector<std::size_t> indices;
+    octree.search(box, indices);
+    std::sort(indices.begin(), indices.end());
+    EXPECT_EQ(indices, PointsTestHelpers::PointsInBox(kernel.getBasicPoints(), box));
+}
+
+TEST_F(PointsOctreeTest, TestSearchPolygonFromInside)
+{
+    // a perspective camera inside the cloud looking along -z, the boxes of the nodes around
+    // the eye reach behind the near plane
+    Points::PointOctree octree(kernel, 8);
+    const Base::Vector3f eye(0.5F, 0.5F, 0.5F);
+    const float nearDist = 0.01F;
+    auto project = [&eye](const Base::Vector3f& pnt) {
+        Base::Vector3f dir = pnt - eye;
+        return Base::Vector2d(dir.x / -dir.z, dir.y / -dir.z);
+    };
+    auto inFront = [&](const Base::Vector3f& pnt) {
+        return eye.z - pnt.z >= nearDist;
+    };
+
+    Base::Polygon2d polygon;
+    polygon.Add(Base::Vector2d(1.03, -0.47));
+    polygon.Add(Base::Vector2d(2.03, -0.47));
+    polygon.Add(Base::Vector2d(2.03, 0.53));
+    polygon.Add(Base::Vector2d(1.03, 0.53));
+
+    std::vector<std::size_t> expected;
+    const auto& points = kernel.getBasicPoints();
+    for (std::size_t i = 0; i < points.size(); i++) {
+        if (polygon.Contains(project(points[i]))) {
+            expected.push_back(i);
+        }
+    }
+    ASSERT_FALSE(expected.empty());
+
+    std::vector<std::size_t> indices;
+    octree.search(polygon, project, inFront, indices);
+    std::sort(indices.begin(), indices.end());
+    EXPECT_EQ(indices, expected);
+}
+
+TEST_F(PointsOctreeTest, TestNearest)
+{
+    Points::PointOctree octree(kernel, 100);
+    const auto& points = kernel.getBasicPoints();
+    for (const Base::Vector3f& pnt : {Base::Vector3f(0.31F, 0.52F, 0.77F),
+                                      Base::Vector3f(-1.0F, 0.5F, 0.5F),
+                                      Base::Vector3f(2.0F, 3.0F, 4.0F)}) {
+        float best = std::sqrt(PointsTestHelpers::SortedSquaredDistances(points, pnt).front());
+
+        std::size_t index {};
+        float distance {};
+        ASSERT_TRUE(octree.nearest(pnt, index, distance));
+        EXPECT_FLOAT_EQ(distance, best);
+        EXPECT_FLOAT_EQ(Base::Distance(pnt, points[index]), best);
+    }
+}
+
+TEST_F(PointsOctreeTest, TestLevelOfDetail)
+{
+    Points::PointOctree octree(kernel, 100);
+    Base::BoundBox3f box = octree.getBoundBox();
+
+    std::vector<std::size_t> indices;
+    octree.selectLevelOfDetail(box, 5000, indices);
+    EXPECT_LE(indices.size(), 5000);
+    EXPECT_GT(indices.size(), 2500);
+
+    // the points are evenly distributed over the octants
+    std::array<int, 8> octants {};
+    for (std::size_t index : indices) {
+        const auto& pnt = kernel.getBasicPoints()[index];
+        octants[(pnt.x > 0.5F ? 1 : 0) + (pnt.y > 0.5F ? 2 : 0) + (pnt.z > 0.5F ? 4 : 0)]++;
+    }
+    for (int count : octants) {
+        EXPECT_NEAR(count, indices.size() / 8.0, indices.size() / 20.0);
+    }
+
+    // with a large enough budget all points are selected
+    indices.clear();
+    octree.selectLevelOfDetail(box, kernel.size(), indices);
+    EXPECT_EQ(indices.size(), kernel.size());
+}
+
+TEST_F(PointsOctreeTest, TestLevelOfDetailEye)
+{
+    Points::PointOctree octree(kernel, 100);
+    Base::BoundBox3f box(0.0F, 0.0F, 0.0F, 1.0F, 1.0F, 0.5F);
+
+    std::vector<std::size_t> indices;
+    octree.selectLevelOfDetail(box, Base::Vector3f(0.0F, 0.0F, 0.0F), 2000, indices);
+    EXPECT_LE(indices.size(), 2000);
+
+    // the points near the eye are denser
+    int near = 0;
+    int far = 0;
+    for (std::size_t index : indices) {
+        const auto& pnt = kernel.getBasicPoints()[index];
+        EXPECT_TRUE(box.IsInBox(pnt));
+        if (pnt.x < 0.5F && pnt.y < 0.5F) {
+            near++;
+        }
+        else if (pnt.x >= 0.5F && pnt.y >= 0.5F) {
+            far++;
+        }
+    }
+    EXPECT_GT(near, 2 * far);
+}
+
+// NOLINTEND(cppcoreguidelines-*,readability-*)
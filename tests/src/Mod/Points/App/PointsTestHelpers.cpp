@@ -0,0 +1,64 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include "PointsTestHelpers.h"
+
+namespace PointsTestHelpers
+{
+
+std::vector<Base::Vector3f> MakeGrid(int num, int layers, int divisions)
+{
+    std::vector<Base::Vector3f> points;
+    for (int k = 0; k < layers; k++) {
+        for (int j = 0; j < num; j++) {
+            for (int i = 0; i < num; i++) {
+                points.emplace_back(float(i) / float(divisions),
+                                    float(j) / float(divisions),
+                                    float(k) / float(divisions));
+            }
+        }
+    }
+    return points;
+}
+
+std::vector<Base::Vector3f> RandomCube(std::size_t count)
+{
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<float> distribution(0.0F, 1.0F);
+    std::vector<Base::Vector3f> points(count);
+    for (auto& pnt : points) {
+        pnt.x = distribution(generator);
+        pnt.y = distribution(generator);
+        pnt.z = distribution(generator);
+    }
+    return points;
+}
+
+std::vector<std::size_t> PointsInBox(const std::vector<Base::Vector3f>& points,
+                                     const Base::BoundBox3f& box)
+{
+    std::vector<std::size_t> indices;
+    for (std::size_t i = 0; i < points.size(); i++) {
+        if (box.IsInBox(points[i])) {
+            indices.push_back(i);
+        }
+    }
+    return indices;
+}
+
+std::vector<float> SortedSquaredDistances(const std::vector<Base::Vector3f>& points,
+                                          const Base::Vector3f& pnt)
+{
+    std::vector<float> distances;
+    for (const auto& it : points) {
+        if (!std::isnan(it.x) && !std::isnan(it.y) && !std::isnan(it.z)) {
+            distances.push_back(Base::DistanceP2(pnt, it));
+        }
+    }
+    std::sort(distances.begin(), distances.end());
+    return distances;
+}
+
+}  // namespace PointsTestHelpers
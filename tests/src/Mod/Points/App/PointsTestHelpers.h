@@ -0,0 +1,40 @@
+// SPDX-License-Identifier: LGPL-2.1-or-later
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+#include <Base/BoundBox.h>
+#include <Base/Vector3D.h>
+
+namespace PointsTestHelpers
+{
+
+/**
+ * A regular grid of num x num x layers points starting at the origin.
+ *
+ * @param num        The number of points along x and y
+ * @param layers     The number of points along z
+ * @param divisions  The coordinates of the points are their indices divided by this number
+ */
+std::vector<Base::Vector3f> MakeGrid(int num, int layers, int divisions);
+
+/**
+ * Random points inside the unit cube. The same count always gives the same points.
+ */
+std::vector<Base::Vector3f> RandomCube(std::size_t count);
+
+/**
+ * The indices of the points inside the box, found by testing every point.
+ */
+std::vector<std::size_t> PointsInBox(const std::vector<Base::Vector3f>& points,
+                                     const Base::BoundBox3f& box);
+
+/**
+ * The squared distances of all points to pnt in ascending order. Points with NaN coordinates
+ * are skipped.
+ */
+std::vector<float> SortedSquaredDistances(const std::vector<Base::Vector3f>& points,
+                                          const Base::Vector3f& pnt);
+
+}  // namespace PointsTestHelpers
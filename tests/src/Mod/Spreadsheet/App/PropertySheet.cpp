@@ -3,8 +3,11 @@
 #include <gtest/gtest.h>
 #include "src/App/InitApplication.h"
 
+#include <algorithm>
 #include <memory>
 
+#include <App/Application.h>
+#include <App/Document.h>
 #include <Mod/Spreadsheet/App/Sheet.h>
 #include <Mod/Spreadsheet/App/PropertySheet.h>
 
@@ -87,3 +90,34 @@ TEST_F(PropertySheetTest, invalidAliases)  // NOLINT
             << "\"" << name << "\" was accepted as an alias name, and should not be";
     }
 }
+
+TEST(PropertySheetDependencies, objectDependencyFollowsLastReferencingCell)  // NOLINT
+{
+    // Arrange
+    tests::initApplication();
+    std::string docName = App::GetApplication().getUniqueDocumentName("test");
+    App::Document* doc = App::GetApplication().newDocument(docName.c_str(), "testUser");
+    auto source = freecad_cast<Spreadsheet::Sheet*>(doc->addObject("Spreadsheet::Sheet", "Source"));
+    auto target = freecad_cast<Spreadsheet::Sheet*>(doc->addObject("Spreadsheet::Sheet", "Target"));
+    source->setCell("A1", "1");
+    target->setCell("A1", "=Source.A1");
+    target->setCell("A2", "=Source.A1 + 1");
+    target->setCell("A3", "=A2 * 2");
+    doc->recompute();
+
+    // Act
+    target->setCell("A1", "");
+    auto outListAfterFirst = target->getOutList();
+    target->setCell("A2", "2");
+    auto outListAfterLast = target->getOutList();
+    doc->recompute();
+
+    // Assert
+    EXPECT_EQ(std::count(outListAfterFirst.begin(), outListAfterFirst.end(), source), 1);
+    EXPECT_EQ(std::count(outListAfterLast.begin(), outListAfterLast.end(), source), 0);
+    auto a3 = dynamic_cast<App::PropertyFloat*>(target->getPropertyByName("A3"));
+    ASSERT_NE(a3, nullptr);
+    EXPECT_DOUBLE_EQ(a3->getValue(), 4.0);
+
+    App::GetApplication().closeDocument(docName.c_str());
+}